@@ -48,6 +48,9 @@ IF(CXX11)
 		IF(CXX11_FLAG)
 			ADD_DEFINITIONS(-DUG_CXX11)
 			add_cpp_flag(${CXX11_FLAG})
+			# std::thread is used for asynchronous output
+			find_package(Threads)
+			set(linkLibraries ${linkLibraries} ${CMAKE_THREAD_LIBS_INIT})
 			MESSAGE(STATUS "Info: C++11 enabled. (flag: ${CXX11_FLAG})")
 		ELSE()
 			SET(CXX11 OFF)
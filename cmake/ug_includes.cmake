@@ -185,6 +185,7 @@ option(POSIX "If enabled and available, some additional functionality may be ava
 option(CRS_ALGEBRA "Use the CRS Sparse Matrix" OFF)
 option(CPU_ALGEBRA "Use the old CPU Sparse Matrix" ON)
 option(INTERNAL_MEMTRACKER "Internal Memory Tracker" OFF)
+option(MEM_ACCOUNTING "Enables categorized accounting of memory used by matrices, vectors, attachments and buffers. Valid options are ON, OFF" ON)
 
 if(APPLE)
 	option(USE_LUA2C "Use LUA2C" ON)
@@ -265,6 +266,7 @@ message(STATUS "Info: PROFILER:          ${PROFILER} (options are: ${profilerOpt
 message(STATUS "Info: PROFILE_PCL:       ${PROFILE_PCL} (options are: ON, OFF)")
 message(STATUS "Info: CPU_FREQ:          ${CPU_FREQ} (options are: ON, OFF)")
 message(STATUS "Info: PROFILE_BRIDGE:    ${PROFILE_BRIDGE} (options are: ON, OFF)")
+message(STATUS "Info: MEM_ACCOUNTING:    ${MEM_ACCOUNTING} (options are: ON, OFF)")
 message(STATUS "Info: LAPACK:            ${LAPACK} (options are: ON, OFF)")
 message(STATUS "Info: BLAS:              ${BLAS} (options are: ON, OFF)")
 message(STATUS "Info: INTERNAL_BOOST:    ${INTERNAL_BOOST} (options are: ON, OFF)")
@@ -420,6 +422,13 @@ if(PCL_DEBUG_BARRIER)
 endif(PCL_DEBUG_BARRIER)
 
 
+########################################
+# MEM_ACCOUNTING
+if(MEM_ACCOUNTING)
+	add_definitions(-DUG_MEM_ACCOUNTING)
+endif(MEM_ACCOUNTING)
+
+
 ########################################
 # OPENMP
 include(${UG_ROOT_CMAKE_PATH}/ug/openmp.cmake)
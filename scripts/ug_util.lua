@@ -48,6 +48,7 @@ ug_load_script("util/gnuplot.lua")
 ug_load_script("util/table_util.lua")
 ug_load_script("util/time_step_util.lua")
 ug_load_script("util/solver_util.lua")
+ug_load_script("util/solver_tuning_util.lua")
 ug_load_script("util/domain_disc_util.lua")
 ug_load_script("util/domain_util.lua")
 ug_load_script("util/math_util.lua")
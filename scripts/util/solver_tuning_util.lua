@@ -0,0 +1,391 @@
+-- Copyright (c) 2017:  G-CSC, Goethe University Frankfurt
+-- 
+-- This file is part of UG4.
+-- 
+-- UG4 is free software: you can redistribute it and/or modify it under the
+-- terms of the GNU Lesser General Public License version 3 (as published by the
+-- Free Software Foundation) with the following additional attribution
+-- requirements (according to LGPL/GPL v3 §7):
+-- 
+-- (1) The following notice must be displayed in the Appropriate Legal Notices
+-- of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+-- 
+-- (2) The following notice must be displayed at a prominent place in the
+-- terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+-- 
+-- (3) The following bibliography is recommended for citation and must be
+-- preserved in all covered files:
+-- "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+--   parallel geometric multigrid solver on hierarchically distributed grids.
+--   Computing and visualization in science 16, 4 (2013), 151-164"
+-- "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+--   flexible software system for simulating pde based models on high performance
+--   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+-- 
+-- This program is distributed in the hope that it will be useful,
+-- but WITHOUT ANY WARRANTY; without even the implied warranty of
+-- MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+-- GNU Lesser General Public License for more details.
+
+
+--[[!
+\defgroup solver_tuning_util Solver Tuning Util
+\ingroup solver_util
+\brief Benchmarks solver descriptors on the actual problem and picks the fastest
+
+Given an assembled operator, a start vector and a right hand side, a call to
+\code
+	local solver, solverDesc = util.solver.TuneLinearSolver(A, u, b, candidates, tuneDesc)
+\endcode
+performs a short trial solve for each candidate descriptor (see util.solver
+for the descriptor format) and returns the fastest one as a ready-to-use
+solver together with its descriptor. If 'candidates' is nil, the list is
+generated by util.solver.CreateTuningCandidates.
+
+Each trial uses a standard convergence check with the tuning reduction and a
+time limit. The costs of a candidate are its setup time (solver:init) plus the
+time needed to reach the requested reduction. If a trial is stopped early,
+the latter is extrapolated from the observed average convergence rate.
+Candidates whose solve time exceeds the costs of the best candidate found so
+far are stopped at once, so that bad combinations only cost little time.
+
+If 'cacheFile' is specified, the winner is stored in this file under the
+signature of the problem (see util.solver.ProblemSignature) and subsequent
+runs of the same problem create the stored solver without any trials.
+
+The tuning parameters and their defaults are
+\code
+{
+	reduction	= 1e-6,		-- defect reduction the costs are measured for
+	absolute	= 1e-50,	-- absolute defect to be reached in the trials
+	maxSteps	= 100,		-- maximum number of steps of a trial
+	timeLimit	= 10,		-- maximum wall clock time of a trial solve (seconds)
+	convCheck	= "standard",	-- convergence check of the returned solver
+	approxSpace	= nil,		-- required for gmg candidates and part of the signature
+	key			= nil,		-- user defined part of the problem signature
+	cacheFile	= nil,		-- file in which the results are cached
+	retune		= false,	-- if true, cached results are ignored and overwritten
+	verbose		= true
+}
+\endcode
+
+The candidate generation parameters and their defaults are
+\code
+{
+	solvers			= {"cg", "bicgstab", "gmres"},
+	preconds		= {"ilu", "gs", "jac", "gmg"},
+	damping			= {0.66},		-- damping factors of "jac"
+	smoothers		= {"ilu", "gs", "jac"},	-- smoothers of "gmg"
+	smoothingSteps	= {1, 3},		-- number of pre- and postsmoothing steps of "gmg"
+	cycles			= {"V", "W"},	-- cycle types of "gmg"
+	approxSpace		= nil			-- gmg candidates are only created if available
+}
+\endcode
+\{
+]]--
+
+ug_load_script("util/persistence.lua")
+
+util = util or {}
+util.solver = util.solver or {}
+util.solver.defaults = util.solver.defaults or {}
+
+util.solver.defaults.tuning =
+{
+	reduction	= 1e-6,
+	absolute	= 1e-50,
+	maxSteps	= 100,
+	timeLimit	= 10,
+	convCheck	= "standard",
+	approxSpace	= nil,
+	key			= nil,
+	cacheFile	= nil,
+	retune		= false,
+	verbose		= true
+}
+
+util.solver.defaults.tuningCandidates =
+{
+	solvers			= {"cg", "bicgstab", "gmres"},
+	preconds		= {"ilu", "gs", "jac", "gmg"},
+	damping			= {0.66},
+	smoothers		= {"ilu", "gs", "jac"},
+	smoothingSteps	= {1, 3},
+	cycles			= {"V", "W"},
+	approxSpace		= nil
+}
+
+-- returns a copy of the given descriptor which only contains plain data,
+-- i.e., created instances and objects like the approximation space are removed.
+local function PlainDesc(desc)
+	if type(desc) ~= "table" then return desc end
+	local plain = {}
+	for k, v in pairs(desc) do
+		if k ~= "instance" and k ~= "solverutil" and k ~= "approxSpace"
+			and type(v) ~= "userdata" then
+			plain[k] = PlainDesc(v)
+		end
+	end
+	return plain
+end
+
+-- returns a short, human readable string for a descriptor
+local function DescToString(desc)
+	if type(desc) ~= "table" then return tostring(desc) end
+	local name = desc.type or desc.name or ""
+	local keys = {}
+	for k, v in pairs(desc) do
+		if k ~= "type" and k ~= "name" and k ~= "instance" and k ~= "solverutil"
+			and k ~= "approxSpace" and type(v) ~= "userdata" then
+			table.insert(keys, k)
+		end
+	end
+	if #keys == 0 then return name end
+	table.sort(keys)
+	local args = {}
+	for _, k in ipairs(keys) do
+		table.insert(args, k .. "=" .. DescToString(desc[k]))
+	end
+	return name .. "(" .. table.concat(args, ", ") .. ")"
+end
+
+--! Creates a list of linear solver descriptors, combining all given solvers,
+--! preconditioners and, for geometric multigrid, smoothers, numbers of
+--! smoothing steps and cycle types.
+--! @param candDesc	(optional) table whose entries replace the ones of
+--!					util.solver.defaults.tuningCandidates
+--! @return			list of linear solver descriptors
+function util.solver.CreateTuningCandidates(candDesc)
+	candDesc = candDesc or {}
+	local defaults = util.solver.defaults.tuningCandidates
+	local approxSpace = candDesc.approxSpace or defaults.approxSpace
+						or util.solver.defaults.approxSpace
+
+	-- expands the damping variants of jacobi, all other iterators are used as they are
+	local function IteratorVariants(name)
+		if name == "jac" then
+			local variants = {}
+			for _, damp in ipairs(candDesc.damping or defaults.damping) do
+				table.insert(variants, {type = "jac", damping = damp})
+			end
+			return variants
+		end
+		return {{type = name}}
+	end
+
+	local preconds = {}
+	for _, name in ipairs(candDesc.preconds or defaults.preconds) do
+		if name == "gmg" then
+			if approxSpace ~= nil then
+				for _, smootherName in ipairs(candDesc.smoothers or defaults.smoothers) do
+				for _, smoother in ipairs(IteratorVariants(smootherName)) do
+				for _, nu in ipairs(candDesc.smoothingSteps or defaults.smoothingSteps) do
+				for _, cycle in ipairs(candDesc.cycles or defaults.cycles) do
+					table.insert(preconds, {
+						type		= "gmg",
+						approxSpace	= approxSpace,
+						smoother	= smoother,
+						preSmooth	= nu,
+						postSmooth	= nu,
+						cycle		= cycle
+					})
+				end end end end
+			else
+				print("util.solver: no approximation space given, skipping 'gmg' candidates.")
+			end
+		else
+			table.append(preconds, IteratorVariants(name))
+		end
+	end
+
+	local candidates = {}
+	for _, solverName in ipairs(candDesc.solvers or defaults.solvers) do
+		for _, precond in ipairs(preconds) do
+			table.insert(candidates, {type = solverName, precond = table.deepcopy(precond)})
+		end
+	end
+	return candidates
+end
+
+--! Returns a string identifying a problem: the global size and number of
+--! entries of the matrix, the number of processes and, if an approximation
+--! space is given, its number of levels and functions.
+--! @param A			the matrix operator (e.g. AssembledLinearOperator)
+--! @param approxSpace	(optional) the approximation space of the problem
+--! @param key			(optional) user defined prefix, e.g. the problem name
+function util.solver.ProblemSignature(A, approxSpace, key)
+	local sig = "n=" .. string.format("%d", ParallelSum(A:num_rows()))
+			 .. ",nnz=" .. string.format("%d", ParallelSum(A:total_num_connections()))
+			 .. ",procs=" .. NumProcs()
+	if approxSpace ~= nil then
+		sig = sig .. ",levels=" .. approxSpace:num_levels()
+				  .. ",fcts=" .. approxSpace:num_fct()
+	end
+	if key ~= nil then sig = key .. ":" .. sig end
+	return sig
+end
+
+--! Loads the results stored by util.solver.TuneLinearSolver. Returns an
+--! empty table if the file does not exist.
+function util.solver.LoadTuningCache(cacheFile)
+	if cacheFile == nil or not FileExists(cacheFile) then return {} end
+	return persistence.load(cacheFile) or {}
+end
+
+--! Stores the given tuning results (only on the output process).
+function util.solver.StoreTuningCache(cacheFile, cache)
+	if cacheFile == nil or ProcRank() ~= 0 then return end
+	persistence.store(cacheFile, cache)
+end
+
+-- performs one time boxed trial solve and returns its results
+local function RunTuningTrial(A, u, b, candidate, approxSpace, tuneDesc, bestCosts)
+	local res = {desc = candidate, costs = math.huge, setup = 0, solve = 0,
+				 steps = 0, reduction = 1, success = false}
+
+	local solver = util.solver.CreateLinearSolver(table.deepcopy(candidate),
+												  {approxSpace = approxSpace})
+	local convCheck = ConvCheck()
+	convCheck:set_maximum_steps(tuneDesc.maxSteps)
+	convCheck:set_minimum_defect(tuneDesc.absolute)
+	convCheck:set_reduction(tuneDesc.reduction)
+	convCheck:set_verbose(false)
+	solver:set_convergence_check(convCheck)
+
+	local x = u:clone()
+
+	-- setup
+	local tStart = GetClockS()
+	local ok = pcall(function() solver:init(A, x) end)
+	res.setup = ParallelMax(GetClockS() - tStart)
+	if not ok then
+		res.error = "setup failed"
+		return res
+	end
+
+	-- no chance to beat the best candidate found so far
+	local timeLimit = math.min(tuneDesc.timeLimit, bestCosts - res.setup)
+	if timeLimit <= 0 then
+		res.error = "setup slower than best candidate"
+		return res
+	end
+	convCheck:set_time_limit(timeLimit)
+
+	-- solve
+	tStart = GetClockS()
+	ok = pcall(function() solver:apply(x, b) end)
+	res.solve = ParallelMax(GetClockS() - tStart)
+	if not ok then
+		res.error = "solve failed"
+		return res
+	end
+
+	res.steps = convCheck:step()
+	res.reduction = convCheck:reduction()
+	if res.reduction ~= res.reduction or res.steps == 0 then
+		res.error = "no valid defect reduction"
+		return res
+	end
+
+	if res.reduction <= tuneDesc.reduction or convCheck:defect() < tuneDesc.absolute then
+		res.success = true
+		res.costs = res.setup + res.solve
+	elseif res.reduction < 1 then
+	--	extrapolate the time to reach the reduction from the average rate
+		local rate = res.reduction ^ (1 / res.steps)
+		local stepsNeeded = math.log(tuneDesc.reduction) / math.log(rate)
+		res.costs = res.setup + res.solve * stepsNeeded / res.steps
+	else
+		res.error = "no convergence"
+	end
+	return res
+end
+
+--! Benchmarks the given candidate solvers on the linear system A*u = b and
+--! returns the fastest one.
+--! @param A			the matrix operator (e.g. AssembledLinearOperator)
+--! @param u			start vector of the trials (remains unchanged)
+--! @param b			right hand side
+--! @param candidates	(optional) list of linear solver descriptors. Defaults
+--!						to util.solver.CreateTuningCandidates(tuneDesc).
+--! @param tuneDesc		(optional) tuning parameters, see util.solver.defaults.tuning
+--! @return solver, solverDesc, results
+--!						the created solver (not initialized) with the convergence
+--!						check tuneDesc.convCheck, its descriptor and the list of
+--!						trial results (empty, if the solver has been taken from
+--!						the cache)
+function util.solver.TuneLinearSolver(A, u, b, candidates, tuneDesc)
+	tuneDesc = tuneDesc or {}
+	local defaults = util.solver.defaults.tuning
+	for k, v in pairs(defaults) do
+		if tuneDesc[k] == nil then tuneDesc[k] = v end
+	end
+
+	local approxSpace = tuneDesc.approxSpace or util.solver.defaults.approxSpace
+
+	-- creates the final solver for the given plain descriptor
+	local function CreateTunedSolver(plainDesc)
+		local desc = table.deepcopy(plainDesc)
+		desc.convCheck = table.deepcopy(tuneDesc.convCheck)
+		return util.solver.CreateLinearSolver(desc, {approxSpace = approxSpace}), desc
+	end
+
+	local signature = util.solver.ProblemSignature(A, approxSpace, tuneDesc.key)
+	local cache = util.solver.LoadTuningCache(tuneDesc.cacheFile)
+	local cached = cache[signature]
+	if cached ~= nil and tuneDesc.retune ~= true then
+		if tuneDesc.verbose then
+			print("util.solver: using cached solver for '" .. signature .. "': "
+					.. DescToString(cached.solver))
+		end
+		local solver, desc = CreateTunedSolver(cached.solver)
+		return solver, desc, {}
+	end
+
+	candidates = candidates or util.solver.CreateTuningCandidates(
+									{approxSpace = approxSpace})
+	util.solver.CondAbort(#candidates == 0, "No candidates given for tuning.")
+
+	if tuneDesc.verbose then
+		print("util.solver: tuning " .. #candidates .. " candidates for '" .. signature .. "'")
+		print(string.format("  %9s %9s %6s %10s %10s   %s",
+							"setup[s]", "solve[s]", "steps", "reduction", "costs[s]", "solver"))
+	end
+
+	local results = {}
+	local best = nil
+	for _, candidate in ipairs(candidates) do
+		local res = RunTuningTrial(A, u, b, PlainDesc(candidate), approxSpace, tuneDesc,
+								   best and best.costs or math.huge)
+		table.insert(results, res)
+		if best == nil or res.costs < best.costs then best = res end
+
+		if tuneDesc.verbose then
+			local costs = res.error or string.format("%10.4g", res.costs)
+			if res.error == nil and not res.success then costs = costs .. " (extrapolated)" end
+			print(string.format("  %9.4g %9.4g %6d %10.3e %10s   %s",
+								res.setup, res.solve, res.steps, res.reduction,
+								costs, DescToString(res.desc)))
+		end
+	end
+
+	util.solver.CondAbort(best.costs == math.huge, "None of the tuning candidates converged.")
+
+	if tuneDesc.verbose then
+		print("util.solver: fastest solver (" .. string.format("%.4g", best.costs) .. "s): "
+				.. DescToString(best.desc))
+	end
+
+	if tuneDesc.cacheFile ~= nil then
+		cache[signature] = {solver = best.desc, costs = best.costs,
+							setup = best.setup, steps = best.steps}
+		util.solver.StoreTuningCache(tuneDesc.cacheFile, cache)
+	end
+
+	local solver, desc = CreateTunedSolver(best.desc)
+	return solver, desc, results
+end
+
+--[[!
+\}
+]]--
@@ -103,7 +103,7 @@ here someApproxSpace points to a previously created approximation space
 		precond = 
 		{	
 			type 		= "gmg",	-- preconditioner ["gmg", "ilu", "ilut", "jac", "gs", "sgs"]
-			smoother 	= "gs",		-- gmg-smoother ["ilu", "ilut", "jac", "gs", "sgs"]
+			smoother 	= "gs",		-- gmg-smoother ["ilu", "ilu_sp", "ilut", "jac", "l1jac", "cheb", "gs", "sgs"]
 			cycle		= "V",		-- gmg-cycle ["V", "F", "W"]
 			preSmooth	= 3,		-- number presmoothing steps
 			postSmooth 	= 3,		-- number postsmoothing steps
@@ -237,6 +237,17 @@ to obtain the described solved.
 }
 \endcode
 
+<h3>GMRES</h3>
+\code
+{
+	type				= "gmres",
+	restart				= 30,
+	orthogonalization	= "mgs",	-- or "cgs2"
+	precond				= "ilu",
+	convCheck			= "standard"
+}
+\endcode
+
 
 <br>
 <h2>Preconditioners</h2>
@@ -278,6 +289,20 @@ parameters.
 }
 \endcode
 
+<br>
+<h3>Single precision ILU</h3>
+ILU whose factors are computed and applied in single precision, while the
+surrounding iteration stays in double precision (scalar CPU1 algebra only).
+\code
+{
+	type 			= "ilu_sp",
+	beta 			= 0,
+	damping 		= 1,
+	sortEps 		= 1.e-50,
+	inversionEps 	= 1.e-8
+}
+\endcode
+
 <br>
 <h3>ILUT</h3>
 \code
@@ -297,6 +322,26 @@ parameters.
 \endcode
 
 
+<br>
+<h3>l1-Jacobi</h3>
+\code
+{
+	type 	= "l1jac",
+	damping = 1.0
+}
+\endcode
+
+<br>
+<h3>Chebyshev</h3>
+\code
+{
+	type 	= "cheb",
+	degree 	= 3,
+	l1 		= false,
+	maxEV 	= nil	-- estimated, if not specified
+}
+\endcode
+
 <br>
 <h3>Gauss Seidel</h3>
 \code
@@ -451,6 +496,13 @@ util.solver.defaults =
 			precond		= "ilu",
 			convCheck	= "standard"
 		},
+
+		gmres = {
+			restart				= 30,
+			orthogonalization	= "mgs",
+			precond				= "ilu",
+			convCheck			= "standard"
+		},
 		
 		lu = {
 			info = false,
@@ -494,6 +546,14 @@ util.solver.defaults =
 			overlap 		= false
 		},
 
+		ilu_sp = {
+			beta 			= 0,
+			damping 		= 1,
+			sortEps 		= 1.e-50,
+			inversionEps 	= 1.e-8,
+			consistentInterfaces = false
+		},
+
 		ilut = {
 			threshold = 1e-6
 		},
@@ -512,6 +572,15 @@ util.solver.defaults =
 			damping = 0.66
 		},
 
+		l1jac = {
+			damping = 1.0
+		},
+
+		cheb = {
+			degree 	= 3,
+			l1 		= false
+		},
+
 		schur = {
 			dirichletSolver	= "lu",
 			skeletonSolver	= "lu"
@@ -664,6 +733,12 @@ function util.solver.CreateLinearSolver(solverDesc, solverutil)
 		createPrecond = true
 		createConvCheck = true
 
+	elseif name == "gmres" then
+		linSolver = GMRES(desc.restart or defaults.restart)
+		linSolver:set_orthogonalization(desc.orthogonalization or defaults.orthogonalization)
+		createPrecond = true
+		createConvCheck = true
+
 	elseif name == "lu"	then
 		if HasClassGroup("SuperLU") then
 			linSolver = AgglomeratingSolver(SuperLU());
@@ -767,8 +842,20 @@ function util.solver.CreatePreconditioner(precondDesc, solverutil)
 		precond:set_inversion_eps(desc.inversionEps or defaults.inversionEps)
 		precond:enable_consistent_interfaces(desc.consistentInterfaces or defaults.consistentInterfaces)
 		precond:enable_overlap(desc.overlap or defaults.overlap)
+	elseif name == "ilu_sp" then
+		precond = MixedPrecisionILU ()
+		precond:set_beta (desc.beta or defaults.beta)
+		precond:set_damp(desc.damping or defaults.damping)
+		precond:set_sort_eps(desc.sortEps or defaults.sortEps)
+		precond:set_inversion_eps(desc.inversionEps or defaults.inversionEps)
+		precond:enable_consistent_interfaces(desc.consistentInterfaces or defaults.consistentInterfaces)
 	elseif name == "ilut" then precond = ILUT (desc.threshold or defaults.threshold);
 	elseif name == "jac"  then precond = Jacobi (desc.damping or defaults.damping);
+	elseif name == "l1jac" then precond = L1Jacobi (desc.damping or defaults.damping);
+	elseif name == "cheb" then
+		precond = Chebyshev (desc.degree or defaults.degree)
+		precond:set_l1_scaling(desc.l1 or defaults.l1)
+		if desc.maxEV then precond:set_max_eigenvalue(desc.maxEV) end
 	elseif name == "bgs"  then precond = BlockGaussSeidel ();
 	elseif name == "gs"   then
 		precond = GaussSeidel ()
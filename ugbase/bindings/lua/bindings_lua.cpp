@@ -394,6 +394,161 @@ void PrintLUACallStack()
 	}
 }
 
+////////////////////////////////////////////////////////////////////////////////
+//	Overload dispatch cache
+////////////////////////////////////////////////////////////////////////////////
+/*	Each proxy closure owns a small cache (allocated on the first call as a
+ *	userdata in its second upvalue), which maps the tuple of lua argument
+ *	types of a call to the overload that matched for that tuple. On a hit the
+ *	overload probing is skipped and the class hierarchy checks for userdata
+ *	arguments are omitted, since the key contains the class name node and the
+ *	wrapper type of each userdata argument.
+ *	Calls with table arguments or numeric strings are not cached, since the
+ *	matching overload may then depend on the values and not only on the types.
+ *	All caches are invalidated whenever the bindings are (re-)created.*/
+
+///	increased each time the bindings are (re-)created. Invalidates all caches.
+static unsigned int g_dispatchGeneration = 0;
+
+struct DispatchKey
+{
+	struct Arg{
+		int luaType;
+		int udType;
+		const ClassNameNode* classNameNode;
+	};
+
+	int numArgs;
+	Arg args[UG_REGISTRY_MAX_NUM_ARGS + 1];
+
+	bool operator==(const DispatchKey& key) const
+	{
+		if(numArgs != key.numArgs) return false;
+		for(int i = 0; i < numArgs; ++i){
+			if((args[i].luaType != key.args[i].luaType)
+				|| (args[i].udType != key.args[i].udType)
+				|| (args[i].classNameNode != key.args[i].classNameNode))
+				return false;
+		}
+		return true;
+	}
+};
+
+struct DispatchCacheEntry
+{
+	DispatchKey				key;
+	const void*				overload;		///< ExportedFunction or ExportedMethod
+	const ClassNameNode*	classNameNode;	///< class in which the method was found
+};
+
+///	a POD, since it lives in a lua userdata without finalizer
+struct DispatchCache
+{
+	static const int NUM_ENTRIES = 4;
+
+	unsigned int		generation;
+	int					numEntries;
+	int					nextSlot;
+	DispatchCacheEntry	entries[NUM_ENTRIES];
+
+	void clear()
+	{
+		generation = g_dispatchGeneration;
+		numEntries = 0;
+		nextSlot = 0;
+	}
+
+	const DispatchCacheEntry* find(const DispatchKey& key) const
+	{
+		for(int i = 0; i < numEntries; ++i)
+			if(entries[i].key == key)
+				return &entries[i];
+		return NULL;
+	}
+
+	void insert(const DispatchKey& key, const void* overload,
+				const ClassNameNode* classNameNode)
+	{
+		DispatchCacheEntry& e = entries[nextSlot];
+		e.key = key;
+		e.overload = overload;
+		e.classNameNode = classNameNode;
+		nextSlot = (nextSlot + 1) % NUM_ENTRIES;
+		if(numEntries < NUM_ENTRIES) ++numEntries;
+	}
+};
+
+///	returns the cache stored in the second upvalue of the running closure
+static DispatchCache* GetDispatchCache(lua_State* L)
+{
+	DispatchCache* cache = (DispatchCache*)lua_touserdata(L, lua_upvalueindex(2));
+	if(!cache){
+		cache = (DispatchCache*)lua_newuserdata(L, sizeof(DispatchCache));
+		cache->clear();
+		lua_replace(L, lua_upvalueindex(2));
+	}
+	else if(cache->generation != g_dispatchGeneration)
+		cache->clear();
+	return cache;
+}
+
+///	fills the key with the types of all entries of the lua stack
+/**	\returns false if the call can not be cached.*/
+static bool MakeDispatchKey(DispatchKey& keyOut, lua_State* L)
+{
+	int numArgs = lua_gettop(L);
+	if(numArgs > UG_REGISTRY_MAX_NUM_ARGS + 1)
+		return false;
+
+	keyOut.numArgs = numArgs;
+	for(int i = 0; i < numArgs; ++i){
+		DispatchKey::Arg& arg = keyOut.args[i];
+		arg.luaType = lua_type(L, i + 1);
+		arg.udType = 0;
+		arg.classNameNode = NULL;
+
+		switch(arg.luaType){
+			case LUA_TTABLE:
+			case LUA_TLIGHTUSERDATA:
+				return false;
+
+		//	numeric strings are accepted by number and string parameters,
+		//	so that the matching overload depends on the value
+			case LUA_TSTRING:
+				if(lua_isnumber(L, i + 1))
+					return false;
+				break;
+
+			case LUA_TUSERDATA:{
+				arg.udType = ((UserDataWrapper*)lua_touserdata(L, i + 1))->type;
+				if(lua_getmetatable(L, i + 1) == 0)
+					return false;
+				lua_pushstring(L, "class_name_node");
+				lua_rawget(L, -2);
+				arg.classNameNode = (const ClassNameNode*) lua_touserdata(L, -1);
+				lua_pop(L, 2);
+			}break;
+
+			default: break;
+		}
+	}
+	return true;
+}
+
+///	executes the given function and pushes its results to the lua stack
+static int CallFunction(lua_State* L, const ExportedFunction* func,
+						ParameterStack& paramsIn)
+{
+	ParameterStack paramsOut;
+
+	try{
+		func->execute(paramsIn, paramsOut);
+	}
+	UG_LUA_BINDINGS_CATCH("In CALL to function '" << FunctionInfo(*func) << "'", ParameterStackString(paramsIn));
+
+	return ParamsToLuaStack(paramsOut, L);
+}
+
 /**
  * LuaProxyFunction handling calls to global functions.
  * Note that not the best matching, but the first matching overload is chosen!
@@ -404,13 +559,27 @@ static int LuaProxyFunction(lua_State* L)
 {
 	const ExportedFunctionGroup* funcGrp = (const ExportedFunctionGroup*)
 											lua_touserdata(L, lua_upvalueindex(1));
+
+//	if the argument types were seen before, call the cached overload directly
+	DispatchCache* cache = GetDispatchCache(L);
+	DispatchKey key;
+	const bool bCacheable = MakeDispatchKey(key, L);
+	if(bCacheable){
+		const DispatchCacheEntry* entry = cache->find(key);
+		if(entry){
+			const ExportedFunction* func = (const ExportedFunction*)entry->overload;
+			ParameterStack paramsIn;
+			if(LuaStackToParams(paramsIn, func->params_in(), L, 0, false) == 0)
+				return CallFunction(L, func, paramsIn);
+		}
+	}
+
 //	we have to try each overload!
 	int badParam = -2;
 	for(size_t i = 0; i < funcGrp->num_overloads(); ++i){
 		const ExportedFunction* func = funcGrp->get_overload(i);
 
 		ParameterStack paramsIn;
-		ParameterStack paramsOut;
 
 		badParam = LuaStackToParams(paramsIn, func->params_in(), L, 0);
 
@@ -420,13 +589,10 @@ static int LuaProxyFunction(lua_State* L)
 			continue;
 		}
 
-		try{
-			func->execute(paramsIn, paramsOut);
-		}
-		UG_LUA_BINDINGS_CATCH("In CALL to function '" << FunctionInfo(*func) << "'", ParameterStackString(paramsIn));
+		if(bCacheable)
+			cache->insert(key, func, NULL);
 
-	//	if we reach this point, then the method was successfully executed.
-		return ParamsToLuaStack(paramsOut, L);
+		return CallFunction(L, func, paramsIn);
 	}
 
 	if(badParam != 0)
@@ -578,6 +744,53 @@ static int LuaProxyGroupConstructor(lua_State* L)
 	return LuaConstructor(L, c, group->name().c_str());
 }
 
+///	executes the given method on self and pushes its results to the lua stack
+static int CallMethod(lua_State* L, const ExportedMethod* m,
+					  UserDataWrapper* self, const ClassNameNode* classNameNode,
+					  ParameterStack& paramsIn)
+{
+	ParameterStack paramsOut;
+
+	try
+	{
+	//	raw pointer
+		if(self->is_raw_ptr())
+		{
+		//	cast to the needed base class
+			void* objPtr = ClassCastProvider::cast_to_base_class(
+										((RawUserDataWrapper*)self)->obj,
+										classNameNode, m->class_name().c_str());
+
+			m->execute(objPtr, paramsIn, paramsOut);
+		}
+	//	smart pointer
+		else if(self->is_smart_ptr())
+		{
+			if(self->is_const())
+			{
+			//	cast to the needed base class
+				void* objPtr = ClassCastProvider::cast_to_base_class(
+											(void*)((ConstSmartUserDataWrapper*)self)->smartPtr.get(),
+											classNameNode, m->class_name().c_str());
+
+				m->execute(objPtr, paramsIn, paramsOut);
+			}
+			else
+			{
+			//	cast to the needed base class
+				void* objPtr = ClassCastProvider::cast_to_base_class(
+											((SmartUserDataWrapper*)self)->smartPtr.get(),
+											classNameNode, m->class_name().c_str());
+
+				m->execute(objPtr, paramsIn, paramsOut);
+			}
+		}
+	}
+	UG_LUA_BINDINGS_CATCH("In CALL to method '" << LuaClassMethodInfo(L, 1, *m)  << "'", ParameterStackString(paramsIn));
+
+	return ParamsToLuaStack(paramsOut, L);
+}
+
 /**
  * This method is not called by lua, but a helper to LuaProxyMethod.
  * It recursively calls itself until a matching overload was found.
@@ -586,24 +799,21 @@ static int LuaProxyGroupConstructor(lua_State* L)
  * @param self
  * @param classNameNode
  * @param errorOutput
+ * @param key		key of the current call or NULL if the call is not cached
+ * @param cache		cache in which a matching overload is stored (if key != NULL)
  * @return The number of items pushed to the stack
  */
 static int ExecuteMethod(lua_State* L, const ExportedMethodGroup* methodGrp,
 						UserDataWrapper* self, const ClassNameNode* classNameNode,
-						bool errorOutput)
+						bool errorOutput, const DispatchKey* key = NULL,
+						DispatchCache* cache = NULL)
 {
-	ParameterStack paramsIn;;
-	ParameterStack paramsOut;
-
-	//int badParam = LuaStackToParams(paramsIn, m->params_in(), L, 1);
-
 //	we have to try each overload!
 	int badParam = -2;
 	for(size_t i = 0; i < methodGrp->num_overloads(); ++i){
 		const ExportedMethod* m = methodGrp->get_overload(i);
 
 		ParameterStack paramsIn;
-		ParameterStack paramsOut;
 
 		badParam = LuaStackToParams(paramsIn, m->params_in(), L, 1);
 
@@ -613,45 +823,10 @@ static int ExecuteMethod(lua_State* L, const ExportedMethodGroup* methodGrp,
 			continue;
 		}
 
-		try
-		{
-		//	raw pointer
-			if(self->is_raw_ptr())
-			{
-			//	cast to the needed base class
-				void* objPtr = ClassCastProvider::cast_to_base_class(
-											((RawUserDataWrapper*)self)->obj,
-											classNameNode, m->class_name().c_str());
+		if(key)
+			cache->insert(*key, m, classNameNode);
 
-				m->execute(objPtr, paramsIn, paramsOut);
-			}
-		//	smart pointer
-			else if(self->is_smart_ptr())
-			{
-				if(self->is_const())
-				{
-				//	cast to the needed base class
-					void* objPtr = ClassCastProvider::cast_to_base_class(
-												(void*)((ConstSmartUserDataWrapper*)self)->smartPtr.get(),
-												classNameNode, m->class_name().c_str());
-
-					m->execute(objPtr, paramsIn, paramsOut);
-				}
-				else
-				{
-				//	cast to the needed base class
-					void* objPtr = ClassCastProvider::cast_to_base_class(
-												((SmartUserDataWrapper*)self)->smartPtr.get(),
-												classNameNode, m->class_name().c_str());
-
-					m->execute(objPtr, paramsIn, paramsOut);
-				}
-			}
-		}
-		UG_LUA_BINDINGS_CATCH("In CALL to method '" << LuaClassMethodInfo(L, 1, *m)  << "'", ParameterStackString(paramsIn));
-
-	//	if we reach this point, then the method was successfully executed.
-		return ParamsToLuaStack(paramsOut, L);
+		return CallMethod(L, m, self, classNameNode, paramsIn);
 	}
 
 //	check whether the parameters were correct
@@ -736,7 +911,8 @@ static int ExecuteMethod(lua_State* L, const ExportedMethodGroup* methodGrp,
 			//	is recursive.
 				if(newMethodGrp){
 					int retVal = ExecuteMethod(L, newMethodGrp, self,
-												curClassName, errorOutput);
+												curClassName, errorOutput,
+												key, cache);
 					if(retVal >= 0)
 						return retVal;
 				}
@@ -821,7 +997,22 @@ static int LuaProxyMethod(lua_State* L)
 		= (const ClassNameNode*) lua_touserdata(L, -1);
 	lua_pop(L, 2);
 
-	int retVal = ExecuteMethod(L, methodGrp, self, classNameNode, false);
+//	if the argument types were seen before, call the cached overload directly
+	DispatchCache* cache = GetDispatchCache(L);
+	DispatchKey key;
+	const bool bCacheable = MakeDispatchKey(key, L);
+	if(bCacheable){
+		const DispatchCacheEntry* entry = cache->find(key);
+		if(entry){
+			const ExportedMethod* m = (const ExportedMethod*)entry->overload;
+			ParameterStack paramsIn;
+			if(LuaStackToParams(paramsIn, m->params_in(), L, 1, false) == 0)
+				return CallMethod(L, m, self, entry->classNameNode, paramsIn);
+		}
+	}
+
+	int retVal = ExecuteMethod(L, methodGrp, self, classNameNode, false,
+							   bCacheable ? &key : NULL, cache);
 	if(retVal >= 0)
 		return retVal;
 
@@ -1051,6 +1242,9 @@ static int LuaProxyDelete(lua_State* L)
  */
 bool CreateBindings_LUA(lua_State* L, Registry& reg)
 {
+//	registered overloads may have changed. Invalidate all dispatch caches.
+	++g_dispatchGeneration;
+
 //	iterate through all registered objects
 	
 /*
@@ -1093,7 +1287,8 @@ bool CreateBindings_LUA(lua_State* L, Registry& reg)
 		
 	//	the function is new. Register it.
 		lua_pushlightuserdata(L, funcGrp);
-		lua_pushcclosure(L, LuaProxyFunction, 1);
+		lua_pushnil(L);
+		lua_pushcclosure(L, LuaProxyFunction, 2);
 		lua_setglobal(L, funcGrp->name().c_str());
 	}
 
@@ -1148,7 +1343,8 @@ bool CreateBindings_LUA(lua_State* L, Registry& reg)
 			const ExportedMethodGroup& m = c->get_method_group(j);
 			lua_pushstring(L, m.name().c_str());
 			lua_pushlightuserdata(L, (void*)&m);
-			lua_pushcclosure(L, LuaProxyMethod, 1);
+			lua_pushnil(L);
+			lua_pushcclosure(L, LuaProxyMethod, 2);
 			lua_settable(L, -3);
 			if(m.name().compare("__tostring") == 0) bToStringFound = true;
 		}
@@ -1170,7 +1366,8 @@ bool CreateBindings_LUA(lua_State* L, Registry& reg)
 				{
 					lua_pushstring(L, m.name().c_str());
 					lua_pushlightuserdata(L, (void*)&m);
-					lua_pushcclosure(L, LuaProxyMethod, 1);
+					lua_pushnil(L);
+					lua_pushcclosure(L, LuaProxyMethod, 2);
 					lua_settable(L, -3);
 					bToStringFound = true;
 					break;
@@ -1188,7 +1385,8 @@ bool CreateBindings_LUA(lua_State* L, Registry& reg)
 				const ExportedMethodGroup& m = c->get_const_method_group(j);
 				lua_pushstring(L, m.name().c_str());
 				lua_pushlightuserdata(L, (void*)&m);
-				lua_pushcclosure(L, LuaProxyMethod, 1);
+				lua_pushnil(L);
+				lua_pushcclosure(L, LuaProxyMethod, 2);
 				lua_settable(L, -3);
 			}
 			lua_setfield(L, -2, "__const");
@@ -168,6 +168,9 @@ struct LuaParsing<LuaFunctionHandle>{
 };
 #endif
 
+//	NOTE: The checkAndGet methods of the pointer types skip the check whether
+//	the object derives from baseClassName if NULL is passed. This is used by
+//	the overload dispatch cache, which has verified the class before.
 template <>
 struct LuaParsing<void*>{
 	static bool checkAndGet(std::pair<void*, const ClassNameNode*>& res,
@@ -199,7 +202,8 @@ struct LuaParsing<void*>{
 
 		if(!classNameNode) return false;
 		if(classNameNode->empty()) return false;
-		if(!ClassNameTreeContains(*classNameNode, baseClassName)) return false;
+		if(baseClassName && !ClassNameTreeContains(*classNameNode, baseClassName))
+			return false;
 
 		res.first = obj;
 		res.second = classNameNode;
@@ -247,7 +251,8 @@ struct LuaParsing<const void*>{
 
 		if(!classNameNode) return false;
 		if(classNameNode->empty()) return false;
-		if(!ClassNameTreeContains(*classNameNode, baseClassName)) return false;
+		if(baseClassName && !ClassNameTreeContains(*classNameNode, baseClassName))
+			return false;
 
 		res.first = obj;
 		res.second = classNameNode;
@@ -284,7 +289,8 @@ struct LuaParsing<SmartPtr<void> >{
 
 		if(!classNameNode) return false;
 		if(classNameNode->empty()) return false;
-		if(!ClassNameTreeContains(*classNameNode, baseClassName)) return false;
+		if(baseClassName && !ClassNameTreeContains(*classNameNode, baseClassName))
+			return false;
 
 		res.first = obj;
 		res.second = classNameNode;
@@ -322,7 +328,8 @@ struct LuaParsing<ConstSmartPtr<void> >{
 
 		if(!classNameNode) return false;
 		if(classNameNode->empty()) return false;
-		if(!ClassNameTreeContains(*classNameNode, baseClassName)) return false;
+		if(baseClassName && !ClassNameTreeContains(*classNameNode, baseClassName))
+			return false;
 
 		res.first = obj;
 		res.second = classNameNode;
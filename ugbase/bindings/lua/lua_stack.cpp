@@ -46,10 +46,18 @@ namespace ug
 namespace bridge {
 
 
+///	class name to check pointer arguments against (NULL skips the check)
+static inline const char* BaseClassName(const ParameterInfo& psInfo, int i,
+                                        bool bCheckClassNames)
+{
+	return bCheckClassNames ? psInfo.class_name(i) : NULL;
+}
+
 int LuaStackToParams(ParameterStack& ps,
 							const ParameterInfo& psInfo,
 							lua_State* L,
-							int offsetToFirstParam)
+							int offsetToFirstParam,
+							bool bCheckClassNames)
 {
 //	make sure that we have the right amount of parameters
 //	if the sizes do not match, return -1.
@@ -108,7 +116,7 @@ int LuaStackToParams(ParameterStack& ps,
 			//	allow by-value arguments. (Small temporary objects profit from
 			//	this strategy).
 				if(!PushLuaStackPointerEntryToParamStack<void*>
-					(ps, L, index, psInfo.class_name(i), bIsVector))
+					(ps, L, index, BaseClassName(psInfo, i, bCheckClassNames), bIsVector))
 					badParam = (int)i + 1;
 			}break;
 			case Variant::VT_CONST_POINTER:{
@@ -118,17 +126,17 @@ int LuaStackToParams(ParameterStack& ps,
 			//	allow by-value arguments. (Small temporary objects profit from
 			//	this strategy).
 				if(!PushLuaStackPointerEntryToParamStack<const void*>
-					(ps, L, index, psInfo.class_name(i), bIsVector))
+					(ps, L, index, BaseClassName(psInfo, i, bCheckClassNames), bIsVector))
 					badParam = (int)i + 1;
 			}break;
 			case Variant::VT_SMART_POINTER:{
 				if(!PushLuaStackPointerEntryToParamStack<SmartPtr<void> >
-					(ps, L, index, psInfo.class_name(i), bIsVector))
+					(ps, L, index, BaseClassName(psInfo, i, bCheckClassNames), bIsVector))
 					badParam = (int)i + 1;
 			}break;
 			case Variant::VT_CONST_SMART_POINTER:{
 				if(!PushLuaStackPointerEntryToParamStack<ConstSmartPtr<void> >
-					(ps, L, index, psInfo.class_name(i), bIsVector))
+					(ps, L, index, BaseClassName(psInfo, i, bCheckClassNames), bIsVector))
 					badParam = (int)i + 1;
 			}break;
 
@@ -43,14 +43,19 @@ namespace ug
 namespace bridge {
 
 ///	copies parameter values from the lua-stack to a parameter-list.
-/**	\returns	The index of the first bad parameter starting from 1.
+/**	If bCheckClassNames is false, userdata arguments are not checked for
+ * deriving from the class expected by psInfo. Only use this if the classes
+ * of all userdata arguments have been verified for psInfo before.
+ *
+ * \returns	The index of the first bad parameter starting from 1.
  *				Returns 0 if everything went right.
  *				Returns -1 if the number of parameters did not match.
  */
 int LuaStackToParams(ParameterStack& ps,
 							const ParameterInfo& psInfo,
 							lua_State* L,
-							int offsetToFirstParam = 0);
+							int offsetToFirstParam = 0,
+							bool bCheckClassNames = true);
 
 ///	Pushes the parameter-values to the Lua-Stack.
 /**
@@ -140,6 +140,7 @@ static void Algebra(Registry& reg, string grp)
 		.add_method("set_random|hide=true", (void (vector_type::*)(number, number))&vector_type::set_random,
 								"Success", "Number")
 		.add_method("print|hide=true", &vector_type::p)
+		.add_method("clone", &vector_type::clone, "SmartPointer to a copy of this vector", "", "returns a deep copy of the vector including its values")
 #ifdef UG_PARALLEL
 		.add_method("check_storage_type", &vector_type::check_storage_type)
 		.add_method("enforce_consistent_type", &vector_type::enforce_consistent_type)
@@ -197,6 +198,9 @@ static void Algebra(Registry& reg, string grp)
 		reg.add_class_<matrix_type>(name, grp)
 			.add_constructor()
 			.add_method("print|hide=true", &matrix_type::p)
+			.add_method("num_rows", &matrix_type::num_rows, "", "", "returns the number of (local) rows")
+			.add_method("num_cols", &matrix_type::num_cols, "", "", "returns the number of (local) columns")
+			.add_method("total_num_connections", &matrix_type::total_num_connections, "", "", "returns the number of (local) stored entries")
 			.set_construct_as_smart_pointer(true);
 		reg.add_class_to_group(name, "Matrix", tag);
 	}
@@ -417,6 +421,8 @@ static void Algebra(Registry& reg, string grp)
 			.add_method("set_reduction", &T::set_reduction,	"", "Relative Reduction|default|min=0D;value=1e-12")
 			.add_method("set_verbose", &T::set_verbose,	"", "Verbosity")
 			.add_method("set_supress_unsuccessful", &T::set_supress_unsuccessful,"", "supress false return")
+			.add_method("set_time_limit", &T::set_time_limit, "", "seconds", "limits the wall clock time of the iteration (0 = unlimited)")
+			.add_method("time_limit_reached", &T::time_limit_reached, "", "", "returns whether the last iteration was ended by the time limit")
 			.add_method("previous_defect", &T::previous_defect)
 			.set_construct_as_smart_pointer(true);
 		reg.add_class_to_group(name, "ConvCheck", tag);
@@ -169,6 +169,37 @@ static void Algebra(Registry& reg, string grp)
 		reg.add_class_to_group(name, "Jacobi", tag);
 	}
 
+//	L1Jacobi
+	{
+		typedef L1Jacobi<TAlgebra> T;
+		typedef IPreconditioner<TAlgebra> TBase;
+		string name = string("L1Jacobi").append(suffix);
+		reg.add_class_<T,TBase>(name, grp, "l1-Jacobi Preconditioner")
+			.add_constructor()
+			.template add_constructor<void (*)(number)>("DampingFactor")
+			.set_construct_as_smart_pointer(true);
+		reg.add_class_to_group(name, "L1Jacobi", tag);
+	}
+
+//	Chebyshev
+	{
+		typedef Chebyshev<TAlgebra> T;
+		typedef IPreconditioner<TAlgebra> TBase;
+		string name = string("Chebyshev").append(suffix);
+		reg.add_class_<T,TBase>(name, grp, "Chebyshev polynomial smoother")
+			.add_constructor()
+			.template add_constructor<void (*)(size_t)>("Degree")
+			.add_method("set_degree", &T::set_degree, "", "degree", "degree of the polynomial (default 3)")
+			.add_method("set_eigenvalue_factors", &T::set_eigenvalue_factors, "", "lower#upper", "smoothed interval relative to the largest eigenvalue (default 0.3, 1.1)")
+			.add_method("set_num_power_iterations", &T::set_num_power_iterations, "", "n", "power iterations to estimate the largest eigenvalue (default 10)")
+			.add_method("set_max_eigenvalue", &T::set_max_eigenvalue, "", "maxEV", "largest eigenvalue of D^{-1}A. 0 enables the estimate (default)")
+			.add_method("set_l1_scaling", &T::set_l1_scaling, "", "l1", "use the l1 row sums instead of the diagonal")
+			.add_method("set_reestimate_interval", &T::set_reestimate_interval, "", "n", "re-estimate every n-th init. 0: only if the size changes (default)")
+			.add_method("max_eigenvalue", &T::max_eigenvalue, "largest eigenvalue", "", "largest eigenvalue of D^{-1}A used in the last init")
+			.set_construct_as_smart_pointer(true);
+		reg.add_class_to_group(name, "Chebyshev", tag);
+	}
+
 //	GaussSeidelBase
 	{
 		typedef GaussSeidelBase<TAlgebra> T;
@@ -327,6 +358,7 @@ static void Algebra(Registry& reg, string grp)
 		reg.add_class_<T,TBase>(name, grp, "Vanka Preconditioner")
 		.add_constructor()
 		.add_method("set_relax", &T::set_relax, "", "relax")
+		.add_method("set_multicolor", &T::set_multicolor, "", "bMulticolor", "colored block ordering, blocks of one color are processed concurrently")
 		.set_construct_as_smart_pointer(true);
 		reg.add_class_to_group(name, "Vanka", tag);
 	}
@@ -339,6 +371,7 @@ static void Algebra(Registry& reg, string grp)
 		reg.add_class_<T,TBase>(name, grp, "Diagonal Vanka Preconditioner")
 		.add_constructor()
 		.add_method("set_relax", &T::set_relax, "", "relax")
+		.add_method("set_multicolor", &T::set_multicolor, "", "bMulticolor", "colored block ordering, blocks of one color are processed concurrently")
 		.set_construct_as_smart_pointer(true);
 		reg.add_class_to_group(name, "DiagVanka", tag);
 	}
@@ -350,6 +383,7 @@ static void Algebra(Registry& reg, string grp)
 		string name = string("AgglomeratingIterator").append(suffix);
 		reg.add_class_<T,TBase>(name, grp, "AgglomeratingIterator")
 			.template add_constructor<void (*)(SmartPtr<ILinearIterator<vector_type> > )>("pLinIterator")
+			.add_method("set_group_size", &T::set_group_size, "", "groupSize", "number of processes agglomerated onto one (0 = all)")
 			.set_construct_as_smart_pointer(true);
 		reg.add_class_to_group(name, "AgglomeratingIterator", tag);
 	}
@@ -361,11 +395,46 @@ static void Algebra(Registry& reg, string grp)
 		string name = string("AgglomeratingPreconditioner").append(suffix);
 		reg.add_class_<T,TBase>(name, grp, "AgglomeratingPreconditioner")
 			.template add_constructor<void (*)(SmartPtr<ILinearIterator<vector_type> > )>("pPreconditioner")
+			.add_method("set_group_size", &T::set_group_size, "", "groupSize", "number of processes agglomerated onto one (0 = all)")
 			.set_construct_as_smart_pointer(true);
 		reg.add_class_to_group(name, "AgglomeratingPreconditioner", tag);
 	}
 
 }
+
+/**
+ * Function called for the registration of Domain and Algebra independent parts.
+ * All Functions and Classes not depending on Domain and Algebra
+ * are to be placed here when registering.
+ *
+ * @param reg				registry
+ * @param parentGroup		group for sorting of functionality
+ */
+static void Common(Registry& reg, string grp)
+{
+#ifdef UG_CPU_1
+//	MixedPrecisionILU (single precision factors are only available for scalar entries)
+	{
+		typedef CPUAlgebra TAlgebra;
+		string suffix = GetAlgebraSuffix<TAlgebra>();
+		string tag = GetAlgebraTag<TAlgebra>();
+
+		typedef MixedPrecisionILU<TAlgebra> T;
+		typedef IPreconditioner<TAlgebra> TBase;
+		string name = string("MixedPrecisionILU").append(suffix);
+		reg.add_class_<T,TBase>(name, grp, "Incomplete LU Decomposition, factorized and applied in single precision")
+			.add_constructor()
+			.add_method("set_beta", &T::set_beta, "", "beta")
+			.add_method("set_sort_eps", &T::set_sort_eps, "", "eps")
+			.add_method("set_inversion_eps", &T::set_inversion_eps, "", "eps")
+			.add_method("set_disable_preprocessing", &T::set_disable_preprocessing, "", "disable",
+						"set whether preprocessing (notably, LU factorization) is to be disabled - usable when the operator has not changed; use with care")
+			.add_method("enable_consistent_interfaces", &T::enable_consistent_interfaces, "", "enable", "Make Matrix consistent for connections in interfaces.")
+			.set_construct_as_smart_pointer(true);
+		reg.add_class_to_group(name, "MixedPrecisionILU", tag);
+	}
+#endif
+}
 	
 
 }; // end Functionality
@@ -382,6 +451,7 @@ void RegisterBridge_Preconditioner(Registry& reg, string grp)
 	typedef Preconditioner::Functionality Functionality;
 
 	try{
+		RegisterCommon<Functionality>(reg,grp);
 		RegisterAlgebraDependent<Functionality>(reg,grp);
 	}
 	UG_REGISTRY_CATCH_THROW(grp);
@@ -46,6 +46,7 @@
 #include "common/serialization.h"
 #include "../util_overloaded.h"
 #include "common/util/binary_buffer.h"
+#include "common/util/async_file_writer.h"
 
 using namespace std;
 
@@ -152,6 +153,46 @@ void SaveToFile(const T &v, std::string filename)
 	pcl::WriteCombinedParallelFile(b, filename);
 }
 
+/// like SaveToFile, but the file is written in a background thread
+/**
+ * The vector is serialized immediately, so that v may be changed afterwards.
+ * Errors are reported by the next asynchronous write or by FlushAsyncOutput.
+ * In parallel, the previous asynchronous output is flushed first, so that at
+ * most one checkpoint is in flight while the next one is prepared.
+ */
+template<typename T>
+void SaveToFileAsync(const T &v, std::string filename)
+{
+	BinaryBuffer b;
+	Serialize(b, v);
+
+	std::string content;
+#ifdef UG_PARALLEL
+	if(b.write_pos() > 0)
+		content.assign(b.buffer(), b.write_pos());
+
+	GetAsyncFileWriter().flush();
+	long long offset = pcl::CreateCombinedParallelFile(content.size(), filename);
+	GetAsyncFileWriter().write(filename, content, offset);
+#else
+//	header as written by WriteCombinedParallelFile
+	int numProcs = 1;
+	int myNextOffset = 2*sizeof(int) + b.write_pos();
+	content.append((const char*)&numProcs, sizeof(numProcs));
+	content.append((const char*)&myNextOffset, sizeof(myNextOffset));
+	if(b.write_pos() > 0)
+		content.append(b.buffer(), b.write_pos());
+
+	GetAsyncFileWriter().write(filename, content);
+#endif
+}
+
+/// waits until all asynchronous output is written to disk
+void FlushAsyncOutput()
+{
+	GetAsyncFileWriter().flush();
+}
+
 template<typename T>
 void ReadFromFile(T &v, std::string filename)
 {
@@ -199,6 +240,7 @@ static void Algebra(Registry& reg, string grp)
 
 	reg.add_function("SaveToFile", OVERLOADED_FUNCTION_PTR(void, SaveToFile<vector_type>, (const vector_type &, std::string)), grp);
 	reg.add_function("ReadFromFile", OVERLOADED_FUNCTION_PTR(void, ReadFromFile<vector_type>, (vector_type &, std::string)), grp);
+	reg.add_function("SaveToFileAsync", OVERLOADED_FUNCTION_PTR(void, SaveToFileAsync<vector_type>, (const vector_type &, std::string)), grp);
 }
 
 }; // end Functionality
@@ -213,6 +255,8 @@ void RegisterBridge_Restart(Registry& reg, string grp)
 
 	try{
 		RegisterAlgebraDependent<Functionality>(reg,grp);
+		reg.add_function("FlushAsyncOutput", &FlushAsyncOutput, grp, "", "",
+						 "waits until all asynchronous output is written to disk");
 	}
 	UG_REGISTRY_CATCH_THROW(grp);
 	//reg.add_function("testomato", testomato, grp);
@@ -241,6 +241,8 @@ static void Algebra(Registry& reg, string grp)
 		string name = string("GMRES").append(suffix);
 		reg.add_class_<T,TBase>(name, grp, "GMRES Solver")
 			.ADD_CONSTRUCTOR( (size_t restar) )("restart")
+			.add_method("set_orthogonalization", &T::set_orthogonalization, "", "method",
+						"orthogonalization of the Krylov basis: 'mgs' (modified Gram-Schmidt, default) or 'cgs2' (classical Gram-Schmidt with reorthogonalization, fewer global reductions)")
 			.add_method("add_postprocess_corr", &T::add_postprocess_corr, "adds a postprocess of the corrections", "op")
 			.add_method("remove_postprocess_corr", &T::remove_postprocess_corr, "removes a postprocess of the corrections", "op")
 			.set_construct_as_smart_pointer(true);
@@ -258,6 +260,8 @@ static void Algebra(Registry& reg, string grp)
 			.add_method("set_sort_sparse", &T::set_sort_sparse, "", "bSort", "if bSort=true, use a cuthill-mckey sorting to reduce fill-in in sparse LU. default true")
 			.add_method("set_info", &T::set_info, "", "bInfo", "if true, sparse LU prints some fill-in info")
 			.add_method("set_show_progress", &T::set_show_progress, "", "onoff", "switches the progress indicator on/off")
+			.add_method("set_sparse_method", &T::set_sparse_method, "", "method", "'ilut' (default) or 'supernodal' (multifrontal supernodal LU with nested dissection ordering)")
+			.add_method("set_nested_dissection_min_size", &T::set_nested_dissection_min_size, "", "minSize", "subgraph size below which nested dissection stops splitting. default 64")
 			.set_construct_as_smart_pointer(true);
 		reg.add_class_to_group(name, "LU", tag);
 	}
@@ -269,6 +273,7 @@ static void Algebra(Registry& reg, string grp)
 		string name = string("AgglomeratingSolver").append(suffix);
 		reg.add_class_<T,TBase>(name, grp, "AgglomeratingSolver")
 			.ADD_CONSTRUCTOR( (SmartPtr<ILinearOperatorInverse<vector_type, vector_type> > ) )("pLinOp")
+			.add_method("set_group_size", &T::set_group_size, "", "groupSize", "number of processes agglomerated onto one (0 = all)")
 			.set_construct_as_smart_pointer(true);
 		reg.add_class_to_group(name, "AgglomeratingSolver", tag);
 	}
@@ -598,6 +598,8 @@ static void Common(Registry& reg, string grp)
 		.add_method("init_levels", &T::init_levels)
 		.add_method("init_surfaces", &T::init_surfaces)
 		.add_method("init_top_surface", &T::init_top_surface)
+		.add_method("set_incremental_dof_update", &T::set_incremental_dof_update, "", "bIncremental", "keeps surface dof indices of unchanged objects after grid adaption")
+		.add_method("set_surface_element_lists", &T::set_surface_element_lists, "", "bEnable", "caches surface element lists for the iteration of surface grid levels")
 
 		.add_method("clear", &T::clear)
 		.add_method("add_fct", static_cast<void (T::*)(const char*, const char*, int, const char*)>(&T::add),
@@ -214,6 +214,11 @@ static void DomainAlgebra(Registry& reg, string grp)
 			.add_method("ignore_init_for_base_solver", static_cast<void (T::*)(bool)>(&T::ignore_init_for_base_solver), "", "ignore")
 			.add_method("ignore_init_for_base_solver", static_cast<bool (T::*)() const>(&T::ignore_init_for_base_solver), "is ignored", "")
 			.add_method("force_reinit", &T::force_reinit)
+			.add_method("set_lag_coarse_operators", &T::set_lag_coarse_operators, "", "bLag", "reuse coarse level operators, smoothers and base solver in subsequent inits")
+			.add_method("set_max_lagged_inits", &T::set_max_lagged_inits, "", "num", "maximal number of inits reusing coarse operators (0 = unlimited)")
+			.add_method("set_lag_degradation_factor", &T::set_lag_degradation_factor, "", "factor", "rebuild lagged operators if contraction rate exceeds factor times the reference rate (<= 0: disabled)")
+			.add_method("set_level_operator_changed", &T::set_level_operator_changed, "", "lev", "rebuild operator of the level in next init (lev < 0: all levels)")
+			.add_method("num_lagged_inits", &T::num_lagged_inits, "number of consecutive inits reusing coarse operators")
 			.set_construct_as_smart_pointer(true);
 		reg.add_class_to_group(name, "GeometricMultiGrid", tag);
 	}
@@ -231,6 +236,7 @@ static void DomainAlgebra(Registry& reg, string grp)
 		.add_method("set_relax", &T::set_relax, "", "relax")
 		.add_method("select_schur_cmp", &T::select_schur_cmp, "", "")
 		.add_method("set_elim_offdiag", &T::set_elim_offdiag, "", "")
+		.add_method("set_multicolor", &T::set_multicolor, "", "bMulticolor", "colored patch ordering, patches of one color are processed concurrently")
 		.set_construct_as_smart_pointer(true);
 		reg.add_class_to_group(name, "ElementGaussSeidel", tag);
 	}
@@ -259,6 +265,7 @@ static void DomainAlgebra(Registry& reg, string grp)
 		reg.add_class_<T,TBase>(name, grp, "Sequential subspace correction")
 					.template add_constructor<void (*)(number)>("omega")
 					.add_method("set_vertex_subspace", &T::set_vertex_subspace, "", "subspace")
+					.add_method("set_multicolor", &T::set_multicolor, "", "bMulticolor", "colored subspace ordering, subspaces of one color are processed concurrently")
 					.set_construct_as_smart_pointer(true);
 		reg.add_class_to_group(name, "SequentialSubspaceCorrection", tag);
 	}
@@ -44,6 +44,7 @@
 #include "lib_disc/domain.h"
 #include "lib_disc/dof_manager/ordering/cuthill_mckee.h"
 #include "lib_disc/dof_manager/ordering/lexorder.h"
+#include "lib_disc/dof_manager/ordering/sfc_order.h"
 #include "lib_disc/dof_manager/ordering/downwindorder.h"
 
 using namespace std;
@@ -109,6 +110,11 @@ static void Domain(Registry& reg, string grp)
 	{
 		reg.add_function("OrderLex", static_cast<void (*)(approximation_space_type&, const char*)>(&OrderLex<TDomain>), grp);
 	}
+
+//	Order along a space filling curve
+	{
+		reg.add_function("OrderSpaceFillingCurve", static_cast<void (*)(approximation_space_type&, const char*)>(&OrderSpaceFillingCurve<TDomain>), grp, "", "approxSpace#curve", "orders dofs along a 'hilbert' or 'morton' curve");
+	}
 //	Order in downwind direction
 	{
 		reg.add_function("OrderDownwind", static_cast<void (*)(approximation_space_type&, SmartPtr<UserData<MathVector<TDomain::dim>, TDomain::dim> >)> (&ug::OrderDownwind<TDomain>), grp);
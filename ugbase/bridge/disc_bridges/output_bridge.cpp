@@ -287,6 +287,10 @@ static void Dimension(Registry& reg, string grp)
 			.add_method("set_write_grid", static_cast<void (T::*)(bool)>(&T::set_write_grid))
 			.add_method("set_write_subset_indices", static_cast<void (T::*)(bool)>(&T::set_write_subset_indices))
 			.add_method("set_write_proc_ranks", static_cast<void (T::*)(bool)>(&T::set_write_proc_ranks))
+			.add_method("set_num_output_files", &T::set_num_output_files, "", "numFiles", "number of *.vtu files the pieces of all processes are grouped into (0: one file per process)")
+			.add_method("set_collective_io", &T::set_collective_io, "", "bCollective", "write grouped *.vtu files collectively using MPI-IO")
+			.add_method("set_async", &T::set_async, "", "bAsync", "write *.vtu files to disk in a background thread")
+			.add_method("flush", &T::flush, "", "", "waits until all asynchronously written files are on disk")
 			.set_construct_as_smart_pointer(true);
 		reg.add_class_to_group(name, "VTKOutput", tag);
 	}
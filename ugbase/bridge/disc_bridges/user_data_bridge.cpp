@@ -177,6 +177,7 @@ void RegisterUserDataTypeB(Registry& reg, string grp)
 				.add_method("add", static_cast<void (T::*)(number, SmartPtr<CplUserData<TData,dim> >)>(&T::add))
 				.add_method("add", static_cast<void (T::*)(SmartPtr<CplUserData<number,dim> > , number)>(&T::add))
 				.add_method("add", static_cast<void (T::*)(number,number)>(&T::add))
+				.add_method("set_fusion", &T::set_fusion, "", "bFusion", "enables/disables flattening of nested linkers")
 				.add_constructor()
 				.template add_constructor<void (*)(const ScaleAddLinker<TData, dim, number>&)>()
 				.set_construct_as_smart_pointer(true);
@@ -311,6 +312,7 @@ static void Dimension(Registry& reg, string grp)
 			.add_method("add", static_cast<void (T::*)(number , SmartPtr<CplUserData<TData,dim> >)>(&T::add))
 			.add_method("add", static_cast<void (T::*)(SmartPtr<CplUserData<TDataScale,dim> > , number)>(&T::add))
 			.add_method("add", static_cast<void (T::*)(number,number)>(&T::add))
+			.add_method("set_fusion", &T::set_fusion, "", "bFusion", "enables/disables flattening of nested linkers")
 			.add_constructor()
 			.template add_constructor<void (*)(const ScaleAddLinker<TData, dim, TDataScale>&)>()
 			.set_construct_as_smart_pointer(true);
@@ -329,6 +331,7 @@ static void Dimension(Registry& reg, string grp)
 			.add_method("add", static_cast<void (T::*)(number , SmartPtr<CplUserData<TData,dim> >)>(&T::add))
 			.add_method("add", static_cast<void (T::*)(SmartPtr<CplUserData<TDataScale,dim> > , number)>(&T::add))
 			.add_method("add", static_cast<void (T::*)(number,number)>(&T::add))
+			.add_method("set_fusion", &T::set_fusion, "", "bFusion", "enables/disables flattening of nested linkers")
 			.add_constructor()
 			.template add_constructor<void (*)(const ScaleAddLinker<TData, dim, TDataScale,number>&)>()
 			.set_construct_as_smart_pointer(true);
@@ -413,6 +416,9 @@ static void Dimension(Registry& reg, string grp)
 			.template add_constructor<void (*)(size_t N, double mean_f, double sigma_f, double sigma)>("LognormalRandomField", "N#mean_f#sigma_f#sigma")
 			.add_method("set_config",  &T::set_config, "", "N#mean_f#sigma_f#sigma")
 			.add_method("set_no_exp",  &T::set_no_exp, "", "", "use this for display of log of the field")
+			.add_method("set_raster_sampling",  &T::set_raster_sampling, "", "minCorner#extension#numNodes", "samples the field on a raster and interpolates it")
+			.add_method("disable_raster_sampling",  &T::disable_raster_sampling, "", "", "evaluates the modes at every point")
+			.add_method("revision",  &T::revision, "revision of the realization")
 			.set_construct_as_smart_pointer(true);
 		reg.add_class_to_group(name, string("LognormalRandomField"), dimTag);
 	}
@@ -426,6 +432,7 @@ static void Dimension(Registry& reg, string grp)
 		   .add_method("load_data_from", static_cast<void (T::*)(const char*)>(&T::load_data_from), "loads data from a file", "file name")
 		   .add_method("set_order", static_cast<void (T::*)(number)>(&T::set_order), "sets order of the IDW-interpolation", "order")
 		   .add_method("set_radius", static_cast<void (T::*)(number)>(&T::set_radius), "sets radius of the neighbourhood for the IDW-interpolation", "radius")
+		   .add_method("set_num_neighbours", &T::set_num_neighbours, "restricts the IDW-interpolation to the k nearest points (0 == all)", "k")
 		   .add_constructor()
 		   .template add_constructor<void(*)(number,number)> ("order#radius")
 		   .set_construct_as_smart_pointer(true);
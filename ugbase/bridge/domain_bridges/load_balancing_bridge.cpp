@@ -47,6 +47,8 @@
 	#include "lib_grid/parallelization/load_balancer.h"
 	#include "lib_grid/parallelization/load_balancer_util.h"
 	#include "lib_grid/parallelization/partitioner_dynamic_bisection.h"
+	#include "lib_grid/parallelization/partitioner_sfc.h"
+	#include "lib_grid/parallelization/partitioner_multilevel.h"
 	#include "lib_grid/parallelization/balance_weights_ref_marks.h"
 	#include "lib_grid/parallelization/partition_pre_processors/replace_coordinate.h"
 	#include "lib_grid/parallelization/partition_post_processors/smooth_partition_bounds.h"
@@ -197,6 +199,54 @@ static void RegisterDynamicBisectionPartitioner(
 	reg.add_class_to_group(name, clsGrpName, GetDomainTag<TDomain>());
 }
 
+template <class TDomain, class TPartitioner>
+static void RegisterSFCPartitioner(
+	Registry& reg,
+	string name,
+	string grpName,
+	string clsGrpName)
+{
+	reg.add_class_<TPartitioner, IPartitioner>(name, grpName)
+		.template add_constructor<void (*)(TDomain&)>()
+		.add_method("set_subset_handler",
+			&TPartitioner::set_subset_handler)
+		.add_method("set_curve",
+			&TPartitioner::set_curve, "", "curve", "'hilbert' (default) or 'morton'")
+		.set_construct_as_smart_pointer(true);
+
+	reg.add_class_to_group(name, clsGrpName, GetDomainTag<TDomain>());
+}
+
+template <class TDomain, class TPartitioner>
+static void RegisterMultilevelPartitioner(
+	Registry& reg,
+	string name,
+	string grpName,
+	string clsGrpName)
+{
+	reg.add_class_<TPartitioner, IPartitioner>(name, grpName)
+		.template add_constructor<void (*)(TDomain&)>()
+		.add_method("set_subset_handler",
+			&TPartitioner::set_subset_handler)
+		.add_method("set_imbalance_tolerance",
+			&TPartitioner::set_imbalance_tolerance, "", "tolerance",
+			"maximal ratio of partition weight and average weight (default 1.05)")
+		.add_method("imbalance_tolerance",
+			&TPartitioner::imbalance_tolerance)
+		.add_method("set_migration_cost",
+			&TPartitioner::set_migration_cost, "", "cost",
+			"penalty for moving elements away from their process (default 0.1)")
+		.add_method("migration_cost",
+			&TPartitioner::migration_cost)
+		.add_method("enable_repartitioning",
+			&TPartitioner::enable_repartitioning)
+		.add_method("repartitioning_enabled",
+			&TPartitioner::repartitioning_enabled)
+		.set_construct_as_smart_pointer(true);
+
+	reg.add_class_to_group(name, clsGrpName, GetDomainTag<TDomain>());
+}
+
 template <class TDomain, class elem_t>
 static void RegisterSmoothPartitionBounds(
 	Registry& reg,
@@ -332,6 +382,22 @@ static void Common(Registry& reg, string grp) {
 			grp,
 			"Partitioner_DynamicBisection");
 
+		RegisterSFCPartitioner<
+				TDomain,
+				DomainPartitioner<TDomain, Partitioner_SFC<Edge, 1> > >(
+			reg,
+			"EdgePartitioner_SFC1d",
+			grp,
+			"Partitioner_SFC");
+
+		RegisterMultilevelPartitioner<
+				TDomain,
+				DomainPartitioner<TDomain, Partitioner_Multilevel<Edge, 1> > >(
+			reg,
+			"EdgePartitioner_Multilevel1d",
+			grp,
+			"Partitioner_Multilevel");
+
 
 		RegisterSmoothPartitionBounds<TDomain, Edge>(
 			reg,
@@ -358,6 +424,22 @@ static void Common(Registry& reg, string grp) {
 			grp,
 			"ManifoldPartitioner_DynamicBisection");
 
+		RegisterSFCPartitioner<
+				TDomain,
+				DomainPartitioner<TDomain, Partitioner_SFC<Edge, 2> > >(
+			reg,
+			"EdgePartitioner_SFC2d",
+			grp,
+			"ManifoldPartitioner_SFC");
+
+		RegisterMultilevelPartitioner<
+				TDomain,
+				DomainPartitioner<TDomain, Partitioner_Multilevel<Edge, 2> > >(
+			reg,
+			"EdgePartitioner_Multilevel2d",
+			grp,
+			"ManifoldPartitioner_Multilevel");
+
 		RegisterDynamicBisectionPartitioner<
 				TDomain,
 				DomainPartitioner<TDomain, Partitioner_DynamicBisection<Face, 2> > >(
@@ -366,6 +448,22 @@ static void Common(Registry& reg, string grp) {
 			grp,
 			"Partitioner_DynamicBisection");
 
+		RegisterSFCPartitioner<
+				TDomain,
+				DomainPartitioner<TDomain, Partitioner_SFC<Face, 2> > >(
+			reg,
+			"FacePartitioner_SFC2d",
+			grp,
+			"Partitioner_SFC");
+
+		RegisterMultilevelPartitioner<
+				TDomain,
+				DomainPartitioner<TDomain, Partitioner_Multilevel<Face, 2> > >(
+			reg,
+			"FacePartitioner_Multilevel2d",
+			grp,
+			"Partitioner_Multilevel");
+
 		RegisterSmoothPartitionBounds<TDomain, Face>(
 			reg,
 			"SmoothPartitionBounds2d",
@@ -391,6 +489,22 @@ static void Common(Registry& reg, string grp) {
 			grp,
 			"HyperManifoldPartitioner_DynamicBisection");
 
+		RegisterSFCPartitioner<
+				TDomain,
+				DomainPartitioner<TDomain, Partitioner_SFC<Edge, 3> > >(
+			reg,
+			"EdgePartitioner_SFC3d",
+			grp,
+			"HyperManifoldPartitioner_SFC");
+
+		RegisterMultilevelPartitioner<
+				TDomain,
+				DomainPartitioner<TDomain, Partitioner_Multilevel<Edge, 3> > >(
+			reg,
+			"EdgePartitioner_Multilevel3d",
+			grp,
+			"HyperManifoldPartitioner_Multilevel");
+
 		RegisterDynamicBisectionPartitioner<
 				TDomain,
 				DomainPartitioner<TDomain, Partitioner_DynamicBisection<Face, 3> > >(
@@ -399,6 +513,22 @@ static void Common(Registry& reg, string grp) {
 			grp,
 			"ManifoldPartitioner_DynamicBisection");
 
+		RegisterSFCPartitioner<
+				TDomain,
+				DomainPartitioner<TDomain, Partitioner_SFC<Face, 3> > >(
+			reg,
+			"FacePartitioner_SFC3d",
+			grp,
+			"ManifoldPartitioner_SFC");
+
+		RegisterMultilevelPartitioner<
+				TDomain,
+				DomainPartitioner<TDomain, Partitioner_Multilevel<Face, 3> > >(
+			reg,
+			"FacePartitioner_Multilevel3d",
+			grp,
+			"ManifoldPartitioner_Multilevel");
+
 		RegisterDynamicBisectionPartitioner<
 				TDomain,
 				DomainPartitioner<TDomain, Partitioner_DynamicBisection<Volume, 3> > >(
@@ -407,6 +537,22 @@ static void Common(Registry& reg, string grp) {
 			grp,
 			"Partitioner_DynamicBisection");
 
+		RegisterSFCPartitioner<
+				TDomain,
+				DomainPartitioner<TDomain, Partitioner_SFC<Volume, 3> > >(
+			reg,
+			"VolumePartitioner_SFC3d",
+			grp,
+			"Partitioner_SFC");
+
+		RegisterMultilevelPartitioner<
+				TDomain,
+				DomainPartitioner<TDomain, Partitioner_Multilevel<Volume, 3> > >(
+			reg,
+			"VolumePartitioner_Multilevel3d",
+			grp,
+			"Partitioner_Multilevel");
+
 		RegisterSmoothPartitionBounds<TDomain, Volume>(
 			reg,
 			"SmoothPartitionBounds3d",
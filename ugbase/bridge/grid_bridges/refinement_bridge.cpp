@@ -264,6 +264,9 @@ void RegisterGridBridge_Refinement(Registry& reg, string parentGroup)
 		.add_constructor()
 		.add_method("assign_grid", static_cast<void (GlobalMultiGridRefiner::*)(MultiGrid&)>(&GlobalMultiGridRefiner::assign_grid),
 				"", "mg")
+		.add_method("enable_bulk_projection", &GlobalMultiGridRefiner::enable_bulk_projection,
+				"", "enable", "projects all new vertices in one (threaded) pass after element creation")
+		.add_method("bulk_projection_enabled", &GlobalMultiGridRefiner::bulk_projection_enabled)
 		.set_construct_as_smart_pointer(true);
 
 	{
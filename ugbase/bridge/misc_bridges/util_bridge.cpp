@@ -35,6 +35,7 @@
 #include "bridge/bridge.h"
 #include "common/stopwatch.h"
 #include "common/util/file_util.h"
+#include "common/util/mem_accounting.h"
 #include "common/util/path_provider.h"
 #include "common/util/table.h"
 #include "common/util/variant.h"
@@ -243,6 +244,25 @@ void RegisterBridge_Util(Registry& reg, string parentGroup)
 	}
 #endif
 
+	// MemAccounting provides live and peak memory per category (matrix, vector, ...)
+	{
+		typedef MemAccounting T;
+		reg.add_function("MemAccountingReport", &T::report, grp,
+				"report", "", "returns live and peak memory per category. Collective in parallel.")
+			.add_function("PrintMemAccountingReport", &T::print_report, grp,
+				"", "", "prints live and peak memory per category. Collective in parallel.")
+			.add_function("MemAccountingResetPeaks", &T::reset_peaks, grp,
+				"", "", "sets the peaks of all categories to their current values.")
+			.add_function("MemAccountingTotalLiveBytes", &T::total_live_bytes, grp,
+				"bytes", "", "accounted bytes over all categories on this process.")
+			.add_function("MemAccountingTotalPeakBytes", &T::total_peak_bytes, grp,
+				"bytes", "", "peak of the accounted bytes over all categories on this process.")
+			.add_function("MemAccountingEnableTimeline", &T::enable_timeline, grp,
+				"", "enable#minDeltaBytes", "records a sample whenever a category changed by minDeltaBytes.")
+			.add_function("MemAccountingWriteTimeline", &T::write_timeline, grp,
+				"", "filename", "writes the recorded timeline as csv. The rank is appended in parallel.");
+	}
+
 }
 
 // end group util_bridge
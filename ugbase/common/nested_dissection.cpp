@@ -0,0 +1,300 @@
+/*
+ * Copyright (c) 2017:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+
+#include "common/common.h"
+#include "nested_dissection.h"
+#include <algorithm>
+#include <vector>
+#include "common/profiler/profiler.h"
+
+namespace ug{
+
+namespace{
+
+/// recursive nested dissection on a symmetric graph stored in compressed rows
+/**
+ * Every vertex carries the id of the subgraph it currently belongs to. Level
+ * structures are only built inside one subgraph, so that separators which
+ * have already been cut off (and get numbered after the parts) act as
+ * barriers for the recursion.
+ */
+class NestedDissection
+{
+	public:
+		NestedDissection(const std::vector<size_t>& vAdjStart,
+		                 const std::vector<size_t>& vAdj, size_t minSize)
+			: m_vAdjStart(vAdjStart), m_vAdj(vAdj),
+			  m_minSize(std::max(minSize, (size_t)1)),
+			  m_vPart(vAdjStart.size()-1, 0), m_vLevel(vAdjStart.size()-1, 0),
+			  m_vVisit(vAdjStart.size()-1, 0), m_stamp(0),
+			  m_nextPart(1), m_cnt(0)
+		{}
+
+		void order(std::vector<size_t>& vNewIndex)
+		{
+			const size_t n = m_vPart.size();
+			m_vNewIndex.clear(); m_vNewIndex.resize(n, (size_t)-1);
+			m_cnt = 0;
+
+			std::vector<size_t> vVrt(n);
+			for(size_t i = 0; i < n; ++i) vVrt[i] = i;
+			dissect(vVrt, 0);
+
+			UG_COND_THROW(m_cnt != n, "Nested dissection numbered " << m_cnt
+			              << " of " << n << " indices.");
+			vNewIndex.swap(m_vNewIndex);
+		}
+
+	private:
+		size_t degree(size_t v) const {return m_vAdjStart[v+1] - m_vAdjStart[v];}
+
+	///	builds the rooted level structure inside subgraph 'id'
+	/**	vOrder is filled with the reached vertices in breadth-first order,
+	 *	vLevelStart[l] marks the first vertex of level l in vOrder. The level
+	 *	of each reached vertex is stored in m_vLevel.
+	 *	\returns the number of levels */
+		size_t level_structure(size_t root, size_t id,
+		                       std::vector<size_t>& vOrder,
+		                       std::vector<size_t>& vLevelStart)
+		{
+			++m_stamp;
+			vOrder.clear(); vLevelStart.clear();
+			vOrder.push_back(root);
+			m_vVisit[root] = m_stamp;
+			m_vLevel[root] = 0;
+
+			size_t levBegin = 0;
+			while(levBegin < vOrder.size())
+			{
+				const size_t levEnd = vOrder.size();
+				vLevelStart.push_back(levBegin);
+				for(size_t k = levBegin; k < levEnd; ++k)
+				{
+					const size_t v = vOrder[k];
+					for(size_t a = m_vAdjStart[v]; a < m_vAdjStart[v+1]; ++a)
+					{
+						const size_t w = m_vAdj[a];
+						if(m_vPart[w] != id || m_vVisit[w] == m_stamp) continue;
+						m_vVisit[w] = m_stamp;
+						m_vLevel[w] = vLevelStart.size();
+						vOrder.push_back(w);
+					}
+				}
+				levBegin = levEnd;
+			}
+			vLevelStart.push_back(vOrder.size());
+			return vLevelStart.size() - 1;
+		}
+
+	///	numbers a subgraph in reverse breadth-first order (no dissection)
+		void number_leaf(const std::vector<size_t>& vVrt)
+		{
+			std::vector<size_t> vOrder, vLevelStart, vAll;
+			vAll.reserve(vVrt.size());
+			const size_t leafId = m_nextPart++;
+			for(size_t i = 0; i < vVrt.size(); ++i)
+				m_vPart[vVrt[i]] = leafId;
+
+			for(size_t i = 0; i < vVrt.size(); ++i)
+			{
+				const size_t v = vVrt[i];
+				if(m_vPart[v] != leafId) continue;
+				level_structure(v, leafId, vOrder, vLevelStart);
+				for(size_t k = 0; k < vOrder.size(); ++k)
+					m_vPart[vOrder[k]] = NUMBERED;
+				vAll.insert(vAll.end(), vOrder.begin(), vOrder.end());
+			}
+
+			for(size_t k = vAll.size(); k > 0; --k)
+				m_vNewIndex[vAll[k-1]] = m_cnt++;
+		}
+
+		void dissect(std::vector<size_t>& vVrt, size_t id)
+		{
+			std::vector<size_t> vOrder, vLevelStart, vTmp, vTmpStart;
+
+			while(!vVrt.empty())
+			{
+				if(vVrt.size() <= m_minSize)
+					{number_leaf(vVrt); return;}
+
+			//	start with a vertex of minimal degree
+				size_t root = vVrt[0];
+				for(size_t i = 1; i < vVrt.size(); ++i)
+					if(degree(vVrt[i]) < degree(root)) root = vVrt[i];
+
+			//	pseudo-peripheral vertex: restart from the last level as long
+			//	as the eccentricity grows
+				size_t numLevel = level_structure(root, id, vOrder, vLevelStart);
+				for(int iter = 0; iter < 8; ++iter)
+				{
+					size_t cand = vOrder[vLevelStart[numLevel-1]];
+					for(size_t k = vLevelStart[numLevel-1]; k < vOrder.size(); ++k)
+						if(degree(vOrder[k]) < degree(cand)) cand = vOrder[k];
+
+					const size_t candLevel = level_structure(cand, id, vTmp, vTmpStart);
+					if(candLevel <= numLevel)
+					{
+					//	restore levels of the accepted structure
+						level_structure(root, id, vOrder, vLevelStart);
+						break;
+					}
+					root = cand; numLevel = candLevel;
+					vOrder.swap(vTmp); vLevelStart.swap(vTmpStart);
+				}
+
+			//	the structure only covers one component: split it off
+				if(vOrder.size() < vVrt.size())
+				{
+					const size_t compId = m_nextPart++;
+					for(size_t k = 0; k < vOrder.size(); ++k)
+						m_vPart[vOrder[k]] = compId;
+					std::vector<size_t> vComp(vOrder);
+					dissect(vComp, compId);
+
+					vTmp.clear();
+					for(size_t i = 0; i < vVrt.size(); ++i)
+						if(m_vPart[vVrt[i]] == id) vTmp.push_back(vVrt[i]);
+					vVrt.swap(vTmp);
+					continue;
+				}
+
+			//	too compact to be split by a level
+				if(numLevel < 3)
+					{number_leaf(vVrt); return;}
+
+			//	middle level: the one where half of the vertices is reached
+				size_t sepLevel = 1;
+				while(sepLevel < numLevel - 2
+					  && vLevelStart[sepLevel+1] < vOrder.size() / 2)
+					++sepLevel;
+
+			//	separator: vertices of the middle level adjacent to the far side
+				const size_t idA = m_nextPart++, idB = m_nextPart++, idS = m_nextPart++;
+				std::vector<size_t> vA, vB, vS;
+				for(size_t k = 0; k < vOrder.size(); ++k)
+				{
+					const size_t v = vOrder[k];
+					const size_t lev = m_vLevel[v];
+					if(lev < sepLevel) vA.push_back(v);
+					else if(lev > sepLevel) vB.push_back(v);
+					else
+					{
+						bool bFar = false;
+						for(size_t a = m_vAdjStart[v]; a < m_vAdjStart[v+1]; ++a)
+						{
+							const size_t w = m_vAdj[a];
+							if(m_vPart[w] == id && m_vLevel[w] == sepLevel + 1)
+								{bFar = true; break;}
+						}
+						if(bFar) vS.push_back(v);
+						else vA.push_back(v);
+					}
+				}
+				for(size_t k = 0; k < vA.size(); ++k) m_vPart[vA[k]] = idA;
+				for(size_t k = 0; k < vB.size(); ++k) m_vPart[vB[k]] = idB;
+				for(size_t k = 0; k < vS.size(); ++k) m_vPart[vS[k]] = idS;
+
+				vVrt.clear();
+				dissect(vA, idA);
+				dissect(vB, idB);
+
+			//	separator is eliminated last
+				for(size_t k = 0; k < vS.size(); ++k)
+				{
+					m_vPart[vS[k]] = NUMBERED;
+					m_vNewIndex[vS[k]] = m_cnt++;
+				}
+				return;
+			}
+		}
+
+	private:
+	///	subgraph id of vertices that already got their new index
+		static const size_t NUMBERED = (size_t)-1;
+
+		const std::vector<size_t>& m_vAdjStart;
+		const std::vector<size_t>& m_vAdj;
+		size_t m_minSize;
+
+		std::vector<size_t> m_vPart;
+		std::vector<size_t> m_vLevel;
+		std::vector<size_t> m_vVisit;
+		size_t m_stamp;
+		size_t m_nextPart;
+
+		std::vector<size_t> m_vNewIndex;
+		size_t m_cnt;
+};
+
+} // end anonymous namespace
+
+
+void ComputeNestedDissectionOrder(std::vector<size_t>& vNewIndex,
+                                  const std::vector<std::vector<size_t> >& vvNeighbour,
+                                  size_t minSize)
+{
+	PROFILE_FUNC();
+	const size_t n = vvNeighbour.size();
+
+//	symmetrized adjacency without self-connections
+	std::vector<std::vector<size_t> > vvSym(n);
+	for(size_t i = 0; i < n; ++i)
+		for(size_t k = 0; k < vvNeighbour[i].size(); ++k)
+		{
+			const size_t j = vvNeighbour[i][k];
+			UG_COND_THROW(j >= n, "Neighbour index " << j << " of index " << i
+			              << " out of range (" << n << ").");
+			if(j == i) continue;
+			vvSym[i].push_back(j);
+			vvSym[j].push_back(i);
+		}
+
+	std::vector<size_t> vAdjStart(n+1, 0), vAdj;
+	for(size_t i = 0; i < n; ++i)
+	{
+		std::sort(vvSym[i].begin(), vvSym[i].end());
+		vvSym[i].erase(std::unique(vvSym[i].begin(), vvSym[i].end()), vvSym[i].end());
+		vAdjStart[i+1] = vAdjStart[i] + vvSym[i].size();
+	}
+	vAdj.reserve(vAdjStart[n]);
+	for(size_t i = 0; i < n; ++i)
+	{
+		vAdj.insert(vAdj.end(), vvSym[i].begin(), vvSym[i].end());
+		std::vector<size_t>().swap(vvSym[i]);
+	}
+
+	NestedDissection nd(vAdjStart, vAdj, minSize);
+	nd.order(vNewIndex);
+}
+
+} // end namespace ug
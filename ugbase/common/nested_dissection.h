@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2017:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+
+#ifndef __H__UG__COMMON__NESTED_DISSECTION__
+#define __H__UG__COMMON__NESTED_DISSECTION__
+
+#include <vector>
+#include <cstddef>
+
+namespace ug{
+
+/// returns an index mapping for a fill-reducing nested dissection ordering
+/**
+ * The index graph is recursively split by vertex separators. The two parts
+ * are numbered first, the separator last, so that eliminating the parts in
+ * a sparse direct factorization does not create fill between them. Separators
+ * are taken from the middle level of a rooted level structure started at a
+ * pseudo-peripheral vertex (George/Liu), trimmed to those vertices which are
+ * actually adjacent to the far side. Disconnected components are handled
+ * independently. Subgraphs with at most minSize vertices are not split any
+ * further but numbered in reverse breadth-first order.
+ *
+ * The adjacency does not have to be symmetric, the ordering is computed
+ * on the symmetrized graph. Self-connections are ignored.
+ *
+ * On exit, vNewIndex contains the mapping newInd = vNewIndex[oldInd].
+ *
+ * \param[out]	vNewIndex		vector returning new index for old index
+ * \param[in]	vvNeighbour		vector of adjacent indices for each index
+ * \param[in]	minSize			subgraph size below which no further dissection is done
+ */
+void ComputeNestedDissectionOrder(std::vector<size_t>& vNewIndex,
+                                  const std::vector<std::vector<size_t> >& vvNeighbour,
+                                  size_t minSize = 64);
+
+} // end namespace ug
+
+#endif /* __H__UG__COMMON__NESTED_DISSECTION__ */
@@ -0,0 +1,216 @@
+/*
+ * Copyright (c) 2017:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+
+#include <cstdio>
+#include <iostream>
+#include "async_file_writer.h"
+#include "common/error.h"
+
+namespace ug
+{
+
+AsyncFileWriter::
+AsyncFileWriter(size_t maxPendingBytes) :
+#ifdef UG_CXX11
+	m_bStop(false),
+	m_bBusy(false),
+#endif
+	m_pendingBytes(0),
+	m_maxPendingBytes(maxPendingBytes)
+{
+}
+
+AsyncFileWriter::
+~AsyncFileWriter()
+{
+#ifdef UG_CXX11
+	if(m_thread.joinable()){
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_bStop = true;
+		}
+		m_cvJob.notify_all();
+		m_thread.join();
+	}
+#endif
+//	the log may already be destroyed at this point, so we use std::cerr
+	if(!m_error.empty())
+		std::cerr << "ERROR in AsyncFileWriter: " << m_error << std::endl;
+}
+
+void AsyncFileWriter::
+set_max_pending_bytes(size_t maxBytes)
+{
+#ifdef UG_CXX11
+	std::lock_guard<std::mutex> lock(m_mutex);
+#endif
+	m_maxPendingBytes = maxBytes;
+}
+
+void AsyncFileWriter::
+write(const std::string& filename, std::string& content, long long offset)
+{
+#ifdef UG_CXX11
+	std::unique_lock<std::mutex> lock(m_mutex);
+	throw_error();
+
+//	back-pressure: wait until enough pending data has been written
+	while(m_pendingBytes > 0 && m_pendingBytes + content.size() > m_maxPendingBytes)
+		m_cvDone.wait(lock);
+	throw_error();
+
+	m_jobs.push_back(Job());
+	Job& job = m_jobs.back();
+	job.filename = filename;
+	job.content.swap(content);
+	job.offset = offset;
+	m_pendingBytes += job.content.size();
+
+	if(!m_thread.joinable())
+		m_thread = std::thread(&AsyncFileWriter::worker, this);
+
+	lock.unlock();
+	m_cvJob.notify_one();
+#else
+	Job job;
+	job.filename = filename;
+	job.content.swap(content);
+	job.offset = offset;
+	m_error = write_job(job);
+	throw_error();
+#endif
+}
+
+void AsyncFileWriter::
+flush()
+{
+#ifdef UG_CXX11
+	std::unique_lock<std::mutex> lock(m_mutex);
+	wait_idle(lock);
+#endif
+	throw_error();
+}
+
+size_t AsyncFileWriter::
+num_pending() const
+{
+#ifdef UG_CXX11
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_jobs.size() + (m_bBusy ? 1 : 0);
+#else
+	return 0;
+#endif
+}
+
+std::string AsyncFileWriter::
+write_job(const Job& job)
+{
+	FILE* file = fopen(job.filename.c_str(), (job.offset < 0) ? "wb" : "r+b");
+	if(file == NULL)
+		return std::string("Cannot open file '").append(job.filename).append("'.");
+
+	std::string err;
+	if(job.offset > 0){
+#ifdef UG_POSIX
+		if(fseeko(file, (off_t)job.offset, SEEK_SET) != 0)
+#else
+		if(fseek(file, (long)job.offset, SEEK_SET) != 0)
+#endif
+			err = std::string("Cannot seek in file '").append(job.filename).append("'.");
+	}
+
+	if(err.empty() && !job.content.empty()
+		&& fwrite(job.content.data(), 1, job.content.size(), file) != job.content.size())
+		err = std::string("Cannot write to file '").append(job.filename).append("'.");
+
+	if(fclose(file) != 0 && err.empty())
+		err = std::string("Cannot close file '").append(job.filename).append("'.");
+
+	return err;
+}
+
+void AsyncFileWriter::
+throw_error()
+{
+	if(m_error.empty()) return;
+	std::string err;
+	err.swap(m_error);
+	UG_THROW("AsyncFileWriter: " << err);
+}
+
+#ifdef UG_CXX11
+void AsyncFileWriter::
+wait_idle(std::unique_lock<std::mutex>& lock)
+{
+	while(!m_jobs.empty() || m_bBusy)
+		m_cvDone.wait(lock);
+}
+
+void AsyncFileWriter::
+worker()
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+	for(;;)
+	{
+		while(m_jobs.empty() && !m_bStop)
+			m_cvJob.wait(lock);
+
+	//	all jobs are written before the thread stops
+		if(m_jobs.empty()) break;
+
+		Job job;
+		job.filename.swap(m_jobs.front().filename);
+		job.content.swap(m_jobs.front().content);
+		job.offset = m_jobs.front().offset;
+		m_jobs.pop_front();
+		m_bBusy = true;
+
+		lock.unlock();
+		std::string err = write_job(job);
+		lock.lock();
+
+		m_bBusy = false;
+		m_pendingBytes -= job.content.size();
+		if(!err.empty() && m_error.empty())
+			m_error = err;
+		m_cvDone.notify_all();
+	}
+}
+#endif
+
+AsyncFileWriter& GetAsyncFileWriter()
+{
+	static AsyncFileWriter writer;
+	return writer;
+}
+
+}//	end of namespace
@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2017:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+
+#ifndef __H__UG__async_file_writer__
+#define __H__UG__async_file_writer__
+
+#include <string>
+#include <deque>
+
+#ifdef UG_CXX11
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#endif
+
+namespace ug
+{
+
+/// \addtogroup ugbase_common_io
+/// \{
+
+///	Writes files in a background thread.
+/**	The content of a file is handed over to the writer as a whole and written
+ * to disk by a background thread, so that the calling thread can continue
+ * its work (e.g. the next time step) while the data is written.
+ *
+ * The memory held by pending jobs is bounded: if the amount of pending data
+ * exceeds max_pending_bytes(), write() waits until enough data has been
+ * written (back-pressure).
+ *
+ * Errors occurring in the background thread are stored and thrown as
+ * UGError by the next call to write() or flush().
+ *
+ * If ug is compiled without C++11 support, all files are written directly
+ * in write().
+ */
+class AsyncFileWriter
+{
+	public:
+		AsyncFileWriter(size_t maxPendingBytes = 256 * 1024 * 1024);
+
+	///	waits until all pending jobs are written. Errors are only logged.
+		~AsyncFileWriter();
+
+	///	sets the maximal amount of data (in bytes) held by pending jobs
+		void set_max_pending_bytes(size_t maxBytes);
+		size_t max_pending_bytes() const			{return m_maxPendingBytes;}
+
+	///	schedules the given content to be written to the given file
+	/**	The content is swapped into the job, i.e. 'content' is empty afterwards.
+	 * If offset < 0, the file is created or truncated. Otherwise the file
+	 * has to exist and the content is written at the given offset (in bytes).*/
+		void write(const std::string& filename, std::string& content,
+				   long long offset = -1);
+
+	///	waits until all pending jobs are written and throws on errors
+		void flush();
+
+	///	returns the number of jobs which have not been written yet
+		size_t num_pending() const;
+
+	private:
+		struct Job{
+			std::string filename;
+			std::string content;
+			long long offset;
+		};
+
+	///	writes a single job to disk. Returns an error message on failure.
+		static std::string write_job(const Job& job);
+
+	///	throws the stored error (if any) and resets it
+		void throw_error();
+
+#ifdef UG_CXX11
+		void worker();
+		void wait_idle(std::unique_lock<std::mutex>& lock);
+
+		std::thread					m_thread;
+		mutable std::mutex			m_mutex;
+		std::condition_variable		m_cvJob;
+		std::condition_variable		m_cvDone;
+		bool						m_bStop;
+		bool						m_bBusy;
+#endif
+
+		std::deque<Job>	m_jobs;
+		size_t			m_pendingBytes;
+		size_t			m_maxPendingBytes;
+		std::string		m_error;
+};
+
+///	returns the writer shared by all asynchronous output of ug
+AsyncFileWriter& GetAsyncFileWriter();
+
+// end group ugbase_common_io
+/// \}
+
+}//	end of namespace
+
+#endif
@@ -128,6 +128,7 @@ Base64FileWriter& Base64FileWriter::operator<<(size_t value)
 }
 
 Base64FileWriter::Base64FileWriter() :
+	m_pOut(&m_fStream),
 	m_currFormat(base64_ascii),
 	m_inBuffer(ios_base::binary | ios_base::out | ios_base::in),
 	m_lastInputByteSize(0),
@@ -136,6 +137,7 @@ Base64FileWriter::Base64FileWriter() :
 
 Base64FileWriter::Base64FileWriter(const char* filename,
 		const ios_base::openmode mode) :
+	m_pOut(&m_fStream),
 	m_currFormat(base64_ascii),
 	m_inBuffer(ios_base::binary | ios_base::out | ios_base::in),
 	m_lastInputByteSize(0),
@@ -165,6 +167,7 @@ void Base64FileWriter::open(const char *filename,
 	}
 	*/
 
+	m_pOut = &m_fStream;
 	m_fStream.open(filename, mode);
 	if (!m_fStream.is_open()) {
 		UG_THROW( "Could not open output file: " << filename);
@@ -173,6 +176,18 @@ void Base64FileWriter::open(const char *filename,
 	}
 }
 
+void Base64FileWriter::open_memory()
+{
+	m_memStream.str("");
+	m_memStream.clear();
+	m_pOut = &m_memStream;
+}
+
+string Base64FileWriter::memory_content() const
+{
+	return m_memStream.str();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // PRIVATE FUNCTIONS
 
@@ -208,13 +223,15 @@ void Base64FileWriter::dispatch(const T& value)
 		}
 		case normal:
 			// nothing to do here, almost
-			m_fStream << value;
+			*m_pOut << value;
 			break;
 	}
 }
 
 inline void Base64FileWriter::assertFileOpen()
 {
+	if (m_pOut == &m_memStream)
+		return;
 	if (m_fStream.bad() || !m_fStream.is_open()) {
 		UG_THROW( "File stream is not open." );
 	}
@@ -263,7 +280,7 @@ void Base64FileWriter::flushInputBuffer(bool force)
 
 		// encode buff in base64
 		copy(base64_text(buff), base64_text(buff + buff_len),
-				boost::archive::iterators::ostream_iterator<char>(m_fStream));
+				boost::archive::iterators::ostream_iterator<char>(*m_pOut));
 	}
 
 	size_t rest_len = m_numBytesWritten - buff_len;
@@ -299,7 +316,7 @@ void Base64FileWriter::flushInputBuffer(bool force)
 
 	if (force) {
 		for(uint i = 0; i < paddChars; ++i)
-			m_fStream << '=';
+			*m_pOut << '=';
 
 		// resetting num bytes written and bytes in block
 		m_numBytesWritten = 0;
@@ -317,6 +334,8 @@ void Base64FileWriter::close()
 	flushInputBuffer(true);
 
 	// only when this is done, close the file stream
+	if (m_pOut == &m_memStream)
+		return;
 	m_fStream.close();
 	UG_ASSERT(m_fStream.good(), "could not close output file.");
 }
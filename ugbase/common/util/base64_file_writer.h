@@ -112,6 +112,20 @@ public:
 	void open(const char *filename,
 			const std::ios_base::openmode mode = std::ios_base::out );
 
+	/**
+	 * \brief Writes to an internal memory buffer instead of a file
+	 * \details After close() the written content can be obtained by
+	 *   memory_content(). This is used to assemble output which is written
+	 *   to disk by another process.
+	 */
+	void open_memory();
+
+	/**
+	 * \brief returns the content written since open_memory()
+	 * \details Call close() before, so that all encoded data is included.
+	 */
+	std::string memory_content() const;
+
 	/**
 	 * \brief gets the current set format
 	 */
@@ -154,6 +168,14 @@ private:
 	 * \brief File stream to write everything to
 	 */
 	std::fstream m_fStream;
+	/**
+	 * \brief Memory stream used instead of m_fStream after open_memory()
+	 */
+	std::stringstream m_memStream;
+	/**
+	 * \brief the stream everything is written to (m_fStream or m_memStream)
+	 */
+	std::ostream* m_pOut;
 	/**
 	 * \brief Current write format (\c base64 or \c normal)
 	 */
@@ -36,13 +36,15 @@ namespace ug
 {
 
 BinaryBuffer::BinaryBuffer() :
-	m_readPos(0), m_writePos(0)
+	m_readPos(0), m_writePos(0), m_memAccount(MEM_BINARY_BUFFER)
 {
 }
 
 BinaryBuffer::BinaryBuffer(size_t bufSize) :
-	m_data(bufSize), m_readPos(0), m_writePos(0)
+	m_data(bufSize), m_readPos(0), m_writePos(0),
+	m_memAccount(MEM_BINARY_BUFFER)
 {
+	m_memAccount.update(m_data.size());
 }
 
 void BinaryBuffer::clear()
@@ -57,8 +59,10 @@ void BinaryBuffer::clear()
 
 void BinaryBuffer::reserve(size_t newSize)
 {
-	if(newSize > m_data.size())
+	if(newSize > m_data.size()){
 		m_data.resize(newSize);
+		m_memAccount.update(m_data.size());
+	}
 }
 
 void BinaryBuffer::set_read_pos(size_t pos)
@@ -35,6 +35,7 @@
 
 #include <vector>
 #include "common/types.h"
+#include "mem_accounting.h"
 
 namespace ug
 {
@@ -105,6 +106,7 @@ class BinaryBuffer
 		std::vector<char>	m_data;
 		size_t				m_readPos;
 		size_t				m_writePos;
+		MemAccount			m_memAccount;
 };
 
 // end group ugbase_common_io
@@ -82,6 +82,7 @@ inline void BinaryBuffer::write(const char* buf, size_t size)
 			m_data.resize(m_data.size() + size);
 		else
 			m_data.resize(m_data.size() * 2);
+		m_memAccount.update(m_data.size());
 	}
 
 //	copy the data
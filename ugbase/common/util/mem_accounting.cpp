@@ -0,0 +1,405 @@
+/*
+ * Copyright (c) 2017:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+
+#include "mem_accounting.h"
+#include "common/log.h"
+#include "common/error.h"
+#include "common/stopwatch.h"
+
+#ifdef UG_CXX11
+	#include <atomic>
+	#include <mutex>
+#endif
+
+#ifdef UG_PARALLEL
+	#include "pcl/pcl_base.h"
+	#include "pcl/pcl_process_communicator.h"
+#endif
+
+namespace ug{
+
+const char* MemCategoryName(int cat)
+{
+	switch(cat){
+		case MEM_MATRIX:		return "matrix";
+		case MEM_VECTOR:		return "vector";
+		case MEM_ATTACHMENT:	return "attachment";
+		case MEM_DOF_INDICES:	return "dof-indices";
+		case MEM_BINARY_BUFFER:	return "binary-buffer";
+		case MEM_OTHER:			return "other";
+		case NUM_MEM_CATEGORIES:return "total";
+		default:				return "unknown";
+	}
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+//	counters
+//	the entry at index NUM_MEM_CATEGORIES holds the sum over all categories.
+#ifdef UG_CXX11
+	typedef std::atomic<size_t>	counter_t;
+	typedef std::atomic<double>	timestamp_t;
+	typedef std::atomic<bool>	flag_t;
+	typedef std::mutex			mutex_t;
+	#define MEMACC_LOCK(m)	std::lock_guard<std::mutex> lock(m)
+#else
+	typedef size_t	counter_t;
+	typedef double	timestamp_t;
+	typedef bool	flag_t;
+	typedef int		mutex_t;
+	#define MEMACC_LOCK(m)
+#endif
+
+struct MemTimelineSample{
+	double	time;
+	int		cat;
+	size_t	live;
+};
+
+static counter_t	s_live[NUM_MEM_CATEGORIES + 1];
+static counter_t	s_peak[NUM_MEM_CATEGORIES + 1];
+static timestamp_t		s_peakTime[NUM_MEM_CATEGORIES + 1];
+
+static const double	s_startTime = get_clock_s();
+
+static flag_t		s_timelineEnabled(false);
+
+///	state of the timeline, guarded by its mutex
+/**	Memory may still be released by destructors of other static objects
+ * after main returned. The timeline is thus allocated once and deliberately
+ * never destroyed, so that RecordSample never accesses a destroyed object.*/
+struct MemTimeline{
+	MemTimeline() : minDelta(1 << 20)
+	{
+		for(int i = 0; i <= NUM_MEM_CATEGORIES; ++i)
+			lastSample[i] = 0;
+	}
+	size_t							minDelta;
+	size_t							lastSample[NUM_MEM_CATEGORIES + 1];
+	std::vector<MemTimelineSample>	samples;
+	mutex_t							mutex;
+};
+
+static MemTimeline& Timeline()
+{
+	static MemTimeline* timeline = new MemTimeline;
+	return *timeline;
+}
+
+static inline bool TimelineEnabled()
+{
+#ifdef UG_CXX11
+	return s_timelineEnabled.load(std::memory_order_relaxed);
+#else
+	return s_timelineEnabled;
+#endif
+}
+
+static inline size_t Load(const counter_t& c)
+{
+#ifdef UG_CXX11
+	return c.load(std::memory_order_relaxed);
+#else
+	return c;
+#endif
+}
+
+///	adds (or subtracts) bytes and returns the new value
+static inline size_t Add(counter_t& c, size_t bytes)
+{
+#ifdef UG_CXX11
+	return c.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+#else
+	return c += bytes;
+#endif
+}
+
+static inline size_t Sub(counter_t& c, size_t bytes)
+{
+#ifdef UG_CXX11
+	return c.fetch_sub(bytes, std::memory_order_relaxed) - bytes;
+#else
+	return c -= bytes;
+#endif
+}
+
+///	raises the peak of the given index to 'live' if necessary
+static inline void UpdatePeak(int i, size_t live)
+{
+#ifdef UG_CXX11
+	size_t peak = s_peak[i].load(std::memory_order_relaxed);
+	while(live > peak){
+		if(s_peak[i].compare_exchange_weak(peak, live, std::memory_order_relaxed)){
+			s_peakTime[i].store(get_clock_s() - s_startTime,
+								std::memory_order_relaxed);
+			break;
+		}
+	}
+#else
+	if(live > s_peak[i]){
+		s_peak[i] = live;
+		s_peakTime[i] = get_clock_s() - s_startTime;
+	}
+#endif
+}
+
+static void RecordSample(int i, size_t live)
+{
+	MemTimeline& tl = Timeline();
+	MEMACC_LOCK(tl.mutex);
+	if(!TimelineEnabled())
+		return;
+
+	size_t last = tl.lastSample[i];
+	size_t delta = (live > last) ? live - last : last - live;
+	if(delta < tl.minDelta)
+		return;
+
+	MemTimelineSample s;
+	s.time = get_clock_s() - s_startTime;
+	s.cat = i;
+	s.live = live;
+	tl.samples.push_back(s);
+	tl.lastSample[i] = live;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+//	MemAccounting
+void MemAccounting::
+allocated(MemCategory cat, size_t bytes)
+{
+	size_t live = Add(s_live[cat], bytes);
+	size_t total = Add(s_live[NUM_MEM_CATEGORIES], bytes);
+	UpdatePeak(cat, live);
+	UpdatePeak(NUM_MEM_CATEGORIES, total);
+
+	if(TimelineEnabled()){
+		RecordSample(cat, live);
+		RecordSample(NUM_MEM_CATEGORIES, total);
+	}
+}
+
+void MemAccounting::
+deallocated(MemCategory cat, size_t bytes)
+{
+	size_t live = Sub(s_live[cat], bytes);
+	size_t total = Sub(s_live[NUM_MEM_CATEGORIES], bytes);
+
+	if(TimelineEnabled()){
+		RecordSample(cat, live);
+		RecordSample(NUM_MEM_CATEGORIES, total);
+	}
+}
+
+size_t MemAccounting::
+live_bytes(MemCategory cat)
+{
+	return Load(s_live[cat]);
+}
+
+size_t MemAccounting::
+peak_bytes(MemCategory cat)
+{
+	return Load(s_peak[cat]);
+}
+
+double MemAccounting::
+peak_time(MemCategory cat)
+{
+#ifdef UG_CXX11
+	return s_peakTime[cat].load(std::memory_order_relaxed);
+#else
+	return s_peakTime[cat];
+#endif
+}
+
+size_t MemAccounting::
+total_live_bytes()
+{
+	return Load(s_live[NUM_MEM_CATEGORIES]);
+}
+
+size_t MemAccounting::
+total_peak_bytes()
+{
+	return Load(s_peak[NUM_MEM_CATEGORIES]);
+}
+
+void MemAccounting::
+reset_peaks()
+{
+	double t = get_clock_s() - s_startTime;
+	for(int i = 0; i <= NUM_MEM_CATEGORIES; ++i){
+	#ifdef UG_CXX11
+		s_peak[i].store(Load(s_live[i]), std::memory_order_relaxed);
+		s_peakTime[i].store(t, std::memory_order_relaxed);
+	#else
+		s_peak[i] = s_live[i];
+		s_peakTime[i] = t;
+	#endif
+	}
+}
+
+void MemAccounting::
+enable_timeline(bool enable, size_t minDeltaBytes)
+{
+	MemTimeline& tl = Timeline();
+	MEMACC_LOCK(tl.mutex);
+	tl.samples.clear();
+	tl.minDelta = minDeltaBytes;
+	for(int i = 0; i <= NUM_MEM_CATEGORIES; ++i)
+		tl.lastSample[i] = 0;
+	s_timelineEnabled = enable;
+}
+
+void MemAccounting::
+write_timeline(const char* filename)
+{
+	std::string name(filename);
+#ifdef UG_PARALLEL
+	{
+		std::stringstream ss;
+		ss << "_p" << pcl::ProcRank();
+		size_t dotPos = name.find_last_of('.');
+		if(dotPos == std::string::npos || name.find('/', dotPos) != std::string::npos)
+			name.append(ss.str());
+		else
+			name.insert(dotPos, ss.str());
+	}
+#endif
+
+	std::ofstream out(name.c_str());
+	UG_COND_THROW(!out, "MemAccounting::write_timeline: Couldn't open file '"
+				  << name << "' for writing.");
+
+	MemTimeline& tl = Timeline();
+	MEMACC_LOCK(tl.mutex);
+	out << "time,category,live_bytes\n";
+	for(size_t i = 0; i < tl.samples.size(); ++i){
+		const MemTimelineSample& s = tl.samples[i];
+		out << s.time << "," << MemCategoryName(s.cat) << "," << s.live << "\n";
+	}
+}
+
+static inline double ToMB(double bytes)
+{
+	return bytes / (1024. * 1024.);
+}
+
+std::string MemAccounting::
+report()
+{
+	const int numEntries = NUM_MEM_CATEGORIES + 1;
+
+	std::stringstream ss;
+	ss << std::fixed << std::setprecision(2);
+
+#ifndef UG_MEM_ACCOUNTING
+	ss << "Memory accounting is disabled (configure with -DMEM_ACCOUNTING=ON).\n";
+	return ss.str();
+#endif
+
+	ss << "Memory accounting (local process, MB):\n"
+	   << std::setw(16) << std::left << "category" << std::right
+	   << std::setw(12) << "live" << std::setw(12) << "peak"
+	   << std::setw(14) << "peak at [s]" << "\n";
+
+	for(int i = 0; i < numEntries; ++i){
+		MemCategory cat = static_cast<MemCategory>(i);
+		ss << std::setw(16) << std::left << MemCategoryName(i) << std::right
+		   << std::setw(12) << ToMB(Load(s_live[i]))
+		   << std::setw(12) << ToMB(Load(s_peak[i]))
+		   << std::setw(14) << peak_time(cat) << "\n";
+	}
+
+#ifdef UG_PARALLEL
+	if(pcl::NumProcs() > 1){
+		std::vector<double> loc(2 * numEntries);
+		for(int i = 0; i < numEntries; ++i){
+			loc[2*i] = (double)Load(s_live[i]);
+			loc[2*i + 1] = (double)Load(s_peak[i]);
+		}
+
+		pcl::ProcessCommunicator pc;
+		const int numProcs = pc.size();
+		std::vector<double> glob;
+		if(pc.get_local_proc_id() == 0)
+			glob.resize(loc.size() * numProcs);
+
+		pc.gather(&loc.front(), (int)loc.size(), PCL_DT_DOUBLE,
+				  glob.empty() ? NULL : &glob.front(), (int)loc.size(),
+				  PCL_DT_DOUBLE, 0);
+
+		if(pc.get_local_proc_id() == 0){
+			ss << "Memory accounting (all " << numProcs << " processes, MB):\n"
+			   << std::setw(16) << std::left << "category" << std::right
+			   << std::setw(12) << "sum live" << std::setw(12) << "sum peak"
+			   << std::setw(12) << "max peak" << std::setw(8) << "rank" << "\n";
+
+			for(int i = 0; i < numEntries; ++i){
+				double sumLive = 0, sumPeak = 0, maxPeak = 0;
+				int maxRank = 0;
+				for(int p = 0; p < numProcs; ++p){
+					const double* v = &glob[p * loc.size() + 2*i];
+					sumLive += v[0];
+					sumPeak += v[1];
+					if(v[1] > maxPeak){
+						maxPeak = v[1];
+						maxRank = pc.get_proc_id(p);
+					}
+				}
+				ss << std::setw(16) << std::left << MemCategoryName(i) << std::right
+				   << std::setw(12) << ToMB(sumLive)
+				   << std::setw(12) << ToMB(sumPeak)
+				   << std::setw(12) << ToMB(maxPeak)
+				   << std::setw(8) << maxRank << "\n";
+			}
+		}
+	}
+#endif
+
+	return ss.str();
+}
+
+void MemAccounting::
+print_report()
+{
+	UG_LOG(report());
+}
+
+}//	end of namespace
@@ -0,0 +1,193 @@
+/*
+ * Copyright (c) 2017:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+
+#ifndef __H__UG__COMMON__UTIL__MEM_ACCOUNTING__
+#define __H__UG__COMMON__UTIL__MEM_ACCOUNTING__
+
+#include <cstddef>
+#include <string>
+
+namespace ug{
+
+/// \addtogroup ugbase_common_util
+/// \{
+
+///	Categories in which memory is tracked by MemAccounting
+enum MemCategory{
+	MEM_MATRIX = 0,		///< entries and column indices of sparse matrices
+	MEM_VECTOR,			///< entries of algebra vectors
+	MEM_ATTACHMENT,		///< data attached to grid elements
+	MEM_DOF_INDICES,	///< index attachments of dof distributions
+	MEM_BINARY_BUFFER,	///< serialization and communication buffers
+	MEM_OTHER,			///< everything else which registers itself
+	NUM_MEM_CATEGORIES
+};
+
+///	returns a printable name for the given category
+const char* MemCategoryName(int cat);
+
+
+///	Process-wide accounting of live and peak memory per MemCategory
+/**	Containers which own large amounts of memory report their capacity
+ * through a MemAccount member. MemAccounting sums those reports per
+ * category, keeps track of the peak of each category (and of the sum over
+ * all categories) together with the time at which the peak was reached and
+ * may optionally record a timeline of the live memory.
+ *
+ * The counters are updated atomically (if UG_CXX11 is defined), so that
+ * accounts may be changed from several threads. Reporting is only
+ * supported from the main thread.
+ *
+ * If ug is configured without UG_MEM_ACCOUNTING, all updates are no-ops
+ * and the reports are empty.
+ */
+class MemAccounting
+{
+	public:
+	///	registers 'bytes' newly allocated bytes in the given category
+		static void allocated(MemCategory cat, size_t bytes);
+
+	///	registers 'bytes' released bytes in the given category
+		static void deallocated(MemCategory cat, size_t bytes);
+
+	///	currently allocated bytes in the given category
+		static size_t live_bytes(MemCategory cat);
+
+	///	maximum of live_bytes(cat) since program start or the last reset_peaks
+		static size_t peak_bytes(MemCategory cat);
+
+	///	time in seconds since program start at which peak_bytes(cat) was reached
+		static double peak_time(MemCategory cat);
+
+	///	sum of live_bytes over all categories
+		static size_t total_live_bytes();
+
+	///	maximum of the summed live bytes over all categories
+	/**	Note that this is generally smaller than the sum of the peaks of
+	 * the individual categories.*/
+		static size_t total_peak_bytes();
+
+	///	sets all peaks to the current live values
+		static void reset_peaks();
+
+	///	enables or disables recording of a timeline
+	/**	If enabled, a sample (time, category, live bytes) is recorded each time
+	 * the live memory of a category has changed by at least minDeltaBytes
+	 * since the last sample of that category. Enabling the timeline clears
+	 * previously recorded samples.*/
+		static void enable_timeline(bool enable, size_t minDeltaBytes = 1 << 20);
+
+	///	writes the recorded timeline as comma separated values
+	/**	In parallel builds the process rank is appended to the filename
+	 * (e.g. 'mem.csv' is written to 'mem_p3.csv' on process 3).*/
+		static void write_timeline(const char* filename);
+
+	///	returns a table of live and peak memory per category
+	/**	In parallel builds this method is collective. The per-process values
+	 * are then gathered on process 0 and the returned string additionally
+	 * contains the sum over all processes and the maximum over all processes
+	 * together with the rank on which it occurs.*/
+		static std::string report();
+
+	///	logs the result of report() through UG_LOG. Collective in parallel builds.
+		static void print_report();
+};
+
+
+///	Accounts the memory owned by one object in MemAccounting
+/**	A container adds a MemAccount member and calls update(bytes) whenever
+ * the size of its owned memory changes. The registered bytes are released
+ * from the accounting when the MemAccount is destroyed.
+ *
+ * Copying a MemAccount registers the same amount of bytes a second time,
+ * since the owner of the copy is assumed to have copied the data, too. An
+ * assignment keeps the category of the assigned-to account.
+ */
+class MemAccount
+{
+	public:
+		explicit MemAccount(MemCategory cat = MEM_OTHER) :
+			m_cat(cat), m_bytes(0)
+		{}
+
+		MemAccount(const MemAccount& ma) :
+			m_cat(ma.m_cat), m_bytes(0)
+		{
+			update(ma.m_bytes);
+		}
+
+		~MemAccount()
+		{
+			update(0);
+		}
+
+		MemAccount& operator=(const MemAccount& ma)
+		{
+			update(ma.m_bytes);
+			return *this;
+		}
+
+	///	sets the number of bytes currently owned by the associated object
+		inline void update(size_t bytes)
+		{
+		#ifdef UG_MEM_ACCOUNTING
+			if(bytes > m_bytes)
+				MemAccounting::allocated(m_cat, bytes - m_bytes);
+			else if(bytes < m_bytes)
+				MemAccounting::deallocated(m_cat, m_bytes - bytes);
+		#endif
+			m_bytes = bytes;
+		}
+
+	///	moves the registered bytes to a different category
+		void set_category(MemCategory cat)
+		{
+			if(cat == m_cat) return;
+			size_t bytes = m_bytes;
+			update(0);
+			m_cat = cat;
+			update(bytes);
+		}
+
+		MemCategory category() const	{return m_cat;}
+		size_t bytes() const			{return m_bytes;}
+
+	private:
+		MemCategory	m_cat;
+		size_t		m_bytes;
+};
+
+/// \}
+
+}//	end of namespace
+
+#endif	//__H__UG__COMMON__UTIL__MEM_ACCOUNTING__
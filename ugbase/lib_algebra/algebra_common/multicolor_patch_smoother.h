@@ -0,0 +1,348 @@
+/*
+ * Copyright (c) 2017:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+
+#ifndef __H__UG__LIB_ALGEBRA__ALGEBRA_COMMON__MULTICOLOR_PATCH_SMOOTHER__
+#define __H__UG__LIB_ALGEBRA__ALGEBRA_COMMON__MULTICOLOR_PATCH_SMOOTHER__
+
+#include <vector>
+#include <algorithm>
+#include "common/error.h"
+#include "lib_algebra/small_algebra/small_matrix/batched_lu.h"
+
+#ifdef UG_OPENMP
+	#include <omp.h>
+#endif
+
+namespace ug{
+
+/// \addtogroup lib_algebra
+///	@{
+
+///	Greedy coloring of index patches for multicolor block Gauss-Seidel smoothers
+/**
+ * A patch is a set of algebraic indices whose unknowns are relaxed together by
+ * solving the local (dense) system. Two patches receive different colors if
+ * relaxing one of them reads or writes an unknown written by the other, i.e.
+ * if they share an index or are coupled by a matrix entry. All patches of one
+ * color can thus be relaxed independently of each other, in any order and
+ * concurrently.
+ *
+ * Inside a color the patches are ordered by size and grouped into chunks of
+ * equally sized patches (at most max_chunk_size each), so that the local
+ * systems of a chunk can be solved by one batched LU decomposition.
+ */
+class MultiColorPatches
+{
+	public:
+		MultiColorPatches() : m_maxChunkSize(16) {clear();}
+
+	///	removes all patches and colors
+		void clear()
+		{
+			m_vPatchOffset.assign(1, 0);
+			m_vPatchInd.clear();
+			m_vOrder.clear();
+			m_vChunkOffset.clear();
+			m_vColorChunkOffset.clear();
+		}
+
+	///	sets the maximal number of patches solved in one batch
+		void set_max_chunk_size(size_t maxChunkSize)
+		{
+			UG_COND_THROW(maxChunkSize == 0, "MultiColorPatches: chunk size must be positive.");
+			m_maxChunkSize = maxChunkSize;
+		}
+
+	///	adds a patch. Indices must be unique within a patch.
+		void add_patch(const std::vector<size_t>& vInd)
+		{
+			m_vPatchInd.insert(m_vPatchInd.end(), vInd.begin(), vInd.end());
+			m_vPatchOffset.push_back(m_vPatchInd.size());
+		}
+
+	///	number of patches
+		size_t num_patches() const {return m_vPatchOffset.size() - 1;}
+
+	///	size of a patch
+		size_t patch_size(size_t p) const {return m_vPatchOffset[p+1] - m_vPatchOffset[p];}
+
+	///	indices of a patch
+		const size_t* patch_indices(size_t p) const {return &m_vPatchInd[0] + m_vPatchOffset[p];}
+
+	///	number of colors (valid after color())
+		size_t num_colors() const
+		{
+			return m_vColorChunkOffset.empty() ? 0 : m_vColorChunkOffset.size() - 1;
+		}
+
+	///	chunks of a color are [color_chunk_begin(c), color_chunk_end(c))
+	///	\{
+		size_t color_chunk_begin(size_t c) const {return m_vColorChunkOffset[c];}
+		size_t color_chunk_end(size_t c) const {return m_vColorChunkOffset[c+1];}
+	///	\}
+
+	///	patches of a chunk are patch(k) for k in [chunk_begin(ch), chunk_end(ch))
+	///	\{
+		size_t chunk_begin(size_t ch) const {return m_vChunkOffset[ch];}
+		size_t chunk_end(size_t ch) const {return m_vChunkOffset[ch+1];}
+		size_t patch(size_t k) const {return m_vOrder[k];}
+	///	\}
+
+	///	computes the coloring of the patches w.r.t. the couplings in A
+		template <typename TMatrix>
+		void color(const TMatrix& A)
+		{
+			const size_t numPatch = num_patches();
+			const size_t numRow = A.num_rows();
+
+		//	index -> patches containing the index (CSR)
+			std::vector<size_t> vIndOffset(numRow + 1, 0);
+			for(size_t i = 0; i < m_vPatchInd.size(); ++i){
+				UG_COND_THROW(m_vPatchInd[i] >= numRow,
+				              "MultiColorPatches: patch index exceeds matrix size.");
+				++vIndOffset[m_vPatchInd[i] + 1];
+			}
+			for(size_t i = 0; i < numRow; ++i)
+				vIndOffset[i+1] += vIndOffset[i];
+
+			std::vector<size_t> vIndPatch(vIndOffset.back());
+			std::vector<size_t> vFill(vIndOffset.begin(), vIndOffset.end() - 1);
+			for(size_t p = 0; p < numPatch; ++p)
+				for(size_t k = m_vPatchOffset[p]; k < m_vPatchOffset[p+1]; ++k)
+					vIndPatch[vFill[m_vPatchInd[k]]++] = p;
+
+		//	adjacency of patches: p and q are adjacent if a row of p has a
+		//	column in q. Stored in both directions for unsymmetric patterns.
+			std::vector<std::vector<size_t> > vAdj(numPatch);
+			for(size_t p = 0; p < numPatch; ++p)
+			{
+				for(size_t k = m_vPatchOffset[p]; k < m_vPatchOffset[p+1]; ++k)
+				{
+					const size_t row = m_vPatchInd[k];
+					for(typename TMatrix::const_row_iterator it = A.begin_row(row);
+						it != A.end_row(row); ++it)
+					{
+						const size_t col = it.index();
+						for(size_t l = vIndOffset[col]; l < vIndOffset[col+1]; ++l){
+							const size_t q = vIndPatch[l];
+							if(q == p) continue;
+							vAdj[p].push_back(q);
+							vAdj[q].push_back(p);
+						}
+					}
+				}
+			}
+
+		//	greedy coloring
+			std::vector<int> vColor(numPatch, -1);
+			std::vector<size_t> vColorMark;
+			int numColor = 0;
+			for(size_t p = 0; p < numPatch; ++p)
+			{
+				std::vector<size_t>& adj = vAdj[p];
+				std::sort(adj.begin(), adj.end());
+				adj.erase(std::unique(adj.begin(), adj.end()), adj.end());
+
+				for(size_t k = 0; k < adj.size(); ++k)
+					if(vColor[adj[k]] >= 0)
+						vColorMark[vColor[adj[k]]] = p + 1;
+
+				int c = 0;
+				while(c < numColor && vColorMark[c] == p + 1) ++c;
+				if(c == numColor){
+					++numColor;
+					vColorMark.push_back(0);
+				}
+				vColor[p] = c;
+			}
+
+		//	order by color, then by patch size
+			m_vOrder.resize(numPatch);
+			for(size_t p = 0; p < numPatch; ++p) m_vOrder[p] = p;
+			std::sort(m_vOrder.begin(), m_vOrder.end(), PatchOrder(*this, vColor));
+
+		//	split into chunks of equally sized patches
+			m_vChunkOffset.clear();
+			m_vColorChunkOffset.assign(1, 0);
+			int curColor = 0;
+			for(size_t k = 0; k < numPatch; ++k)
+			{
+				const size_t p = m_vOrder[k];
+				while(vColor[p] > curColor){
+					m_vColorChunkOffset.push_back(m_vChunkOffset.size());
+					++curColor;
+				}
+
+				if(k == 0 || vColor[p] != vColor[m_vOrder[k-1]]
+				   || patch_size(p) != patch_size(m_vOrder[k-1])
+				   || k - m_vChunkOffset.back() >= m_maxChunkSize)
+					m_vChunkOffset.push_back(k);
+			}
+			while((int)m_vColorChunkOffset.size() <= numColor)
+				m_vColorChunkOffset.push_back(m_vChunkOffset.size());
+			m_vChunkOffset.push_back(numPatch);
+		}
+
+	protected:
+		struct PatchOrder
+		{
+			PatchOrder(const MultiColorPatches& mcp, const std::vector<int>& vColor)
+				: m_mcp(mcp), m_vColor(vColor) {}
+			bool operator()(size_t p, size_t q) const
+			{
+				if(m_vColor[p] != m_vColor[q]) return m_vColor[p] < m_vColor[q];
+				if(m_mcp.patch_size(p) != m_mcp.patch_size(q))
+					return m_mcp.patch_size(p) < m_mcp.patch_size(q);
+				return p < q;
+			}
+			const MultiColorPatches& m_mcp;
+			const std::vector<int>& m_vColor;
+		};
+
+	protected:
+		std::vector<size_t> m_vPatchOffset;
+		std::vector<size_t> m_vPatchInd;
+
+		std::vector<size_t> m_vOrder;
+		std::vector<size_t> m_vChunkOffset;
+		std::vector<size_t> m_vColorChunkOffset;
+
+		size_t m_maxChunkSize;
+};
+
+
+///	solves the local systems of a chunk of equally sized patches and updates c
+/**	\return false if a local matrix is singular */
+template <typename TMatrix, typename TVector>
+bool MultiColorPatchChunkSolve(const TMatrix& A, TVector& c, const TVector& d,
+                               number relax, const MultiColorPatches& mcp, size_t chunk,
+                               std::vector<number>& vMat, std::vector<number>& vRhs)
+{
+	typedef typename TMatrix::const_row_iterator const_row_iterator;
+	typedef typename TVector::value_type vector_block_type;
+
+	const size_t kBegin = mcp.chunk_begin(chunk);
+	const size_t batch = mcp.chunk_end(chunk) - kBegin;
+	const size_t numInd = mcp.patch_size(mcp.patch(kBegin));
+	if(numInd == 0) return true;
+
+	const size_t bs = GetSize(d[mcp.patch_indices(mcp.patch(kBegin))[0]]);
+	const size_t n = numInd * bs;
+
+	vMat.assign(n * n * batch, 0.0);
+	vRhs.resize(n * batch);
+
+	for(size_t b = 0; b < batch; ++b)
+	{
+		const size_t* vInd = mcp.patch_indices(mcp.patch(kBegin + b));
+
+	//	local matrix
+		for(size_t j = 0; j < numInd; ++j)
+		{
+			for(size_t k = 0; k < numInd; ++k)
+			{
+				bool bFound;
+				const_row_iterator it = A.get_connection(vInd[j], vInd[k], bFound);
+				if(!bFound) continue;
+				for(size_t r = 0; r < bs; ++r)
+					for(size_t s = 0; s < bs; ++s)
+						vMat[((j*bs+r)*n + k*bs+s)*batch + b] = BlockRef(it.value(), r, s);
+			}
+		}
+
+	//	local defect s[j] := d[j] - sum_k A(j,k)*c[k] over the whole row
+		for(size_t j = 0; j < numInd; ++j)
+		{
+			vector_block_type sj = d[vInd[j]];
+			for(const_row_iterator it = A.begin_row(vInd[j]); it != A.end_row(vInd[j]); ++it)
+				MatMultAdd(sj, 1.0, sj, -1.0, it.value(), c[it.index()]);
+
+			for(size_t r = 0; r < bs; ++r)
+				vRhs[(j*bs+r)*batch + b] = BlockRef(sj, r);
+		}
+	}
+
+	if(!BatchedLUSolve(n, batch, &vMat[0], &vRhs[0]))
+		return false;
+
+	for(size_t b = 0; b < batch; ++b)
+	{
+		const size_t* vInd = mcp.patch_indices(mcp.patch(kBegin + b));
+		for(size_t j = 0; j < numInd; ++j)
+			for(size_t r = 0; r < bs; ++r)
+				BlockRef(c[vInd[j]], r) += relax * vRhs[(j*bs+r)*batch + b];
+	}
+	return true;
+}
+
+
+///	performs one multicolor block Gauss-Seidel step on the given patches
+/**
+ * Processes the colors one after another. The chunks of a color are
+ * independent and are distributed among threads if OpenMP is enabled.
+ * Unlike the lexicographic patch smoothers, the correction is NOT reset to
+ * zero here; callers have to do that if needed.
+ */
+template <typename TMatrix, typename TVector>
+void MultiColorPatchStep(const TMatrix& A, TVector& c, const TVector& d,
+                         number relax, const MultiColorPatches& mcp)
+{
+	bool bSuccess = true;
+	for(size_t col = 0; col < mcp.num_colors(); ++col)
+	{
+		const int chBegin = (int)mcp.color_chunk_begin(col);
+		const int chEnd = (int)mcp.color_chunk_end(col);
+
+#ifdef UG_OPENMP
+		#pragma omp parallel
+#endif
+		{
+			std::vector<number> vMat, vRhs;
+#ifdef UG_OPENMP
+			#pragma omp for schedule(dynamic) reduction(&&:bSuccess)
+#endif
+			for(int ch = chBegin; ch < chEnd; ++ch)
+				bSuccess = MultiColorPatchChunkSolve(A, c, d, relax, mcp, (size_t)ch, vMat, vRhs)
+							&& bSuccess;
+		}
+
+	//	exceptions must not leave the parallel region, thus thrown here
+		if(!bSuccess)
+			UG_THROW("MultiColorPatchStep: local patch matrix of color "<<col<<" is singular.");
+	}
+}
+
+/// @}
+
+} // end namespace ug
+
+#endif /* __H__UG__LIB_ALGEBRA__ALGEBRA_COMMON__MULTICOLOR_PATCH_SMOOTHER__ */
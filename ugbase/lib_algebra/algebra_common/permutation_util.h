@@ -37,6 +37,7 @@
 #include "common/profiler/profiler.h"
 #include "common/error.h"
 #include "common/cuthill_mckee.h"
+#include "common/nested_dissection.h"
 //#include "lib_disc/dof_manager/ordering/cuthill_mckee.h"
 #include <vector>
 
@@ -109,6 +110,25 @@ void GetCuthillMcKeeOrder(const TSparseMatrix &mat, std::vector<size_t> &newInde
 
 	ComputeCuthillMcKeeOrder(newIndex, neighbors, true, false);
 }
+
+/**
+ * @param mat 			A sparse matrix
+ * @param newIndex		the nested dissection ordered new indices (of the matrix rows,
+ * 						i.e. blocks are kept together)
+ * @param minSize		size of subgraphs which are not dissected any further
+ */
+template<typename TSparseMatrix>
+void GetNestedDissectionOrder(const TSparseMatrix &mat, std::vector<size_t> &newIndex, size_t minSize = 64)
+{
+	std::vector<std::vector<size_t> > neighbors;
+	neighbors.resize(mat.num_rows());
+
+	for(size_t i=0; i<mat.num_rows(); i++)
+		for(typename TSparseMatrix::const_row_iterator i_it = mat.begin_row(i); i_it != mat.end_row(i); ++i_it)
+			neighbors[i].push_back(i_it.index());
+
+	ComputeNestedDissectionOrder(newIndex, neighbors, minSize);
+}
 /// @}
 } // end namespace ug
 
@@ -39,6 +39,7 @@
 #include <iostream>
 #include <algorithm>
 #include "common/util/ostream_util.h"
+#include "common/util/mem_accounting.h"
 
 #include "../algebra_common/connection.h"
 #include "../algebra_common/matrixrow.h"
@@ -610,6 +611,8 @@ private:
 	}
     void assureValuesSize(size_t s);
     size_t get_nnz() const { return nnz; }
+	///	reports the current capacity of the row and entry arrays to MemAccounting
+    void update_mem_account();
 
 private:
 	// disallowed operations (not defined):
@@ -644,6 +647,8 @@ protected:
     int m_numCols;
     mutable int iIterators;
 
+    MemAccount m_memAccount;
+
 #ifdef CHECK_ROW_ITERATORS
 public:
     mutable std::vector<int> nrOfRowIterators;
@@ -49,7 +49,8 @@
 namespace ug{
 
 template<typename T>
-SparseMatrix<T>::SparseMatrix()
+SparseMatrix<T>::SparseMatrix() :
+	m_memAccount(MEM_MATRIX)
 {
 	PROFILE_SPMATRIX(SparseMatrix_constructor);
 	bNeedsValues = true;
@@ -59,6 +60,7 @@ SparseMatrix<T>::SparseMatrix()
 	maxValues = 0;
 	cols.resize(32);
 	if(bNeedsValues) values.resize(32);
+	update_mem_account();
 }
 
 template<typename T>
@@ -77,6 +79,7 @@ void SparseMatrix<T>::clear_and_free()
 #ifdef CHECK_ROW_ITERATORS
 	std::vector<int>().swap(nrOfRowIterators);
 #endif
+	update_mem_account();
 }
 
 
@@ -99,6 +102,7 @@ void SparseMatrix<T>::resize_and_clear(size_t newRows, size_t newCols)
 	nrOfRowIterators.clear();
 	nrOfRowIterators.resize(newRows, 0);
 #endif
+	update_mem_account();
 }
 
 template<typename T>
@@ -128,6 +132,7 @@ void SparseMatrix<T>::resize_and_keep_values(size_t newRows, size_t newCols)
 		copyToNewSize(get_nnz_max_cols(newCols), newCols);
 
 	m_numCols = newCols;
+	update_mem_account();
 }
 
 
@@ -630,6 +635,7 @@ void SparseMatrix<T>::copyToNewSize(size_t newSize, size_t maxCol)
 		cols.resize(newSize);
 		cols.resize(cols.capacity());
 		if(bNeedsValues) { values.resize(newSize); values.resize(cols.size()); }
+		update_mem_account();
 		return;
 	}
 
@@ -661,6 +667,7 @@ void SparseMatrix<T>::copyToNewSize(size_t newSize, size_t maxCol)
 	maxValues = j;
 	if(bNeedsValues) values.swap(v);
 	cols.swap(c);
+	update_mem_account();
 }
 
 template<typename T>
@@ -680,6 +687,15 @@ void SparseMatrix<T>::assureValuesSize(size_t s)
 
 }
 
+template<typename T>
+void SparseMatrix<T>::update_mem_account()
+{
+	m_memAccount.update(
+		(rowStart.capacity() + rowEnd.capacity() + rowMax.capacity()
+		 + cols.capacity()) * sizeof(int)
+		+ values.capacity() * sizeof(value_type));
+}
+
 template<typename T>
 int SparseMatrix<T>::get_nnz_max_cols(size_t maxCols)
 {
@@ -38,6 +38,7 @@
 #include "../common/template_expressions.h"
 #include "../common/operations.h"
 #include "common/util/smart_pointer.h"
+#include "common/util/mem_accounting.h"
 #include <vector>
 //#include "../vector_interface/ivector.h"
 
@@ -69,7 +70,7 @@ public:
 	//! virtual destructor
 	virtual ~Vector();
 
-	Vector(const vector_type & v)
+	Vector(const vector_type & v) : m_memAccount(MEM_VECTOR)
 	{
 		m_capacity = 0;
 		m_size = 0; values = NULL;
@@ -225,6 +226,7 @@ private:
 	size_t m_size;			///< size of the vector (vector is from 0..size-1)
 	size_t m_capacity;		///< size of the vector (vector is from 0..size-1)
 	value_type *values;		///< array where the values are stored, size m_size
+	MemAccount m_memAccount;	///< reports m_capacity to MemAccounting
 
 	//mutable vector_mode dist_mode;
 };
@@ -124,13 +124,15 @@ inline void Vector<value_type>::operator -= (const vector_type &v)
 
 
 template<typename value_type>
-Vector<value_type>::Vector () : m_size(0), m_capacity(0), values(NULL)
+Vector<value_type>::Vector () : m_size(0), m_capacity(0), values(NULL),
+	m_memAccount(MEM_VECTOR)
 {
 	FORCE_CREATION { p(); } // force creation of this rountines for gdb.
 }
 
 template<typename value_type>
-Vector<value_type>::Vector(size_t size) : m_size(0), m_capacity(0), values(NULL)
+Vector<value_type>::Vector(size_t size) : m_size(0), m_capacity(0), values(NULL),
+	m_memAccount(MEM_VECTOR)
 {
 	FORCE_CREATION { p(); } // force creation of this rountines for gdb.
 	create(size);
@@ -151,6 +153,7 @@ void Vector<value_type>::destroy()
 		values = NULL;
 	}
 	m_size = 0;
+	m_memAccount.update(0);
 }
 
 
@@ -162,6 +165,7 @@ void Vector<value_type>::create(size_t size)
 	m_size = size;
 	values = new value_type[size];
 	m_capacity = size;
+	m_memAccount.update(m_capacity * sizeof(value_type));
 }
 
 
@@ -205,6 +209,7 @@ void Vector<value_type>::reserve_exactly(size_t newCapacity, bool bCopyValues)
 	if(values) delete [] values;
 	values = new_values;
 	m_capacity = newCapacity;
+	m_memAccount.update(m_capacity * sizeof(value_type));
 }
 
 
@@ -243,6 +248,7 @@ void Vector<value_type>::create(const Vector &v)
 	m_size = v.m_size;
 	values = new value_type[m_size];
 	m_capacity = m_size;
+	m_memAccount.update(m_capacity * sizeof(value_type));
 
 	// we cannot use memcpy here bcs of variable blocks.
 	for(size_t i=0; i<m_size; i++)
@@ -90,6 +90,26 @@ struct CPUAlgebra
 	}
 };
 
+///	scalar algebra in single precision
+/**	Used internally for mixed precision preconditioners (see
+ * MixedPrecisionPreconditioner). It is not registered as an algebra.*/
+struct CPUFloatAlgebra
+{
+#ifdef UG_PARALLEL
+		typedef ParallelMatrix<SparseMatrix<float> > matrix_type;
+		typedef ParallelVector<Vector<float> > vector_type;
+#else
+		typedef SparseMatrix<float> matrix_type;
+		typedef Vector<float> vector_type;
+#endif
+
+	static const int blockSize = 1;
+	static AlgebraType get_type()
+	{
+		return AlgebraType(AlgebraType::CPU, 1);
+	}
+};
+
 // end group cpu_algebra
 /// \}
 
@@ -51,6 +51,9 @@
 #include "common/stopwatch.h"
 #include "lib_disc/function_spaces/approximation_space.h"
 #include "lib_disc/common/function_group.h"
+#ifdef UG_PARALLEL
+	#include "pcl/pcl_process_communicator.h"
+#endif
 
 namespace ug{
 
@@ -190,6 +193,20 @@ class StdConvCheck : public IConvergenceCheck<TVector>
 		void set_reduction(number relReduction) {m_relReduction = relReduction;}
 		void set_supress_unsuccessful(bool bsupress){ m_supress_unsuccessful = bsupress; }
 
+	///	limits the wall clock time of an iteration (in seconds, 0 = unlimited)
+	/**
+	 * The time is measured from the call to start_defect. In parallel the
+	 * elapsed time is reduced in each step over the process communicator of
+	 * the defect passed to start, so that all processes of the iteration end
+	 * it in the same step. If the iteration is started by start_defect only,
+	 * each process checks its own time and the caller has to make sure that
+	 * the processes take the same decision.
+	 */
+		void set_time_limit(number seconds) {m_timeLimit = seconds;}
+
+	///	returns whether the last iteration was ended by the time limit
+		bool time_limit_reached() const {return m_bTimeLimitReached;}
+
 		void start_defect(number initialDefect);
 
 		void start(const TVector& d);
@@ -205,7 +222,9 @@ class StdConvCheck : public IConvergenceCheck<TVector>
 		virtual std::string config_string() const
 		{
 			std::stringstream ss;
-			ss << "StdConvCheck( max steps = " << m_maxSteps << ", min defect = " << m_minDefect << ", relative reduction = " << m_relReduction << ")";
+			ss << "StdConvCheck( max steps = " << m_maxSteps << ", min defect = " << m_minDefect << ", relative reduction = " << m_relReduction;
+			if(m_timeLimit > 0) ss << ", time limit = " << m_timeLimit << "s";
+			ss << ")";
 			return ss.str();
 		}
 
@@ -237,6 +256,8 @@ class StdConvCheck : public IConvergenceCheck<TVector>
 
 		bool is_valid_number(number value);
 
+		bool time_limit_exceeded();
+
 	protected:
 		// start defect
 		number m_initialDefect;
@@ -281,6 +302,20 @@ class StdConvCheck : public IConvergenceCheck<TVector>
 		// return true in post method if max nr of iterations is reached
 		bool m_supress_unsuccessful;
 
+		// maximum wall clock time of the iteration in seconds (0 = unlimited)
+		number m_timeLimit;
+
+		// time at which the iteration has been started
+		double m_startTime;
+
+		// flag indicating that the iteration was ended by the time limit
+		bool m_bTimeLimitReached;
+
+#ifdef UG_PARALLEL
+		// processes over which the elapsed time is reduced
+		pcl::ProcessCommunicator m_timeComm;
+#endif
+
 	private:
 		std::vector<number> _defects;
 };
@@ -51,7 +51,8 @@ StdConvCheck()
  :	 m_initialDefect(0.0), m_currentDefect(0.0), m_lastDefect(0.0), m_currentStep(0),
   	 m_ratesProduct(1), m_maxSteps(200), m_minDefect(10e-8), m_relReduction(10e-10),
 	 m_verbose(true), m_offset(0), m_symbol('%'), m_name("Iteration"), m_info(""),
-	 m_supress_unsuccessful(false)
+	 m_supress_unsuccessful(false), m_timeLimit(0), m_startTime(0),
+	 m_bTimeLimitReached(false)
 	 {};
 
 template <typename TVector>
@@ -60,7 +61,8 @@ StdConvCheck(int maxSteps, number minDefect, number relReduction)
  :	 m_initialDefect(0.0), m_currentDefect(0.0), m_lastDefect(0.0), m_currentStep(0),
   	 m_ratesProduct(1), m_maxSteps(maxSteps), m_minDefect(minDefect), m_relReduction(relReduction),
 	 m_verbose(true), m_offset(0), m_symbol('%'), m_name("Iteration"), m_info(""),
-	 m_supress_unsuccessful(false)
+	 m_supress_unsuccessful(false), m_timeLimit(0), m_startTime(0),
+	 m_bTimeLimitReached(false)
 	 {};
 
 template <typename TVector>
@@ -69,7 +71,8 @@ StdConvCheck(int maxSteps, number minDefect, number relReduction, bool verbose)
  :	 m_initialDefect(0.0), m_currentDefect(0.0), m_lastDefect(0.0), m_currentStep(0),
   	 m_ratesProduct(1), m_maxSteps(maxSteps), m_minDefect(minDefect), m_relReduction(relReduction),
 	 m_verbose(verbose), m_offset(0), m_symbol('%'), m_name("Iteration"), m_info(""),
-	 m_supress_unsuccessful(false)
+	 m_supress_unsuccessful(false), m_timeLimit(0), m_startTime(0),
+	 m_bTimeLimitReached(false)
 	 {};
 
 template <typename TVector>
@@ -78,7 +81,8 @@ StdConvCheck(int maxSteps, number minDefect, number relReduction, bool verbose,b
  :	 m_initialDefect(0.0), m_currentDefect(0.0), m_lastDefect(0.0), m_currentStep(0),
   	 m_ratesProduct(1), m_maxSteps(maxSteps), m_minDefect(minDefect), m_relReduction(relReduction),
 	 m_verbose(verbose), m_offset(0), m_symbol('%'), m_name("Iteration"), m_info(""),
-	 m_supress_unsuccessful(supressUnsuccessful)
+	 m_supress_unsuccessful(supressUnsuccessful), m_timeLimit(0), m_startTime(0),
+	 m_bTimeLimitReached(false)
 	 {};
 
 template <typename TVector>
@@ -89,6 +93,12 @@ void StdConvCheck<TVector>::start_defect(number initialDefect)
 	m_currentDefect = m_initialDefect;
 	m_currentStep = 0;
 	m_ratesProduct = 1;
+	m_startTime = get_clock_s();
+	m_bTimeLimitReached = false;
+#ifdef UG_PARALLEL
+//	without a vector the participating processes are unknown
+	m_timeComm = pcl::ProcessCommunicator(pcl::PCD_LOCAL);
+#endif
 
 	if(m_verbose)
 	{
@@ -134,6 +144,9 @@ template <typename TVector>
 void StdConvCheck<TVector>::start(const TVector& d)
 {
 	start_defect(d.norm());
+#ifdef UG_PARALLEL
+	m_timeComm = d.layouts()->proc_comm();
+#endif
 }
 
 template <typename TVector>
@@ -165,9 +178,26 @@ bool StdConvCheck<TVector>::iteration_ended()
 	if(step() >= m_maxSteps) return true;
 	if(defect() < m_minDefect) return true;
 	if(reduction() < m_relReduction) return true;
+	if(time_limit_exceeded()) return true;
 	return false;
 }
 
+template <typename TVector>
+bool StdConvCheck<TVector>::time_limit_exceeded()
+{
+	if(m_timeLimit <= 0) return false;
+
+	double elapsed = get_clock_s() - m_startTime;
+#ifdef UG_PARALLEL
+//	all processes of the iteration have to take the same decision
+	if(!m_timeComm.is_local() && !m_timeComm.empty())
+		elapsed = m_timeComm.allreduce(elapsed, PCL_RO_MAX);
+#endif
+
+	m_bTimeLimitReached = (elapsed >= m_timeLimit);
+	return m_bTimeLimitReached;
+}
+
 template <typename TVector>
 bool StdConvCheck<TVector>::post()
 {
@@ -211,6 +241,11 @@ bool StdConvCheck<TVector>::post()
 			}
 			if (m_supress_unsuccessful) return true;
 		}
+
+		if(m_bTimeLimitReached && m_verbose)
+		{
+			print_offset(); UG_LOG("Time limit of " << m_timeLimit << "s reached after " << step() << " steps.\n");
+		}
 	}
 
 	if(m_verbose)
@@ -86,9 +86,19 @@ class AgglomeratingBase : public TBase
 		typedef typename TAlgebra::matrix_type matrix_type;
 
 	public:
+	//	Constructor
+		AgglomeratingBase() : m_pMatrix(NULL), m_groupSize(0), m_bRoot(true), m_bEmpty(false) {}
+
 	// 	Destructor
 		virtual ~AgglomeratingBase() {};
 
+	///	sets the number of processes agglomerated onto one process (0 = all)
+	/**	With a group size k > 0, the matrix is only agglomerated on every k-th
+	 *	process and the agglomerated problem is solved in parallel by these
+	 *	processes. The agglomerated solver may itself be an agglomerating solver,
+	 *	which results in a hierarchical agglomeration (e.g. by a factor 8 per level).*/
+		void set_group_size(size_t groupSize) {m_groupSize = groupSize;}
+
 		bool i_am_root()
 		{
 			return m_bRoot;
@@ -106,17 +116,28 @@ class AgglomeratingBase : public TBase
 #ifdef UG_PARALLEL
 			m_bEmpty = A.layouts()->proc_comm().empty();
 			if(m_bEmpty) return true;
-			m_bRoot = pcl::ProcRank() == A.layouts()->proc_comm().get_proc_id(0);
 			PROFILE_FUNC();
 
 			m_spCollectedOp = make_sp(new MatrixOperator<matrix_type, vector_type>());
 			matrix_type &collectedA = m_spCollectedOp->get_matrix();
 
-			CollectMatrixOnOneProc(A, collectedA, agglomerationLayout.master(), agglomerationLayout.slave());
+			if(m_groupSize == 0 || m_groupSize >= A.layouts()->proc_comm().size())
+			{
+				m_bRoot = pcl::ProcRank() == A.layouts()->proc_comm().get_proc_id(0);
+				CollectMatrixOnOneProc(A, collectedA, agglomerationLayout.master(), agglomerationLayout.slave());
+				m_spLocalAlgebraLayouts = CreateLocalAlgebraLayouts();
+			}
+			else
+			{
+			//	partial agglomeration: the collected matrix is distributed on the group roots
+				m_spLocalAlgebraLayouts = make_sp(new AlgebraLayouts);
+				m_bRoot = CollectMatrixOnGroupRoots(A, collectedA, agglomerationLayout.master(),
+							agglomerationLayout.slave(), *m_spLocalAlgebraLayouts, m_groupSize);
+			}
 			agglomerationLayout.comm() = A.layouts()->comm();
 			agglomerationLayout.proc_comm() = A.layouts()->proc_comm();
+			agglomerationLayout.layouts_changed();
 
-			m_spLocalAlgebraLayouts = CreateLocalAlgebraLayouts();
 			collectedA.set_layouts(m_spLocalAlgebraLayouts);
 #else
 			m_bEmpty = false;
@@ -139,12 +160,14 @@ class AgglomeratingBase : public TBase
 
 		void gather_vector_on_one(vector_type &collectedB, const vector_type &b, ParallelStorageType type)
 		{
-			GatherVectorOnOne(agglomerationLayout, collectedB, b, PST_ADDITIVE);
+			GatherVectorOnOne(agglomerationLayout.master(), agglomerationLayout.slave(), agglomerationLayout.comm(),
+					collectedB, b, PST_ADDITIVE, i_am_root());
 		}
 
 		void broadcast_vector_from_one(vector_type &x, const vector_type &collectedX, ParallelStorageType type)
 		{
-			BroadcastVectorFromOne(agglomerationLayout, x, collectedX, PST_CONSISTENT);
+			BroadcastVectorFromOne(agglomerationLayout.master(), agglomerationLayout.slave(), agglomerationLayout.comm(),
+					x, collectedX, PST_CONSISTENT, i_am_root());
 		}
 #endif
 
@@ -191,7 +214,7 @@ class AgglomeratingBase : public TBase
 				bSuccess = init_agglomerated(m_spCollectedOp);
 				//UG_DLOG(LIB_ALG_LINEAR_SOLVER, 1,
 				if(collectedX.size() != m_pMatrix->num_rows()) {
-					UG_LOG("Agglomerated on proc 0. Size is " << collectedX.size() << "(was on this proc: "
+					UG_LOG("Agglomerated on proc " << pcl::ProcRank() << ". Size is " << collectedX.size() << "(was on this proc: "
 						<< m_pMatrix->num_rows() << ")\n");
 				}
 			}
@@ -289,6 +312,9 @@ class AgglomeratingBase : public TBase
 
 		// matrix to invert
 		matrix_type* m_pMatrix;
+
+		// number of processes agglomerated onto one (0 = all)
+		size_t m_groupSize;
 #ifdef UG_PARALLEL
 		vector_type collectedB, collectedX;
 		HorizontalAlgebraLayouts agglomerationLayout;
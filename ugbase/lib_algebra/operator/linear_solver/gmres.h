@@ -35,6 +35,9 @@
 
 #include <iostream>
 #include <string>
+#include <vector>
+#include <algorithm>
+#include <cmath>
 
 #include "lib_algebra/operator/interface/operator.h"
 #include "common/profiler/profiler.h"
@@ -58,6 +61,29 @@ namespace ug{
  *
  * - Saad, "Iterative Methods For Sparse Linear Systems"
  *
+ * The new Krylov vectors can be orthogonalized in two ways
+ * (see set_orthogonalization):
+ *
+ * - "mgs": modified Gram-Schmidt (default). Needs one global reduction per
+ *   previous basis vector and one pass over the vector for each of them.
+ * - "cgs2": classical Gram-Schmidt with reorthogonalization. All
+ *   projections onto the previous basis vectors are computed in one fused,
+ *   cache-blocked multi-dot kernel and a single global reduction, together
+ *   with the norm of the new vector. The second Gram-Schmidt pass is only
+ *   performed if the first one removed a large part of the vector (the
+ *   criterion of Daniel, Gragg, Kaufman and Stewart), i.e. one or two
+ *   reductions per iteration are needed, independent of the restart length.
+ *   The Krylov basis is stored contiguously in one array, so that the
+ *   multi-dot and the update stream each basis vector only once.
+ *   Since the reorthogonalization is needed in most iterations, this doubles
+ *   the local work of the orthogonalization; it pays off on many processes,
+ *   where the reductions dominate.
+ *
+ * - Giraud, Langou, Rozloznik, "The loss of orthogonality in the Gram-Schmidt
+ *   orthogonalization process"
+ * - Daniel, Gragg, Kaufman, Stewart, "Reorthogonalization and stable
+ *   algorithms for updating the Gram-Schmidt QR factorization"
+ *
  * \tparam 	TVector		vector type
  */
 template <typename TVector>
@@ -71,6 +97,12 @@ class GMRES
 	///	Base type
 		typedef IPreconditionedLinearOperatorInverse<vector_type> base_type;
 
+	///	Block type of the vector entries
+		typedef typename vector_type::value_type value_type;
+
+	///	orthogonalization methods
+		enum Orthogonalization {MGS, CGS2};
+
 	protected:
 		using base_type::convergence_check;
 		using base_type::linear_operator;
@@ -79,15 +111,25 @@ class GMRES
 
 	public:
 	///	default constructor
-		GMRES(size_t restart) : m_restart(restart) {};
+		GMRES(size_t restart) : m_restart(restart), m_orthogonalization(MGS) {};
 
 	///	constructor setting the preconditioner and the convergence check
 		GMRES( size_t restart,
 		       SmartPtr<ILinearIterator<vector_type> > spPrecond,
 		       SmartPtr<IConvergenceCheck<vector_type> > spConvCheck)
-			: base_type(spPrecond, spConvCheck), m_restart(restart)
+			: base_type(spPrecond, spConvCheck), m_restart(restart),
+			  m_orthogonalization(MGS)
 		{};
 
+	///	sets the orthogonalization method ("mgs" or "cgs2")
+		void set_orthogonalization(const std::string& method)
+		{
+			if(method == "mgs") m_orthogonalization = MGS;
+			else if(method == "cgs2") m_orthogonalization = CGS2;
+			else UG_THROW("GMRES: Unknown orthogonalization '"<<method<<"'. "
+						  "Use 'mgs' or 'cgs2'.");
+		}
+
 	///	name of solver
 		virtual const char* name() const {return "GMRES";}
 
@@ -128,12 +170,24 @@ class GMRES
 			std::vector<number> c(m_restart+1);
 			std::vector<number> s(m_restart+1);
 
+		//	for cgs2, the basis is stored contiguously and only two work vectors
+		//	are used for the current basis vector and the new Krylov vector
+			const bool bCGS2 = (m_orthogonalization == CGS2);
+			SmartPtr<vector_type> spCorr;
+			if(bCGS2){
+				m_basis.resize((m_restart+1) * x.size());
+				spCorr = x.clone_without_values();
+			}
+
 		//	old norm
 			number oldNorm;
 
 		// 	Iteration loop
 			while(!convergence_check()->iteration_ended())
 			{
+			//	reuse the two work vectors of the last restart cycle
+				if(bCGS2) compact_work_vectors(v);
+
 			//	get storage for first vector v[0]
 				if(v[0].invalid()) v[0] = x.clone_without_values();
 
@@ -163,6 +217,7 @@ class GMRES
 
 			//	normalize v[0] := v[0] / ||v[0]||
 				*v[0] *= 1./gamma[0];
+				if(bCGS2) store_basis_vector(0, *v[0]);
 
 			//	loop gmres iterations
 				size_t numIter = 0;
@@ -204,18 +259,25 @@ class GMRES
 				//	post-process the correction
 					m_corr_post_process.apply (*v[j+1]);
 
-				//	loop previous steps
-					for(size_t i = 0; i <= j; ++i)
-					{
-					//	h_ij := (r, v[j])
-						h[i][j] = VecProd(*v[j+1], *v[i]);
-
-					//	v[j+1] -= h_ij * v[i]
-						VecScaleAppend(*v[j+1], *v[i], (-1)*h[i][j]);
+				//	orthogonalize against previous basis vectors
+					if(bCGS2){
+						h[j+1][j] = orthogonalize_cgs2(*v[j+1], j+1, m_proj);
+						for(size_t i = 0; i <= j; ++i) h[i][j] = m_proj[i];
 					}
+					else{
+					//	loop previous steps
+						for(size_t i = 0; i <= j; ++i)
+						{
+						//	h_ij := (r, v[j])
+							h[i][j] = VecProd(*v[j+1], *v[i]);
+
+						//	v[j+1] -= h_ij * v[i]
+							VecScaleAppend(*v[j+1], *v[i], (-1)*h[i][j]);
+						}
 
-				//	compute h_{j+1,j}
-					h[j+1][j] = v[j+1]->norm();
+					//	compute h_{j+1,j}
+						h[j+1][j] = v[j+1]->norm();
+					}
 
 				//	update h
 					for(size_t i = 0; i < j; ++i)
@@ -252,6 +314,13 @@ class GMRES
 
 				//	normalize v[j+1]
 					*v[j+1] *= 1./(h[j+1][j]);
+
+				//	store v[j+1] in the basis and pass the work vector of
+				//	v[j] on to v[j+2]
+					if(bCGS2){
+						store_basis_vector(j+1, *v[j+1]);
+						if(j+2 < v.size()) {v[j+2] = v[j]; v[j] = SPNULL;}
+					}
 				}
 
 			//	compute current x
@@ -262,11 +331,23 @@ class GMRES
 					gamma[i] /= h[i][i];
 
 				//	x = x + gamma[i] * v[i]
-					VecScaleAppend(x, *v[i], gamma[i]);
+					if(!bCGS2) VecScaleAppend(x, *v[i], gamma[i]);
 
 					if(i == 0) break;
 				}
 
+			//	x = x + sum_i gamma[i] * v[i], in one pass over the basis
+				if(bCGS2){
+					basis_combination(*spCorr, gamma, numIter+1);
+					VecScaleAppend(x, *spCorr, 1.0);
+				}
+
+			//	the unique basis vectors have been added, make x consistent again
+				#ifdef UG_PARALLEL
+				if(!x.change_storage_type(PST_CONSISTENT))
+					UG_THROW("GMRES: Cannot convert x to consistent vector.");
+				#endif
+
 			//	compute fresh defect: b := b - A*x
 				*spR = b;
 				linear_operator()->apply_sub(*spR, x);
@@ -283,7 +364,8 @@ class GMRES
 		virtual std::string config_string() const
 		{
 			std::stringstream ss;
-			ss << "GMRes ( restart = " << m_restart << ")\n";
+			ss << "GMRes ( restart = " << m_restart << ", orthogonalization = "
+			   << (m_orthogonalization == CGS2 ? "cgs2" : "mgs") << ")\n";
 			ss << base_type::config_string_preconditioner_convergence_check();
 			return ss.str();
 		}
@@ -317,10 +399,148 @@ class GMRES
 			convergence_check()->set_info(s);
 		}
 
+	///	moves the (at most two) allocated work vectors to v[0] and v[1]
+		void compact_work_vectors(std::vector<SmartPtr<vector_type> >& v)
+		{
+			for(size_t k = 2; k < v.size(); ++k){
+				if(v[k].invalid()) continue;
+				if(v[0].invalid()) v[0] = v[k];
+				else if(v[1].invalid()) v[1] = v[k];
+				v[k] = SPNULL;
+			}
+		}
+
+	///	copies a (unique) vector to column i of the contiguous basis
+		void store_basis_vector(size_t i, const vector_type& vi)
+		{
+			const size_t n = vi.size();
+		//	processes without indices have an empty basis
+			if(n == 0) return;
+			std::copy(&vi[0], &vi[0] + n, &m_basis[i*n]);
+		}
+
+	///	computes res[i] = (V_i, w) for i < numBasis and, if requested, also
+	///	res[numBasis] = (w, w), using one global reduction
+		void basis_multi_dot(std::vector<number>& res, const vector_type& w,
+		                     size_t numBasis, bool bNorm)
+		{
+			PROFILE_BEGIN_GROUP(GMRES_multi_dot, "algebra gmres");
+			const size_t n = w.size();
+			std::vector<number> local(numBasis + (bNorm ? 1 : 0), 0.0);
+
+		//	blocked over the rows, so that the block of w stays in cache while
+		//	it is multiplied with all basis vectors
+			for(size_t k0 = 0; k0 < n; k0 += s_blockSize){
+				const size_t k1 = std::min(n, k0 + s_blockSize);
+				for(size_t i = 0; i < numBasis; ++i){
+					const value_type* vi = &m_basis[i*n];
+					number sum = 0.0;
+					for(size_t k = k0; k < k1; ++k)
+						VecProdAdd(vi[k], w[k], sum);
+					local[i] += sum;
+				}
+				if(bNorm)
+					for(size_t k = k0; k < k1; ++k)
+						VecNormSquaredAdd(w[k], local[numBasis]);
+			}
+
+			#ifdef UG_PARALLEL
+			if(!w.layouts()->proc_comm().empty()){
+				w.layouts()->proc_comm().allreduce(local, res, PCL_RO_SUM);
+				return;
+			}
+			#endif
+			res.swap(local);
+		}
+
+	///	computes w -= sum_{i < numBasis} coeff[i] * V_i, in one pass over w
+		void basis_subtract(vector_type& w, const std::vector<number>& coeff,
+		                    size_t numBasis)
+		{
+			PROFILE_BEGIN_GROUP(GMRES_basis_update, "algebra gmres");
+			const size_t n = w.size();
+			for(size_t k0 = 0; k0 < n; k0 += s_blockSize){
+				const size_t k1 = std::min(n, k0 + s_blockSize);
+				for(size_t i = 0; i < numBasis; ++i){
+					const value_type* vi = &m_basis[i*n];
+					const number alpha = -coeff[i];
+					for(size_t k = k0; k < k1; ++k)
+						VecScaleAdd(w[k], 1.0, w[k], alpha, vi[k]);
+				}
+			}
+		}
+
+	///	computes res = sum_{i < numBasis} coeff[i] * V_i (unique in parallel)
+		void basis_combination(vector_type& res, const std::vector<number>& coeff,
+		                       size_t numBasis)
+		{
+			res.set(0.0);
+			#ifdef UG_PARALLEL
+			res.set_storage_type(PST_UNIQUE);
+			#endif
+			std::vector<number> negCoeff(numBasis);
+			for(size_t i = 0; i < numBasis; ++i) negCoeff[i] = -coeff[i];
+			basis_subtract(res, negCoeff, numBasis);
+		}
+
+	///	orthogonalizes w against the first numBasis basis vectors (cgs2)
+	/**
+	 * Classical Gram-Schmidt with (selective) reorthogonalization. The
+	 * projection coefficients of all passes are summed up and returned in
+	 * proj. The norm of w is reduced together with the projections, the norm
+	 * of the orthogonalized vector is obtained from
+	 *
+	 * 		||w - V h||^2 = ||w||^2 - ||h||^2,		h = V^T w.
+	 *
+	 * If the norm drops below 1/sqrt(2) of the norm before the pass, the
+	 * result may have lost orthogonality (and the formula above suffers from
+	 * cancellation), so the pass is repeated once.
+	 *
+	 * \returns the norm of the orthogonalized w
+	 */
+		number orthogonalize_cgs2(vector_type& w, size_t numBasis,
+		                          std::vector<number>& proj)
+		{
+			PROFILE_BEGIN_GROUP(GMRES_cgs2, "algebra gmres");
+
+			proj.assign(numBasis, 0.0);
+			number norm2 = 0.0;
+			for(int pass = 0; pass < 2; ++pass)
+			{
+			//	h = V^T w and ||w||^2 in one reduction, w -= V h
+				basis_multi_dot(m_proj2, w, numBasis, true);
+				basis_subtract(w, m_proj2, numBasis);
+
+				const number norm2Before = m_proj2[numBasis];
+				norm2 = norm2Before;
+				for(size_t i = 0; i < numBasis; ++i){
+					proj[i] += m_proj2[i];
+					norm2 -= m_proj2[i]*m_proj2[i];
+				}
+
+				if(norm2 > 0.5 * norm2Before) return std::sqrt(norm2);
+			}
+
+		//	still cancellation after reorthogonalization: compute explicitly
+			return w.norm();
+		}
+
 	protected:
 	///	restart parameter
 		size_t m_restart;
 
+	///	orthogonalization method
+		Orthogonalization m_orthogonalization;
+
+	///	contiguous storage of the Krylov basis (cgs2): V_i = m_basis[i*n, (i+1)*n)
+		std::vector<value_type> m_basis;
+
+	///	projection coefficients (summed, and of the current cgs2 pass)
+		std::vector<number> m_proj, m_proj2;
+
+	///	number of rows processed at once in the multi-dot kernel
+		static const size_t s_blockSize = 2048;
+
 	///	postprocessor for the correction in the iterations
 		/**
 		 * These postprocess operations are applied to the preconditioned
@@ -42,6 +42,8 @@
 	#include "lib_algebra/parallelization/parallelization.h"
 #endif
 #include "../preconditioner/ilut_scalar.h"
+#include "supernodal_lu.h"
+#include "lib_algebra/algebra_common/permutation_util.h"
 #include "../interface/preconditioned_linear_operator_inverse.h"
 #include "linear_solver.h"
 
@@ -75,7 +77,8 @@ class LU
 
 	public:
 	///	constructor
-		LU() : m_spOperator(NULL), m_mat(), m_bSortSparse(true), m_bInfo(false), m_bShowProgress(true)
+		LU() : m_spOperator(NULL), m_mat(), m_bSortSparse(true), m_bInfo(false), m_bShowProgress(true),
+			m_bSupernodal(false), m_minNestedDissectionSize(64)
 		{
 #ifdef LAPACK_AVAILABLE
 			m_iMinimumForSparse = 4000;
@@ -102,6 +105,29 @@ class LU
 		{
 			m_bInfo = b;
 		}
+
+	///	selects the factorization used in sparse mode
+	/**
+	 * "ilut": ILUT with threshold 0 (entry-wise elimination, optionally
+	 * Cuthill-McKee sorted, see set_sort_sparse). This is the default.
+	 * "supernodal": multifrontal supernodal LU in nested dissection ordering.
+	 * The symbolic factorization is kept and reused as long as the sparsity
+	 * pattern of the matrix does not change (e.g. for repeated inits as
+	 * base solver). Only available for algebras with a static block size.
+	 */
+		void set_sparse_method(const std::string& method)
+		{
+			if(method == "ilut") m_bSupernodal = false;
+			else if(method == "supernodal") m_bSupernodal = true;
+			else UG_THROW("LU::set_sparse_method: unknown method '" << method
+			              << "', use 'ilut' or 'supernodal'.");
+		}
+
+	///	subgraph size below which the nested dissection ordering stops splitting
+		void set_nested_dissection_min_size(size_t minSize)
+		{
+			m_minNestedDissectionSize = minSize;
+		}
 		
 		void set_show_progress(bool b)
 		{
@@ -178,8 +204,84 @@ class LU
 		}
 
 
+		bool init_supernodal(const matrix_type &M)
+		{
+			try{
+			PROFILE_FUNC();
+		//	the expansion to scalar indices below relies on a fixed block size
+			UG_COND_THROW(!block_traits<typename matrix_type::value_type>::is_static,
+						  "Supernodal LU requires a static block size.");
+#ifdef 	UG_PARALLEL
+			matrix_type A;
+			A = M;
+
+			MatAddSlaveRowsToMasterRowOverlap0(A);
+
+		//	set zero on slaves
+			std::vector<IndexLayout::Element> vIndex;
+			CollectUniqueElements(vIndex, M.layouts()->slave());
+			SetDirichletRow(A, vIndex);
+#else
+			const matrix_type &A = M;
+#endif
+			if(m_bInfo)
+			{
+				UG_LOG("LU using Supernodal LU on ");
+				print_info(A);
+				UG_LOG("\n");
+			}
+
+		//	scalar compressed row storage
+			CPUAlgebra::matrix_type S;
+			m_size = GetDoubleSparseFromBlockSparse(S, A);
+			const CPUAlgebra::matrix_type &cS = S;
+			m_vRowStart.resize(m_size+1);
+			m_vColInd.clear(); m_vValue.clear();
+			m_vRowStart[0] = 0;
+			for(size_t r = 0; r < m_size; ++r)
+			{
+				for(CPUAlgebra::matrix_type::const_row_iterator it = cS.begin_row(r); it != cS.end_row(r); ++it)
+				{
+					m_vColInd.push_back(it.index());
+					m_vValue.push_back(it.value());
+				}
+				m_vRowStart[r+1] = m_vColInd.size();
+			}
+
+			if(m_spSupernodal.invalid())
+				m_spSupernodal = make_sp(new SupernodalLU());
+
+		//	symbolic factorization only if the pattern changed
+			if(!m_spSupernodal->same_pattern(m_vRowStart, m_vColInd))
+			{
+			//	order the block graph, so that blocks stay together
+				std::vector<size_t> vBlockIndex, vNewIndex(m_size);
+				GetNestedDissectionOrder(A, vBlockIndex, m_minNestedDissectionSize);
+				const size_t blockSize = block_traits<typename matrix_type::value_type>::static_num_rows;
+				for(size_t i = 0; i < A.num_rows(); ++i)
+					for(size_t j = 0; j < blockSize; ++j)
+						vNewIndex[i*blockSize + j] = vBlockIndex[i]*blockSize + j;
+
+				m_spSupernodal->analyze(m_size, m_vRowStart, m_vColInd, vNewIndex);
+				if(m_bInfo) m_spSupernodal->print_statistics();
+			}
+			else if(m_bInfo)
+				UG_LOG("LU: pattern unchanged, reusing symbolic factorization.\n");
+
+			m_spSupernodal->factorize(m_vValue);
+
+			}UG_CATCH_THROW("LU::" << __FUNCTION__ << " failed")
+			return true;
+		}
+
 		bool init_sparse(const matrix_type &A)
 		{
+			if(m_bSupernodal)
+			{
+				m_bDense = false;
+				return init_supernodal(A);
+			}
+
 			try{
 			PROFILE_FUNC();
 			m_bDense = false;
@@ -227,6 +329,20 @@ class LU
 		bool solve_sparse(vector_type &x, const vector_type &b)
 		{
 			PROFILE_FUNC();
+			if(m_bSupernodal)
+			{
+				m_vSolve.resize(m_size);
+				for(size_t i=0, k=0; i<b.size(); i++)
+					for(size_t j=0; j<GetSize(b[i]); j++)
+						m_vSolve[k++] = BlockRef(b[i],j);
+
+				m_spSupernodal->solve(m_vSolve);
+
+				for(size_t i=0, k=0; i<x.size(); i++)
+					for(size_t j=0; j<GetSize(x[i]); j++)
+						BlockRef(x[i],j) = m_vSolve[k++];
+				return true;
+			}
 			ilut_scalar->solve(x, b);
 			return true;
 		}
@@ -386,6 +502,7 @@ class LU
 			ss << " Minimum Entries for Sparse LU: " << m_iMinimumForSparse;
 			if(m_iMinimumForSparse==0)
 				ss << " (= always Sparse LU)";
+			ss << "\n Sparse Method: " << (m_bSupernodal ? "supernodal (nested dissection)" : "ilut");
 			return ss.str();
 		}
 
@@ -411,6 +528,13 @@ class LU
 		SmartPtr<ILUTScalarPreconditioner<algebra_type> > ilut_scalar;
 		size_t m_iMinimumForSparse;
 		bool m_bSortSparse, m_bInfo, m_bShowProgress;
+
+	///	supernodal sparse factorization
+		bool m_bSupernodal;
+		size_t m_minNestedDissectionSize;
+		SmartPtr<SupernodalLU> m_spSupernodal;
+		std::vector<size_t> m_vRowStart, m_vColInd;
+		std::vector<double> m_vValue, m_vSolve;
 };
 
 } // end namespace ug
@@ -0,0 +1,543 @@
+/*
+ * Copyright (c) 2017:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+
+#include "supernodal_lu.h"
+#include "common/common.h"
+#include "common/profiler/profiler.h"
+#include "common/util/string_util.h"
+#include <algorithm>
+#include <cmath>
+
+namespace ug{
+
+static const size_t NO_PARENT = (size_t)-1;
+
+SupernodalLU::SupernodalLU()
+	: m_relax(0.1), m_maxSupernodeSize(128), m_bAnalyzed(false), m_n(0),
+	  m_maxFront(0), m_bFactorized(false)
+{}
+
+void SupernodalLU::build_graph(std::vector<size_t>& vAdjStart,
+                               std::vector<size_t>& vAdj,
+                               const std::vector<size_t>& vPerm) const
+{
+	std::vector<std::vector<size_t> > vvAdj(m_n);
+	for(size_t r = 0; r < m_n; ++r)
+		for(size_t k = m_vRowStart[r]; k < m_vRowStart[r+1]; ++k)
+		{
+			const size_t i = vPerm[r], j = vPerm[m_vColInd[k]];
+			if(i == j) continue;
+			vvAdj[i].push_back(j);
+			vvAdj[j].push_back(i);
+		}
+
+	vAdjStart.resize(m_n+1);
+	vAdjStart[0] = 0;
+	for(size_t i = 0; i < m_n; ++i)
+	{
+		std::sort(vvAdj[i].begin(), vvAdj[i].end());
+		vvAdj[i].erase(std::unique(vvAdj[i].begin(), vvAdj[i].end()), vvAdj[i].end());
+		vAdjStart[i+1] = vAdjStart[i] + vvAdj[i].size();
+	}
+	vAdj.clear(); vAdj.reserve(vAdjStart[m_n]);
+	for(size_t i = 0; i < m_n; ++i)
+	{
+		vAdj.insert(vAdj.end(), vvAdj[i].begin(), vvAdj[i].end());
+		std::vector<size_t>().swap(vvAdj[i]);
+	}
+}
+
+///	elimination tree of a symmetric graph (Liu's algorithm with path compression)
+static void ComputeEliminationTree(std::vector<size_t>& vParent,
+                                   const std::vector<size_t>& vAdjStart,
+                                   const std::vector<size_t>& vAdj)
+{
+	const size_t n = vAdjStart.size() - 1;
+	vParent.assign(n, NO_PARENT);
+	std::vector<size_t> vAncestor(n, NO_PARENT);
+	for(size_t k = 0; k < n; ++k)
+		for(size_t a = vAdjStart[k]; a < vAdjStart[k+1]; ++a)
+		{
+			size_t i = vAdj[a];
+			while(i != NO_PARENT && i < k)
+			{
+				const size_t next = vAncestor[i];
+				vAncestor[i] = k;
+				if(next == NO_PARENT) vParent[i] = k;
+				i = next;
+			}
+		}
+}
+
+void SupernodalLU::analyze(size_t n, const std::vector<size_t>& vRowStart,
+                           const std::vector<size_t>& vColInd,
+                           const std::vector<size_t>& vNewIndex)
+{
+	PROFILE_FUNC_GROUP("algebra");
+	UG_COND_THROW(vRowStart.size() != n+1, "SupernodalLU: row start array has size "
+	              << vRowStart.size() << ", expected " << n+1);
+	UG_COND_THROW(vNewIndex.size() != n, "SupernodalLU: ordering has size "
+	              << vNewIndex.size() << ", expected " << n);
+
+	m_bAnalyzed = false; m_bFactorized = false;
+	m_n = n;
+	m_vRowStart = vRowStart;
+	m_vColInd = vColInd;
+
+	{
+		std::vector<bool> vUsed(n, false);
+		for(size_t i = 0; i < n; ++i)
+		{
+			UG_COND_THROW(vNewIndex[i] >= n || vUsed[vNewIndex[i]],
+			              "SupernodalLU: ordering is not a permutation.");
+			vUsed[vNewIndex[i]] = true;
+		}
+	}
+
+//	elimination tree in the given ordering
+	std::vector<size_t> vAdjStart, vAdj, vParent;
+	build_graph(vAdjStart, vAdj, vNewIndex);
+	ComputeEliminationTree(vParent, vAdjStart, vAdj);
+
+//	postorder the tree, so that each subtree is numbered consecutively
+//	(this does not change the fill, but makes supernodes contiguous)
+	std::vector<size_t> vPost(n);
+	{
+		std::vector<size_t> vChildStart(n+1, 0), vChild(n);
+		for(size_t i = 0; i < n; ++i)
+			if(vParent[i] != NO_PARENT) ++vChildStart[vParent[i]+1];
+		for(size_t i = 0; i < n; ++i) vChildStart[i+1] += vChildStart[i];
+		std::vector<size_t> vFill(vChildStart.begin(), vChildStart.end()-1);
+		for(size_t i = 0; i < n; ++i)
+			if(vParent[i] != NO_PARENT) vChild[vFill[vParent[i]]++] = i;
+
+		size_t cnt = 0;
+		std::vector<size_t> vStack, vNext(n);
+		for(size_t root = 0; root < n; ++root)
+		{
+			if(vParent[root] != NO_PARENT) continue;
+			vStack.push_back(root); vNext[root] = vChildStart[root];
+			while(!vStack.empty())
+			{
+				const size_t v = vStack.back();
+				if(vNext[v] < vChildStart[v+1])
+				{
+					const size_t c = vChild[vNext[v]++];
+					vNext[c] = vChildStart[c];
+					vStack.push_back(c);
+				}
+				else
+				{
+					vPost[v] = cnt++;
+					vStack.pop_back();
+				}
+			}
+		}
+		UG_COND_THROW(cnt != n, "SupernodalLU: elimination tree postorder failed.");
+	}
+
+	m_vPerm.resize(n);
+	for(size_t i = 0; i < n; ++i) m_vPerm[i] = vPost[vNewIndex[i]];
+	build_graph(vAdjStart, vAdj, m_vPerm);
+	ComputeEliminationTree(vParent, vAdjStart, vAdj);
+
+//	symbolic factorization column by column: the structure of column j of L
+//	is its lower adjacency merged with the structures of its children.
+//	Supernodes are detected on the fly, only the structure of the last column
+//	of each supernode is kept.
+	std::vector<std::vector<size_t> > vvStruct(n);
+	std::vector<size_t> vCount(n), vMark(n, NO_PARENT);
+	std::vector<std::vector<size_t> > vvChildren(n);
+	for(size_t i = 0; i < n; ++i)
+		if(vParent[i] != NO_PARENT) vvChildren[vParent[i]].push_back(i);
+
+	std::vector<bool> vIsLast(n, false);
+	std::vector<size_t> vSnFirst;
+	for(size_t j = 0; j < n; ++j)
+	{
+		std::vector<size_t>& S = vvStruct[j];
+		vMark[j] = j;
+		for(size_t a = vAdjStart[j]; a < vAdjStart[j+1]; ++a)
+		{
+			const size_t i = vAdj[a];
+			if(i > j && vMark[i] != j) {vMark[i] = j; S.push_back(i);}
+		}
+		for(size_t c = 0; c < vvChildren[j].size(); ++c)
+		{
+			const size_t child = vvChildren[j][c];
+			const std::vector<size_t>& Sc = vvStruct[child];
+			for(size_t k = 0; k < Sc.size(); ++k)
+				if(vMark[Sc[k]] != j) {vMark[Sc[k]] = j; S.push_back(Sc[k]);}
+		}
+		std::sort(S.begin(), S.end());
+		vCount[j] = S.size();
+
+	//	structures of children which do not end a supernode are not needed
+	//	any more (for j-1 this is decided below)
+		for(size_t c = 0; c < vvChildren[j].size(); ++c)
+		{
+			const size_t child = vvChildren[j][c];
+			if(child + 1 != j && !vIsLast[child])
+				std::vector<size_t>().swap(vvStruct[child]);
+		}
+
+	//	amalgamate j with the supernode of j-1?
+		bool bMerge = false;
+		if(j > 0 && vParent[j-1] == j && !vSnFirst.empty()
+			&& j - vSnFirst.back() < m_maxSupernodeSize)
+		{
+			const size_t f = vSnFirst.back();
+			double zeros = 0, total = 0;
+			for(size_t c = f; c <= j; ++c)
+			{
+				const double stored = (double)(j - c) + (double)vCount[j] + 1.0;
+				total += stored;
+				zeros += stored - (double)vCount[c] - 1.0;
+			}
+			bMerge = (zeros <= m_relax * total);
+		}
+
+		if(bMerge)
+			std::vector<size_t>().swap(vvStruct[j-1]);
+		else
+		{
+			if(j > 0) vIsLast[j-1] = true;
+			vSnFirst.push_back(j);
+		}
+	}
+	if(n > 0) vIsLast[n-1] = true;
+	vSnFirst.push_back(n);
+
+	const size_t numSn = vSnFirst.size() - 1;
+	m_vSnFirst = vSnFirst;
+
+	std::vector<size_t> vSnOf(n);
+	for(size_t s = 0; s < numSn; ++s)
+		for(size_t j = vSnFirst[s]; j < vSnFirst[s+1]; ++j) vSnOf[j] = s;
+
+//	supernode tree and front index sets
+	m_vSnParent.assign(numSn, NO_PARENT);
+	m_vSnIndStart.resize(numSn+1);
+	m_vSnIndStart[0] = 0;
+	m_vSnInd.clear();
+	m_maxFront = 0;
+	for(size_t s = 0; s < numSn; ++s)
+	{
+		const size_t last = vSnFirst[s+1] - 1;
+		if(vParent[last] != NO_PARENT) m_vSnParent[s] = vSnOf[vParent[last]];
+		for(size_t j = vSnFirst[s]; j <= last; ++j) m_vSnInd.push_back(j);
+		const std::vector<size_t>& S = vvStruct[last];
+		for(size_t k = 0; k < S.size(); ++k)
+			if(S[k] > last) m_vSnInd.push_back(S[k]);
+		m_vSnIndStart[s+1] = m_vSnInd.size();
+		m_maxFront = std::max(m_maxFront, front_size(s));
+		std::vector<size_t>().swap(vvStruct[last]);
+	}
+
+	m_vChildStart.assign(numSn+1, 0);
+	for(size_t s = 0; s < numSn; ++s)
+		if(m_vSnParent[s] != NO_PARENT) ++m_vChildStart[m_vSnParent[s]+1];
+	for(size_t s = 0; s < numSn; ++s) m_vChildStart[s+1] += m_vChildStart[s];
+	m_vChild.resize(m_vChildStart[numSn]);
+	{
+		std::vector<size_t> vFill(m_vChildStart.begin(), m_vChildStart.end()-1);
+		for(size_t s = 0; s < numSn; ++s)
+			if(m_vSnParent[s] != NO_PARENT) m_vChild[vFill[m_vSnParent[s]]++] = s;
+	}
+
+//	positions of the update rows in the parent front
+	std::vector<size_t> vPos(n, NO_PARENT);
+	m_vRelStart.resize(numSn+1);
+	m_vRelStart[0] = 0;
+	m_vRel.clear();
+	for(size_t s = 0; s < numSn; ++s)
+	{
+		const size_t p = m_vSnParent[s];
+		const size_t w = width(s), m = front_size(s);
+		if(p != NO_PARENT)
+		{
+			for(size_t k = m_vSnIndStart[p]; k < m_vSnIndStart[p+1]; ++k)
+				vPos[m_vSnInd[k]] = k - m_vSnIndStart[p];
+			for(size_t k = w; k < m; ++k)
+			{
+				const size_t pos = vPos[m_vSnInd[m_vSnIndStart[s] + k]];
+				UG_COND_THROW(pos == NO_PARENT || pos >= front_size(p),
+				              "SupernodalLU: update row not contained in parent front.");
+				m_vRel.push_back(pos);
+			}
+			for(size_t k = m_vSnIndStart[p]; k < m_vSnIndStart[p+1]; ++k)
+				vPos[m_vSnInd[k]] = NO_PARENT;
+		}
+		else
+			UG_COND_THROW(m != w, "SupernodalLU: root supernode with update rows.");
+		m_vRelStart[s+1] = m_vRel.size();
+	}
+
+//	assembly map of the matrix entries: entry (i,j) belongs to the front of
+//	the supernode containing column min(i,j)
+	const size_t nnz = m_vRowStart[n];
+	std::vector<size_t> vEntrySn(nnz);
+	m_vAsmStart.assign(numSn+1, 0);
+	for(size_t r = 0; r < n; ++r)
+		for(size_t k = m_vRowStart[r]; k < m_vRowStart[r+1]; ++k)
+		{
+			const size_t s = vSnOf[std::min(m_vPerm[r], m_vPerm[m_vColInd[k]])];
+			vEntrySn[k] = s;
+			++m_vAsmStart[s+1];
+		}
+	for(size_t s = 0; s < numSn; ++s) m_vAsmStart[s+1] += m_vAsmStart[s];
+	m_vAsmEntry.resize(nnz);
+	{
+		std::vector<size_t> vFill(m_vAsmStart.begin(), m_vAsmStart.end()-1);
+		for(size_t k = 0; k < nnz; ++k) m_vAsmEntry[vFill[vEntrySn[k]]++] = k;
+	}
+	std::vector<size_t> vEntryRow(nnz);
+	for(size_t r = 0; r < n; ++r)
+		for(size_t k = m_vRowStart[r]; k < m_vRowStart[r+1]; ++k) vEntryRow[k] = r;
+
+	m_vAsmOffset.resize(nnz);
+	for(size_t s = 0; s < numSn; ++s)
+	{
+		const size_t m = front_size(s);
+		for(size_t k = m_vSnIndStart[s]; k < m_vSnIndStart[s+1]; ++k)
+			vPos[m_vSnInd[k]] = k - m_vSnIndStart[s];
+		for(size_t a = m_vAsmStart[s]; a < m_vAsmStart[s+1]; ++a)
+		{
+			const size_t k = m_vAsmEntry[a];
+			const size_t pi = vPos[m_vPerm[vEntryRow[k]]];
+			const size_t pj = vPos[m_vPerm[m_vColInd[k]]];
+			UG_COND_THROW(pi == NO_PARENT || pj == NO_PARENT,
+			              "SupernodalLU: matrix entry outside of front.");
+			m_vAsmOffset[a] = pi * m + pj;
+		}
+		for(size_t k = m_vSnIndStart[s]; k < m_vSnIndStart[s+1]; ++k)
+			vPos[m_vSnInd[k]] = NO_PARENT;
+	}
+
+//	factor storage
+	m_vFactorStart.resize(numSn+1);
+	m_vFactorStart[0] = 0;
+	for(size_t s = 0; s < numSn; ++s)
+	{
+		const size_t w = width(s), m = front_size(s);
+		m_vFactorStart[s+1] = m_vFactorStart[s] + w*m + (m-w)*w;
+	}
+	m_vFactor.clear();
+
+	m_bAnalyzed = true;
+}
+
+bool SupernodalLU::same_pattern(const std::vector<size_t>& vRowStart,
+                                const std::vector<size_t>& vColInd) const
+{
+	return m_bAnalyzed && vRowStart == m_vRowStart && vColInd == m_vColInd;
+}
+
+void SupernodalLU::factorize(const std::vector<double>& vValue)
+{
+	PROFILE_FUNC_GROUP("algebra");
+	UG_COND_THROW(!m_bAnalyzed, "SupernodalLU: factorize called before analyze.");
+	UG_COND_THROW(vValue.size() != m_vColInd.size(), "SupernodalLU: got "
+	              << vValue.size() << " values for " << m_vColInd.size() << " entries.");
+	m_bFactorized = false;
+
+	const size_t numSn = num_supernodes();
+	m_vFactor.resize(num_factor_entries());
+	std::vector<std::vector<double> > vvUpdate(numSn);
+	std::vector<double> F;
+
+	for(size_t s = 0; s < numSn; ++s)
+	{
+		const size_t w = width(s), m = front_size(s), mu = m - w;
+
+	//	assemble frontal matrix
+		F.assign(m*m, 0.0);
+		for(size_t a = m_vAsmStart[s]; a < m_vAsmStart[s+1]; ++a)
+			F[m_vAsmOffset[a]] += vValue[m_vAsmEntry[a]];
+
+	//	extend-add the update matrices of the children
+		for(size_t c = m_vChildStart[s]; c < m_vChildStart[s+1]; ++c)
+		{
+			const size_t child = m_vChild[c];
+			std::vector<double>& U = vvUpdate[child];
+			const size_t* rel = &m_vRel[m_vRelStart[child]];
+			const size_t cu = m_vRelStart[child+1] - m_vRelStart[child];
+			for(size_t i = 0; i < cu; ++i)
+			{
+				double* Frow = &F[rel[i]*m];
+				const double* Urow = &U[i*cu];
+				for(size_t j = 0; j < cu; ++j)
+					Frow[rel[j]] += Urow[j];
+			}
+			std::vector<double>().swap(U);
+		}
+
+	//	factor the pivot block and the panels
+		for(size_t k = 0; k < w; ++k)
+		{
+			const double* Fk = &F[k*m];
+			const double d = Fk[k];
+			if(d == 0.0 || d != d)
+				UG_THROW("SupernodalLU: zero pivot in row " << m_vSnFirst[s] + k
+				         << " (reordered), matrix is singular or needs pivoting.");
+			for(size_t i = k+1; i < m; ++i)
+			{
+				double* Fi = &F[i*m];
+				const double l = (Fi[k] /= d);
+				if(l == 0.0) continue;
+			//	pivot rows are updated completely, the L21 panel only in the
+			//	pivot columns; the Schur complement is updated blockwise below
+				const size_t jEnd = (i < w) ? m : w;
+				for(size_t j = k+1; j < jEnd; ++j)
+					Fi[j] -= l * Fk[j];
+			}
+		}
+
+	//	Schur complement F22 -= L21 * U12
+		if(mu > 0)
+		{
+#ifdef UG_OPENMP
+			#pragma omp parallel for schedule(static) if(mu*mu*w > 1000000)
+#endif
+			for(int ii = (int)w; ii < (int)m; ++ii)
+			{
+				double* Fi = &F[ii*m];
+				for(size_t k = 0; k < w; ++k)
+				{
+					const double l = Fi[k];
+					if(l == 0.0) continue;
+					const double* Fk = &F[k*m];
+					for(size_t j = w; j < m; ++j)
+						Fi[j] -= l * Fk[j];
+				}
+			}
+		}
+
+	//	store factors
+		double* pFac = &m_vFactor[m_vFactorStart[s]];
+		std::copy(F.begin(), F.begin() + w*m, pFac);
+		pFac += w*m;
+		for(size_t i = w; i < m; ++i)
+			for(size_t k = 0; k < w; ++k)
+				*pFac++ = F[i*m+k];
+
+	//	pass Schur complement on to the parent
+		if(mu > 0)
+		{
+			std::vector<double>& U = vvUpdate[s];
+			U.resize(mu*mu);
+			for(size_t i = 0; i < mu; ++i)
+				std::copy(&F[(w+i)*m + w], &F[(w+i)*m + m], &U[i*mu]);
+		}
+	}
+
+	m_bFactorized = true;
+}
+
+void SupernodalLU::solve(std::vector<double>& x) const
+{
+	PROFILE_FUNC_GROUP("algebra");
+	UG_COND_THROW(!m_bFactorized, "SupernodalLU: solve called before factorize.");
+	UG_COND_THROW(x.size() != m_n, "SupernodalLU: vector has size " << x.size()
+	              << ", expected " << m_n);
+
+	std::vector<double>& y = m_vWork;
+	y.resize(m_n);
+	for(size_t i = 0; i < m_n; ++i) y[m_vPerm[i]] = x[i];
+
+	const size_t numSn = num_supernodes();
+
+//	forward substitution L y = b
+	for(size_t s = 0; s < numSn; ++s)
+	{
+		const size_t w = width(s), m = front_size(s), f = m_vSnFirst[s];
+		const size_t* ind = &m_vSnInd[m_vSnIndStart[s]];
+		const double* U = &m_vFactor[m_vFactorStart[s]];
+		const double* L21 = U + w*m;
+
+		for(size_t k = 0; k < w; ++k)
+		{
+			double v = y[f+k];
+			for(size_t j = 0; j < k; ++j)
+				v -= U[k*m+j] * y[f+j];
+			y[f+k] = v;
+		}
+		for(size_t i = 0; i < m-w; ++i)
+		{
+			double v = 0.0;
+			for(size_t k = 0; k < w; ++k)
+				v += L21[i*w+k] * y[f+k];
+			y[ind[w+i]] -= v;
+		}
+	}
+
+//	backward substitution U x = y
+	for(size_t s = numSn; s > 0; --s)
+	{
+		const size_t w = width(s-1), m = front_size(s-1), f = m_vSnFirst[s-1];
+		const size_t* ind = &m_vSnInd[m_vSnIndStart[s-1]];
+		const double* U = &m_vFactor[m_vFactorStart[s-1]];
+
+		for(size_t k = w; k > 0; --k)
+		{
+			const double* Uk = &U[(k-1)*m];
+			double v = y[f+k-1];
+			for(size_t j = k; j < w; ++j)
+				v -= Uk[j] * y[f+j];
+			for(size_t j = w; j < m; ++j)
+				v -= Uk[j] * y[ind[j]];
+			y[f+k-1] = v / Uk[k-1];
+		}
+	}
+
+	for(size_t i = 0; i < m_n; ++i) x[i] = y[m_vPerm[i]];
+}
+
+void SupernodalLU::print_statistics() const
+{
+	const size_t numSn = num_supernodes();
+	double flops = 0;
+	for(size_t s = 0; s < numSn; ++s)
+	{
+		const double w = (double)width(s), m = (double)front_size(s);
+		flops += w * m * m;
+	}
+	UG_LOG("SupernodalLU: " << m_n << " unknowns, " << m_vColInd.size() << " matrix entries, "
+	       << numSn << " supernodes, largest front " << m_maxFront << ".\n");
+	UG_LOG("  factor entries: " << num_factor_entries() << " (fill factor "
+	       << (m_vColInd.size() ? (double)num_factor_entries() / (double)m_vColInd.size() : 0.0)
+	       << "), " << GetBytesSizeString(num_factor_entries()*sizeof(double))
+	       << ", approx. " << flops << " flops per factorization.\n");
+}
+
+} // end namespace ug
+
@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) 2017:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+
+#ifndef __H__LIB_ALGEBRA__SUPERNODAL_LU__
+#define __H__LIB_ALGEBRA__SUPERNODAL_LU__
+
+#include <vector>
+#include <cstddef>
+
+namespace ug{
+
+/// multifrontal supernodal LU factorization of a scalar sparse matrix
+/**
+ * Direct factorization A = L*U of a square sparse matrix given in compressed
+ * row storage. The factorization is done without pivoting on the symmetrized
+ * sparsity pattern (as the sparse mode of LU always did), in the ordering
+ * passed to analyze() - typically a nested dissection ordering.
+ *
+ * analyze() computes the elimination tree, postorders it, detects (relaxed)
+ * supernodes, i.e. chains of columns with (nearly) identical structure, and
+ * precomputes all index maps. The result depends on the pattern only and is
+ * kept across factorize() calls, so that a new matrix with unchanged pattern
+ * (same_pattern()) only needs the numeric factorization.
+ *
+ * factorize() visits the supernodes in postorder. For each one a dense
+ * frontal matrix is assembled from the matrix entries and the update
+ * matrices of its children (extend-add), the pivot block is factored and
+ * the Schur complement is passed on to the parent supernode. All work is
+ * done on dense blocks, which is the main gain over the entry-wise sparse
+ * elimination used by ILUT.
+ */
+class SupernodalLU
+{
+	public:
+		SupernodalLU();
+
+	///	fraction of explicitly stored zeros tolerated when amalgamating supernodes
+		void set_relaxation(double relax) {m_relax = relax;}
+
+	///	maximum number of columns in one supernode
+		void set_max_supernode_size(size_t s) {m_maxSupernodeSize = s;}
+
+	///	symbolic factorization
+	/**
+	 * \param[in]	n			number of rows (and columns)
+	 * \param[in]	vRowStart	row start offsets into vColInd (size n+1)
+	 * \param[in]	vColInd		column indices, sorted per row
+	 * \param[in]	vNewIndex	fill-reducing ordering, newInd = vNewIndex[oldInd]
+	 */
+		void analyze(size_t n, const std::vector<size_t>& vRowStart,
+		             const std::vector<size_t>& vColInd,
+		             const std::vector<size_t>& vNewIndex);
+
+	///	returns if analyze() has been called for exactly this pattern
+		bool same_pattern(const std::vector<size_t>& vRowStart,
+		                  const std::vector<size_t>& vColInd) const;
+
+	///	returns if a symbolic factorization is present
+		bool analyzed() const {return m_bAnalyzed;}
+
+	///	numeric factorization, vValue is aligned with the analyzed vColInd
+		void factorize(const std::vector<double>& vValue);
+
+	///	solves A*x = b, x contains b on entry
+		void solve(std::vector<double>& x) const;
+
+	///	number of unknowns
+		size_t size() const {return m_n;}
+
+	///	number of supernodes
+		size_t num_supernodes() const {return m_vSnFirst.size() ? m_vSnFirst.size() - 1 : 0;}
+
+	///	number of stored entries in L and U
+		size_t num_factor_entries() const {return m_vFactorStart.size() ? m_vFactorStart.back() : 0;}
+
+	///	size of the largest frontal matrix
+		size_t max_front_size() const {return m_maxFront;}
+
+	///	prints statistics of the symbolic factorization
+		void print_statistics() const;
+
+	protected:
+	///	front size of supernode s
+		size_t front_size(size_t s) const {return m_vSnIndStart[s+1] - m_vSnIndStart[s];}
+
+	///	number of pivot columns of supernode s
+		size_t width(size_t s) const {return m_vSnFirst[s+1] - m_vSnFirst[s];}
+
+	///	builds the symmetrized graph without diagonal in the ordering vPerm
+		void build_graph(std::vector<size_t>& vAdjStart, std::vector<size_t>& vAdj,
+		                 const std::vector<size_t>& vPerm) const;
+
+	protected:
+		double m_relax;
+		size_t m_maxSupernodeSize;
+
+		bool m_bAnalyzed;
+		size_t m_n;
+
+	///	analyzed pattern (original numbering)
+		std::vector<size_t> m_vRowStart;
+		std::vector<size_t> m_vColInd;
+
+	///	final (postordered) permutation, new = m_vPerm[old]
+		std::vector<size_t> m_vPerm;
+
+	///	first column of each supernode (size numSn+1)
+		std::vector<size_t> m_vSnFirst;
+	///	parent supernode, (size_t)-1 for roots
+		std::vector<size_t> m_vSnParent;
+	///	children of each supernode
+		std::vector<size_t> m_vChildStart;
+		std::vector<size_t> m_vChild;
+	///	front index set of each supernode: pivot columns followed by the
+	///	sorted row structure below
+		std::vector<size_t> m_vSnIndStart;
+		std::vector<size_t> m_vSnInd;
+	///	positions of the update rows of each supernode in the parent front
+		std::vector<size_t> m_vRelStart;
+		std::vector<size_t> m_vRel;
+	///	matrix entries assembled into each front: entry index and front offset
+		std::vector<size_t> m_vAsmStart;
+		std::vector<size_t> m_vAsmEntry;
+		std::vector<size_t> m_vAsmOffset;
+
+	///	factor storage per supernode: the w pivot rows of the front (U, with
+	///	unit lower L11 below the diagonal) followed by the L21 panel
+		std::vector<size_t> m_vFactorStart;
+		std::vector<double> m_vFactor;
+		size_t m_maxFront;
+
+		bool m_bFactorized;
+		mutable std::vector<double> m_vWork;
+};
+
+} // end namespace ug
+
+#endif /* __H__LIB_ALGEBRA__SUPERNODAL_LU__ */
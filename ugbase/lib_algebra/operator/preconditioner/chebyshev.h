@@ -0,0 +1,358 @@
+/*
+ * Copyright (c) 2017:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+
+#ifndef __H__UG__LIB_ALGEBRA__OPERATOR__PRECONDITIONER__CHEBYSHEV__
+#define __H__UG__LIB_ALGEBRA__OPERATOR__PRECONDITIONER__CHEBYSHEV__
+
+#include <cmath>
+#include "lib_algebra/operator/interface/preconditioner.h"
+#include "lib_algebra/operator/preconditioner/l1_jacobi.h"
+
+#ifdef UG_PARALLEL
+	#include "lib_algebra/parallelization/parallelization.h"
+#endif
+
+namespace ug{
+
+///	Chebyshev polynomial smoother
+/**
+ * Applies a Chebyshev polynomial of a given degree in the Jacobi (or
+ * l1-Jacobi) preconditioned operator \f$ D^{-1} A \f$ to the defect, such that
+ * the error components belonging to the eigenvalues in
+ *
+ * 		\f$ [\alpha \lambda_{max}, \beta \lambda_{max}] \f$
+ *
+ * of \f$ D^{-1} A \f$ are damped uniformly. The default factors
+ * \f$ \alpha = 0.3, \beta = 1.1 \f$ target the upper part of the spectrum,
+ * which makes the iteration a smoother for multigrid methods.
+ *
+ * Each step only consists of (degree - 1) matrix-vector products and vector
+ * updates. No inner products (and thus no global reductions) are needed, so
+ * that the smoother parallelizes as well as Jacobi.
+ *
+ * \f$ \lambda_{max} \f$ is estimated during init by a few power iterations
+ * on \f$ D^{-1} A \f$, unless it is set explicitly. The estimate is kept
+ * across re-inits with matrices of the same size, since the spectrum changes
+ * only little between e.g. Newton steps or time steps. Use
+ * set_reestimate_interval to refresh it regularly.
+ *
+ * References:
+ * <ul>
+ * <li> M. Adams, M. Brezina, J. Hu and R. Tuminaro. Parallel multigrid
+ *      smoothing: polynomial versus Gauss-Seidel. J. Comput. Phys. 188 (2003)
+ * <li> Y. Saad. Iterative methods for sparse linear systems, Alg. 12.1
+ * </ul>
+ */
+template <typename TAlgebra>
+class Chebyshev : public IPreconditioner<TAlgebra>
+{
+	public:
+	///	Algebra type
+		typedef TAlgebra algebra_type;
+
+	///	Vector type
+		typedef typename TAlgebra::vector_type vector_type;
+
+	///	Matrix type
+		typedef typename TAlgebra::matrix_type matrix_type;
+
+	///	Matrix Operator type
+		typedef typename IPreconditioner<TAlgebra>::matrix_operator_type matrix_operator_type;
+
+	///	Base type
+		typedef IPreconditioner<TAlgebra> base_type;
+
+	public:
+	///	default constructor
+		Chebyshev() :
+			m_degree(3), m_lowerFactor(0.3), m_upperFactor(1.1),
+			m_numPowerIts(10), m_bL1(false), m_maxEVUser(0),
+			m_reestimateInterval(0)
+		{
+			reset_estimate();
+		}
+
+	///	constructor setting the polynomial degree
+		Chebyshev(size_t degree) :
+			m_degree(degree), m_lowerFactor(0.3), m_upperFactor(1.1),
+			m_numPowerIts(10), m_bL1(false), m_maxEVUser(0),
+			m_reestimateInterval(0)
+		{
+			reset_estimate();
+		}
+
+	/// clone constructor
+	/**	Only the settings are copied. The eigenvalue estimate is not, since
+	 * clones are typically used for different operators (e.g. on the levels
+	 * of a multigrid hierarchy).*/
+		Chebyshev(const Chebyshev<TAlgebra>& parent) :
+			base_type(parent),
+			m_degree(parent.m_degree),
+			m_lowerFactor(parent.m_lowerFactor),
+			m_upperFactor(parent.m_upperFactor),
+			m_numPowerIts(parent.m_numPowerIts),
+			m_bL1(parent.m_bL1),
+			m_maxEVUser(parent.m_maxEVUser),
+			m_reestimateInterval(parent.m_reestimateInterval)
+		{
+			reset_estimate();
+		}
+
+	///	Clone
+		virtual SmartPtr<ILinearIterator<vector_type> > clone()
+		{
+			return make_sp(new Chebyshev<algebra_type>(*this));
+		}
+
+	///	returns if parallel solving is supported
+		virtual bool supports_parallel() const {return true;}
+
+	///	Destructor
+		virtual ~Chebyshev() {}
+
+	///	sets the degree of the polynomial (number of matrix-vector products + 1)
+		void set_degree(size_t degree)
+		{
+			UG_COND_THROW(degree < 1, "Chebyshev: degree has to be at least 1.");
+			m_degree = degree;
+		}
+
+	///	sets the targeted eigenvalue interval relative to the largest eigenvalue
+		void set_eigenvalue_factors(number lower, number upper)
+		{
+			UG_COND_THROW(lower <= 0 || lower >= upper,
+						  "Chebyshev: factors have to satisfy 0 < lower < upper.");
+			m_lowerFactor = lower;
+			m_upperFactor = upper;
+		}
+
+	///	sets the number of power iterations used to estimate the largest eigenvalue
+		void set_num_power_iterations(size_t n)	{m_numPowerIts = n;}
+
+	///	sets the largest eigenvalue of D^{-1}A explicitly. 0 enables the estimate.
+		void set_max_eigenvalue(number maxEV)	{m_maxEVUser = maxEV;}
+
+	///	if enabled, the l1 row sums are used instead of the diagonal
+		void set_l1_scaling(bool bL1)			{m_bL1 = bL1;}
+
+	///	re-estimates the largest eigenvalue every n-th init. 0: only if the size changes
+		void set_reestimate_interval(size_t n)	{m_reestimateInterval = n;}
+
+	///	returns the largest eigenvalue of D^{-1}A used in the last init
+		number max_eigenvalue() const
+		{
+			return (m_maxEVUser > 0) ? m_maxEVUser : m_maxEVEstimate;
+		}
+
+	protected:
+	///	Name of preconditioner
+		virtual const char* name() const {return "Chebyshev";}
+
+	///	Preprocess routine
+		virtual bool preprocess(SmartPtr<MatrixOperator<matrix_type, vector_type> > pOp)
+		{
+			PROFILE_BEGIN_GROUP(Chebyshev_preprocess, "algebra Chebyshev");
+
+			matrix_type& mat = *pOp;
+			if(mat.num_rows() != mat.num_cols()){
+				UG_LOG("Square Matrix needed for Chebyshev Iteration.\n");
+				return false;
+			}
+
+			if(!ComputeInverseDiagonal(m_diagInv, mat, m_bL1))
+				return false;
+
+			if(m_maxEVUser > 0)
+				return true;
+
+		//	reuse the estimate from a previous init if possible
+			++m_numInitsSinceEstimate;
+			if(m_maxEVEstimate > 0 && m_estimateSize == mat.num_rows()
+				&& (m_reestimateInterval == 0
+					|| m_numInitsSinceEstimate < m_reestimateInterval))
+				return true;
+
+			m_maxEVEstimate = estimate_max_eigenvalue(*pOp);
+			m_estimateSize = mat.num_rows();
+			m_numInitsSinceEstimate = 0;
+
+			if(!(m_maxEVEstimate > 0)){
+				UG_LOG("Chebyshev: Could not estimate the largest eigenvalue. "
+						"Is the matrix positive definite?\n");
+				reset_estimate();
+				return false;
+			}
+			return true;
+		}
+
+		virtual bool step(SmartPtr<MatrixOperator<matrix_type, vector_type> > pOp,
+		                  vector_type& c, const vector_type& d)
+		{
+			PROFILE_BEGIN_GROUP(Chebyshev_step, "algebra Chebyshev");
+
+			const number maxEV = max_eigenvalue();
+			const number lmax = m_upperFactor * maxEV;
+			const number lmin = m_lowerFactor * maxEV;
+			const number theta = 0.5 * (lmax + lmin);
+			const number delta = 0.5 * (lmax - lmin);
+			const number sigma = theta / delta;
+			number rho = 1.0 / sigma;
+
+			create_work_vectors(d);
+			vector_type& r = *m_spR;
+			vector_type& p = *m_spP;
+			vector_type& z = *m_spZ;
+
+		//	p = 1/theta D^{-1} d, c = p
+			r = d;
+			ApplyInverseDiagonal(p, m_diagInv, r);
+			if(!make_consistent(p)) return false;
+			p *= 1.0 / theta;
+			c = p;
+
+			for(size_t k = 1; k < m_degree; ++k){
+			//	r = r - A p (additive), z = D^{-1} r (consistent)
+				pOp->apply_sub(r, p);
+				ApplyInverseDiagonal(z, m_diagInv, r);
+				if(!make_consistent(z)) return false;
+
+			//	p = rho_k rho_{k-1} p + 2 rho_k / delta z, c = c + p
+				const number rhoNew = 1.0 / (2.0 * sigma - rho);
+				VecScaleAdd(p, rhoNew * rho, p, 2.0 * rhoNew / delta, z);
+				VecScaleAdd(c, 1.0, c, 1.0, p);
+				rho = rhoNew;
+			}
+
+			return true;
+		}
+
+	///	Postprocess routine
+		virtual bool postprocess() {return true;}
+
+	protected:
+	///	power iteration for the largest eigenvalue of D^{-1}A
+	/**	Uses the quotient (D^{-1}Ax, Ax) / (x, Ax), which is the Rayleigh
+	 * quotient of the symmetric M = D^{-1/2} A D^{-1/2} for the vector
+	 * M^{1/2} D^{1/2} x. It approaches the largest eigenvalue from below,
+	 * which is compensated by the upper eigenvalue factor.*/
+		number estimate_max_eigenvalue(matrix_operator_type& A)
+		{
+			PROFILE_BEGIN_GROUP(Chebyshev_estimate, "algebra Chebyshev");
+
+			SmartPtr<vector_type> spX = m_diagInv.clone_without_values();
+			SmartPtr<vector_type> spY = m_diagInv.clone_without_values();
+			SmartPtr<vector_type> spZ = m_diagInv.clone_without_values();
+			vector_type& x = *spX;
+			vector_type& y = *spY;
+			vector_type& z = *spZ;
+
+		//	a deterministic start vector with components in all directions
+			for(size_t i = 0; i < x.size(); ++i)
+				for(size_t k = 0; k < (size_t)GetSize(x[i]); ++k)
+					BlockRef(x[i], k) = 0.5 + (number)((7919 * i + 104729 * k) % 1000) / 1000.;
+			if(!make_consistent(x)) return 0;
+
+			number lambda = 0;
+			for(size_t it = 0; it < m_numPowerIts; ++it){
+				A.apply(y, x);
+				ApplyInverseDiagonal(z, m_diagInv, y);
+				if(!make_consistent(z)) return 0;
+
+				const number xAx = VecProd(x, y);
+				const number zAz = VecProd(z, y);
+				if(!(xAx > 0) || !(zAz > 0))
+					return 0;
+
+				lambda = zAz / xAx;
+				VecScaleAssign(x, 1.0 / std::sqrt(zAz), z);
+			}
+
+			return lambda;
+		}
+
+	///	changes an additive vector to a consistent one
+		bool make_consistent(vector_type& v)
+		{
+#ifdef UG_PARALLEL
+			v.set_storage_type(PST_ADDITIVE);
+			if(!v.change_storage_type(PST_CONSISTENT)){
+				UG_LOG("ERROR in 'Chebyshev': Cannot change parallel "
+						"status of vector to consistent.\n");
+				return false;
+			}
+#endif
+			return true;
+		}
+
+		void create_work_vectors(const vector_type& d)
+		{
+			if(m_spR.valid() && m_spR->size() == d.size())
+				return;
+			m_spR = d.clone_without_values();
+			m_spP = d.clone_without_values();
+			m_spZ = d.clone_without_values();
+		}
+
+		void reset_estimate()
+		{
+			m_maxEVEstimate = 0;
+			m_estimateSize = 0;
+			m_numInitsSinceEstimate = 0;
+		}
+
+	protected:
+	///	settings
+		size_t m_degree;
+		number m_lowerFactor;
+		number m_upperFactor;
+		size_t m_numPowerIts;
+		bool m_bL1;
+		number m_maxEVUser;
+		size_t m_reestimateInterval;
+
+	///	cached estimate of the largest eigenvalue of D^{-1}A
+		number m_maxEVEstimate;
+		size_t m_estimateSize;
+		size_t m_numInitsSinceEstimate;
+
+	///	inverse (l1-)diagonal, consistent in parallel
+		vector_type m_diagInv;
+
+	///	work vectors of step
+		SmartPtr<vector_type> m_spR;
+		SmartPtr<vector_type> m_spP;
+		SmartPtr<vector_type> m_spZ;
+};
+
+} // end namespace ug
+
+#endif
@@ -0,0 +1,225 @@
+/*
+ * Copyright (c) 2017:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+
+#ifndef __H__UG__LIB_ALGEBRA__OPERATOR__PRECONDITIONER__L1_JACOBI__
+#define __H__UG__LIB_ALGEBRA__OPERATOR__PRECONDITIONER__L1_JACOBI__
+
+#include <cmath>
+#include "lib_algebra/operator/interface/preconditioner.h"
+#include "lib_algebra/small_algebra/small_algebra.h"
+
+#ifdef UG_PARALLEL
+	#include "lib_algebra/parallelization/parallelization.h"
+#endif
+
+namespace ug{
+
+///	computes the inverse of the point diagonal (or of the l1 row sums) of A
+/**	For each scalar row k of A, the entry k of diagInvOut is set to
+ *
+ * 		1 / a_kk						(bL1 == false)
+ * 		1 / sum_j |a_kj|				(bL1 == true)
+ *
+ * In parallel, the diagonal is computed from the additive matrix and made
+ * consistent, i.e., the l1 row sums are upper bounds of the row sums of the
+ * assembled matrix.
+ *
+ * \returns false if an entry can't be inverted.
+ */
+template <typename matrix_type, typename vector_type>
+bool ComputeInverseDiagonal(vector_type& diagInvOut, matrix_type& A, bool bL1)
+{
+	PROFILE_FUNC_GROUP("algebra");
+	typedef typename matrix_type::const_row_iterator const_row_iterator;
+
+	const matrix_type& cA = A;
+	const size_t numRows = A.num_rows();
+	diagInvOut.resize(numRows);
+#ifdef UG_PARALLEL
+	diagInvOut.set_layouts(A.layouts());
+#endif
+
+	for(size_t i = 0; i < numRows; ++i){
+		const size_t blockSize = GetRows(A(i, i));
+		for(size_t k = 0; k < blockSize; ++k)
+			BlockRef(diagInvOut[i], k) = 0;
+
+		if(!bL1){
+			for(size_t k = 0; k < blockSize; ++k)
+				BlockRef(diagInvOut[i], k) = BlockRef(A(i, i), k, k);
+		}
+		else{
+			for(const_row_iterator it = cA.begin_row(i); it != cA.end_row(i); ++it){
+				for(size_t k = 0; k < blockSize; ++k)
+					for(size_t l = 0; l < (size_t)GetCols(it.value()); ++l)
+						BlockRef(diagInvOut[i], k) += std::fabs(BlockRef(it.value(), k, l));
+			}
+		}
+	}
+
+#ifdef UG_PARALLEL
+	diagInvOut.set_storage_type(PST_ADDITIVE);
+	diagInvOut.change_storage_type(PST_CONSISTENT);
+#endif
+
+	for(size_t i = 0; i < numRows; ++i){
+		for(size_t k = 0; k < (size_t)GetSize(diagInvOut[i]); ++k){
+			number& d = BlockRef(diagInvOut[i], k);
+			if(d == 0){
+				UG_LOG("ComputeInverseDiagonal: zero " << (bL1 ? "row sum" : "diagonal")
+					   << " in row " << i << ".\n");
+				return false;
+			}
+			d = 1.0 / d;
+		}
+	}
+	return true;
+}
+
+///	multiplies d componentwise with the inverse diagonal, c = D^{-1} d
+/**	The parallel storage type of c is not touched. Since diagInv is
+ * consistent, c has the storage type of d.*/
+template <typename vector_type>
+void ApplyInverseDiagonal(vector_type& c, const vector_type& diagInv,
+                          const vector_type& d)
+{
+	for(size_t i = 0; i < diagInv.size(); ++i)
+		for(size_t k = 0; k < (size_t)GetSize(diagInv[i]); ++k)
+			BlockRef(c[i], k) = BlockRef(diagInv[i], k) * BlockRef(d[i], k);
+}
+
+
+///	l1-Jacobi smoother
+/**
+ * The l1-Jacobi iteration is the Jacobi iteration with the diagonal replaced
+ * by the l1 norms of the (scalar) matrix rows,
+ *
+ * 		\f$ c = D_{l1}^{-1} d, \quad (D_{l1})_{kk} = \sum_j |a_{kj}| \f$.
+ *
+ * Since \f$ D_{l1} - A \f$ is positive semi-definite for symmetric A, the
+ * iteration converges for spd matrices without damping and is thus a robust
+ * smoother which, like Jacobi, only needs one vector update and no inner
+ * products per step. In parallel, the row sums of the additive matrix are
+ * used, which further increases the diagonal at process boundaries.
+ *
+ * References:
+ * <ul>
+ * <li> A. H. Baker, R. D. Falgout, T. V. Kolev and U. M. Yang. Multigrid
+ *      smoothers for ultraparallel computing. SIAM J. Sci. Comput. 33 (2011)
+ * </ul>
+ */
+template <typename TAlgebra>
+class L1Jacobi : public IPreconditioner<TAlgebra>
+{
+	public:
+	///	Algebra type
+		typedef TAlgebra algebra_type;
+
+	///	Vector type
+		typedef typename TAlgebra::vector_type vector_type;
+
+	///	Matrix type
+		typedef typename TAlgebra::matrix_type matrix_type;
+
+	///	Base type
+		typedef IPreconditioner<TAlgebra> base_type;
+
+	public:
+	///	default constructor
+		L1Jacobi() {}
+
+	///	constructor setting the damping parameter
+		L1Jacobi(number damp) {this->set_damp(damp);}
+
+	/// clone constructor
+		L1Jacobi(const L1Jacobi<TAlgebra>& parent) : base_type(parent) {}
+
+	///	Clone
+		virtual SmartPtr<ILinearIterator<vector_type> > clone()
+		{
+			return make_sp(new L1Jacobi<algebra_type>(*this));
+		}
+
+	///	returns if parallel solving is supported
+		virtual bool supports_parallel() const {return true;}
+
+	///	Destructor
+		virtual ~L1Jacobi() {}
+
+	protected:
+	///	Name of preconditioner
+		virtual const char* name() const {return "L1Jacobi";}
+
+	///	Preprocess routine
+		virtual bool preprocess(SmartPtr<MatrixOperator<matrix_type, vector_type> > pOp)
+		{
+			PROFILE_BEGIN_GROUP(L1Jacobi_preprocess, "algebra L1Jacobi");
+
+			matrix_type& mat = *pOp;
+			if(mat.num_rows() != mat.num_cols()){
+				UG_LOG("Square Matrix needed for L1Jacobi Iteration.\n");
+				return false;
+			}
+
+			return ComputeInverseDiagonal(m_diagInv, mat, true);
+		}
+
+		virtual bool step(SmartPtr<MatrixOperator<matrix_type, vector_type> > pOp,
+		                  vector_type& c, const vector_type& d)
+		{
+			PROFILE_BEGIN_GROUP(L1Jacobi_step, "algebra L1Jacobi");
+
+		// 	c = D_l1^{-1} * d. The correction is additive, make it consistent
+			ApplyInverseDiagonal(c, m_diagInv, d);
+
+#ifdef UG_PARALLEL
+			c.set_storage_type(PST_ADDITIVE);
+			if(!c.change_storage_type(PST_CONSISTENT)){
+				UG_LOG("ERROR in 'L1Jacobi::step': Cannot change parallel "
+						"status of correction to consistent.\n");
+				return false;
+			}
+#endif
+			return true;
+		}
+
+	///	Postprocess routine
+		virtual bool postprocess() {return true;}
+
+	protected:
+	///	inverse of the l1 row sums (consistent in parallel)
+		vector_type m_diagInv;
+};
+
+} // end namespace ug
+
+#endif
@@ -0,0 +1,232 @@
+/*
+ * Copyright (c) 2017:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+
+
+#ifndef __H__UG__LIB_ALGEBRA__OPERATOR__PRECONDITIONER__MIXED_PRECISION__
+#define __H__UG__LIB_ALGEBRA__OPERATOR__PRECONDITIONER__MIXED_PRECISION__
+
+#include "common/error.h"
+#include "common/util/smart_pointer.h"
+#include "lib_algebra/cpu_algebra_types.h"
+#include "lib_algebra/operator/interface/preconditioner.h"
+#include "lib_algebra/operator/interface/matrix_operator.h"
+
+namespace ug{
+
+///	copies a scalar sparse matrix into a matrix of different precision
+/**	The sparsity pattern is copied as is, values are converted entry-wise
+ * (e.g. rounded to the nearest float). In parallel, layouts and storage type
+ * are copied as well.*/
+template <typename TDestMatrix, typename TSrcMatrix>
+void ConvertMatrixPrecision(TDestMatrix& dest, const TSrcMatrix& src)
+{
+	PROFILE_FUNC_GROUP("algebra");
+	typedef typename TDestMatrix::value_type dest_value_type;
+	typedef typename TSrcMatrix::const_row_iterator const_row_iterator;
+
+	dest.resize_and_clear(src.num_rows(), src.num_cols());
+	for(size_t i = 0; i < src.num_rows(); ++i)
+		for(const_row_iterator it = src.begin_row(i); it != src.end_row(i); ++it)
+			dest(i, it.index()) = static_cast<dest_value_type>(it.value());
+	dest.defragment();
+
+#ifdef UG_PARALLEL
+	dest.set_layouts(src.layouts());
+	dest.set_storage_type(src.get_storage_mask());
+#endif
+}
+
+///	copies a scalar vector into a vector of different precision
+/**	In parallel, layouts and storage type are copied as well.*/
+template <typename TDestVector, typename TSrcVector>
+void ConvertVectorPrecision(TDestVector& dest, const TSrcVector& src)
+{
+	typedef typename TDestVector::value_type dest_value_type;
+	if(dest.size() != src.size()) dest.resize(src.size());
+	for(size_t i = 0; i < src.size(); ++i)
+		dest[i] = static_cast<dest_value_type>(src[i]);
+
+#ifdef UG_PARALLEL
+	dest.set_layouts(src.layouts());
+	dest.set_storage_type(src.get_storage_mask());
+#endif
+}
+
+///	Applies a linear iterator of a lower precision algebra as preconditioner
+/**
+ * The operator is converted to the matrix type of TLowAlgebra on
+ * preprocessing and the inner iterator is initialized with the converted
+ * operator. In each step the defect is converted to the vector type of
+ * TLowAlgebra, the inner iterator computes the correction and the
+ * correction is converted back. The surrounding iteration (a Krylov method
+ * or the defect correction of the LinearSolver) still computes the defect in
+ * the precision of TAlgebra. This is a mixed precision iterative refinement:
+ * the rounding errors of the preconditioner only affect the convergence rate,
+ * the accuracy of the final solution is determined by the outer iteration.
+ *
+ * Both algebras have to be scalar, since entries are converted one by one.
+ * The parallel storage types are handled by the inner iterator.
+ *
+ * \tparam	TAlgebra		algebra of the outer iteration
+ * \tparam	TLowAlgebra		algebra in which the inner iterator is applied
+ */
+template <typename TAlgebra, typename TLowAlgebra = CPUFloatAlgebra>
+class MixedPrecisionPreconditioner : public IPreconditioner<TAlgebra>
+{
+	public:
+	///	Algebra type
+		typedef TAlgebra algebra_type;
+
+	///	Vector type
+		typedef typename TAlgebra::vector_type vector_type;
+
+	///	Matrix type
+		typedef typename TAlgebra::matrix_type matrix_type;
+
+	///	Matrix type of the inner iterator
+		typedef typename TLowAlgebra::matrix_type low_matrix_type;
+
+	///	Vector type of the inner iterator
+		typedef typename TLowAlgebra::vector_type low_vector_type;
+
+	///	Inner iterator type
+		typedef ILinearIterator<low_vector_type> inner_type;
+
+	///	Base type
+		typedef IPreconditioner<TAlgebra> base_type;
+
+	protected:
+		using base_type::print_debugger_message;
+
+	public:
+	//	Constructor
+		MixedPrecisionPreconditioner() : m_bDisablePreprocessing(false) {}
+
+	//	Constructor setting the inner iterator
+		MixedPrecisionPreconditioner(SmartPtr<inner_type> spInner)
+			: m_spInner(spInner), m_bDisablePreprocessing(false) {}
+
+	/// clone constructor
+		MixedPrecisionPreconditioner(const MixedPrecisionPreconditioner<TAlgebra, TLowAlgebra> &parent)
+			: base_type(parent),
+			  m_bDisablePreprocessing(parent.m_bDisablePreprocessing)
+		{
+			SmartPtr<inner_type> spInner = parent.m_spInner;
+			if(spInner.valid())
+				m_spInner = spInner->clone();
+		}
+
+	///	Clone
+		virtual SmartPtr<ILinearIterator<vector_type> > clone()
+		{
+			return make_sp(new MixedPrecisionPreconditioner<TAlgebra, TLowAlgebra>(*this));
+		}
+
+	///	Destructor
+		virtual ~MixedPrecisionPreconditioner(){}
+
+	///	sets the inner iterator
+		void set_inner(SmartPtr<inner_type> spInner)	{m_spInner = spInner;}
+
+	///	returns the inner iterator
+		SmartPtr<inner_type> inner()					{return m_spInner;}
+
+	///	returns if parallel solving is supported
+		virtual bool supports_parallel() const
+		{
+			return m_spInner.valid() && m_spInner->supports_parallel();
+		}
+
+	/// disable preprocessing (if underlying matrix has not changed)
+		void set_disable_preprocessing(bool bDisable)	{m_bDisablePreprocessing = bDisable;}
+
+	protected:
+	//	Name of preconditioner
+		virtual const char* name() const {return "MixedPrecisionPreconditioner";}
+
+	//	Preprocess routine
+		virtual bool preprocess(SmartPtr<MatrixOperator<matrix_type, vector_type> > pOp)
+		{
+			if (m_bDisablePreprocessing) return true;
+
+			PROFILE_BEGIN_GROUP(MixedPrecision_preprocess, "algebra MixedPrecision");
+			UG_COND_THROW(m_spInner.invalid(), name() << ": No inner iterator set.");
+
+			if(m_spLowOp.invalid())
+				m_spLowOp = make_sp(new MatrixOperator<low_matrix_type, low_vector_type>);
+			ConvertMatrixPrecision(m_spLowOp->get_matrix(), pOp->get_matrix());
+
+			return m_spInner->init(m_spLowOp);
+		}
+
+	//	Stepping routine
+		virtual bool step(SmartPtr<MatrixOperator<matrix_type, vector_type> > pOp,
+		                  vector_type& c,
+		                  const vector_type& d)
+		{
+			PROFILE_BEGIN_GROUP(MixedPrecision_step, "algebra MixedPrecision");
+
+			ConvertVectorPrecision(m_d, d);
+			if(m_c.size() != m_d.size()) m_c.resize(m_d.size());
+		#ifdef UG_PARALLEL
+			m_c.set_layouts(m_d.layouts());
+		#endif
+
+			if(!m_spInner->apply(m_c, m_d)){
+				print_debugger_message(std::string(name()) + ": Inner iterator failed.\n");
+				return false;
+			}
+
+			ConvertVectorPrecision(c, m_c);
+			return true;
+		}
+
+	///	Postprocess routine
+		virtual bool postprocess() {return true;}
+
+	protected:
+	///	inner iterator
+		SmartPtr<inner_type> m_spInner;
+
+	///	converted operator
+		SmartPtr<MatrixOperator<low_matrix_type, low_vector_type> > m_spLowOp;
+
+	///	converted defect and correction
+		low_vector_type m_d, m_c;
+
+	///	whether the preprocessing is skipped
+		bool m_bDisablePreprocessing;
+};
+
+} // end namespace ug
+
+#endif
@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2017:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+
+
+#ifndef __H__UG__LIB_ALGEBRA__OPERATOR__PRECONDITIONER__MIXED_PRECISION_ILU__
+#define __H__UG__LIB_ALGEBRA__OPERATOR__PRECONDITIONER__MIXED_PRECISION_ILU__
+
+#include "common/util/smart_pointer.h"
+#include "lib_algebra/cpu_algebra_types.h"
+#include "mixed_precision.h"
+#include "ilu.h"
+
+namespace ug{
+
+///	ILU preconditioner, that is factorized and applied in single precision
+/**
+ * This preconditioner runs the ILU of the single precision algebra
+ * CPUFloatAlgebra inside a MixedPrecisionPreconditioner, i.e. the incomplete
+ * LU factors are stored as a SparseMatrix<float> and the triangular solves
+ * are performed in single precision. Defect and correction are converted at
+ * the interface.
+ *
+ * Compared to the double precision ILU, the memory of the factors and the
+ * memory traffic of each application are reduced by one third (values are
+ * stored in 4 instead of 8 bytes, column indices are unchanged).
+ *
+ * Since the single precision factors are restricted to scalar entries, this
+ * preconditioner is only available for scalar (CPU1) algebras. In parallel,
+ * the same strategies as in ILU are used.
+ */
+template <typename TAlgebra>
+class MixedPrecisionILU : public MixedPrecisionPreconditioner<TAlgebra, CPUFloatAlgebra>
+{
+	public:
+	///	Algebra type
+		typedef TAlgebra algebra_type;
+
+	///	Vector type
+		typedef typename TAlgebra::vector_type vector_type;
+
+	///	single precision ILU type
+		typedef ILU<CPUFloatAlgebra> ilu_type;
+
+	///	Base type
+		typedef MixedPrecisionPreconditioner<TAlgebra, CPUFloatAlgebra> base_type;
+
+	public:
+	//	Constructor
+		MixedPrecisionILU(double beta=0.0) :
+			m_spILU(make_sp(new ilu_type(beta)))
+		{
+			base_type::set_inner(m_spILU);
+		}
+
+	/// clone constructor
+		MixedPrecisionILU(const MixedPrecisionILU<TAlgebra> &parent)
+			: base_type(parent),
+			  m_spILU(base_type::inner().template cast_dynamic<ilu_type>())
+		{}
+
+	///	Clone
+		virtual SmartPtr<ILinearIterator<vector_type> > clone()
+		{
+			return make_sp(new MixedPrecisionILU<algebra_type>(*this));
+		}
+
+	///	Destructor
+		virtual ~MixedPrecisionILU(){}
+
+	///	set factor for \f$ ILU_{\beta} \f$
+		void set_beta(double beta) 						{m_spILU->set_beta(beta);}
+
+	///	sets the smallest allowed value for sorted factorization
+		void set_sort_eps(number eps)					{m_spILU->set_sort_eps(eps);}
+
+	///	sets the smallest allowed value for the Aii/Bi quotient
+		void set_inversion_eps(number eps)				{m_spILU->set_inversion_eps(eps);}
+
+	///	enables consistent interfaces (see ILU::enable_consistent_interfaces)
+		void enable_consistent_interfaces (bool enable)	{m_spILU->enable_consistent_interfaces(enable);}
+
+	protected:
+	//	Name of preconditioner
+		virtual const char* name() const {return "MixedPrecisionILU";}
+
+	protected:
+	///	the single precision ILU, which is the inner iterator
+		SmartPtr<ilu_type> m_spILU;
+
+	private:
+	//	the inner iterator is fixed
+		using base_type::set_inner;
+};
+
+} // end namespace ug
+
+#endif
@@ -35,6 +35,7 @@
 
 #include "common/util/smart_pointer.h"
 #include "lib_algebra/operator/interface/preconditioner.h"
+#include "lib_algebra/algebra_common/multicolor_patch_smoother.h"
 
 #ifdef UG_PARALLEL
 	#include "pcl/pcl_util.h"
@@ -106,6 +107,33 @@ bool Vanka_step(const Matrix_type &A, Vector_type &x, const Vector_type &b, numb
 	return true;
 }
 
+// Collects the Vanka patches of A for multicolor smoothing: For each row i with
+// vanishing diagonal (i.e. a pressure row) the patch consists of all indices
+// coupled to i. If vCenter is not NULL, the rows i are stored as well.
+template<typename Matrix_type>
+void CollectVankaPatches(const Matrix_type &A, MultiColorPatches& mcp,
+                         std::vector<size_t>* vCenter = NULL)
+{
+	mcp.clear();
+	if(vCenter) vCenter->clear();
+
+	std::vector<size_t> vInd;
+	for(size_t i=0; i < A.num_rows(); i++)
+	{
+		if (A(i,i)!=0) continue;
+
+		vInd.clear();
+		for(typename Matrix_type::const_row_iterator it = A.begin_row(i); it != A.end_row(i) ; ++it)
+			vInd.push_back(it.index());
+		if (vInd.size()>MAXBLOCKSIZE) UG_THROW("MAXBLOCKSIZE too small\n");
+
+		mcp.add_patch(vInd);
+		if(vCenter) vCenter->push_back(i);
+	}
+
+	mcp.color(A);
+}
+
 // Diagonal Vanka block smoother:
 // When setting up the local block matrix the side-diagonal entries are left away, except for the pressure.
 // The local block matrix therefore has the form
@@ -120,17 +148,58 @@ bool Vanka_step(const Matrix_type &A, Vector_type &x, const Vector_type &b, numb
 // The velocity off-diagonal entries are considered in the local defect vector.
 // The local block system can be solved in O(n) time so that a step of this smoother is computationly cheaper than the
 // full Vanka smoother.
+// Relaxes the diagonal Vanka block centered at the pressure row i.
+// s is a work array of at least MAXBLOCKSIZE entries.
 template<typename Matrix_type, typename Vector_type>
-bool Diag_Vanka_step(const Matrix_type &A, Vector_type &x, const Vector_type &b, number relax)
+void Diag_Vanka_block(const Matrix_type &A, Vector_type &x, const Vector_type &b, number relax,
+                      size_t i, typename Vector_type::value_type* s)
 {
-	typedef typename Vector_type::value_type vector_block_type;
-	DenseVector< VariableArray1<vector_block_type> > s;
-	DenseVector< VariableArray1<vector_block_type> > localx;
-	DenseMatrix< VariableArray2<number> > mat;
-	s.resize(MAXBLOCKSIZE);
 	typedef typename Matrix_type::value_type block_type;
 
 	size_t blockind[MAXBLOCKSIZE];
+	size_t blocksize=0;
+
+	for(typename Matrix_type::const_row_iterator it = A.begin_row(i); it != A.end_row(i) ; ++it){
+		if (it.index()==i) continue;
+		if (blocksize>=MAXBLOCKSIZE) UG_THROW("MAXBLOCKSIZE too small\n");
+		blockind[blocksize] = it.index();
+		s[blocksize] = b[blockind[blocksize]];
+		for(typename Matrix_type::const_row_iterator rowit = A.begin_row(blockind[blocksize]); rowit != A.end_row(blockind[blocksize]) ; ++rowit){
+				if ((rowit.index()==blockind[blocksize])||(rowit.index()==i)) continue;
+				// s[blocksize] -= a_ij*x_j
+				MatMultAdd(s[blocksize], 1.0, s[blocksize], -1.0, rowit.value(), x[rowit.index()]);
+		};
+		blocksize++;
+	};
+	// remark: blocksize is without pressure variable, so actual blocksize is blocksize+1
+	block_type a_ii = A(i,i);
+	typename Vector_type::value_type s_i = b[i];
+	// Gauss elimination on local block matrix
+	for (size_t j=0;j<blocksize;j++){
+		block_type a_q = A(i,blockind[j]);
+		block_type a_jj =  A(blockind[j],blockind[j]);
+		a_q /= a_jj;
+		// s_i -= a_ij/a_jj*s_j
+		MatMultAdd(s_i, 1.0, s_i, -1.0, a_q, s[j]);
+		// a_ii -= a_ij/a_jj*a_ji
+		a_ii-=a_q*A(blockind[j],i);
+	}
+	// solve diagonalized system
+	// x[i] = s_i/a_ii
+	InverseMatMult(x[i], 1.0, a_ii, s_i);
+	for (size_t j=0;j<blocksize;j++){
+		 // s_j-=a_ji*x_i
+		 MatMultAdd(s[j], 1.0, s[j], -1.0, A(blockind[j],i), x[i]);
+		 // x_j=1/a_jj*s_j
+		 InverseMatMult(x[blockind[j]], relax, A(blockind[j],blockind[j]),s[j]);
+	}
+}
+
+template<typename Matrix_type, typename Vector_type>
+bool Diag_Vanka_step(const Matrix_type &A, Vector_type &x, const Vector_type &b, number relax)
+{
+	typedef typename Vector_type::value_type vector_block_type;
+	std::vector<vector_block_type> s(MAXBLOCKSIZE);
 
 	for(size_t i=0; i < x.size(); i++)
     {
@@ -151,41 +220,40 @@ bool Diag_Vanka_step(const Matrix_type &A, Vector_type &x, const Vector_type &b,
 			continue;
 		};
 
-		size_t blocksize=0;
+		Diag_Vanka_block(A, x, b, relax, i, &s[0]);
+	}
+	return true;
+}
 
-		for(typename Matrix_type::const_row_iterator it = A.begin_row(i); it != A.end_row(i) ; ++it){
-			if (it.index()==i) continue;
-			blockind[blocksize] = it.index();
-			s[blocksize] = b[blockind[blocksize]];
-			for(typename Matrix_type::const_row_iterator rowit = A.begin_row(blockind[blocksize]); rowit != A.end_row(blockind[blocksize]) ; ++rowit){
-					if ((rowit.index()==blockind[blocksize])||(rowit.index()==i)) continue;
-					// s[blocksize] -= a_ij*x_j
-					MatMultAdd(s[blocksize], 1.0, s[blocksize], -1.0, rowit.value(), x[rowit.index()]);
-			};
-			blocksize++;
-		};
-		if (blocksize>MAXBLOCKSIZE) UG_THROW("MAXBLOCKSIZE too small\n");
-		// remark: blocksize is without pressure variable, so actual blocksize is blocksize+1
-		block_type a_ii = A(i,i);
-		typename Vector_type::value_type s_i = b[i];
-		// Gauss elimination on local block matrix
-		for (size_t j=0;j<blocksize;j++){
-			block_type a_q = A(i,blockind[j]);
-			block_type a_jj =  A(blockind[j],blockind[j]);
-			a_q /= a_jj;
-			// s_i -= a_ij/a_jj*s_j
-			MatMultAdd(s_i, 1.0, s_i, -1.0, a_q, s[j]);
-			// a_ii -= a_ij/a_jj*a_ji
-			a_ii-=a_q*A(blockind[j],i);
-		}
-		// solve diagonalized system
-		// x[i] = s_i/a_ii
-		InverseMatMult(x[i], 1.0, a_ii, s_i);
-		for (size_t j=0;j<blocksize;j++){
-			 // s_j-=a_ji*x_i
-			 MatMultAdd(s[j], 1.0, s[j], -1.0, A(blockind[j],i), x[i]);
-			 // x_j=1/a_jj*s_j
-			 InverseMatMult(x[blockind[j]], relax, A(blockind[j],blockind[j]),s[j]);
+// Multicolor variant of Diag_Vanka_step: the blocks of one color are relaxed
+// concurrently if OpenMP is enabled. vCenter maps patches to pressure rows.
+template<typename Matrix_type, typename Vector_type>
+bool Diag_Vanka_multicolor_step(const Matrix_type &A, Vector_type &x, const Vector_type &b, number relax,
+                                const MultiColorPatches& mcp, const std::vector<size_t>& vCenter)
+{
+	typedef typename Vector_type::value_type vector_block_type;
+
+	for(size_t i=0; i < x.size(); i++)
+    {
+        x[i]=0;
+    };
+
+	for(size_t col = 0; col < mcp.num_colors(); ++col)
+	{
+		const int chBegin = (int)mcp.color_chunk_begin(col);
+		const int chEnd = (int)mcp.color_chunk_end(col);
+
+#ifdef UG_OPENMP
+		#pragma omp parallel
+#endif
+		{
+			std::vector<vector_block_type> s(MAXBLOCKSIZE);
+#ifdef UG_OPENMP
+			#pragma omp for schedule(dynamic)
+#endif
+			for(int ch = chBegin; ch < chEnd; ++ch)
+				for(size_t k = mcp.chunk_begin(ch); k < mcp.chunk_end(ch); ++k)
+					Diag_Vanka_block(A, x, b, relax, vCenter[mcp.patch(k)], &s[0]);
 		}
 	}
 	return true;
@@ -219,7 +287,7 @@ class Vanka : public IPreconditioner<TAlgebra>
 
 	public:
 	///	default constructor
-		Vanka() {m_relax=1;};
+		Vanka() : m_bMulticolor(false) {m_relax=1;};
 
 	///	Clone
 		virtual SmartPtr<ILinearIterator<vector_type> > clone()
@@ -227,6 +295,8 @@ class Vanka : public IPreconditioner<TAlgebra>
 			SmartPtr<Vanka<algebra_type> > newInst(new Vanka<algebra_type>());
 			newInst->set_debug(debug_writer());
 			newInst->set_damp(this->damping());
+			newInst->set_relax(m_relax);
+			newInst->set_multicolor(m_bMulticolor);
 			return newInst;
 		}
 
@@ -240,8 +310,16 @@ class Vanka : public IPreconditioner<TAlgebra>
 	public:
 		void set_relax(number omega){m_relax=omega;};
 
+	///	activates multicolor ordering of the blocks
+	/**	Blocks are colored such that blocks of the same color are not coupled.
+	 *	The colors are processed one after another, the blocks of one color
+	 *	concurrently (if compiled with OpenMP). The result differs from the
+	 *	lexicographic variant only in the order of the blocks.*/
+		void set_multicolor(bool bMulticolor){m_bMulticolor=bMulticolor;};
+
 	protected:
 		number m_relax;
+		bool m_bMulticolor;
 
 	protected:
 	///	Name of preconditioner
@@ -261,6 +339,14 @@ class Vanka : public IPreconditioner<TAlgebra>
 				SetDirichletRow(m_A, vIndex);
 			}
 #endif
+			if(m_bMulticolor)
+			{
+#ifdef UG_PARALLEL
+				if(pcl::NumProcs() > 1) CollectVankaPatches(m_A, m_mcp);
+				else
+#endif
+				CollectVankaPatches(*pOp, m_mcp);
+			}
 			return true;
 		}
 
@@ -275,7 +361,8 @@ class Vanka : public IPreconditioner<TAlgebra>
 				dhelp.resize(d.size()); dhelp = d;
 				dhelp.change_storage_type(PST_UNIQUE);
 
-				if(!Vanka_step(m_A, c, dhelp, m_relax)) return false;
+				if(m_bMulticolor) {c.set(0.0); MultiColorPatchStep(m_A, c, dhelp, m_relax, m_mcp);}
+				else if(!Vanka_step(m_A, c, dhelp, m_relax)) return false;
 
 				c.set_storage_type(PST_UNIQUE);
 				return true;
@@ -283,7 +370,8 @@ class Vanka : public IPreconditioner<TAlgebra>
 			else
 #endif
 			{
-				if(!Vanka_step(*pOp, c, d, m_relax)) return false;
+				if(m_bMulticolor) {c.set(0.0); MultiColorPatchStep(*pOp, c, d, m_relax, m_mcp);}
+				else if(!Vanka_step(*pOp, c, d, m_relax)) return false;
 
 #ifdef UG_PARALLEL
 				c.set_storage_type(PST_UNIQUE);
@@ -300,6 +388,8 @@ class Vanka : public IPreconditioner<TAlgebra>
 		matrix_type m_A;
 #endif
 
+	///	block coloring for multicolor ordering
+		MultiColorPatches m_mcp;
 };
 
 ///	Diagvanka Preconditioner, description see above diagvanka_step function
@@ -329,7 +419,7 @@ class DiagVanka : public IPreconditioner<TAlgebra>
 
 	public:
 	///	default constructor
-		DiagVanka() {m_relax=1;};
+		DiagVanka() : m_bMulticolor(false) {m_relax=1;};
 
 	///	Clone
 		virtual SmartPtr<ILinearIterator<vector_type> > clone()
@@ -337,6 +427,8 @@ class DiagVanka : public IPreconditioner<TAlgebra>
 			SmartPtr<DiagVanka<algebra_type> > newInst(new DiagVanka<algebra_type>());
 			newInst->set_debug(debug_writer());
 			newInst->set_damp(this->damping());
+			newInst->set_relax(m_relax);
+			newInst->set_multicolor(m_bMulticolor);
 			return newInst;
 		}
 
@@ -350,8 +442,16 @@ class DiagVanka : public IPreconditioner<TAlgebra>
 	public:
 		void set_relax(number omega){m_relax=omega;};
 
+	///	activates multicolor ordering of the blocks
+	/**	Blocks are colored such that blocks of the same color are not coupled.
+	 *	The colors are processed one after another, the blocks of one color
+	 *	concurrently (if compiled with OpenMP). The result differs from the
+	 *	lexicographic variant only in the order of the blocks.*/
+		void set_multicolor(bool bMulticolor){m_bMulticolor=bMulticolor;};
+
 	protected:
 		number m_relax;
+		bool m_bMulticolor;
 
 	protected:
 	///	Name of preconditioner
@@ -371,6 +471,14 @@ class DiagVanka : public IPreconditioner<TAlgebra>
 				SetDirichletRow(m_A, vIndex);
 			}
 #endif
+			if(m_bMulticolor)
+			{
+#ifdef UG_PARALLEL
+				if(pcl::NumProcs() > 1) CollectVankaPatches(m_A, m_mcp, &m_vCenter);
+				else
+#endif
+				CollectVankaPatches(*pOp, m_mcp, &m_vCenter);
+			}
 			return true;
 		}
 
@@ -385,7 +493,8 @@ class DiagVanka : public IPreconditioner<TAlgebra>
 				dhelp.resize(d.size()); dhelp = d;
 				dhelp.change_storage_type(PST_UNIQUE);
 
-				if(!Diag_Vanka_step(m_A, c, dhelp, m_relax)) return false;
+				if(m_bMulticolor) Diag_Vanka_multicolor_step(m_A, c, dhelp, m_relax, m_mcp, m_vCenter);
+				else if(!Diag_Vanka_step(m_A, c, dhelp, m_relax)) return false;
 
 				c.set_storage_type(PST_UNIQUE);
 				return true;
@@ -394,7 +503,8 @@ class DiagVanka : public IPreconditioner<TAlgebra>
 #endif
 			{
 
-				if(!Diag_Vanka_step(*pOp, c, d, m_relax)) return false;
+				if(m_bMulticolor) Diag_Vanka_multicolor_step(*pOp, c, d, m_relax, m_mcp, m_vCenter);
+				else if(!Diag_Vanka_step(*pOp, c, d, m_relax)) return false;
 
 #ifdef UG_PARALLEL
 				c.set_storage_type(PST_UNIQUE);
@@ -411,6 +521,9 @@ class DiagVanka : public IPreconditioner<TAlgebra>
 		matrix_type m_A;
 #endif
 
+	///	block coloring for multicolor ordering and the pressure row of each block
+		MultiColorPatches m_mcp;
+		std::vector<size_t> m_vCenter;
 };
 
 
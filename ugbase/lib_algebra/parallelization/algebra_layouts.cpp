@@ -42,6 +42,37 @@
 namespace ug
 {
 
+void HorizontalAlgebraLayouts::
+enable_comm_plans(bool enable)
+{
+	m_commPlansEnabled = enable;
+	if(!enable)
+		layouts_changed();
+}
+
+pcl::InterfaceCommPlan<IndexLayout>& HorizontalAlgebraLayouts::
+comm_plan(const IndexLayout& sendLayout, const IndexLayout& recvLayout,
+		  size_t valueSize) const
+{
+//	the layouts may have been changed through a non-const accessor
+	if(m_commPlans.revision != m_revision){
+		m_commPlans.plans.clear();
+		m_commPlans.revision = m_revision;
+	}
+
+	CommPlanKey key(std::make_pair(&sendLayout, &recvLayout), valueSize);
+
+	SmartPtr<pcl::InterfaceCommPlan<IndexLayout> >& plan = m_commPlans.plans[key];
+	if(plan.invalid()){
+		plan = make_sp(new pcl::InterfaceCommPlan<IndexLayout>);
+		plan->init(sendLayout, recvLayout, valueSize, proc_comm());
+	}
+	UG_ASSERT(plan->matches(sendLayout, recvLayout),
+			  "Cached communication plan is outdated. Make sure to call "
+			  "layouts_changed() after modifying the layouts.");
+	return *plan;
+}
+
 
 std::ostream &operator << (std::ostream &out, const HorizontalAlgebraLayouts &layouts)
 {
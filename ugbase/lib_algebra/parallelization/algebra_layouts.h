@@ -34,7 +34,11 @@
 #define __H__UG4__LIB_ALGEBRA__PARALLELIZATION__ALGEBRA_LAYOUTS__
 
 #ifdef UG_PARALLEL
+#include <map>
+#include <utility>
 #include "pcl/pcl_base.h"
+#include "pcl/pcl_interface_comm_plan.h"
+#include "common/util/smart_pointer.h"
 #include "lib_algebra/parallelization/parallel_index_layout.h"
 #endif
 
@@ -47,11 +51,12 @@ namespace ug{
 class HorizontalAlgebraLayouts
 {
 	public:
-		HorizontalAlgebraLayouts() : m_overlapEnabled(false) 	{}
+		HorizontalAlgebraLayouts() : m_overlapEnabled(false), m_revision(0), m_commPlansEnabled(true)	{}
 
 	///	clears the struct
 		void clear()
 		{
+			layouts_changed();
 			masterLayout.clear();			slaveLayout.clear();
 		}
 
@@ -83,19 +88,47 @@ class HorizontalAlgebraLayouts
 	///	Tells whether overlap interfaces should be considered
 		bool overlap_enabled() const		{return m_overlapEnabled;}
 
+	/**	If enabled, repeated interface exchanges of fixed size values (e.g.
+	 * during ParallelVector::change_storage_type) are performed through
+	 * persistent communication plans (see comm_plan). Enabled by default.
+	 * It is important to enable or disable plans on all involved processes
+	 * at the same time.*/
+		void enable_comm_plans(bool enable);
+	///	Tells whether persistent communication plans shall be used
+		bool comm_plans_enabled() const		{return m_commPlansEnabled;}
+
+	///	returns a persistent communication plan for the given layouts and value size
+	/**	Plans are created on first request on the process communicator
+	 * returned by proc_comm() and are cached. Each call of a non-const
+	 * layout accessor or of the non-const proc_comm() increases a revision
+	 * counter, and all cached plans are rebuilt on the next request if the
+	 * revision changed. Copies of this object do not share the cache.
+	 * sendLayout and recvLayout should be layouts of this object.*/
+		pcl::InterfaceCommPlan<IndexLayout>&
+		comm_plan(const IndexLayout& sendLayout, const IndexLayout& recvLayout,
+				  size_t valueSize) const;
+
+	///	releases all cached communication plans
+	/**	Changes through the non-const accessors are detected automatically
+	 * (see comm_plan). This method has to be called if a reference to a
+	 * layout or to the process communicator, which was obtained before a
+	 * plan was requested, is used to change it afterwards.*/
+		void layouts_changed()				{++m_revision; m_commPlans.plans.clear();}
+
 	public:
 	/// returns the horizontal slave/master index layout
+	/**	Outdates the cached communication plans (see comm_plan).*/
 	/// \{
-		IndexLayout& master()			{return masterLayout;}
-		IndexLayout& master_overlap() 	{return masterOverlapLayout;}
-		IndexLayout& slave()			{return slaveLayout;}
-		IndexLayout& slave_overlap() 	{return slaveOverlapLayout;}
+		IndexLayout& master()			{++m_revision; return masterLayout;}
+		IndexLayout& master_overlap() 	{++m_revision; return masterOverlapLayout;}
+		IndexLayout& slave()			{++m_revision; return slaveLayout;}
+		IndexLayout& slave_overlap() 	{++m_revision; return slaveOverlapLayout;}
 	/// \}
 
 	///	returns communicator
 	/// \{
 		pcl::InterfaceCommunicator<IndexLayout>& comm() 	{return communicator;}
-		pcl::ProcessCommunicator& proc_comm()				{return processCommunicator;}
+		pcl::ProcessCommunicator& proc_comm()				{++m_revision; return processCommunicator;}
 	/// \}
 
 	protected:
@@ -114,6 +147,32 @@ class HorizontalAlgebraLayouts
 		pcl::InterfaceCommunicator<IndexLayout> communicator;
 
 		bool m_overlapEnabled;
+
+	///	revision of the layouts, increased by the non-const accessors
+		size_t m_revision;
+
+	///	key for cached communication plans: (send layout, receive layout), value size
+		typedef std::pair<std::pair<const IndexLayout*, const IndexLayout*>, size_t>
+				CommPlanKey;
+		typedef std::map<CommPlanKey, SmartPtr<pcl::InterfaceCommPlan<IndexLayout> > >
+				CommPlanMap;
+
+	///	cache of persistent communication plans, which is never copied
+	/**	Plans refer to the layouts of the object that created them. A copy
+	 * thus starts with an empty cache and an assignment clears it.*/
+		struct CommPlanCache
+		{
+			CommPlanCache() : revision(0)						{}
+			CommPlanCache(const CommPlanCache&) : revision(0)	{}
+			CommPlanCache& operator=(const CommPlanCache&)		{plans.clear(); return *this;}
+			CommPlanMap plans;
+		///	revision of the layouts the plans were built for
+			size_t revision;
+		};
+
+	///	cached persistent communication plans
+		mutable CommPlanCache m_commPlans;
+		bool m_commPlansEnabled;
 };
 
 ///	Extends the HorizontalAlgebraLayouts by vertical layouts.
@@ -136,9 +195,10 @@ class AlgebraLayouts : public HorizontalAlgebraLayouts
 
 	public:
 	/// returns the vertical slave/master index layout
+	/**	Outdates the cached communication plans (see comm_plan).*/
 	/// \{
-		IndexLayout& vertical_master() 		{return verticalMasterLayout;}
-		IndexLayout& vertical_slave()  		{return verticalSlaveLayout;}
+		IndexLayout& vertical_master() 		{++m_revision; return verticalMasterLayout;}
+		IndexLayout& vertical_slave()  		{++m_revision; return verticalSlaveLayout;}
 	/// \}
 
 	protected:
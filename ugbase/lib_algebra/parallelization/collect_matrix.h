@@ -267,6 +267,125 @@ void CollectMatrixOnOneProc(const matrix_type &A, matrix_type &collectedA, Index
 	}UG_CATCH_THROW(__FUNCTION__ << " failed");
 }
 
+/**
+ * Partial agglomeration: The processes of the communicator of A are split into
+ * groups of groupSize consecutive processes (in the order of the communicator).
+ * The matrix is collected on the first process of each group (the group root)
+ * like in CollectMatrixOnOneProc. Additionally, horizontal layouts between the
+ * group roots are created, such that the collected matrices form a distributed
+ * (additive) matrix on the sub-communicator of the group roots. Nesting this
+ * procedure gives a hierarchical agglomeration.
+ *
+ * @param A					(input) the distributed parallel matrix A
+ * @param collectedA		(output) the collected matrix A on the group roots
+ * @param masterLayout		the agglomeration master layout (only defined on group roots)
+ * @param slaveLayout		the agglomeration slave layout (only defined on other processes)
+ * @param collectedLayouts	(output) horizontal layouts and process communicator of the
+ * 							group roots (the communicator is empty on the other processes)
+ * @param groupSize			number of processes per group
+ * @return true if this process is a group root
+ */
+template<typename matrix_type>
+bool CollectMatrixOnGroupRoots(const matrix_type &A, matrix_type &collectedA,
+		IndexLayout &masterLayout, IndexLayout &slaveLayout,
+		AlgebraLayouts &collectedLayouts, size_t groupSize)
+{
+	try{
+	PROFILE_FUNC_GROUP("algebra parallelization");
+	UG_COND_THROW(groupSize == 0, "group size has to be positive.");
+	masterLayout.clear();
+	slaveLayout.clear();
+	collectedLayouts.clear();
+
+	const pcl::ProcessCommunicator &pc = A.layouts()->proc_comm();
+
+//	group root of each process
+	std::map<int, int> groupRoot;
+	for(size_t i=0; i<pc.size(); i++)
+		groupRoot[pc.get_proc_id(i)] = pc.get_proc_id((i / groupSize) * groupSize);
+	const int myRoot = groupRoot[pcl::ProcRank()];
+	const bool bRoot = (myRoot == pcl::ProcRank());
+
+//	collect the matrices of the groups
+	ParallelNodes PN(A.layouts(), A.num_rows());
+	if(bRoot)
+	{
+		std::vector<int> srcprocs;
+		for(size_t i=0; i<pc.size(); i++)
+			if(pc.get_proc_id(i) != myRoot && groupRoot[pc.get_proc_id(i)] == myRoot)
+				srcprocs.push_back(pc.get_proc_id(i));
+		ReceiveMatrix(A, collectedA, masterLayout, srcprocs, PN);
+	}
+	else
+		SendMatrix(A, slaveLayout, myRoot, PN);
+
+	collectedLayouts.proc_comm() = pc.create_sub_communicator(bRoot);
+	if(!bRoot) return false;
+
+//	an index is a master on the root of the group of its master process and a
+//	slave on all other roots. the interfaces are ordered by the global ids.
+	typedef std::vector<std::pair<AlgebraID, size_t> > IDVec;
+	std::map<int, IDVec> slaveIDs;
+	for(size_t i=0; i<PN.local_size(); i++)
+	{
+		const AlgebraID &id = PN.local_to_global(i);
+		std::map<int, int>::const_iterator it = groupRoot.find(id.master_proc());
+		UG_COND_THROW(it == groupRoot.end(), "master process " << id.master_proc()
+						<< " of " << id << " not in the process communicator.");
+		if(it->second != myRoot)
+			slaveIDs[it->second].push_back(std::make_pair(id, i));
+	}
+
+//	notify the roots from which they will receive slave ids
+	pcl::ProcessCommunicator rootComm = collectedLayouts.proc_comm();
+	const size_t numRoots = rootComm.size();
+	std::vector<int> vSend(numRoots, 0), vRecv(numRoots, 0);
+	for(size_t i=0; i<numRoots; i++)
+		if(slaveIDs.find(rootComm.get_proc_id(i)) != slaveIDs.end())
+			vSend[i] = 1;
+	rootComm.alltoall(&vSend[0], 1, PCL_DT_INT, &vRecv[0], 1, PCL_DT_INT);
+
+	pcl::InterfaceCommunicator<IndexLayout> &communicator = A.layouts()->comm();
+	std::map<int, BinaryBuffer> sendStreams, recvStreams;
+	for(typename std::map<int, IDVec>::iterator it = slaveIDs.begin(); it != slaveIDs.end(); ++it)
+	{
+		IDVec &vID = it->second;
+		std::sort(vID.begin(), vID.end());
+
+		IndexLayout::Interface &interface = collectedLayouts.slave().interface(it->first);
+		BinaryBuffer &stream = sendStreams[it->first];
+		Serialize(stream, vID.size());
+		for(size_t j=0; j<vID.size(); j++)
+		{
+			interface.push_back(vID[j].second);
+			Serialize(stream, vID[j].first);
+		}
+		communicator.send_raw(it->first, stream.buffer(), stream.write_pos(), false);
+	}
+	for(size_t i=0; i<numRoots; i++)
+		if(vRecv[i])
+			communicator.receive_raw(rootComm.get_proc_id(i), recvStreams[rootComm.get_proc_id(i)]);
+	communicator.communicate();
+
+	for(std::map<int, BinaryBuffer>::iterator it = recvStreams.begin(); it != recvStreams.end(); ++it)
+	{
+		BinaryBuffer &stream = it->second;
+		stream.set_read_pos(0);
+		IndexLayout::Interface &interface = collectedLayouts.master().interface(it->first);
+
+		size_t numIDs;
+		Deserialize(stream, numIDs);
+		for(size_t j=0; j<numIDs; j++)
+		{
+			AlgebraID id;
+			Deserialize(stream, id);
+			interface.push_back(PN.global_to_local(id));
+		}
+	}
+	return true;
+	}UG_CATCH_THROW(__FUNCTION__ << " failed");
+}
+
 /**
  * gathers the vector vec to collectedVec on one processor
  * @param agglomeratedMaster	master agglomeration layout. only nonempty if Root=true
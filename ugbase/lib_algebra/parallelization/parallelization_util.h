@@ -36,6 +36,7 @@
 #include <utility>
 #include <vector>
 #include <map>
+#include <cstring>
 #include "common/assert.h"
 #include "algebra_id.h"
 #include "communication_policies.h"
@@ -279,6 +280,125 @@ void AdditiveToUnique(	TVector* pVec,
 		com.communicate();
 }
 
+///	operations that can be performed by PlannedVecExchange
+enum VecExchangeOperation
+{
+	VEO_COPY,			///< received values overwrite the local values
+	VEO_ADD,			///< received values are added to the local values
+	VEO_ADD_SET_ZERO	///< as VEO_ADD, but sent values are set to zero
+};
+
+///	returns true if interface exchanges of TVector may use persistent communication plans
+template <typename TVector>
+bool CommPlanApplicable(const HorizontalAlgebraLayouts& layouts)
+{
+	return block_traits<typename TVector::value_type>::is_static
+			&& layouts.comm_plans_enabled();
+}
+
+///	exchanges interface values of a vector through a cached persistent communication plan
+/**
+ * Values on the interfaces of sendLayout are sent to the associated interfaces
+ * of recvLayout, where they are handled as specified by op. The communication
+ * plan is taken from the cache of the given layouts, so that repeated exchanges
+ * between the same layouts do neither negotiate buffer sizes nor allocate memory.
+ * This is only valid, if CommPlanApplicable<TVector>(layouts) returns true.
+ *
+ * \param[in,out]		pVec			Parallel Vector
+ * \param[in]			layouts			Layouts holding the plan cache
+ * \param[in]			sendLayout		Layout whose values are sent
+ * \param[in]			recvLayout		Layout whose values are received
+ * \param[in]			op				Operation performed with the values
+ */
+template <typename TVector>
+void PlannedVecExchange(TVector* pVec,
+                        const HorizontalAlgebraLayouts& layouts,
+                        const IndexLayout& sendLayout, const IndexLayout& recvLayout,
+                        VecExchangeOperation op)
+{
+	PROFILE_FUNC_GROUP("algebra parallelization");
+	typedef typename TVector::value_type value_type;
+	const size_t valueSize = sizeof(value_type);
+
+	pcl::InterfaceCommPlan<IndexLayout>& plan =
+			layouts.comm_plan(sendLayout, recvLayout, valueSize);
+	TVector& v = *pVec;
+
+//	gather values into the send buffer
+	const size_t numSend = plan.num_send_values();
+	for(size_t i = 0; i < numSend; ++i){
+		value_type& val = v[plan.send_element(i)];
+		memcpy(plan.send_value(i), static_cast<const void*>(&val), valueSize);
+		if(op == VEO_ADD_SET_ZERO)
+			val *= 0;
+	}
+
+	plan.communicate();
+
+//	scatter received values
+	value_type recvVal;
+	const size_t numRecv = plan.num_recv_values();
+	for(size_t i = 0; i < numRecv; ++i){
+		memcpy(static_cast<void*>(&recvVal), plan.recv_value(i), valueSize);
+		if(op == VEO_COPY)
+			v[plan.recv_element(i)] = recvVal;
+		else
+			v[plan.recv_element(i)] += recvVal;
+	}
+}
+
+/// changes parallel storage type from additive to consistent using the given layouts
+/**	Uses persistent communication plans if possible and the communicator of
+ * the layouts otherwise.*/
+template <typename TVector>
+void AdditiveToConsistent(TVector* pVec, const HorizontalAlgebraLayouts& layouts)
+{
+	if(CommPlanApplicable<TVector>(layouts)){
+		PROFILE_FUNC_GROUP("algebra parallelization");
+		PlannedVecExchange(pVec, layouts, layouts.slave(), layouts.master(), VEO_ADD);
+		PlannedVecExchange(pVec, layouts, layouts.master(), layouts.slave(), VEO_COPY);
+	}
+	else
+		AdditiveToConsistent(pVec, layouts.master(), layouts.slave(), &layouts.comm());
+}
+
+/// changes parallel storage type from unique to consistent using the given layouts
+/**	Uses persistent communication plans if possible and the communicator of
+ * the layouts otherwise.*/
+template <typename TVector>
+void UniqueToConsistent(TVector* pVec, const HorizontalAlgebraLayouts& layouts)
+{
+	if(CommPlanApplicable<TVector>(layouts))
+		PlannedVecExchange(pVec, layouts, layouts.master(), layouts.slave(), VEO_COPY);
+	else
+		UniqueToConsistent(pVec, layouts.master(), layouts.slave(), &layouts.comm());
+}
+
+/// changes parallel storage type from additive to unique using the given layouts
+/**	Uses persistent communication plans if possible and the communicator of
+ * the layouts otherwise.*/
+template <typename TVector>
+void AdditiveToUnique(TVector* pVec, const HorizontalAlgebraLayouts& layouts)
+{
+	if(CommPlanApplicable<TVector>(layouts))
+		PlannedVecExchange(pVec, layouts, layouts.slave(), layouts.master(), VEO_ADD_SET_ZERO);
+	else
+		AdditiveToUnique(pVec, layouts.master(), layouts.slave(), &layouts.comm());
+}
+
+///	Copies values from the source to the target layout using the given layouts
+/**	Uses persistent communication plans if possible and the communicator of
+ * the layouts otherwise.*/
+template <typename TVector>
+void CopyValues(TVector* pVec, const HorizontalAlgebraLayouts& layouts,
+                const IndexLayout& sourceLayout, const IndexLayout& targetLayout)
+{
+	if(CommPlanApplicable<TVector>(layouts))
+		PlannedVecExchange(pVec, layouts, sourceLayout, targetLayout, VEO_COPY);
+	else
+		CopyValues(pVec, sourceLayout, targetLayout, &layouts.comm());
+}
+
 /// sets the values of a vector to a given number only on the interface indices
 /**
  * \param[in,out]		pVec			Vector
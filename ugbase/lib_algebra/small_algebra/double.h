@@ -40,7 +40,7 @@
  *	by the same methods.
  */
 
-// todo: also with float / complex<float> / complex<double>
+// todo: also with complex<float> / complex<double> (float: see float.h)
 
 #ifndef __H__UG__SMALL_ALGEBRA__DOUBLE__
 #define __H__UG__SMALL_ALGEBRA__DOUBLE__
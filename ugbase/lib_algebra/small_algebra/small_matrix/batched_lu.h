@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2017:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+
+#ifndef __H__UG__SMALL_ALGEBRA__BATCHED_LU__
+#define __H__UG__SMALL_ALGEBRA__BATCHED_LU__
+
+#include <cstddef>
+#include <cmath>
+#include "common/types.h"
+
+namespace ug{
+
+/// \addtogroup small_algebra
+/// \{
+
+/**
+ * Solves a batch of equally sized dense systems A_b x_b = r_b, b=0..batch-1,
+ * by LU decomposition with partial pivoting.
+ *
+ * The systems are stored interleaved ("structure of arrays"): entry (i,j) of
+ * system b is found at A[(i*n+j)*batch + b] and entry i of the right hand side
+ * of system b at x[i*batch + b]. All innermost loops therefore run over the
+ * batch index with unit stride and are vectorized by the compiler. Only the
+ * row exchanges of the pivoting are performed per system.
+ *
+ * On exit, x holds the solutions and A is overwritten by the factors.
+ *
+ * \param n			size of each system
+ * \param batch		number of systems
+ * \param A			interleaved matrices (n*n*batch entries)
+ * \param x			interleaved right hand sides / solutions (n*batch entries)
+ * \return false if one of the matrices is singular
+ */
+inline bool BatchedLUSolve(size_t n, size_t batch, number* A, number* x)
+{
+	for(size_t k = 0; k < n; ++k)
+	{
+		number* Akk = A + (k*n+k)*batch;
+
+	//	partial pivoting, done separately for each system
+		for(size_t b = 0; b < batch; ++b)
+		{
+			size_t piv = k;
+			number maxVal = std::fabs(Akk[b]);
+			for(size_t i = k+1; i < n; ++i){
+				const number val = std::fabs(A[(i*n+k)*batch + b]);
+				if(val > maxVal) {maxVal = val; piv = i;}
+			}
+			if(maxVal == 0.0) return false;
+			if(piv == k) continue;
+
+			for(size_t j = k; j < n; ++j){
+				number tmp = A[(k*n+j)*batch + b];
+				A[(k*n+j)*batch + b] = A[(piv*n+j)*batch + b];
+				A[(piv*n+j)*batch + b] = tmp;
+			}
+			number tmp = x[k*batch + b];
+			x[k*batch + b] = x[piv*batch + b];
+			x[piv*batch + b] = tmp;
+		}
+
+	//	elimination of column k in all systems at once
+		for(size_t i = k+1; i < n; ++i)
+		{
+			number* Aik = A + (i*n+k)*batch;
+			for(size_t b = 0; b < batch; ++b)
+				Aik[b] /= Akk[b];
+
+			for(size_t j = k+1; j < n; ++j)
+			{
+				number* Aij = A + (i*n+j)*batch;
+				const number* Akj = A + (k*n+j)*batch;
+				for(size_t b = 0; b < batch; ++b)
+					Aij[b] -= Aik[b] * Akj[b];
+			}
+
+			number* xi = x + i*batch;
+			const number* xk = x + k*batch;
+			for(size_t b = 0; b < batch; ++b)
+				xi[b] -= Aik[b] * xk[b];
+		}
+	}
+
+//	backward substitution
+	for(size_t i = n; i-- > 0;)
+	{
+		number* xi = x + i*batch;
+		for(size_t j = i+1; j < n; ++j)
+		{
+			const number* Aij = A + (i*n+j)*batch;
+			const number* xj = x + j*batch;
+			for(size_t b = 0; b < batch; ++b)
+				xi[b] -= Aij[b] * xj[b];
+		}
+		const number* Aii = A + (i*n+i)*batch;
+		for(size_t b = 0; b < batch; ++b)
+			xi[b] /= Aii[b];
+	}
+
+	return true;
+}
+
+/// \}
+
+} // end namespace ug
+
+#endif /* __H__UG__SMALL_ALGEBRA__BATCHED_LU__ */
@@ -62,7 +62,8 @@ DoFDistribution(SmartPtr<MultiGrid> spMG,
                 ConstSmartPtr<DoFDistributionInfo> spDDInfo,
                 SmartPtr<SurfaceView> spSurfView,
                 const GridLevel& level, bool bGrouped,
-                SmartPtr<DoFIndexStorage> spDoFIndexStorage)
+                SmartPtr<DoFIndexStorage> spDoFIndexStorage,
+                bool bIncremental)
 	: DoFDistributionInfoProvider(spDDInfo),
       m_bGrouped(bGrouped),
 	  m_spMG(spMG),
@@ -71,7 +72,10 @@ DoFDistribution(SmartPtr<MultiGrid> spMG,
 	  m_spSurfView(spSurfView),
 	  m_gridLevel(level),
 	  m_spDoFIndexStorage(spDoFIndexStorage),
-	  m_numIndex(0)
+	  m_numIndex(0),
+	  m_bIncremental(bIncremental),
+	  m_bLastReinitIncremental(false),
+	  m_generation(0)
 {
 	if(m_spDoFIndexStorage.invalid())
 		m_spDoFIndexStorage = SmartPtr<DoFIndexStorage>(new DoFIndexStorage(spMG, spDDInfo));
@@ -83,12 +87,18 @@ DoFDistribution(SmartPtr<MultiGrid> spMG,
 	m_spAlgebraLayouts = SmartPtr<AlgebraLayouts>(new AlgebraLayouts);
 #endif
 
+//	stamps are written by the initial reinit
+	if(m_bIncremental) attach_generation();
+
 	reinit();
 }
 
 
 DoFDistribution::
-~DoFDistribution() {}
+~DoFDistribution()
+{
+	detach_generation();
+}
 
 
 void DoFDistribution::check_subsets()
@@ -173,6 +183,9 @@ add(TBaseObject* obj, const ReferenceObjectID roid, const int si)
 	m_numIndex += numNewIndex;
 	m_vNumIndexOnSubset[si] += numNewIndex;
 
+//	stamp object for later incremental updates
+	if(m_bIncremental) generation(obj) = m_generation;
+
 // 	if obj is a master, assign all its slaves
 	if(master) {
 		typedef typename PeriodicBoundaryManager::Group<TBaseObject>::SlaveContainer SlaveContainer;
@@ -1392,6 +1405,7 @@ void DoFDistribution::reinit()
 				TBaseElem* p = dynamic_cast<TBaseElem*>(mg.get_parent(elem));
 				while(p && sv.is_contained(p, grid_level(), SurfaceView::SHADOW_RIM_COPY)){
 					obj_index(p) = obj_index(elem);
+					if(m_bIncremental) generation(p) = m_generation;
 					p = dynamic_cast<TBaseElem*>(mg.get_parent(p));
 				}
 			}
@@ -1432,6 +1446,11 @@ void DoFDistribution::reinit()
 
 void DoFDistribution::reinit()
 {
+	m_bLastReinitIncremental = false;
+	m_vNewVertex.clear(); m_vNewEdge.clear();
+	m_vNewFace.clear(); m_vNewVolume.clear();
+	++m_generation;
+
 	m_numIndex = 0;
 	m_vNumIndexOnSubset.resize(0);
 	m_vNumIndexOnSubset.resize(num_subsets(), 0);
@@ -1446,6 +1465,216 @@ void DoFDistribution::reinit()
 #endif
 }
 
+////////////////////////////////////////////////////////////////////////////////
+// Incremental update after adaption
+////////////////////////////////////////////////////////////////////////////////
+
+void DoFDistribution::attach_generation()
+{
+	if(m_pMG->has_attachment<Vertex>(m_aGeneration)) return;
+
+	m_pMG->attach_to_all_dv(m_aGeneration, 0);
+	m_aaGeneration.access(*m_pMG, m_aGeneration);
+}
+
+void DoFDistribution::detach_generation()
+{
+	if(!m_pMG->has_attachment<Vertex>(m_aGeneration)) return;
+
+	m_pMG->detach_from_all(m_aGeneration);
+	m_aaGeneration = MultiElementAttachmentAccessor<Attachment<uint> >();
+}
+
+void DoFDistribution::set_incremental(bool bIncremental)
+{
+	if(bIncremental == m_bIncremental) return;
+	m_bIncremental = bIncremental;
+
+//	the stamps of the current index set are unknown, thus a full reinit
+//	is required when switching on
+	if(m_bIncremental){
+		attach_generation();
+		reinit();
+	}
+	else detach_generation();
+}
+
+bool DoFDistribution::incremental_update_possible() const
+{
+	if(!m_bIncremental) return false;
+	if(grid_level().type() != GridLevel::SURFACE) return false;
+	if(m_spMG->has_periodic_boundaries()) return false;
+	if((int)m_vNumIndexOnSubset.size() != num_subsets()) return false;
+	return true;
+}
+
+template <typename TBaseElem>
+void DoFDistribution::
+collect_kept_and_new(std::vector<TBaseElem*>& vKept,
+                     std::vector<TBaseElem*>& vNew,
+                     std::vector<bool>& vClaimed,
+                     size_t& numKept)
+{
+	typedef typename traits<TBaseElem>::iterator iterator;
+	static const int dim = TBaseElem::dim;
+
+	if(max_dofs(dim) == 0) return;
+
+	const SurfaceView& sv = *m_spSurfView;
+	MultiGrid& mg = *m_spMG;
+	const uint lastGen = m_generation;
+	const size_t oldNumIndex = vClaimed.size();
+
+	for(int si = 0; si < num_subsets(); ++si)
+	{
+		if(max_dofs(dim, si) == 0) continue;
+
+	//	same iteration as in reinit<TBaseElem>()
+		iterator iter = begin<TBaseElem>(si, SurfaceView::ALL);
+		iterator iterEnd = end<TBaseElem>(si, SurfaceView::ALL);
+
+		for(; iter != iterEnd; ++iter){
+			TBaseElem* elem = *iter;
+			if(sv.is_contained(elem, grid_level(), SurfaceView::SHADOW_RIM_COPY)){
+				if(mg.num_children<TBaseElem>(elem) > 0){
+					TBaseElem* child = mg.get_child<TBaseElem>(elem, 0);
+					if(sv.is_contained(child, grid_level(), SurfaceView::SURFACE_RIM))
+						continue;
+				}
+			}
+
+			const size_t numInd = num_obj_indices(elem->reference_object_id(), si);
+			if(numInd == 0) continue;
+
+		//	candidate index: own index if stamped in the last generation, else
+		//	the index of a SHADOW_COPY parent that was stamped (e.g. a vertex
+		//	that has just been created on top of an existing vertex)
+			size_t index = (size_t)-1;
+			if(generation(elem) == lastGen)
+				index = obj_index(elem);
+			else{
+				TBaseElem* p = dynamic_cast<TBaseElem*>(mg.get_parent(elem));
+				if(p && generation(p) == lastGen
+					&& sv.is_contained(p, grid_level(), SurfaceView::SHADOW_RIM_COPY))
+					index = obj_index(p);
+			}
+
+		//	the old index range must be valid and not used by another object
+			bool bKeep = (index != (size_t)-1) && (index + numInd <= oldNumIndex);
+			for(size_t k = 0; bKeep && k < numInd; ++k)
+				if(vClaimed[index + k]) bKeep = false;
+
+			if(bKeep){
+				for(size_t k = 0; k < numInd; ++k) vClaimed[index + k] = true;
+				obj_index(elem) = index;
+				vKept.push_back(elem);
+				numKept += numInd;
+			}
+			else vNew.push_back(elem);
+		}
+	}
+}
+
+template <typename TBaseElem>
+void DoFDistribution::
+assign_kept_and_new(const std::vector<TBaseElem*>& vKept,
+                    const std::vector<TBaseElem*>& vNew,
+                    const std::vector<size_t>& vOldToNew)
+{
+	MultiGrid& mg = *m_spMG;
+	const SurfaceView& sv = *m_spSurfView;
+
+	for(size_t i = 0; i < vKept.size(); ++i){
+		TBaseElem* elem = vKept[i];
+		const int si = m_spMGSH->get_subset_index(elem);
+		obj_index(elem) = vOldToNew[obj_index(elem)];
+		generation(elem) = m_generation;
+		m_vNumIndexOnSubset[si] += num_obj_indices(elem->reference_object_id(), si);
+	}
+
+	for(size_t i = 0; i < vNew.size(); ++i)
+		add(vNew[i], vNew[i]->reference_object_id(), m_spMGSH->get_subset_index(vNew[i]));
+
+//	copy indices down to SHADOW_COPY parents
+	for(int pass = 0; pass < 2; ++pass){
+		const std::vector<TBaseElem*>& vElem = (pass == 0) ? vKept : vNew;
+		for(size_t i = 0; i < vElem.size(); ++i){
+			TBaseElem* elem = vElem[i];
+			TBaseElem* p = dynamic_cast<TBaseElem*>(mg.get_parent(elem));
+			while(p && sv.is_contained(p, grid_level(), SurfaceView::SHADOW_RIM_COPY)){
+				obj_index(p) = obj_index(elem);
+				generation(p) = m_generation;
+				p = dynamic_cast<TBaseElem*>(mg.get_parent(p));
+			}
+		}
+	}
+}
+
+void DoFDistribution::reinit_after_adaption()
+{
+	if(!incremental_update_possible()) reinit();
+	else reinit_incremental();
+
+//	inform grid functions explicitly, such that they do not depend on the
+//	order in which the adaption callbacks are called
+	for(size_t i = 0; i < m_vpGridFunction.size(); ++i)
+		m_vpGridFunction[i]->dof_distribution_adapted(m_bLastReinitIncremental);
+}
+
+void DoFDistribution::reinit_incremental()
+{
+	PROFILE_FUNC();
+
+	const size_t oldNumIndex = m_numIndex;
+	std::vector<bool> vClaimed(oldNumIndex, false);
+	size_t numKept = 0;
+
+	m_vNewVertex.clear(); m_vNewEdge.clear();
+	m_vNewFace.clear(); m_vNewVolume.clear();
+	std::vector<Vertex*> vKeptVertex;
+	std::vector<Edge*> vKeptEdge;
+	std::vector<Face*> vKeptFace;
+	std::vector<Volume*> vKeptVolume;
+
+	collect_kept_and_new<Vertex>(vKeptVertex, m_vNewVertex, vClaimed, numKept);
+	collect_kept_and_new<Edge>(vKeptEdge, m_vNewEdge, vClaimed, numKept);
+	collect_kept_and_new<Face>(vKeptFace, m_vNewFace, vClaimed, numKept);
+	collect_kept_and_new<Volume>(vKeptVolume, m_vNewVolume, vClaimed, numKept);
+
+//	compact the kept indices (order preserving) and move the values of the
+//	managed grid functions. Since new <= old and the map is ascending, the
+//	values can be moved in place.
+	std::vector<size_t> vOldToNew(oldNumIndex, (size_t)-1);
+	std::vector<std::pair<size_t, size_t> > vIndexMap;
+	size_t cnt = 0;
+	for(size_t i = 0; i < oldNumIndex; ++i){
+		if(!vClaimed[i]) continue;
+		vOldToNew[i] = cnt;
+		if(i != cnt) vIndexMap.push_back(std::pair<size_t, size_t>(i, cnt));
+		++cnt;
+	}
+	UG_ASSERT(cnt == numKept, "Kept index count mismatch");
+
+	if(!vIndexMap.empty()) copy_values(vIndexMap, true);
+
+	++m_generation;
+	m_numIndex = numKept;
+	m_vNumIndexOnSubset.resize(0);
+	m_vNumIndexOnSubset.resize(num_subsets(), 0);
+
+	assign_kept_and_new<Vertex>(vKeptVertex, m_vNewVertex, vOldToNew);
+	assign_kept_and_new<Edge>(vKeptEdge, m_vNewEdge, vOldToNew);
+	assign_kept_and_new<Face>(vKeptFace, m_vNewFace, vOldToNew);
+	assign_kept_and_new<Volume>(vKeptVolume, m_vNewVolume, vOldToNew);
+
+	resize_values(m_numIndex);
+	m_bLastReinitIncremental = true;
+
+#ifdef UG_PARALLEL
+	reinit_layouts_and_communicator();
+#endif
+}
+
 
 #ifdef UG_PARALLEL
 void DoFDistribution::reinit_layouts_and_communicator()
@@ -1481,6 +1710,9 @@ void DoFDistribution::reinit_layouts_and_communicator()
 	}else{
 		layouts()->vertical_master().clear();
 	}
+
+//	cached communication plans refer to the old layouts
+	layouts()->layouts_changed();
 }
 
 void DoFDistribution::reinit_index_layout(IndexLayout& layout, int keyType)
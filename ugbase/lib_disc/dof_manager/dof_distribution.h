@@ -34,6 +34,7 @@
 #define __H__UG__LIB_DISC__DOF_MANAGER__DOF_DISTRIBUTION__
 
 #include "lib_grid/tools/surface_view.h"
+#include "lib_grid/algorithms/attachment_util.h"
 #include "lib_disc/domain_traits.h"
 #include "lib_disc/common/local_algebra.h"
 #include "dof_index_storage.h"
@@ -51,12 +52,17 @@ class DoFDistribution : public DoFDistributionInfoProvider
 {
 	public:
 		///	constructor
+		/**
+		 * If bIncremental is true, the indices are updated incrementally
+		 * after grid adaption (see reinit_after_adaption).
+		 */
 		DoFDistribution(SmartPtr<MultiGrid> spMG,
 		                SmartPtr<MGSubsetHandler> spMGSH,
 		                ConstSmartPtr<DoFDistributionInfo> spDDInfo,
 		                SmartPtr<SurfaceView> spSurfView,
 		                const GridLevel& level, bool bGrouped,
-		                SmartPtr<DoFIndexStorage> spDoFIndexStorage = SPNULL);
+		                SmartPtr<DoFIndexStorage> spDoFIndexStorage = SPNULL,
+		                bool bIncremental = false);
 
 		/// destructor
 		~DoFDistribution();
@@ -482,6 +488,20 @@ class DoFDistribution : public DoFDistributionInfoProvider
 		/// number of distributed indices on whole domain
 		size_t m_numIndex;
 
+		///	incremental updates
+		/// \{
+		bool m_bIncremental;
+		bool m_bLastReinitIncremental;
+		uint m_generation;
+		Attachment<uint> m_aGeneration;
+		MultiElementAttachmentAccessor<Attachment<uint> > m_aaGeneration;
+
+		std::vector<Vertex*> m_vNewVertex;
+		std::vector<Edge*> m_vNewEdge;
+		std::vector<Face*> m_vNewFace;
+		std::vector<Volume*> m_vNewVolume;
+		/// \}
+
 		/// number of distributed indices on each subset
 		std::vector<size_t> m_vNumIndexOnSubset;
 
@@ -495,11 +515,72 @@ class DoFDistribution : public DoFDistributionInfoProvider
 		///	initializes the indices
 		void reinit();
 
+		///	updates the indices after grid adaption
+		/**
+		 * If incremental updates are enabled (and possible), the indices of
+		 * objects that already carried dofs before the adaption are kept,
+		 * the indices of removed objects are compacted (order preserving) and
+		 * new objects are appended. A child vertex that replaces its parent in
+		 * the surface inherits the parent's index. Values of managed grid
+		 * functions are moved and resized accordingly. Otherwise, a full
+		 * reinit() is performed. Finally, all managed grid functions are
+		 * informed through IGridFunction::dof_distribution_adapted.
+		 */
+		void reinit_after_adaption();
+
+	protected:
+		///	incremental part of reinit_after_adaption
+		void reinit_incremental();
+
+	public:
+		///	enables incremental index updates after grid adaption (surface only)
+		void set_incremental(bool bIncremental);
+
+		///	returns if incremental index updates are enabled
+		bool incremental() const {return m_bIncremental;}
+
+		///	returns if the last (re)initialization was incremental
+		bool last_reinit_incremental() const {return m_bLastReinitIncremental;}
+
+		///	returns the elements that got new indices in the last incremental update
+		template <typename TBaseElem>
+		const std::vector<TBaseElem*>& new_elements() const;
+
 	protected:
 		///	initializes the indices
 		template <typename TBaseElem>
 		void reinit();
 
+		///	incremental update: sorts surface elements into kept and new ones
+		template <typename TBaseElem>
+		void collect_kept_and_new(std::vector<TBaseElem*>& vKept,
+		                          std::vector<TBaseElem*>& vNew,
+		                          std::vector<bool>& vClaimed,
+		                          size_t& numKept);
+
+		///	incremental update: assigns compacted and new indices
+		template <typename TBaseElem>
+		void assign_kept_and_new(const std::vector<TBaseElem*>& vKept,
+		                         const std::vector<TBaseElem*>& vNew,
+		                         const std::vector<size_t>& vOldToNew);
+
+		///	number of indices of an object (without periodic and grouping checks)
+		inline size_t num_obj_indices(const ReferenceObjectID roid, const int si) const
+		{return m_bGrouped ? 1 : num_dofs(roid,si);}
+
+		///	returns if incremental update is possible
+		bool incremental_update_possible() const;
+
+		///	attaches / detaches the generation stamps
+		/// \{
+		void attach_generation();
+		void detach_generation();
+		/// \}
+
+		///	returns the generation stamp of an object
+		template <typename TElem>
+		inline uint& generation(TElem* obj) {return m_aaGeneration[obj];}
+
 		template <typename TBaseElem>
 		void permute_indices(const std::vector<size_t>& vNewInd);
 
@@ -565,6 +646,15 @@ class DoFDistribution : public DoFDistributionInfoProvider
 
 };
 
+template <>
+inline const std::vector<Vertex*>& DoFDistribution::new_elements<Vertex>() const {return m_vNewVertex;}
+template <>
+inline const std::vector<Edge*>& DoFDistribution::new_elements<Edge>() const {return m_vNewEdge;}
+template <>
+inline const std::vector<Face*>& DoFDistribution::new_elements<Face>() const {return m_vNewFace;}
+template <>
+inline const std::vector<Volume*>& DoFDistribution::new_elements<Volume>() const {return m_vNewVolume;}
+
 } // end namespace ug
 
 #endif /* __H__UG__LIB_DISC__DOF_MANAGER__DOF_DISTRIBUTION__ */
@@ -54,18 +54,26 @@ void DoFIndexStorage::init_attachments()
 //	attach DoFs to vertices
 	if(max_dofs(VERTEX)) {
 		multi_grid()->attach_to_dv<Vertex>(m_aIndex, (size_t)-1);
+		multi_grid()->get_attachment_data_container<Vertex>(m_aIndex)
+						->set_mem_category(MEM_DOF_INDICES);
 		m_aaIndexVRT.access(*multi_grid(), m_aIndex);
 	}
 	if(max_dofs(EDGE)) {
 		multi_grid()->attach_to_dv<Edge>(m_aIndex, (size_t)-1);
+		multi_grid()->get_attachment_data_container<Edge>(m_aIndex)
+						->set_mem_category(MEM_DOF_INDICES);
 		m_aaIndexEDGE.access(*multi_grid(), m_aIndex);
 	}
 	if(max_dofs(FACE)) {
 		multi_grid()->attach_to_dv<Face>(m_aIndex, (size_t)-1);
+		multi_grid()->get_attachment_data_container<Face>(m_aIndex)
+						->set_mem_category(MEM_DOF_INDICES);
 		m_aaIndexFACE.access(*multi_grid(), m_aIndex);
 	}
 	if(max_dofs(VOLUME)) {
 		multi_grid()->attach_to_dv<Volume>(m_aIndex, (size_t)-1);
+		multi_grid()->get_attachment_data_container<Volume>(m_aIndex)
+						->set_mem_category(MEM_DOF_INDICES);
 		m_aaIndexVOL.access(*multi_grid(), m_aIndex);
 	}
 }
@@ -56,6 +56,10 @@ class AdaptionSurfaceGridFunction : public GridObserver
 		template <typename TAlgebra>
 		void copy_to_surface(GridFunction<TDomain,TAlgebra>& rSurfaceFct);
 
+	///	copies values only for the elements newly numbered by an incremental dof update
+		template <typename TAlgebra>
+		void copy_to_surface_new_elements(GridFunction<TDomain,TAlgebra>& rSurfaceFct);
+
 		AValues value_attachment()	{return m_aValue;}
 
 	protected:
@@ -68,6 +72,8 @@ class AdaptionSurfaceGridFunction : public GridObserver
 		void copy_to_surface(GridFunction<TDomain,TAlgebra>& rSurfaceFct, TElem* elem);
 		template <typename TElem, typename TAlgebra>
 		void copy_to_surface(GridFunction<TDomain,TAlgebra>& rSurfaceFct);
+		template <typename TElem, typename TAlgebra>
+		void copy_to_surface_new_elements(GridFunction<TDomain,TAlgebra>& rSurfaceFct);
 
 	public:
 		void prolongate(const GridMessage_Adaption& msg);
@@ -175,6 +175,36 @@ copy_to_surface(GridFunction<TDomain,TAlgebra>& rSurfaceFct)
 	detach_entries();
 }
 
+template <typename TDomain>
+template <typename TElem, typename TAlgebra>
+void AdaptionSurfaceGridFunction<TDomain>::
+copy_to_surface_new_elements(GridFunction<TDomain,TAlgebra>& rSurfaceFct)
+{
+	const std::vector<TElem*>& vElem
+		= rSurfaceFct.dd()->template new_elements<TElem>();
+
+	for(size_t i = 0; i < vElem.size(); ++i)
+		copy_to_surface(rSurfaceFct, vElem[i]);
+}
+
+template <typename TDomain>
+template <typename TAlgebra>
+void AdaptionSurfaceGridFunction<TDomain>::
+copy_to_surface_new_elements(GridFunction<TDomain,TAlgebra>& rSurfaceFct)
+{
+	GFUNCADAPT_PROFILE_FUNC();
+	if(rSurfaceFct.max_dofs(VERTEX))copy_to_surface_new_elements<Vertex,TAlgebra>(rSurfaceFct);
+	if(rSurfaceFct.max_dofs(EDGE)) 	copy_to_surface_new_elements<Edge,TAlgebra>(rSurfaceFct);
+	if(rSurfaceFct.max_dofs(FACE))	copy_to_surface_new_elements<Face,TAlgebra>(rSurfaceFct);
+	if(rSurfaceFct.max_dofs(VOLUME))copy_to_surface_new_elements<Volume,TAlgebra>(rSurfaceFct);
+
+	#ifdef UG_PARALLEL
+	rSurfaceFct.set_storage_type(m_ParallelStorageType);
+	#endif
+
+	detach_entries();
+}
+
 
 template <typename TDomain>
 template <typename TBaseElem>
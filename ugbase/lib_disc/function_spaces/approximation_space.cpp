@@ -83,6 +83,8 @@ init(SmartPtr<subset_handler_type> spMGSH,
 	m_spDoFDistributionInfo = SmartPtr<DoFDistributionInfo>(new DoFDistributionInfo(spMGSH));
 	m_algebraType = algebraType;
 	m_bAdaptionIsActive = false;
+	m_bIncrementalDoFUpdate = false;
+	m_bSurfaceElementLists = false;
 	m_RevCnt = RevisionCounter(this);
 
 	this->set_dof_distribution_info(m_spDoFDistributionInfo);
@@ -341,7 +343,8 @@ void IApproximationSpace::create_dof_distribution(const GridLevel& gl)
 //	create DoFDistribution
 	SmartPtr<DoFDistribution> spDD = SmartPtr<DoFDistribution>(new
 		DoFDistribution(m_spMG, m_spMGSH, m_spDoFDistributionInfo,
-						m_spSurfaceView, gl, m_bGrouped, spIndexStrg));
+						m_spSurfaceView, gl, m_bGrouped, spIndexStrg,
+						gl.is_surface() && m_bIncrementalDoFUpdate));
 
 //	add to list and sort
 	m_vDD.push_back(spDD);
@@ -351,8 +354,10 @@ void IApproximationSpace::create_dof_distribution(const GridLevel& gl)
 void IApproximationSpace::surface_view_required()
 {
 //	allocate surface view if needed
-	if(!m_spSurfaceView.valid())
+	if(!m_spSurfaceView.valid()){
 		m_spSurfaceView = SmartPtr<SurfaceView>(new SurfaceView(m_spMGSH));
+		m_spSurfaceView->enable_element_lists(m_bSurfaceElementLists);
+	}
 }
 
 void IApproximationSpace::dof_distribution_info_required()
@@ -398,11 +403,28 @@ void IApproximationSpace::dof_distribution_info_required()
 		UG_THROW("Cannot determine blocksize of Algebra.");
 }
 
+void IApproximationSpace::set_incremental_dof_update(bool bIncremental)
+{
+	m_bIncrementalDoFUpdate = bIncremental;
+
+	for(size_t i = 0; i < m_vDD.size(); ++i)
+		if(m_vDD[i]->grid_level().is_surface())
+			m_vDD[i]->set_incremental(bIncremental);
+}
+
+void IApproximationSpace::set_surface_element_lists(bool bEnable)
+{
+	m_bSurfaceElementLists = bEnable;
+
+	if(m_spSurfaceView.valid())
+		m_spSurfaceView->enable_element_lists(bEnable);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // Grid-Change Handling
 ////////////////////////////////////////////////////////////////////////////////
 
-void IApproximationSpace::reinit()
+void IApproximationSpace::reinit(bool bAdaption)
 {
 	PROFILE_FUNC();
 //	update surface view
@@ -411,7 +433,8 @@ void IApproximationSpace::reinit()
 
 //	reinit all existing dof distributions
 	for(size_t i = 0; i < m_vDD.size(); ++i){
-		m_vDD[i]->reinit();
+		if(bAdaption) m_vDD[i]->reinit_after_adaption();
+		else m_vDD[i]->reinit();
 	}
 
 //	increase revision counter
@@ -440,7 +463,7 @@ grid_changed_callback(const GridMessage_Adaption& msg)
 	else if(m_bAdaptionIsActive){
 			if(msg.adaption_ends())
 			{
-				reinit();
+				reinit(true);
 				m_bAdaptionIsActive = false;
 
 				#ifdef APPROX_SPACE_PERFORM_CHANGED_GRID_DEBUG_SAVES
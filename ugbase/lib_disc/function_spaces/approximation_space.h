@@ -210,6 +210,24 @@ class IApproximationSpace : public DoFDistributionInfoProvider
 	///	returns the current revision
 		const RevisionCounter& revision() const {return m_RevCnt;}
 
+	///	enables incremental surface dof updates after grid adaption
+	/**
+	 * If enabled, the surface dof distributions keep the indices of unchanged
+	 * objects after grid adaption and only number the new objects. Managed
+	 * grid functions then only need to be updated on the new objects.
+	 */
+		void set_incremental_dof_update(bool bIncremental);
+
+	///	returns if incremental surface dof updates are enabled
+		bool incremental_dof_update() const {return m_bIncrementalDoFUpdate;}
+
+	///	enables cached element lists for the iteration of surface grid levels
+	/**
+	 * The lists are rebuilt on grid adaption and on subset reassignments
+	 * (see SurfaceView::enable_element_lists).
+	 */
+		void set_surface_element_lists(bool bEnable);
+
 	protected:
 	///	creates a dof distribution
 		void create_dof_distribution(const GridLevel& gl);
@@ -221,8 +239,10 @@ class IApproximationSpace : public DoFDistributionInfoProvider
 		void dof_distribution_info_required();
 
 	protected:
-	///	reinits all data after grid adaption
-		void reinit();
+	///	reinits all data after grid change
+	/**	If bAdaption is true, the surface dof distributions may update their
+	 * indices incrementally (if enabled).*/
+		void reinit(bool bAdaption = false);
 
 	///	message hub id
 		MessageHub::SPCallbackId m_spGridAdaptionCallbackID;
@@ -256,6 +276,12 @@ class IApproximationSpace : public DoFDistributionInfoProvider
 	///	flag if DoFs should be grouped
 		bool m_bGrouped;
 
+	///	flag if surface DoFs are updated incrementally after adaption
+		bool m_bIncrementalDoFUpdate;
+
+	///	flag if the surface view caches element lists
+		bool m_bSurfaceElementLists;
+
 	///	DofDistributionInfo
 		SmartPtr<DoFDistributionInfo> m_spDoFDistributionInfo;
 
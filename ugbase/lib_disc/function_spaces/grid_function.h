@@ -98,6 +98,14 @@ class IGridFunction
 	 * \param[in]	defaultValue	default value for new entries
 	 */
 		virtual void resize_values(size_t s, number defaultValue = 0.0) = 0;
+
+	///	called by the dof distribution when it has been updated after grid adaption
+	/**
+	 * \param[in]	bIncremental	if true, the values of objects that kept
+	 * 								their dofs have already been moved to the
+	 * 								new indices
+	 */
+		virtual void dof_distribution_adapted(bool bIncremental) = 0;
 };
 
 template <typename TDomain> class AdaptionSurfaceGridFunction;
@@ -384,6 +392,9 @@ class GridFunction
 		virtual void copy_values(const std::vector<std::pair<size_t, size_t> >& vIndexMap,
 		                         bool bDisjunct = false);
 
+	///	\copydoc IGridFunction::dof_distribution_adapted
+		virtual void dof_distribution_adapted(bool bIncremental);
+
 
 	protected:
 	///	message hub id
@@ -371,21 +371,32 @@ grid_changed_callback(const GridMessage_Adaption& msg)
 		m_spAdaptGridFct->prolongate(msg);
 	}
 
-	// at end of adaption: copy values back into algebra vector
-	if(msg.adaption_ends())
-	{
-		// all grid functions must resize to the current number of dofs
-		resize_values(num_indices());
+	// at end of adaption, the values are copied back into the algebra vector
+	// when the dof distribution has been updated (see dof_distribution_adapted)
+}
 
-		#ifdef UG_PARALLEL
-		//	set layouts
-		this->set_layouts(m_spDD->layouts());
-		#endif
+template <typename TDomain, typename TAlgebra>
+void
+GridFunction<TDomain, TAlgebra>::
+dof_distribution_adapted(bool bIncremental)
+{
+	if(m_spAdaptGridFct.invalid()) return;
 
+	// all grid functions must resize to the current number of dofs
+	resize_values(num_indices());
 
+	#ifdef UG_PARALLEL
+	//	set layouts
+	this->set_layouts(m_spDD->layouts());
+	#endif
+
+	//	after an incremental dof update, the values on unchanged objects
+	//	have already been moved by the dof distribution
+	if(bIncremental)
+		m_spAdaptGridFct->copy_to_surface_new_elements(*this);
+	else
 		m_spAdaptGridFct->copy_to_surface(*this);
-		m_spAdaptGridFct = SPNULL;
-	}
+	m_spAdaptGridFct = SPNULL;
 }
 
 template <typename TDomain, typename TAlgebra>
@@ -34,7 +34,14 @@
 
 #include "common/util/os_info.h"  // for GetPathSeparator
 
+#include "common/util/async_file_writer.h"
+
 #include <sstream>
+#include <limits>
+
+#ifdef UG_PARALLEL
+#include "pcl/parallel_file.h"
+#endif
 
 namespace ug{
 
@@ -75,21 +82,11 @@ print(const char* filename, Domain<TDim>& domain)
 //	open the file
 	try
 	{
-	VTKFileWriter File(name.c_str());
+	VTKFileWriter File;
+	open_vtu(File, name, false);
 
 //	header
-	File << VTKFileWriter::normal;
-	File << "<?xml version=\"1.0\"?>\n";
-
-	write_comment(File);
-
-	File << "<VTKFile type=\"UnstructuredGrid\" version=\"0.1\" byte_order=\"";
-	if(IsLittleEndian()) File << "LittleEndian";
-	else File << "BigEndian";
-	File << "\">\n";
-
-//	opening the grid
-	File << "  <UnstructuredGrid>\n";
+	write_vtu_header(File, false, 0.0);
 
 // 	get dimension of grid-piece
 	int dim = DimensionOfSubsets(sh);
@@ -118,8 +115,8 @@ print(const char* filename, Domain<TDim>& domain)
 	}
 
 //	write closing xml tags
-	File << "  </UnstructuredGrid>\n";
-	File << "</VTKFile>\n";
+	write_vtu_footer(File);
+	close_vtu(File, name, false);
 
 // 	detach help indices
 	grid.detach_from_vertices(aVrtIndex);
@@ -171,6 +168,209 @@ write_empty_grid_piece(VTKFileWriter& File, bool binary)
 	File << "    </Piece>\n";
 }
 
+template <int TDim>
+void VTKOutput<TDim>::
+write_vtu_header(VTKFileWriter& File, bool bTimeDep, number time)
+{
+	File << VTKFileWriter::normal;
+	File << "<?xml version=\"1.0\"?>\n";
+
+	write_comment(File);
+
+	File << "<VTKFile type=\"UnstructuredGrid\" version=\"0.1\" byte_order=\"";
+	if(IsLittleEndian()) File << "LittleEndian";
+	else File << "BigEndian";
+	File << "\">\n";
+
+//	writing time point
+	if(bTimeDep)
+	{
+		File << "  <Time timestep=\""<<time<<"\"/>\n";
+	}
+
+//	opening the grid
+	File << "  <UnstructuredGrid>\n";
+}
+
+template <int TDim>
+void VTKOutput<TDim>::
+write_vtu_footer(VTKFileWriter& File)
+{
+	File << VTKFileWriter::normal;
+	File << "  </UnstructuredGrid>\n";
+	File << "</VTKFile>\n";
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Grouped Output
+////////////////////////////////////////////////////////////////////////////////
+
+template <int TDim>
+int VTKOutput<TDim>::
+num_output_files() const
+{
+#ifdef UG_PARALLEL
+	const int numProcs = pcl::NumProcs();
+	if(numProcs == 1) return 0;
+
+	if(m_numOutputFiles > 0)
+		return (m_numOutputFiles < numProcs) ? m_numOutputFiles : 0;
+
+//	collective io without specified number of files: one file for all
+	if(m_bCollectiveIO) return 1;
+#endif
+	return 0;
+}
+
+template <int TDim>
+int VTKOutput<TDim>::
+output_file_index(int rank) const
+{
+#ifdef UG_PARALLEL
+	const int numFiles = num_output_files();
+	if(numFiles > 0)
+		return (int)(((long long)rank * numFiles) / pcl::NumProcs());
+#endif
+	return rank;
+}
+
+template <int TDim>
+int VTKOutput<TDim>::
+output_file_rank(int fileIndex) const
+{
+#ifdef UG_PARALLEL
+	const int numFiles = num_output_files();
+	if(numFiles > 0)
+		return (int)(((long long)fileIndex * pcl::NumProcs() + numFiles - 1) / numFiles);
+#endif
+	return fileIndex;
+}
+
+template <int TDim>
+void VTKOutput<TDim>::
+write_grouped_vtu(const std::string& name, const std::string& piece)
+{
+#ifdef UG_PARALLEL
+	PROFILE_FUNC();
+	const int numFiles = num_output_files();
+	UG_COND_THROW(numFiles <= 0, "VTK::write_grouped_vtu: grouped output not enabled.");
+
+	const int rank = pcl::ProcRank();
+	const int fileIndex = output_file_index(rank);
+	const int firstRank = output_file_rank(fileIndex);
+	const int endRank = (fileIndex + 1 < numFiles) ? output_file_rank(fileIndex + 1)
+												   : pcl::NumProcs();
+
+	if(m_bCollectiveIO)
+	{
+	//	create the communicators of all groups (has to be done by all procs)
+		if(m_outputFileCommNumFiles != numFiles)
+		{
+			pcl::ProcessCommunicator world;
+			for(int f = 0; f < numFiles; ++f)
+			{
+				const int fEnd = (f + 1 < numFiles) ? output_file_rank(f + 1)
+													: pcl::NumProcs();
+				std::vector<int> vProc;
+				for(int p = output_file_rank(f); p < fEnd; ++p)
+					vProc.push_back(p);
+
+				pcl::ProcessCommunicator comm = world.create_sub_communicator(vProc);
+				if(f == fileIndex) m_outputFileComm = comm;
+			}
+			m_outputFileCommNumFiles = numFiles;
+		}
+
+	//	the first proc of the group writes the header, the last one the footer
+		std::string data;
+		VTKFileWriter File;
+		if(rank == firstRank)
+		{
+			File.open_memory();
+			write_vtu_header(File, false, 0.0);
+			File.close();
+			data = File.memory_content();
+		}
+		data.append(piece);
+		if(rank == endRank - 1)
+		{
+			File.open_memory();
+			write_vtu_footer(File);
+			File.close();
+			data.append(File.memory_content());
+		}
+
+		pcl::WriteConcatenatedParallelFile(data.data(), data.size(), name, m_outputFileComm);
+		return;
+	}
+
+//	all procs of the group send their piece to the first proc of the group
+	const int tag = 4232;
+	pcl::ProcessCommunicator com;
+	if(rank != firstRank)
+	{
+		UG_COND_THROW(piece.size() > (size_t)std::numeric_limits<int>::max(),
+					  "VTK::write_grouped_vtu: piece too large to be sent.");
+		int size = (int)piece.size();
+		com.send_data(&size, sizeof(int), firstRank, tag);
+		if(size > 0)
+			com.send_data(const_cast<char*>(piece.data()), size, firstRank, tag);
+		return;
+	}
+
+	VTKFileWriter File;
+	open_vtu(File, name, false);
+	write_vtu_header(File, false, 0.0);
+	File << piece;
+
+	std::vector<char> vBuffer;
+	for(int p = firstRank + 1; p < endRank; ++p)
+	{
+		int size = 0;
+		com.receive_data(&size, sizeof(int), p, tag);
+		if(size == 0) continue;
+		vBuffer.resize(size + 1);
+		com.receive_data(&vBuffer.front(), size, p, tag);
+		vBuffer[size] = 0;
+		File << &vBuffer.front();
+	}
+
+	write_vtu_footer(File);
+	close_vtu(File, name, false);
+#else
+	UG_THROW("VTK::write_grouped_vtu: only available in parallel.");
+#endif
+}
+
+template <int TDim>
+void VTKOutput<TDim>::
+open_vtu(VTKFileWriter& File, const std::string& name, bool bGrouped)
+{
+	if(bGrouped || m_bAsync) File.open_memory();
+	else File.open(name.c_str());
+}
+
+template <int TDim>
+void VTKOutput<TDim>::
+close_vtu(VTKFileWriter& File, const std::string& name, bool bGrouped)
+{
+	File << VTKFileWriter::normal;
+	File.close();
+
+	if(bGrouped)
+	{
+		try{
+			write_grouped_vtu(name, File.memory_content());
+		}
+		UG_CATCH_THROW("VTK: Can not write grouped vtu - file.");
+	}
+	else if(m_bAsync)
+	{
+		std::string content = File.memory_content();
+		GetAsyncFileWriter().write(name, content);
+	}
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // FileNames
 ////////////////////////////////////////////////////////////////////////////////
@@ -614,6 +814,30 @@ set_write_proc_ranks(bool b) {
 	m_bWriteProcRanks = b;
 }
 
+template <int TDim>
+void VTKOutput<TDim>::
+set_num_output_files(int n) {
+	m_numOutputFiles = n;
+}
+
+template <int TDim>
+void VTKOutput<TDim>::
+set_collective_io(bool b) {
+	m_bCollectiveIO = b;
+}
+
+template <int TDim>
+void VTKOutput<TDim>::
+set_async(bool b) {
+	m_bAsync = b;
+}
+
+template <int TDim>
+void VTKOutput<TDim>::
+flush() {
+	GetAsyncFileWriter().flush();
+}
+
 template <int TDim>
 void VTKOutput<TDim>::
 set_user_defined_comment(const char* comment){
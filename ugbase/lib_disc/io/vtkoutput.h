@@ -45,7 +45,11 @@
 #include "common/util/base64_file_writer.h"
 #include "lib_disc/common/function_group.h"
 #include "lib_disc/domain.h"
+#include "lib_grid/tools/scoped_marker.h"
 #include "lib_disc/spatial_disc/user_data/user_data.h"
+#ifdef UG_PARALLEL
+#include "pcl/pcl_process_communicator.h"
+#endif
 
 namespace ug{
 // todo this should avoid refactoring all the signatures of VTKOutput, remove it later
@@ -140,8 +144,8 @@ struct IteratorProvider<MGSubsetHandler>
  * with only one process), the *.pvtu are not written and the *.vtu file
  * contains all information.
  *
- * ATTENTION: This class uses heavily the mark-function of the grid.
- * 			  Do not use any member function while having called begin_mark()
+ * Vertices already written are tracked with a ScopedMarker, so the output
+ * may be called while the grid's own marks are in use (Grid::begin_marking).
  *
  * \tparam		dim 	world dimension
  */
@@ -493,7 +497,7 @@ protected:
 	 */
 		template <typename TElem, typename T>
 		void
-		count_sizes(Grid& grid, const T& iterContainer, int si,
+		count_sizes(ScopedMarker& marker, const T& iterContainer, int si,
 		            int& numVert, int& numElem, int& numConn);
 
 		template <typename T>
@@ -589,7 +593,7 @@ protected:
 		write_points_elementwise(VTKFileWriter& File,
 		                         Grid::VertexAttachmentAccessor<Attachment<int> >& aaVrtIndex,
 		                         const Grid::VertexAttachmentAccessor<Attachment<MathVector<TDim> > >& aaPos,
-		                         Grid& grid, const T& iterContainer, int si, int& n);
+		                         ScopedMarker& marker, const T& iterContainer, int si, int& n);
 
 	/**
 	 * This function writes the elements that are part of a given subset. If si < 0
@@ -800,13 +804,13 @@ protected:
 	 * \param[in]	File		file stream
 	 * \param[in]	u			grid function
 	 * \param[in]	vFct		components to be written
-	 * \param[in]	grid		Grid
+	 * \param[in]	marker		marker of already written vertices
 	 * \param[in]	si			subset index
 	 */
 		template <typename TElem, typename TFunction>
 		void write_nodal_values_elementwise(VTKFileWriter& File, TFunction& u,
 		                                    const std::vector<size_t>& vFct,
-		                                    Grid& grid, int si);
+		                                    ScopedMarker& marker, int si);
 
 	/**
 	 * This function writes the values of a function as a \<DataArray\> field to
@@ -852,7 +856,7 @@ protected:
 		void write_nodal_data_elementwise(VTKFileWriter& File, TFunction& u,
 		                                  number time,
 		                                  SmartPtr<UserData<TData, TDim> > spData,
-		                                  Grid& grid, int si);
+		                                  ScopedMarker& marker, int si);
 		template <typename TFunction, typename TData>
 		void write_nodal_data(VTKFileWriter& File, TFunction& u, number time,
 		                      SmartPtr<UserData<TData, TDim> > spData,
@@ -990,7 +994,12 @@ protected:
 
 	public:
 	///	default constructor
-		VTKOutput()	: m_bSelectAll(true), m_bBinary(true), m_bWriteGrid(true), m_bWriteSubsetIndices(false), m_bWriteProcRanks(false) {} //TODO: maybe true?
+		VTKOutput()	: m_bSelectAll(true), m_bBinary(true), m_bWriteGrid(true), m_bWriteSubsetIndices(false), m_bWriteProcRanks(false),
+					  m_numOutputFiles(0), m_bCollectiveIO(false), m_bAsync(false)
+#ifdef UG_PARALLEL
+					  , m_outputFileCommNumFiles(0)
+#endif
+		{} //TODO: maybe true?
 
 	/// should values be printed in binary (base64 encoded way ) or plain ascii
 		void set_binary(bool b);
@@ -1001,10 +1010,64 @@ protected:
 
 		void set_write_proc_ranks(bool b);
 
+	///	sets the number of *.vtu files the pieces of all processes are written to
+	/**	By default (n = 0) each process writes its own *.vtu file and the
+	 * files are grouped by a *.pvtu file. For 0 < n < #procs the processes
+	 * are split into n groups of consecutive ranks. The pieces of each group
+	 * are written into one multi-piece *.vtu file, which is named after the
+	 * first rank of the group. The *.pvtu file then only lists these n files.*/
+		void set_num_output_files(int n);
+
+	///	if enabled, grouped *.vtu files are written collectively using MPI-IO
+	/**	All processes of a group write their piece directly into the shared
+	 * file. Otherwise the pieces are sent to the first process of the group,
+	 * which writes the file. If no number of output files was specified,
+	 * all processes write into a single file.*/
+		void set_collective_io(bool b);
+
+	///	if enabled, *.vtu files are written to disk in a background thread
+	/**	The file content is assembled in memory during the print call and
+	 * handed over to the GetAsyncFileWriter(), so that the computation can
+	 * proceed while the data is written. Errors are reported by the next
+	 * print call or by flush(). Grouped files written with collective io
+	 * are always written synchronously.*/
+		void set_async(bool b);
+
+	///	waits until all asynchronously written files are on disk
+	/**	Throws, if an error occurred while writing.*/
+		void flush();
+
 	protected:
 	///	returns true if name for vtk-component is already used
 		bool vtk_name_used(const char* name) const;
 
+	///	writes the xml header of a *.vtu file up to the opening UnstructuredGrid tag
+		void write_vtu_header(VTKFileWriter& File, bool bTimeDep, number time);
+
+	///	writes the closing xml tags of a *.vtu file
+		static void write_vtu_footer(VTKFileWriter& File);
+
+	///	number of grouped output files (0 if every process writes its own file)
+		int num_output_files() const;
+
+	///	index of the grouped output file the given process writes its piece to
+		int output_file_index(int rank) const;
+
+	///	first process of the group writing to the given output file
+		int output_file_rank(int fileIndex) const;
+
+	///	writes the piece of this process into the grouped file 'name'
+	/**	Has to be called by all processes.*/
+		void write_grouped_vtu(const std::string& name, const std::string& piece);
+
+	///	opens the *.vtu file, or a memory buffer if the content is written later
+		void open_vtu(VTKFileWriter& File, const std::string& name, bool bGrouped);
+
+	///	finishes a *.vtu file opened by open_vtu
+	/**	Grouped pieces are sent to write_grouped_vtu, asynchronous files
+	 * are handed over to the AsyncFileWriter.*/
+		void close_vtu(VTKFileWriter& File, const std::string& name, bool bGrouped);
+
 	///	writes data to stream
 	/**
 	 * The purpose of the function is to convert a double data to binary float
@@ -1057,6 +1120,19 @@ protected:
 
 		bool m_bWriteSubsetIndices;
 		bool m_bWriteProcRanks;
+
+	///	number of grouped output files (0: one file per process)
+		int m_numOutputFiles;
+	///	write grouped files with MPI-IO
+		bool m_bCollectiveIO;
+	///	write files asynchronously
+		bool m_bAsync;
+
+#ifdef UG_PARALLEL
+	///	communicator of the processes writing to the same file (collective io)
+		pcl::ProcessCommunicator m_outputFileComm;
+		int m_outputFileCommNumFiles;
+#endif
 };
 
 } // namespace ug
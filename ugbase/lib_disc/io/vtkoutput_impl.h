@@ -213,6 +213,10 @@ print_subset(const char* filename, TFunction& u, int si, int step, number time,
 	rank = pcl::ProcRank();
 #endif
 
+//	if pieces are grouped, the file is named after the first proc of the group
+	const bool bGrouped = (num_output_files() > 0);
+	if(bGrouped) rank = output_file_rank(output_file_index(rank));
+
 //	get name for *.vtu file
 	std::string name;
 	try{
@@ -224,7 +228,8 @@ print_subset(const char* filename, TFunction& u, int si, int step, number time,
 //	open the file
 	try
 	{
-	VTKFileWriter File(name.c_str());
+	VTKFileWriter File;
+	open_vtu(File, name, bGrouped);
 
 //	bool if time point should be written to *.vtu file
 //	in parallel we must not (!) write it to the *.vtu file, but to the *.pvtu
@@ -233,25 +238,9 @@ print_subset(const char* filename, TFunction& u, int si, int step, number time,
 	if(pcl::NumProcs() > 1) bTimeDep = false;
 #endif
 
-//	header
-	File << VTKFileWriter::normal;
-	File << "<?xml version=\"1.0\"?>\n";
-
-	write_comment(File);
-
-	File << "<VTKFile type=\"UnstructuredGrid\" version=\"0.1\" byte_order=\"";
-	if(IsLittleEndian()) File << "LittleEndian";
-	else File << "BigEndian";
-	File << "\">\n";
-
-//	writing time point
-	if(bTimeDep)
-	{
-		File << "  <Time timestep=\""<<time<<"\"/>\n";
-	}
-
-//	opening the grid
-	File << "  <UnstructuredGrid>\n";
+//	header (grouped files get their header from write_grouped_vtu)
+	if(!bGrouped)
+		write_vtu_header(File, bTimeDep, time);
 
 // 	get dimension of grid-piece
 	int dim = -1;
@@ -280,9 +269,9 @@ print_subset(const char* filename, TFunction& u, int si, int step, number time,
 	}
 
 //	write closing xml tags
-	File << VTKFileWriter::normal;
-	File << "  </UnstructuredGrid>\n";
-	File << "</VTKFile>\n";
+	if(!bGrouped)
+		write_vtu_footer(File);
+	close_vtu(File, name, bGrouped);
 
 // 	detach help indices
 	grid.detach_from_vertices(aVrtIndex);
@@ -345,6 +334,10 @@ print_subsets(const char* filename, TFunction& u, SubsetGroup& ssGrp, int step,
 	rank = pcl::ProcRank();
 #endif
 
+//	if pieces are grouped, the file is named after the first proc of the group
+	const bool bGrouped = (num_output_files() > 0);
+	if(bGrouped) rank = output_file_rank(output_file_index(rank));
+
 //	get name for *.vtu file
 	std::string name;
 	try{
@@ -356,7 +349,8 @@ print_subsets(const char* filename, TFunction& u, SubsetGroup& ssGrp, int step,
 //	open the file
 	try
 	{
-	VTKFileWriter File(name.c_str());
+	VTKFileWriter File;
+	open_vtu(File, name, bGrouped);
 
 //	bool if time point should be written to *.vtu file
 //	in parallel we must not (!) write it to the *.vtu file, but to the *.pvtu
@@ -365,25 +359,9 @@ print_subsets(const char* filename, TFunction& u, SubsetGroup& ssGrp, int step,
 	if(pcl::NumProcs() > 1) bTimeDep = false;
 #endif
 
-//	header
-	File << VTKFileWriter::normal;
-	File << "<?xml version=\"1.0\"?>\n";
-
-	write_comment(File);
-
-	File << "<VTKFile type=\"UnstructuredGrid\" version=\"0.1\" byte_order=\"";
-	if(IsLittleEndian()) File << "LittleEndian";
-	else File << "BigEndian";
-	File << "\">\n";
-
-//	writing time point
-	if(bTimeDep)
-	{
-		File << "  <Time timestep=\""<<time<<"\"/>\n";
-	}
-
-//	opening the grid
-	File << "  <UnstructuredGrid>\n";
+//	header (grouped files get their header from write_grouped_vtu)
+	if(!bGrouped)
+		write_vtu_header(File, bTimeDep, time);
 
 // 	get dimension of grid-piece: the highest dimension of the specified subsets
 	int dim = -1;
@@ -409,9 +387,9 @@ print_subsets(const char* filename, TFunction& u, SubsetGroup& ssGrp, int step,
 	}
 
 //	write closing xml tags
-	File << VTKFileWriter::normal;
-	File << "  </UnstructuredGrid>\n";
-	File << "</VTKFile>\n";
+	if(!bGrouped)
+		write_vtu_footer(File);
+	close_vtu(File, name, bGrouped);
 
 // 	detach help indices
 	grid.detach_from_vertices(aVrtIndex);
@@ -652,7 +630,7 @@ write_grid_solution_piece(VTKFileWriter& File,
 template <int TDim>
 template <typename TElem, typename T>
 void VTKOutput<TDim>::
-count_sizes(Grid& grid, const T& iterContainer, int si,
+count_sizes(ScopedMarker& marker, const T& iterContainer, int si,
             int& numVert, int& numElem, int& numConn)
 {
 //	get reference element
@@ -694,11 +672,11 @@ count_sizes(Grid& grid, const T& iterContainer, int si,
 			Vertex* v = GetVertex(elem,i);
 
 		//	if this vertex has already been counted, skip it
-			if(grid.is_marked(v)) continue;
+			if(marker.is_marked(v)) continue;
 
 		// count vertex and mark it
 			++numVert;
-			grid.mark(v);
+			marker.mark(v);
 		}
 	}
 };
@@ -711,29 +689,26 @@ count_piece_sizes(Grid& grid, const T& iterContainer, int si, int dim,
                   int& numVert, int& numElem, int& numConn)
 {
 //	reset all marks
-	grid.begin_marking();
+	ScopedMarker marker(grid);
 
 //	switch dimension
 	switch(dim)
 	{
-		case 0: count_sizes<Vertex, T>(grid, iterContainer, si, numVert, numElem, numConn); break;
-		case 1: count_sizes<RegularEdge, T>(grid, iterContainer, si, numVert, numElem, numConn);
-				count_sizes<ConstrainingEdge, T>(grid, iterContainer, si, numVert, numElem, numConn); break;
-		case 2: count_sizes<Triangle, T>(grid, iterContainer, si, numVert, numElem, numConn);
-				count_sizes<Quadrilateral, T>(grid, iterContainer, si, numVert, numElem, numConn);
-				count_sizes<ConstrainingTriangle, T>(grid, iterContainer, si, numVert, numElem, numConn);
-				count_sizes<ConstrainingQuadrilateral, T>(grid, iterContainer, si, numVert, numElem, numConn); break;
-		case 3: count_sizes<Tetrahedron, T>(grid, iterContainer, si, numVert, numElem, numConn);
-				count_sizes<Pyramid, T>(grid, iterContainer, si, numVert, numElem, numConn);
-				count_sizes<Prism, T>(grid, iterContainer, si, numVert, numElem, numConn);
-				count_sizes<Octahedron, T>(grid, iterContainer, si, numVert, numElem, numConn);
-				count_sizes<Hexahedron, T>(grid, iterContainer, si, numVert, numElem, numConn); break;
+		case 0: count_sizes<Vertex, T>(marker, iterContainer, si, numVert, numElem, numConn); break;
+		case 1: count_sizes<RegularEdge, T>(marker, iterContainer, si, numVert, numElem, numConn);
+				count_sizes<ConstrainingEdge, T>(marker, iterContainer, si, numVert, numElem, numConn); break;
+		case 2: count_sizes<Triangle, T>(marker, iterContainer, si, numVert, numElem, numConn);
+				count_sizes<Quadrilateral, T>(marker, iterContainer, si, numVert, numElem, numConn);
+				count_sizes<ConstrainingTriangle, T>(marker, iterContainer, si, numVert, numElem, numConn);
+				count_sizes<ConstrainingQuadrilateral, T>(marker, iterContainer, si, numVert, numElem, numConn); break;
+		case 3: count_sizes<Tetrahedron, T>(marker, iterContainer, si, numVert, numElem, numConn);
+				count_sizes<Pyramid, T>(marker, iterContainer, si, numVert, numElem, numConn);
+				count_sizes<Prism, T>(marker, iterContainer, si, numVert, numElem, numConn);
+				count_sizes<Octahedron, T>(marker, iterContainer, si, numVert, numElem, numConn);
+				count_sizes<Hexahedron, T>(marker, iterContainer, si, numVert, numElem, numConn); break;
 		default: UG_THROW("VTK::count_piece_sizes: Dimension " << dim <<
 		                        " is not supported.");
 	}
-
-//	signal end of marking
-	grid.end_marking();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -747,7 +722,7 @@ void VTKOutput<TDim>::
 write_points_elementwise(VTKFileWriter& File,
                          Grid::VertexAttachmentAccessor<Attachment<int> >& aaVrtIndex,
                          const Grid::VertexAttachmentAccessor<Attachment<MathVector<TDim> > >& aaPos,
-                         Grid& grid, const T& iterContainer, int si, int& n)
+                         ScopedMarker& marker, const T& iterContainer, int si, int& n)
 {
 //	get reference element
 	typedef typename reference_element_traits<TElem>::reference_element_type
@@ -774,10 +749,10 @@ write_points_elementwise(VTKFileWriter& File,
 			Vertex* v = GetVertex(elem, i);
 
 		//	if vertex has already be handled, skip it
-			if(grid.is_marked(v)) continue;
+			if(marker.is_marked(v)) continue;
 
 		//	mark the vertex as processed
-			grid.mark(v);
+			marker.mark(v);
 
 		//	number vertex
 			aaVrtIndex[v] = n++;
@@ -853,31 +828,28 @@ write_points(VTKFileWriter& File,
 	n = 0;
 
 //	start marking of vertices
-	grid.begin_marking();
+	ScopedMarker marker(grid);
 
 //	switch dimension
 	if(numVert > 0){
 		switch(dim){
-			case 0: write_points_elementwise<Vertex,T>(File, aaVrtIndex, aaPos, grid, iterContainer, si, n); break;
-			case 1: write_points_elementwise<RegularEdge,T>(File, aaVrtIndex, aaPos, grid, iterContainer, si, n);
-					write_points_elementwise<ConstrainingEdge,T>(File, aaVrtIndex, aaPos, grid, iterContainer, si, n); break;
-			case 2: write_points_elementwise<Triangle,T>(File, aaVrtIndex, aaPos, grid, iterContainer, si, n);
-					write_points_elementwise<Quadrilateral,T>(File, aaVrtIndex, aaPos, grid, iterContainer, si, n);
-					write_points_elementwise<ConstrainingTriangle,T>(File, aaVrtIndex, aaPos, grid, iterContainer, si, n);
-					write_points_elementwise<ConstrainingQuadrilateral,T>(File, aaVrtIndex, aaPos, grid, iterContainer, si, n); break;
-			case 3:	write_points_elementwise<Tetrahedron,T>(File, aaVrtIndex, aaPos, grid, iterContainer, si, n);
-					write_points_elementwise<Pyramid,T>(File, aaVrtIndex, aaPos, grid, iterContainer, si, n);
-					write_points_elementwise<Prism,T>(File, aaVrtIndex, aaPos, grid, iterContainer, si, n);
-					write_points_elementwise<Octahedron,T>(File, aaVrtIndex, aaPos, grid, iterContainer, si, n);
-					write_points_elementwise<Hexahedron,T>(File, aaVrtIndex, aaPos, grid, iterContainer, si, n); break;
+			case 0: write_points_elementwise<Vertex,T>(File, aaVrtIndex, aaPos, marker, iterContainer, si, n); break;
+			case 1: write_points_elementwise<RegularEdge,T>(File, aaVrtIndex, aaPos, marker, iterContainer, si, n);
+					write_points_elementwise<ConstrainingEdge,T>(File, aaVrtIndex, aaPos, marker, iterContainer, si, n); break;
+			case 2: write_points_elementwise<Triangle,T>(File, aaVrtIndex, aaPos, marker, iterContainer, si, n);
+					write_points_elementwise<Quadrilateral,T>(File, aaVrtIndex, aaPos, marker, iterContainer, si, n);
+					write_points_elementwise<ConstrainingTriangle,T>(File, aaVrtIndex, aaPos, marker, iterContainer, si, n);
+					write_points_elementwise<ConstrainingQuadrilateral,T>(File, aaVrtIndex, aaPos, marker, iterContainer, si, n); break;
+			case 3:	write_points_elementwise<Tetrahedron,T>(File, aaVrtIndex, aaPos, marker, iterContainer, si, n);
+					write_points_elementwise<Pyramid,T>(File, aaVrtIndex, aaPos, marker, iterContainer, si, n);
+					write_points_elementwise<Prism,T>(File, aaVrtIndex, aaPos, marker, iterContainer, si, n);
+					write_points_elementwise<Octahedron,T>(File, aaVrtIndex, aaPos, marker, iterContainer, si, n);
+					write_points_elementwise<Hexahedron,T>(File, aaVrtIndex, aaPos, marker, iterContainer, si, n); break;
 			default: UG_THROW("VTK::write_points: Dimension " << dim <<
 			                        " is not supported.");
 		}
 	}
 
-//	signal end of marking the grid
-	grid.end_marking();
-
 //	write closing tags
 	File << VTKFileWriter::normal;
 	File << "\n        </DataArray>\n";
@@ -910,32 +882,29 @@ write_points(VTKFileWriter& File,
 	n = 0;
 
 //	start marking of vertices
-	grid.begin_marking();
+	ScopedMarker marker(grid);
 
 //	switch dimension
 	if(numVert > 0)
 	for(size_t i = 0; i < ssGrp.size(); i++){
 		switch(dim){
-			case 0: write_points_elementwise<Vertex,T>(File, aaVrtIndex, aaPos, grid, iterContainer, ssGrp[i], n); break;
-			case 1: write_points_elementwise<RegularEdge,T>(File, aaVrtIndex, aaPos, grid, iterContainer, ssGrp[i], n);
-					write_points_elementwise<ConstrainingEdge,T>(File, aaVrtIndex, aaPos, grid, iterContainer, ssGrp[i], n); break;
-			case 2: write_points_elementwise<Triangle,T>(File, aaVrtIndex, aaPos, grid, iterContainer, ssGrp[i], n);
-					write_points_elementwise<Quadrilateral,T>(File, aaVrtIndex, aaPos, grid, iterContainer, ssGrp[i], n);
-					write_points_elementwise<ConstrainingTriangle,T>(File, aaVrtIndex, aaPos, grid, iterContainer, ssGrp[i], n);
-					write_points_elementwise<ConstrainingQuadrilateral,T>(File, aaVrtIndex, aaPos, grid, iterContainer, ssGrp[i], n); break;
-			case 3:	write_points_elementwise<Tetrahedron,T>(File, aaVrtIndex, aaPos, grid, iterContainer, ssGrp[i], n);
-					write_points_elementwise<Pyramid,T>(File, aaVrtIndex, aaPos, grid, iterContainer, ssGrp[i], n);
-					write_points_elementwise<Prism,T>(File, aaVrtIndex, aaPos, grid, iterContainer, ssGrp[i], n);
-					write_points_elementwise<Octahedron,T>(File, aaVrtIndex, aaPos, grid, iterContainer, ssGrp[i], n);
-					write_points_elementwise<Hexahedron,T>(File, aaVrtIndex, aaPos, grid, iterContainer, ssGrp[i], n); break;
+			case 0: write_points_elementwise<Vertex,T>(File, aaVrtIndex, aaPos, marker, iterContainer, ssGrp[i], n); break;
+			case 1: write_points_elementwise<RegularEdge,T>(File, aaVrtIndex, aaPos, marker, iterContainer, ssGrp[i], n);
+					write_points_elementwise<ConstrainingEdge,T>(File, aaVrtIndex, aaPos, marker, iterContainer, ssGrp[i], n); break;
+			case 2: write_points_elementwise<Triangle,T>(File, aaVrtIndex, aaPos, marker, iterContainer, ssGrp[i], n);
+					write_points_elementwise<Quadrilateral,T>(File, aaVrtIndex, aaPos, marker, iterContainer, ssGrp[i], n);
+					write_points_elementwise<ConstrainingTriangle,T>(File, aaVrtIndex, aaPos, marker, iterContainer, ssGrp[i], n);
+					write_points_elementwise<ConstrainingQuadrilateral,T>(File, aaVrtIndex, aaPos, marker, iterContainer, ssGrp[i], n); break;
+			case 3:	write_points_elementwise<Tetrahedron,T>(File, aaVrtIndex, aaPos, marker, iterContainer, ssGrp[i], n);
+					write_points_elementwise<Pyramid,T>(File, aaVrtIndex, aaPos, marker, iterContainer, ssGrp[i], n);
+					write_points_elementwise<Prism,T>(File, aaVrtIndex, aaPos, marker, iterContainer, ssGrp[i], n);
+					write_points_elementwise<Octahedron,T>(File, aaVrtIndex, aaPos, marker, iterContainer, ssGrp[i], n);
+					write_points_elementwise<Hexahedron,T>(File, aaVrtIndex, aaPos, marker, iterContainer, ssGrp[i], n); break;
 			default: UG_THROW("VTK::write_points: Dimension " << dim <<
 			                        " is not supported.");
 		}
 	}
 
-//	signal end of marking the grid
-	grid.end_marking();
-
 //	write closing tags
 	File << VTKFileWriter::normal;
 	File << "\n        </DataArray>\n";
@@ -1745,7 +1714,7 @@ template <typename TElem, typename TFunction, typename TData>
 void VTKOutput<TDim>::
 write_nodal_data_elementwise(VTKFileWriter& File, TFunction& u, number time,
                              SmartPtr<UserData<TData, TDim> > spData,
-                             Grid& grid, int si)
+                             ScopedMarker& marker, int si)
 {
 //	get reference element
 	typedef typename reference_element_traits<TElem>::reference_element_type
@@ -1820,10 +1789,10 @@ write_nodal_data_elementwise(VTKFileWriter& File, TFunction& u, number time,
 			Vertex* v = GetVertex(elem, co);
 
 		//	if vertex has been handled before, skip
-			if(grid.is_marked(v)) continue;
+			if(marker.is_marked(v)) continue;
 
 		//	mark as used
-			grid.mark(v);
+			marker.mark(v);
 
 		//	loop all components
 			write_item_to_file(File, vValue[co]);
@@ -1860,29 +1829,26 @@ write_nodal_data(VTKFileWriter& File, TFunction& u, number time,
 		File << VTKFileWriter::base64_binary << n;
 
 //	start marking of grid
-	grid.begin_marking();
+	ScopedMarker marker(grid);
 
 //	switch dimension
 	switch(dim)
 	{
-		case 1:	write_nodal_data_elementwise<RegularEdge,TFunction,TData>(File, u, time, spData, grid, si);
-				write_nodal_data_elementwise<ConstrainingEdge,TFunction,TData>(File, u, time, spData, grid, si); break;
-		case 2:	write_nodal_data_elementwise<Triangle,TFunction,TData>(File, u, time, spData, grid, si);
-				write_nodal_data_elementwise<Quadrilateral,TFunction,TData>(File, u, time, spData, grid, si);
-				write_nodal_data_elementwise<ConstrainingTriangle,TFunction,TData>(File, u, time, spData, grid, si);
-				write_nodal_data_elementwise<ConstrainingQuadrilateral,TFunction,TData>(File, u, time, spData, grid, si); break;
-		case 3:	write_nodal_data_elementwise<Tetrahedron,TFunction,TData>(File, u, time, spData, grid, si);
-				write_nodal_data_elementwise<Pyramid,TFunction,TData>(File, u, time, spData, grid, si);
-				write_nodal_data_elementwise<Prism,TFunction,TData>(File, u, time, spData, grid, si);
-				write_nodal_data_elementwise<Octahedron,TFunction,TData>(File, u, time, spData, grid, si);
-				write_nodal_data_elementwise<Hexahedron,TFunction,TData>(File, u, time, spData, grid, si); break;
+		case 1:	write_nodal_data_elementwise<RegularEdge,TFunction,TData>(File, u, time, spData, marker, si);
+				write_nodal_data_elementwise<ConstrainingEdge,TFunction,TData>(File, u, time, spData, marker, si); break;
+		case 2:	write_nodal_data_elementwise<Triangle,TFunction,TData>(File, u, time, spData, marker, si);
+				write_nodal_data_elementwise<Quadrilateral,TFunction,TData>(File, u, time, spData, marker, si);
+				write_nodal_data_elementwise<ConstrainingTriangle,TFunction,TData>(File, u, time, spData, marker, si);
+				write_nodal_data_elementwise<ConstrainingQuadrilateral,TFunction,TData>(File, u, time, spData, marker, si); break;
+		case 3:	write_nodal_data_elementwise<Tetrahedron,TFunction,TData>(File, u, time, spData, marker, si);
+				write_nodal_data_elementwise<Pyramid,TFunction,TData>(File, u, time, spData, marker, si);
+				write_nodal_data_elementwise<Prism,TFunction,TData>(File, u, time, spData, marker, si);
+				write_nodal_data_elementwise<Octahedron,TFunction,TData>(File, u, time, spData, marker, si);
+				write_nodal_data_elementwise<Hexahedron,TFunction,TData>(File, u, time, spData, marker, si); break;
 		default: UG_THROW("VTK::write_nodal_data: Dimension " << dim <<
 		                        " is not supported.");
 	}
 
-//	end marking
-	grid.end_marking();
-
 //	write closing tag
 	File << VTKFileWriter::normal;
 	File << "\n        </DataArray>\n";
@@ -1915,30 +1881,27 @@ write_nodal_data(VTKFileWriter& File, TFunction& u, number time,
 		File << VTKFileWriter::base64_binary << n;
 
 //	start marking of grid
-	grid.begin_marking();
+	ScopedMarker marker(grid);
 
 //	switch dimension
 	for(size_t i = 0; i < ssGrp.size(); i++)
 	switch(dim)
 	{
-		case 1:	write_nodal_data_elementwise<RegularEdge,TFunction,TData>(File, u, time, spData, grid, ssGrp[i]);
-				write_nodal_data_elementwise<ConstrainingEdge,TFunction,TData>(File, u, time, spData, grid, ssGrp[i]); break;
-		case 2:	write_nodal_data_elementwise<Triangle,TFunction,TData>(File, u, time, spData, grid, ssGrp[i]);
-				write_nodal_data_elementwise<Quadrilateral,TFunction,TData>(File, u, time, spData, grid, ssGrp[i]);
-				write_nodal_data_elementwise<ConstrainingTriangle,TFunction,TData>(File, u, time, spData, grid, ssGrp[i]);
-				write_nodal_data_elementwise<ConstrainingQuadrilateral,TFunction,TData>(File, u, time, spData, grid, ssGrp[i]); break;
-		case 3:	write_nodal_data_elementwise<Tetrahedron,TFunction,TData>(File, u, time, spData, grid, ssGrp[i]);
-				write_nodal_data_elementwise<Pyramid,TFunction,TData>(File, u, time, spData, grid, ssGrp[i]);
-				write_nodal_data_elementwise<Prism,TFunction,TData>(File, u, time, spData, grid, ssGrp[i]);
-				write_nodal_data_elementwise<Octahedron,TFunction,TData>(File, u, time, spData, grid, ssGrp[i]);
-				write_nodal_data_elementwise<Hexahedron,TFunction,TData>(File, u, time, spData, grid, ssGrp[i]); break;
+		case 1:	write_nodal_data_elementwise<RegularEdge,TFunction,TData>(File, u, time, spData, marker, ssGrp[i]);
+				write_nodal_data_elementwise<ConstrainingEdge,TFunction,TData>(File, u, time, spData, marker, ssGrp[i]); break;
+		case 2:	write_nodal_data_elementwise<Triangle,TFunction,TData>(File, u, time, spData, marker, ssGrp[i]);
+				write_nodal_data_elementwise<Quadrilateral,TFunction,TData>(File, u, time, spData, marker, ssGrp[i]);
+				write_nodal_data_elementwise<ConstrainingTriangle,TFunction,TData>(File, u, time, spData, marker, ssGrp[i]);
+				write_nodal_data_elementwise<ConstrainingQuadrilateral,TFunction,TData>(File, u, time, spData, marker, ssGrp[i]); break;
+		case 3:	write_nodal_data_elementwise<Tetrahedron,TFunction,TData>(File, u, time, spData, marker, ssGrp[i]);
+				write_nodal_data_elementwise<Pyramid,TFunction,TData>(File, u, time, spData, marker, ssGrp[i]);
+				write_nodal_data_elementwise<Prism,TFunction,TData>(File, u, time, spData, marker, ssGrp[i]);
+				write_nodal_data_elementwise<Octahedron,TFunction,TData>(File, u, time, spData, marker, ssGrp[i]);
+				write_nodal_data_elementwise<Hexahedron,TFunction,TData>(File, u, time, spData, marker, ssGrp[i]); break;
 		default: UG_THROW("VTK::write_nodal_data: Dimension " << dim <<
 		                        " is not supported.");
 	}
 
-//	end marking
-	grid.end_marking();
-
 //	write closing tag
 	File << VTKFileWriter::normal;
 	File << "\n        </DataArray>\n";
@@ -1952,7 +1915,7 @@ template <typename TElem, typename TFunction>
 void VTKOutput<TDim>::
 write_nodal_values_elementwise(VTKFileWriter& File, TFunction& u,
                                const std::vector<size_t>& vFct,
-                               Grid& grid, int si)
+                               ScopedMarker& marker, int si)
 {
 //	get reference element
 	typedef typename reference_element_traits<TElem>::reference_element_type
@@ -1983,10 +1946,10 @@ write_nodal_values_elementwise(VTKFileWriter& File, TFunction& u,
 			Vertex* v = GetVertex(elem, co);
 
 		//	if vertex has been handled before, skip
-			if(grid.is_marked(v)) continue;
+			if(marker.is_marked(v)) continue;
 
 		//	mark as used
-			grid.mark(v);
+			marker.mark(v);
 
 		//	loop all components
 			for(size_t i = 0; i < vFct.size(); ++i)
@@ -2035,30 +1998,27 @@ write_nodal_values(VTKFileWriter& File, TFunction& u,
 		File << VTKFileWriter::base64_binary << n;
 
 //	start marking of grid
-	grid.begin_marking();
+	ScopedMarker marker(grid);
 
 //	switch dimension
 	switch(dim)
 	{
-		case 0:	write_nodal_values_elementwise<Vertex>(File, u, vFct, grid, si); break;
-		case 1:	write_nodal_values_elementwise<RegularEdge>(File, u, vFct, grid, si);
-				write_nodal_values_elementwise<ConstrainingEdge>(File, u, vFct, grid, si); break;
-		case 2:	write_nodal_values_elementwise<Triangle>(File, u, vFct, grid, si);
-				write_nodal_values_elementwise<Quadrilateral>(File, u, vFct, grid, si);
-				write_nodal_values_elementwise<ConstrainingTriangle>(File, u, vFct, grid, si);
-				write_nodal_values_elementwise<ConstrainingQuadrilateral>(File, u, vFct, grid, si); break;
-		case 3:	write_nodal_values_elementwise<Tetrahedron>(File, u, vFct, grid, si);
-				write_nodal_values_elementwise<Pyramid>(File, u, vFct, grid, si);
-				write_nodal_values_elementwise<Prism>(File, u, vFct, grid, si);
-				write_nodal_values_elementwise<Octahedron>(File, u, vFct, grid, si);
-				write_nodal_values_elementwise<Hexahedron>(File, u, vFct, grid, si); break;
+		case 0:	write_nodal_values_elementwise<Vertex>(File, u, vFct, marker, si); break;
+		case 1:	write_nodal_values_elementwise<RegularEdge>(File, u, vFct, marker, si);
+				write_nodal_values_elementwise<ConstrainingEdge>(File, u, vFct, marker, si); break;
+		case 2:	write_nodal_values_elementwise<Triangle>(File, u, vFct, marker, si);
+				write_nodal_values_elementwise<Quadrilateral>(File, u, vFct, marker, si);
+				write_nodal_values_elementwise<ConstrainingTriangle>(File, u, vFct, marker, si);
+				write_nodal_values_elementwise<ConstrainingQuadrilateral>(File, u, vFct, marker, si); break;
+		case 3:	write_nodal_values_elementwise<Tetrahedron>(File, u, vFct, marker, si);
+				write_nodal_values_elementwise<Pyramid>(File, u, vFct, marker, si);
+				write_nodal_values_elementwise<Prism>(File, u, vFct, marker, si);
+				write_nodal_values_elementwise<Octahedron>(File, u, vFct, marker, si);
+				write_nodal_values_elementwise<Hexahedron>(File, u, vFct, marker, si); break;
 		default: UG_THROW("VTK::write_nodal_values: Dimension " << dim <<
 		                        " is not supported.");
 	}
 
-//	end marking
-	grid.end_marking();
-
 //	write closing tag
 	File << VTKFileWriter::normal;
 	File << "\n        </DataArray>\n";
@@ -2082,31 +2042,28 @@ write_nodal_values(VTKFileWriter& File, TFunction& u,
 		File << VTKFileWriter::base64_binary << n;
 
 //	start marking of grid
-	grid.begin_marking();
+	ScopedMarker marker(grid);
 
 //	switch dimension
 	for(size_t i = 0; i < ssGrp.size(); i++)
 	switch(dim)
 	{
-		case 0:	write_nodal_values_elementwise<Vertex>(File, u, vFct, grid, ssGrp[i]); break;
-		case 1:	write_nodal_values_elementwise<RegularEdge>(File, u, vFct, grid, ssGrp[i]);
-				write_nodal_values_elementwise<ConstrainingEdge>(File, u, vFct, grid, ssGrp[i]); break;
-		case 2:	write_nodal_values_elementwise<Triangle>(File, u, vFct, grid, ssGrp[i]);
-				write_nodal_values_elementwise<Quadrilateral>(File, u, vFct, grid, ssGrp[i]);
-				write_nodal_values_elementwise<ConstrainingTriangle>(File, u, vFct, grid, ssGrp[i]);
-				write_nodal_values_elementwise<ConstrainingQuadrilateral>(File, u, vFct, grid, ssGrp[i]); break;
-		case 3:	write_nodal_values_elementwise<Tetrahedron>(File, u, vFct, grid, ssGrp[i]);
-				write_nodal_values_elementwise<Pyramid>(File, u, vFct, grid, ssGrp[i]);
-				write_nodal_values_elementwise<Prism>(File, u, vFct, grid, ssGrp[i]);
-				write_nodal_values_elementwise<Octahedron>(File, u, vFct, grid, ssGrp[i]);
-				write_nodal_values_elementwise<Hexahedron>(File, u, vFct, grid, ssGrp[i]); break;
+		case 0:	write_nodal_values_elementwise<Vertex>(File, u, vFct, marker, ssGrp[i]); break;
+		case 1:	write_nodal_values_elementwise<RegularEdge>(File, u, vFct, marker, ssGrp[i]);
+				write_nodal_values_elementwise<ConstrainingEdge>(File, u, vFct, marker, ssGrp[i]); break;
+		case 2:	write_nodal_values_elementwise<Triangle>(File, u, vFct, marker, ssGrp[i]);
+				write_nodal_values_elementwise<Quadrilateral>(File, u, vFct, marker, ssGrp[i]);
+				write_nodal_values_elementwise<ConstrainingTriangle>(File, u, vFct, marker, ssGrp[i]);
+				write_nodal_values_elementwise<ConstrainingQuadrilateral>(File, u, vFct, marker, ssGrp[i]); break;
+		case 3:	write_nodal_values_elementwise<Tetrahedron>(File, u, vFct, marker, ssGrp[i]);
+				write_nodal_values_elementwise<Pyramid>(File, u, vFct, marker, ssGrp[i]);
+				write_nodal_values_elementwise<Prism>(File, u, vFct, marker, ssGrp[i]);
+				write_nodal_values_elementwise<Octahedron>(File, u, vFct, marker, ssGrp[i]);
+				write_nodal_values_elementwise<Hexahedron>(File, u, vFct, marker, ssGrp[i]); break;
 		default: UG_THROW("VTK::write_nodal_values: Dimension " << dim <<
 		                        " is not supported.");
 	}
 
-//	end marking
-	grid.end_marking();
-
 //	write closing tag
 	File << VTKFileWriter::normal;
 	File << "\n        </DataArray>\n";
@@ -3054,9 +3011,11 @@ write_pvtu(TFunction& u, const std::string& filename,
 			fprintf(file, "    </PCellData>\n");
 		}
 
-	// 	include files from all procs
-		for (int i = 0; i < numProcs; i++) {
-			vtu_filename(name, filename, i, si, maxSi, step);
+	// 	include files from all procs (or from all groups of procs)
+		const int numFiles = num_output_files();
+		const int numPieces = (numFiles > 0) ? numFiles : numProcs;
+		for (int i = 0; i < numPieces; i++) {
+			vtu_filename(name, filename, output_file_rank(i), si, maxSi, step);
 			name = FilenameWithoutPath(name);
 			fprintf(file, "    <Piece Source=\"%s\"/>\n", name.c_str());
 		}
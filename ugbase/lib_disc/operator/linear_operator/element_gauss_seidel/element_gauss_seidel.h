@@ -38,6 +38,7 @@
 #define __H__UG__LIB_DISC__OPERATOR__LINEAR_OPERATOR__ELEMENT_GAUSS_SEIDEL__
 
 #include "lib_algebra/operator/interface/preconditioner.h"
+#include "lib_algebra/algebra_common/multicolor_patch_smoother.h"
 
 #include <vector>
 #include <algorithm>
@@ -299,6 +300,39 @@ void ElementGaussSeidelStep(const typename TAlgebra::matrix_type& A,
 }
 
 
+/// collects the algebraic indices of all patches (one per grouping object)
+template<typename TGroupObj, typename TDomain, typename TAlgebra>
+void CollectElementPatches(const GridFunction<TDomain, TAlgebra>& c, MultiColorPatches& mcp)
+{
+	typedef typename GridFunction<TDomain, TAlgebra>::element_type Element;
+	std::vector<Element*> vElem;
+	std::vector<size_t> vInd;
+
+	mcp.clear();
+
+	typedef typename GridFunction<TDomain, TAlgebra>::template traits<TGroupObj>::const_iterator GroupObjIter;
+	for(GroupObjIter iter = c.template begin<TGroupObj>();
+					 iter != c.template end<TGroupObj>(); ++iter){
+
+		// collect elems associated to grouping object
+		c.collect_associated(vElem, *iter);
+
+		// get all algebraic indices on element
+		vInd.clear();
+		for(size_t i = 0; i < vElem.size(); ++i)
+			c.algebra_indices(vElem[i], vInd, false);
+
+		// check for doublicates
+		if(vElem.size() > 1){
+		    std::sort(vInd.begin(), vInd.end());
+		    vInd.erase(std::unique(vInd.begin(), vInd.end()), vInd.end());
+		}
+
+		mcp.add_patch(vInd);
+	}
+}
+
+
 ///	ElementGaussSeidel Preconditioner
 template <typename TDomain, typename TAlgebra>
 class ElementGaussSeidel : public IPreconditioner<TAlgebra>
@@ -328,16 +362,16 @@ class ElementGaussSeidel : public IPreconditioner<TAlgebra>
 
 	public:
 	///	default constructor
-		ElementGaussSeidel() : m_relax(1.0), m_type("element"), m_schur_alpha(1.0), m_elim_off_diag(false) {};
+		ElementGaussSeidel() : m_relax(1.0), m_type("element"), m_bMulticolor(false), m_bPatchesValid(false), m_schur_alpha(1.0), m_elim_off_diag(false) {};
 
 	///	constructor setting relaxation
-		ElementGaussSeidel(number relax) : m_relax(relax), m_type("element"), m_schur_alpha(1.0), m_elim_off_diag(false) {};
+		ElementGaussSeidel(number relax) : m_relax(relax), m_type("element"), m_bMulticolor(false), m_bPatchesValid(false), m_schur_alpha(1.0), m_elim_off_diag(false) {};
 
 	///	constructor setting type
-		ElementGaussSeidel(const std::string& type) : m_relax(1.0), m_type(type), m_schur_alpha(1.0), m_elim_off_diag(false) {};
+		ElementGaussSeidel(const std::string& type) : m_relax(1.0), m_type(type), m_bMulticolor(false), m_bPatchesValid(false), m_schur_alpha(1.0), m_elim_off_diag(false) {};
 
 	///	constructor setting relaxation and type
-		ElementGaussSeidel(number relax, const std::string& type) : m_relax(relax), m_type(type), m_schur_alpha(1.0), m_elim_off_diag(false) {};
+		ElementGaussSeidel(number relax, const std::string& type) : m_relax(relax), m_type(type), m_bMulticolor(false), m_bPatchesValid(false), m_schur_alpha(1.0), m_elim_off_diag(false) {};
 
 	///	Clone
 		virtual SmartPtr<ILinearIterator<vector_type> > clone()
@@ -348,6 +382,7 @@ class ElementGaussSeidel : public IPreconditioner<TAlgebra>
 			newInst->set_damp(this->damping());
 			newInst->set_relax(m_relax);
 			newInst->set_type(m_type);
+			newInst->set_multicolor(m_bMulticolor);
 
 			newInst->m_schur_cmp =m_schur_cmp;
 			newInst->m_schur_alpha = m_schur_alpha;
@@ -365,7 +400,17 @@ class ElementGaussSeidel : public IPreconditioner<TAlgebra>
 		void set_relax(number omega){m_relax=omega;};
 
 	/// set type
-		void set_type(const std::string& type){m_type=type;};
+		void set_type(const std::string& type){m_type=type; m_bPatchesValid=false;};
+
+	///	activates multicolor ordering of the patches
+	/**	Patches are colored such that patches of the same color are not coupled.
+	 *	The colors are processed one after another, the patches of one color
+	 *	concurrently (if compiled with OpenMP) and equally sized patches are
+	 *	solved by batched LU decompositions. The patch index sets are computed
+	 *	once per preprocess. Elimination of schur components (select_schur_cmp)
+	 *	and of off-diagonal couplings (set_elim_offdiag) is not supported, the
+	 *	step throws if one of them is combined with the multicolor ordering.*/
+		void set_multicolor(bool bMulticolor){m_bMulticolor=bMulticolor; m_bPatchesValid=false;};
 
 		void select_schur_cmp(const std::vector<std::string>& cmp, number alpha)
 		{
@@ -393,9 +438,42 @@ class ElementGaussSeidel : public IPreconditioner<TAlgebra>
 				//SetDirichletRow(m_A, vIndex);
 			}
 #endif
+			m_bPatchesValid = false;
 			return true;
 		}
 
+	///	multicolor step, computes the patches and their coloring if needed
+		void multicolor_step(const matrix_type& A, grid_function_type& c, const vector_type& d)
+		{
+			typedef typename GridFunction<TDomain, TAlgebra>::element_type Element;
+			typedef typename GridFunction<TDomain, TAlgebra>::side_type Side;
+
+			UG_COND_THROW(!m_schur_cmp.empty() || m_elim_off_diag,
+						  "ElementGaussSeidel: The multicolor ordering does not support "
+						  "schur components (select_schur_cmp) or elimination of "
+						  "off-diagonal couplings (set_elim_offdiag).");
+
+			if(!m_bPatchesValid)
+			{
+				if (m_type == "element") CollectElementPatches<Element,TDomain,TAlgebra>(c, m_mcp);
+				else if	(m_type == "side") CollectElementPatches<Side,TDomain,TAlgebra>(c, m_mcp);
+				else if	(m_type == "face") CollectElementPatches<Face,TDomain,TAlgebra>(c, m_mcp);
+				else if	(m_type == "edge") CollectElementPatches<Edge,TDomain,TAlgebra>(c, m_mcp);
+				else if	(m_type == "vertex") CollectElementPatches<Vertex,TDomain,TAlgebra>(c, m_mcp);
+				else UG_THROW("ElementGaussSeidel: wrong patch type '"<<m_type<<"'."
+							  " Options: element, side, face, edge, vertex.")
+
+				m_mcp.color(A);
+				m_bPatchesValid = true;
+			}
+
+			c.set(0.0);
+#ifdef UG_PARALLEL
+			c.set_storage_type(PST_ADDITIVE);
+#endif
+			MultiColorPatchStep<matrix_type, vector_type>(A, c, d, m_relax, m_mcp);
+		}
+
 		virtual bool step(SmartPtr<MatrixOperator<matrix_type, vector_type> > pOp, vector_type& c, const vector_type& d)
 		{
 			GridFunction<TDomain, TAlgebra>* pC
@@ -415,7 +493,8 @@ class ElementGaussSeidel : public IPreconditioner<TAlgebra>
 				spDtmp->change_storage_type(PST_UNIQUE);
 				
 				// execute step
-				if (m_type == "element") ElementGaussSeidelStep<Element,TDomain,TAlgebra>(m_A, *pC, *spDtmp, m_relax, m_schur_cmp, m_schur_alpha);
+				if (m_bMulticolor) multicolor_step(m_A, *pC, *spDtmp);
+				else if (m_type == "element") ElementGaussSeidelStep<Element,TDomain,TAlgebra>(m_A, *pC, *spDtmp, m_relax, m_schur_cmp, m_schur_alpha);
 				else UG_THROW("ElementGaussSeidel: wrong patch type '"<<m_type<<"'."
 					      " Options: element, side, face, edge, vertex.");
 				
@@ -428,7 +507,8 @@ class ElementGaussSeidel : public IPreconditioner<TAlgebra>
 #endif
 			  {
 			    matrix_type &A=*pOp; 
-			    if (m_type == "element") ElementGaussSeidelStep<Element,TDomain,TAlgebra>(A, *pC, d, m_relax, m_schur_cmp, m_schur_alpha);
+			    if (m_bMulticolor) multicolor_step(A, *pC, d);
+			    else if (m_type == "element") ElementGaussSeidelStep<Element,TDomain,TAlgebra>(A, *pC, d, m_relax, m_schur_cmp, m_schur_alpha);
 			    else if	(m_type == "side") ElementGaussSeidelStep<Side,TDomain,TAlgebra>(A, *pC, d, m_relax, m_schur_cmp, m_schur_alpha);
 			    else if	(m_type == "face") ElementGaussSeidelStep<Face,TDomain,TAlgebra>(A, *pC, d, m_relax, m_schur_cmp, m_schur_alpha);
 			    else if	(m_type == "edge") ElementGaussSeidelStep<Edge,TDomain,TAlgebra>(A, *pC, d, m_relax, m_schur_cmp, m_schur_alpha);
@@ -454,6 +534,11 @@ class ElementGaussSeidel : public IPreconditioner<TAlgebra>
 		number m_relax;
 		std::string m_type;
 
+	///	multicolor ordering
+		bool m_bMulticolor;
+		bool m_bPatchesValid;
+		MultiColorPatches m_mcp;
+
 #ifdef SCHUR_MOD
 		std::vector<std::string> m_schur_cmp;
 		number m_schur_alpha;
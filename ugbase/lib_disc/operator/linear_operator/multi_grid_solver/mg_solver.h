@@ -251,6 +251,39 @@ class AssembledMultiGridCycle :
 	/// reinit transfer operators
 		void force_reinit();
 
+	///	enables the reuse of coarse level operators in subsequent calls to init
+	/**	If enabled, the level matrices below the top level are kept together
+	 * with the smoothers and the base solver initialized for them, as long as
+	 * grid and DoF distribution are unchanged (lagged coarse operators).
+	 * Only the top level operator is rebuilt in init. All level operators are
+	 * rebuilt, if
+	 * - the maximal number of lagged inits is reached (set_max_lagged_inits),
+	 * - the contraction rate of the cycle degraded (set_lag_degradation_factor),
+	 * - the approximation space changed or force_reinit is called.
+	 * Single levels can be rebuilt using set_level_operator_changed.
+	 * Note, that the transfer operators are always reused while grid and
+	 * DoF distribution are unchanged.*/
+		void set_lag_coarse_operators(bool bLag) {m_bLagCoarseOperators = bLag;}
+
+	///	sets the maximal number of inits reusing the coarse operators (0 = unlimited)
+		void set_max_lagged_inits(int num) {m_maxLaggedInits = num;}
+
+	///	sets the factor of convergence degradation, that triggers a rebuild
+	/**	The contraction rate of the cycle is measured (geometric mean over all
+	 * applications between two inits). If the rate with lagged coarse
+	 * operators exceeds factor times the rate measured with freshly built
+	 * operators, all level operators are rebuilt in the next init.
+	 * Measuring requires an additional defect computation in apply, if the
+	 * cycle is used as a preconditioner. A factor <= 0 disables the trigger.*/
+		void set_lag_degradation_factor(number factor) {m_lagDegradationFactor = factor;}
+
+	///	marks the operator of a level as changed, i.e. it is rebuilt in the next init
+	/**	lev < 0 marks all levels.*/
+		void set_level_operator_changed(int lev);
+
+	///	returns the number of consecutive inits that reused coarse operators
+		int num_lagged_inits() const {return m_numLaggedInits;}
+
 	///	Compute new correction c = B*d
 		virtual bool apply(vector_type& c, const vector_type& d);
 
@@ -286,6 +319,25 @@ class AssembledMultiGridCycle :
 	///	initializes common part
 		void init();
 
+	///	decides which level operators are reused in the current init
+		void update_operator_reuse(bool bStructureChanged);
+
+	///	returns if the operator of a level is reused in the current init
+		bool reuse_level_operator(int lev) const
+		{
+			return lev >= 0 && lev < (int)m_vReuseLevelOperator.size()
+					&& m_vReuseLevelOperator[lev];
+		}
+
+	///	returns if the contraction rate of the cycles is measured
+		bool measure_contraction() const
+		{
+			return m_bLagCoarseOperators && m_lagDegradationFactor > 0;
+		}
+
+	///	remembers the contraction rate of a cycle
+		void record_contraction(number defBefore, number defAfter);
+
 	///	initializes the smoother and base solver
 		void init_smoother();
 
@@ -359,6 +411,37 @@ class AssembledMultiGridCycle :
 	///	approximation space revision of cached values
 		RevisionCounter m_ApproxSpaceRevision;
 
+	///	flag if coarse level operators are reused in subsequent inits
+		bool m_bLagCoarseOperators;
+
+	///	maximal number of inits reusing coarse operators (0 = unlimited)
+		int m_maxLaggedInits;
+
+	///	factor of convergence degradation triggering a rebuild (<= 0: disabled)
+		number m_lagDegradationFactor;
+
+	///	number of consecutive inits, that reused coarse operators
+		int m_numLaggedInits;
+
+	///	flag if the level operators have been built for the current structure
+		bool m_bLevelOperatorsValid;
+
+	///	levels marked as changed by the user
+		std::vector<bool> m_vLevelOperatorChanged;
+
+	///	levels reused in the current init
+		std::vector<bool> m_vReuseLevelOperator;
+
+	///	contraction rate measured with freshly built operators
+		number m_lagRefRate;
+
+	///	sum of the logarithms and number of measured rates since the last init
+		number m_lagSumLogRate;
+		int m_lagNumRates;
+
+	///	flag if the defect is measured by apply_update_defect for the current apply
+		bool m_bDefectUpdateFollows;
+
 	///	prototype for pre-smoother
 		SmartPtr<ILinearIterator<vector_type> > m_spPreSmootherPrototype;
 
@@ -36,6 +36,9 @@
 #include <iostream>
 #include <sstream>
 #include <string>
+#include <cmath>
+#include <limits>
+#include <algorithm>
 #include "common/profiler/profiler.h"
  #include "common/error.h"
 #include "lib_disc/function_spaces/grid_function_util.h"
@@ -84,6 +87,10 @@ AssembledMultiGridCycle() :
 	m_LocalFullRefLevel(0), m_GridLevelType(GridLevel::LEVEL),
 	m_bUseRAP(false), m_bSmoothOnSurfaceRim(false),
 	m_bCommCompOverlap(false),
+	m_bLagCoarseOperators(false), m_maxLaggedInits(0),
+	m_lagDegradationFactor(0.0), m_numLaggedInits(0),
+	m_bLevelOperatorsValid(false), m_lagRefRate(0.0),
+	m_lagSumLogRate(0.0), m_lagNumRates(0), m_bDefectUpdateFollows(false),
 	m_spPreSmootherPrototype(new Jacobi<TAlgebra>()),
 	m_spPostSmootherPrototype(m_spPreSmootherPrototype),
 	m_spProjectionPrototype(SPNULL),
@@ -106,6 +113,10 @@ AssembledMultiGridCycle(SmartPtr<ApproximationSpace<TDomain> > approxSpace) :
 	m_LocalFullRefLevel(0), m_GridLevelType(GridLevel::LEVEL),
 	m_bUseRAP(false), m_bSmoothOnSurfaceRim(false),
 	m_bCommCompOverlap(false),
+	m_bLagCoarseOperators(false), m_maxLaggedInits(0),
+	m_lagDegradationFactor(0.0), m_numLaggedInits(0),
+	m_bLevelOperatorsValid(false), m_lagRefRate(0.0),
+	m_lagSumLogRate(0.0), m_lagNumRates(0), m_bDefectUpdateFollows(false),
 	m_spPreSmootherPrototype(new Jacobi<TAlgebra>()),
 	m_spPostSmootherPrototype(m_spPreSmootherPrototype),
 	m_spProjectionPrototype(new StdInjection<TDomain,TAlgebra>(m_spApproxSpace)),
@@ -146,6 +157,9 @@ clone()
 	clone->set_presmoother(m_spPreSmootherPrototype);
 	clone->set_postsmoother(m_spPostSmootherPrototype);
 	clone->set_surface_level(m_surfaceLev);
+	clone->set_lag_coarse_operators(m_bLagCoarseOperators);
+	clone->set_max_lagged_inits(m_maxLaggedInits);
+	clone->set_lag_degradation_factor(m_lagDegradationFactor);
 
 	for(size_t i = 0; i < m_vspProlongationPostProcess.size(); ++i)
 		clone->add_prolongation_post_process(m_vspProlongationPostProcess[i]);
@@ -178,6 +192,10 @@ apply(vector_type& rC, const vector_type& rD)
 	m_pC = pC;
 	const GF& d = *pD;
 
+//	contraction is measured by apply_update_defect, if called from there
+	const bool bMeasure = measure_contraction() && !m_bDefectUpdateFollows;
+	m_bDefectUpdateFollows = false;
+
 	try{
 // 	Check if surface level has been chosen correctly
 //	Please note, that the approximation space returns the global number of levels,
@@ -256,6 +274,15 @@ apply(vector_type& rC, const vector_type& rD)
 	UG_CATCH_THROW("GMG: Damping failed.")
 	GMG_PROFILE_END();
 
+//	measure contraction for the lagging of coarse operators
+	if(bMeasure){
+		GMG_PROFILE_BEGIN(GMG_Apply_MeasureContraction);
+		SmartPtr<vector_type> spDefect = rD.clone();
+		m_spSurfaceMat->matmul_minus(*spDefect, rC);
+		record_contraction(d.norm(), spDefect->norm());
+		GMG_PROFILE_END();
+	}
+
 //	debug output
 	write_debug(c, "Correction_Out");
 
@@ -298,12 +325,22 @@ apply_update_defect(vector_type &c, vector_type& rD)
 //				Krylov-Methods (CG, BiCGStab, ...) only the correction is
 //				needed. We optimize for that case.
 
+//	the contraction is measured on the updated defect (see apply)
+	number defBefore = 0.0;
+	if(measure_contraction()){
+		defBefore = rD.norm();
+		m_bDefectUpdateFollows = true;
+	}
+
 //	compute correction
 	if(!apply(c, rD)) return false;
 
 //	update defect: d = d - A*c
 	m_spSurfaceMat->matmul_minus(rD, c);
 
+	if(measure_contraction())
+		record_contraction(defBefore, rD.norm());
+
 //	write for debugging
 	const GF* pD = dynamic_cast<const GF*>(&rD);
 	if(!pD) UG_THROW("GMG::apply: Expect Defect to be grid based.")
@@ -421,9 +458,13 @@ init()
 	if(m_baseLev > topLev)
 		UG_THROW("GMG::init: Base Level greater than Surface level.");
 
+	bool bStructureChanged = false;
 	if(m_ApproxSpaceRevision != m_spApproxSpace->revision()
 		|| topLev != m_topLev)
 	{
+		bStructureChanged = true;
+		m_bLevelOperatorsValid = false;
+
 	//	remember new top level
 		 m_topLev = topLev;
 
@@ -455,6 +496,9 @@ init()
 		m_ApproxSpaceRevision = m_spApproxSpace->revision();
 	}
 
+//	decide which level operators can be reused
+	update_operator_reuse(bStructureChanged);
+
 //	Assemble coarse grid operators
 	GMG_PROFILE_BEGIN(GMG_Init_CreateLevelMatrices);
 	try{
@@ -476,7 +520,7 @@ init()
 	GMG_PROFILE_END();
 
 //	Init base solver
-	if(!ignore_init_for_base_solver()){
+	if(!ignore_init_for_base_solver() && !reuse_level_operator(m_baseLev)){
 		GMG_PROFILE_BEGIN(GMG_Init_BaseSolver);
 		try{
 			init_base_solver();
@@ -484,6 +528,8 @@ init()
 		UG_CATCH_THROW("GMG:init: Cannot init Base Solver.");
 		GMG_PROFILE_END();
 	}
+
+	m_bLevelOperatorsValid = true;
 	} UG_CATCH_THROW("GMG: Init failure for init(u)");
 
 	UG_DLOG(LIB_DISC_MULTIGRID, 3, "gmg-stop init_common\n");
@@ -516,6 +562,73 @@ force_reinit()
 	m_ApproxSpaceRevision.invalidate();
 }
 
+template <typename TDomain, typename TAlgebra>
+void AssembledMultiGridCycle<TDomain, TAlgebra>::
+set_level_operator_changed(int lev)
+{
+	if(lev < 0){
+		m_bLevelOperatorsValid = false;
+		return;
+	}
+	if((int)m_vLevelOperatorChanged.size() <= lev)
+		m_vLevelOperatorChanged.resize(lev + 1, false);
+	m_vLevelOperatorChanged[lev] = true;
+}
+
+template <typename TDomain, typename TAlgebra>
+void AssembledMultiGridCycle<TDomain, TAlgebra>::
+record_contraction(number defBefore, number defAfter)
+{
+	if(defBefore <= 0.0) return;
+	const number rate = std::max(defAfter / defBefore, (number)1e-16);
+//	ignore nan and inf
+	if(!(rate < std::numeric_limits<number>::max())) return;
+	m_lagSumLogRate += std::log(rate);
+	++m_lagNumRates;
+}
+
+template <typename TDomain, typename TAlgebra>
+void AssembledMultiGridCycle<TDomain, TAlgebra>::
+update_operator_reuse(bool bStructureChanged)
+{
+//	evaluate the contraction measured since the last init
+	bool bDegraded = false;
+	if(m_lagNumRates > 0){
+		const number rate = std::exp(m_lagSumLogRate / m_lagNumRates);
+		if(m_numLaggedInits == 0)
+			m_lagRefRate = rate;
+		else if(m_lagDegradationFactor > 0 && rate > m_lagDegradationFactor * m_lagRefRate)
+		{
+			UG_DLOG(LIB_DISC_MULTIGRID, 1, "GMG: contraction rate " << rate
+					<< " degraded (reference: " << m_lagRefRate
+					<< "), rebuilding coarse operators.\n");
+			bDegraded = true;
+		}
+	}
+	m_lagSumLogRate = 0.0;
+	m_lagNumRates = 0;
+
+	const bool bLag = m_bLagCoarseOperators && m_bLevelOperatorsValid
+					&& !bStructureChanged && !bDegraded
+					&& (m_maxLaggedInits <= 0 || m_numLaggedInits < m_maxLaggedInits);
+
+//	the top level operator is always rebuilt
+	bool bAnyReused = false;
+	m_vReuseLevelOperator.assign(m_topLev + 1, false);
+	if(bLag){
+		for(int lev = m_baseLev; lev < m_topLev; ++lev){
+			if(lev < (int)m_vLevelOperatorChanged.size() && m_vLevelOperatorChanged[lev])
+				continue;
+			m_vReuseLevelOperator[lev] = true;
+			bAnyReused = true;
+		}
+	}
+	m_vLevelOperatorChanged.clear();
+
+	if(bAnyReused) ++m_numLaggedInits;
+	else m_numLaggedInits = 0;
+}
+
 
 template <typename TDomain, typename TAlgebra>
 void AssembledMultiGridCycle<TDomain, TAlgebra>::
@@ -598,7 +711,11 @@ assemble_level_operator()
 
 	//	In Full-Ref case we can copy the Matrix from the surface
 		bool bCpyFromSurface = ((lev == m_topLev) && (lev <= m_LocalFullRefLevel));
-		if(!bCpyFromSurface)
+		if(reuse_level_operator(lev))
+		{
+			UG_DLOG(LIB_DISC_MULTIGRID, 4, "  assemble_level_operator: reusing operator on lev "<<lev<<"\n");
+		}
+		else if(!bCpyFromSurface)
 		{
 			UG_DLOG(LIB_DISC_MULTIGRID, 4, "  start assemble_level_operator: assemble on lev "<<lev<<"\n");
 			GMG_PROFILE_BEGIN(GMG_AssembleLevelMat_AssembleOnLevel);
@@ -689,7 +806,7 @@ assemble_level_operator()
 //	solver is carried out in serial (gathering to some processes), we have
 //	to assemble the assemble the coarse grid matrix on the whole grid as
 //	well
-	if(m_bGatheredBaseUsed)
+	if(m_bGatheredBaseUsed && !reuse_level_operator(m_baseLev))
 	{
 		UG_DLOG(LIB_DISC_MULTIGRID, 4, "  start assemble_level_operator: ass gathered on lev "<<m_baseLev<<"\n");
 		LevData& ld = *m_vLevData[m_baseLev];
@@ -825,6 +942,7 @@ init_rap_operator()
 	GMG_PROFILE_BEGIN(GMG_BuildRAP_ResizeLevelMat);
 	for(int lev = m_topLev; lev >= m_baseLev; --lev)
 	{
+		if(reuse_level_operator(lev)) continue;
 		LevData& ld = *m_vLevData[lev];
 		ld.A->resize_and_clear(ld.st->size(), ld.st->size());
 		#ifdef UG_PARALLEL
@@ -876,7 +994,8 @@ init_rap_operator()
 			}
 
 		//	copy connection to level matrix
-			(*(m_vLevData[colLevel]->A))(lvlRow, lvlCol) = conn.value();
+			if(!reuse_level_operator(colLevel))
+				(*(m_vLevData[colLevel]->A))(lvlRow, lvlCol) = conn.value();
 		}
 	}
 	GMG_PROFILE_END();
@@ -893,6 +1012,7 @@ init_rap_operator()
 	GMG_PROFILE_BEGIN(GMG_BuildRAP_AllLevelMat);
 	for(int lev = m_topLev; lev > m_baseLev; --lev)
 	{
+		if(reuse_level_operator(lev-1)) continue;
 		UG_DLOG(LIB_DISC_MULTIGRID, 4, "  start init_rap_operator: build rap on lev "<<lev<<"\n");
 		LevData& lf = *m_vLevData[lev];
 		LevData& lc = *m_vLevData[lev-1];
@@ -956,7 +1076,7 @@ init_rap_operator()
 		write_debug(*ld.A, "LevelMatrix", *ld.st, *ld.st);
 	}
 
-	if(m_bGatheredBaseUsed)
+	if(m_bGatheredBaseUsed && !reuse_level_operator(m_baseLev))
 	{
 #ifdef UG_PARALLEL
 		GMG_PROFILE_BEGIN(GMG_BuildRAP_CopyNoghostToGhost_GatheredBase);
@@ -1127,6 +1247,9 @@ init_smoother()
 	{
 		LevData& ld = *m_vLevData[lev];
 
+	//	smoothers of reused operators are still valid
+		if(reuse_level_operator(lev)) continue;
+
 		UG_DLOG(LIB_DISC_MULTIGRID, 4, "  init_smoother: initializing pre-smoother on lev "<<lev<<"\n");
 		bool success;
 		GridLevel gw_gl; enter_debug_writer_section(gw_gl, "PreSmootherInit", lev);
@@ -2307,6 +2430,12 @@ config_string() const
 	ss << "\n";
 	ss << " Basesolver ( Baselevel = " << m_baseLev << ", gathered base = " << (m_bGatheredBaseIfAmbiguous ? "true" : "false") << "): ";
 	ss << ConfigShift(m_spBaseSolver->config_string());
+	if(m_bLagCoarseOperators){
+		ss << " Lagged coarse operators (max. inits = ";
+		if(m_maxLaggedInits > 0) ss << m_maxLaggedInits;
+		else ss << "unlimited";
+		ss << ", degradation factor = " << m_lagDegradationFactor << ")\n";
+	}
 	return ss.str();
 
 }
@@ -38,6 +38,7 @@
 #define __H__UG__LIB_DISC__OPERATOR__LINEAR_OPERATOR__SEQUENTIAL_SSC__
 
 #include "lib_algebra/operator/interface/preconditioner.h"
+#include "lib_algebra/algebra_common/multicolor_patch_smoother.h"
 
 #include <vector>
 #include <algorithm>
@@ -92,6 +93,9 @@ public:
 		virtual void update_solution(vector_type &u, double omega=1.0) = 0;
 
 		virtual size_t size() { return 0; }
+
+		/// Algebraic indices (after init), used for multicolor ordering. Returns false if not supported.
+		virtual bool algebra_indices(std::vector<size_t>& vInd) const { return false; }
 };
 
 
@@ -205,6 +209,9 @@ public:
 
 	virtual size_t size() { return m_vInd.size(); }
 
+	virtual bool algebra_indices(std::vector<size_t>& vInd) const
+	{ vInd = m_vInd; return true; }
+
 protected:
 
 	/// Algebraic indices.
@@ -321,6 +328,20 @@ public:
 
 	virtual size_t size() { return m_vInd.size(); }
 
+	/// Only for scalar algebras, since blocks are always relaxed as a whole.
+	virtual bool algebra_indices(std::vector<size_t>& vInd) const
+	{
+		if(TAlgebra::blockSize != 1) return false;
+
+		vInd.resize(m_vInd.size());
+		for(size_t j = 0; j < m_vInd.size(); ++j)
+			vInd[j] = m_vInd[j][0];
+
+		std::sort(vInd.begin(), vInd.end());
+		vInd.erase(std::unique(vInd.begin(), vInd.end()), vInd.end());
+		return true;
+	}
+
 protected:
 	/// Algebraic indices.
 	std::vector<DoFIndex> m_vInd;
@@ -621,10 +642,10 @@ protected:
 
 public:
 	///	default constructor
-	SequentialSubspaceCorrection() : m_relax(1.0), m_type("vertex") {};
+	SequentialSubspaceCorrection() : m_relax(1.0), m_type("vertex"), m_bMulticolor(false), m_bPatchesValid(false) {};
 
 	///	constructor setting relaxation
-	SequentialSubspaceCorrection(number relax) : m_relax(relax), m_type("vertex") {};
+	SequentialSubspaceCorrection(number relax) : m_relax(relax), m_type("vertex"), m_bMulticolor(false), m_bPatchesValid(false) {};
 
 
 	///	Clone
@@ -637,6 +658,7 @@ public:
 		newInst->set_relax(m_relax);
 		newInst->set_type(m_type);
 		newInst->set_vertex_subspace(m_spVertexSubspace);
+		newInst->set_multicolor(m_bMulticolor);
 		return newInst;
 	}
 
@@ -655,7 +677,13 @@ public:
 
 	/// set subspace
 	void set_vertex_subspace(SmartPtr<ILocalSubspace <TDomain, TAlgebra, Vertex> > spVertexSubspace)
-	{ m_spVertexSubspace = spVertexSubspace; }
+	{ m_spVertexSubspace = spVertexSubspace; m_bPatchesValid = false; }
+
+	/// activates multicolor ordering of the subspaces
+	/** Subspaces of the same color are not coupled and are corrected concurrently
+	 *  (if compiled with OpenMP), equally sized ones by batched LU decompositions.
+	 *  Requires a subspace providing its algebraic indices.*/
+	void set_multicolor(bool bMulticolor){ m_bMulticolor = bMulticolor; m_bPatchesValid = false; }
 
 
 protected:
@@ -693,6 +721,7 @@ protected:
 		THROW_IF_NOT_EQUAL(pA->num_rows(), pA->num_cols());
 		// UG_COND_THROW(CheckDiagonalInvertible(*pA) == false, name() << ": A has noninvertible diagonal");
 
+		m_bPatchesValid = false;
 		return true;
 	}
 
@@ -720,7 +749,8 @@ protected:
 #endif
 		{
 			matrix_type &A=*pOp;
-			if	(m_type == "vertex") SequentialSubspaceCorrectionLoop<Vertex,TDomain,TAlgebra>(A, *pC, d, m_relax,
+			if	(m_bMulticolor) multicolor_step(A, *pC, d);
+			else if	(m_type == "vertex") SequentialSubspaceCorrectionLoop<Vertex,TDomain,TAlgebra>(A, *pC, d, m_relax,
 					*m_spVertexSubspace, pC->template begin<Vertex>(), pC->template end<Vertex>());
 			else UG_THROW("SequentialSubspaceCorrectionStep: wrong patch type '"<<m_type<<"'."
 					" Options: element, side, face, edge, vertex.")
@@ -736,13 +766,41 @@ protected:
 	///	Postprocess routine
 	virtual bool postprocess() {return true;}
 
+	/// Multicolor step, computes subspace indices and coloring if needed.
+	void multicolor_step(const matrix_type& A, grid_function_type& c, const vector_type& d)
+	{
+		if(!m_bPatchesValid)
+		{
+			UG_COND_THROW(m_type != "vertex", "SequentialSubspaceCorrection: wrong patch type '"<<m_type<<"'."
+					" Options: vertex.");
+
+			std::vector<size_t> vInd;
+			m_mcp.clear();
+			typedef typename grid_function_type::template traits<Vertex>::const_iterator VertexIter;
+			for(VertexIter iter = c.template begin<Vertex>(); iter != c.template end<Vertex>(); ++iter)
+			{
+				m_spVertexSubspace->init(*iter, c);
+				UG_COND_THROW(!m_spVertexSubspace->algebra_indices(vInd),
+				              name() << ": multicolor ordering not supported by subspace.");
+				m_mcp.add_patch(vInd);
+			}
+			m_mcp.color(A);
+			m_bPatchesValid = true;
+		}
 
+		MultiColorPatchStep<matrix_type, vector_type>(A, c, d, m_relax, m_mcp);
+	}
 
 
 protected:
 	number m_relax;
 	std::string m_type;
 
+	/// multicolor ordering
+	bool m_bMulticolor;
+	bool m_bPatchesValid;
+	MultiColorPatches m_mcp;
+
 	SmartPtr<ILocalSubspace <TDomain, TAlgebra, Vertex> > m_spVertexSubspace;
 
 #ifdef UG_PARALLEL
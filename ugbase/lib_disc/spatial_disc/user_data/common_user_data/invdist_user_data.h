@@ -37,6 +37,10 @@
 #define __H__UG__LIB_DISC__SPATIAL_DISC__USER_DATA__IDW_USER_DATA__
 
 #include <vector>
+#include <utility>
+#ifdef UG_CXX11
+	#include <atomic>
+#endif
 
 // ug4 headers
 #include "common/common.h"
@@ -130,6 +134,71 @@ public:
 	);
 };
 
+/// Static kd-tree of the interpolation points for the IDW interpolation
+/**
+ * The tree is built once for a set of points and allows to find the points
+ * in a ball or the k nearest points in O(log N) (for a bounded number of
+ * points found). It is built by recursive median splits along the coordinate
+ * of the largest extent. The nodes are stored implicitly: The median of every
+ * index range [b, e) is located at (b + e) / 2.
+ *
+ * \tparam WDim	dimensionality of the space
+ */
+template <int WDim>
+class IDWSearchTree
+{
+public:
+
+///	dimensionality of the space (i.e. of the coordinate vectors)
+	static const int dim = WDim;
+	
+///	type of the search results: pairs (squared distance, index of the point)
+	typedef std::vector<std::pair<number, size_t> > result_type;
+	
+public:
+
+///	builds the tree for the points in a given range (the points are indexed in the order of the range)
+	template <typename TPntIterator>
+	void build
+	(
+		TPntIterator pnt_beg, ///< the first point (with member pos)
+		TPntIterator pnt_end ///< delimiter of the points
+	);
+	
+///	deletes the tree
+	void clear () {m_vPos.clear (); m_vInd.clear (); m_vSplitDim.clear ();}
+	
+///	returns the number of the points in the tree
+	size_t size () const {return m_vInd.size ();}
+	
+///	finds all the points in a closed ball (the results are appended)
+	void points_in_ball
+	(
+		result_type & res, ///< the found points
+		const MathVector<dim> & x, ///< center of the ball
+		number R ///< radius of the ball
+	) const;
+	
+///	finds the k nearest points, optionally restricted to a ball (the results are overwritten)
+	void nearest_points
+	(
+		result_type & res, ///< the found points
+		const MathVector<dim> & x, ///< the point whose neighbours are searched
+		size_t k, ///< number of the neighbours
+		number R = 0 ///< radius of the ball (if 0 then the whole space)
+	) const;
+
+private:
+
+	void build_recursive (size_t b, size_t e);
+	void ball_recursive (result_type & res, const MathVector<dim> & x, number R2, size_t b, size_t e) const;
+	void nearest_recursive (result_type & res, const MathVector<dim> & x, size_t k, number R2, size_t b, size_t e) const;
+	
+	std::vector<MathVector<dim> > m_vPos; ///< points in the tree order
+	std::vector<size_t> m_vInd; ///< original indices of the points in the tree order
+	std::vector<int> m_vSplitDim; ///< split coordinate of the node at the given position
+};
+
 /// UserData interface for the IDW interpolation
 /**
  * This class implements the UserData interface for the inverse-distance-weighting
@@ -139,6 +208,12 @@ public:
  *
  * Setting the radius to 0 means the unconstrained version of the IDW interpolation.
  *
+ * Furthermore, the interpolation may be restricted to the k nearest interpolation
+ * points (set_num_neighbours). If the radius or the number of the neighbours is
+ * specified, the interpolation points are looked up in a kd-tree, so that the
+ * evaluation costs O(log N) instead of O(N) operations. The tree is rebuilt
+ * on the first evaluation after the set of the interpolation points changed.
+ *
  * \tparam WDim		dimensionality of the geometric space (the world dimension)
  * \tparam TData	type of the data to interpolate
  */
@@ -154,6 +229,9 @@ public:
 ///	type of the data to extrapolate
 	typedef TData data_type;
 	
+///	type of the base class
+	typedef StdGlobPosData<IDWUserData<WDim, TData>, TData, WDim> base_type;
+	
 private:
 	
 /// type of a interpolation point data item
@@ -170,12 +248,12 @@ public:
 
 ///	class constructor that creates an empty object with default parameters
 	IDWUserData ()
-	:	m_order (dim + 1), m_R (0)
+	:	m_order (dim + 1), m_R (0), m_num_nb (0), m_tree_valid (false)
 	{}
 	
 ///	class constructor that creates an empty object with given parameters
 	IDWUserData (number order, number R)
-	:	m_order (order), m_R (R)
+	:	m_order (order), m_R (R), m_num_nb (0), m_tree_valid (false)
 	{}
 
 ///	virtual destructor
@@ -189,8 +267,11 @@ public:
 ///	sets the order of the interpolation
 	void set_order (number order) {m_order = order;}
 	
+///	sets the number of the nearest interpolation points to use (0 == all)
+	void set_num_neighbours (size_t k) {m_num_nb = k;}
+	
 ///	deletes all the interpolation points from the list
-	void clear () {m_data.clear ();}
+	void clear () {m_data.clear (); data_changed ();}
 	
 ///	loads data from a given stream (and appends the loaded points to the current list)
 	void load_data_from (std::istream & in);
@@ -199,23 +280,52 @@ public:
 	void load_data_from (const char * file_name);
 	
 ///	appends an interpolation point to the list
-	void append (const MathVector<dim> & x, const data_type & val) {m_data.push_back (data_item (x, val));}
+	void append (const MathVector<dim> & x, const data_type & val) {m_data.push_back (data_item (x, val)); data_changed ();}
 	
 public:
 
 ///	evaluates the data at a given point
 	inline void evaluate (data_type & value, const MathVector<dim> & x, number time, int si) const
 	{
-		typedef typename std::vector<data_item>::const_iterator pnt_iter_type;
-		IDWInterpolation<dim, pnt_iter_type, data_type>::compute (value, x, m_R,
-										m_data.begin (), m_data.end (), m_order);
+		typename IDWSearchTree<dim>::result_type nb;
+		evaluate_at (value, x, nb);
 	}
+	
+	using base_type::operator();
+	
+///	evaluates the data at an array of points (reusing the search buffers)
+	virtual void operator() (data_type vValue [], const MathVector<dim> vGlobIP [],
+		number time, int si, const size_t nip) const;
 
+private:
+
+///	invalidates the search tree
+	void data_changed () {m_tree_valid = false;}
+	
+///	rebuilds the search tree if necessary
+	void update_tree () const;
+	
+///	evaluates the data at a given point using a given buffer for the search
+	void evaluate_at (data_type & value, const MathVector<dim> & x,
+		typename IDWSearchTree<dim>::result_type & nb) const;
+	
+///	computes the interpolation basing on the found neighbours
+	void interpolate (data_type & value, const MathVector<dim> & x,
+		const typename IDWSearchTree<dim>::result_type & nb) const;
+	
 private:
 
 	std::vector<data_item> m_data; ///< interpolation points
 	number m_order; ///< order of the interpolation
 	number m_R; ///< radius of the neighbourhood to look for the interpolation points in (0 == infinite)
+	size_t m_num_nb; ///< number of the nearest interpolation points to use (0 == all)
+	
+	mutable IDWSearchTree<dim> m_tree; ///< search tree of the interpolation points
+#	ifdef UG_CXX11
+	mutable std::atomic<bool> m_tree_valid; ///< whether the search tree is up to date
+#	else
+	mutable bool m_tree_valid; ///< whether the search tree is up to date
+#	endif
 };
 
 } // end namespace ug
@@ -34,6 +34,10 @@
  * Implementation of the Inverse Distance Weighting (IDW) interpolation for data sets
  */
 
+#include <algorithm>
+#include <limits>
+#include <string>
+
 namespace ug {
 
 /**
@@ -124,6 +128,345 @@ void IDWInterpolation<WDim, TPntIterator, TData>::compute
 	res = sum;
 }
 
+/**
+ * Builds the search tree for the points in a given range.
+ */
+template <int WDim>
+template <typename TPntIterator>
+void IDWSearchTree<WDim>::build
+(
+	TPntIterator pnt_beg, ///< the first point (with member pos)
+	TPntIterator pnt_end ///< delimiter of the points
+)
+{
+	clear ();
+	for (TPntIterator pnt = pnt_beg; pnt != pnt_end; ++pnt)
+	{
+		m_vInd.push_back (m_vPos.size ());
+		m_vPos.push_back (pnt->pos);
+	}
+	m_vSplitDim.resize (m_vInd.size (), 0);
+	
+	build_recursive (0, m_vInd.size ());
+	
+//	store the positions in the tree order
+	std::vector<MathVector<dim> > vPos (m_vInd.size ());
+	for (size_t i = 0; i < m_vInd.size (); i++)
+		vPos[i] = m_vPos[m_vInd[i]];
+	m_vPos.swap (vPos);
+}
+
+/// compares the indices of the points by one of their coordinates
+template <int WDim>
+struct IDWSearchTreeCoordLess
+{
+	IDWSearchTreeCoordLess (const std::vector<MathVector<WDim> > & vPos, int d) : m_vPos (vPos), m_d (d) {}
+	bool operator () (size_t i, size_t j) const {return m_vPos[i][m_d] < m_vPos[j][m_d];}
+	const std::vector<MathVector<WDim> > & m_vPos;
+	int m_d;
+};
+
+/**
+ * Splits the index range [b, e) at its median along the coordinate of the largest extent.
+ */
+template <int WDim>
+void IDWSearchTree<WDim>::build_recursive (size_t b, size_t e)
+{
+	if (e <= b + 1)
+		return;
+	
+//	find the coordinate of the largest extent
+	MathVector<dim> minPos = m_vPos[m_vInd[b]], maxPos = minPos;
+	for (size_t i = b + 1; i < e; i++)
+	{
+		const MathVector<dim> & p = m_vPos[m_vInd[i]];
+		for (int d = 0; d < dim; d++)
+		{
+			if (p[d] < minPos[d]) minPos[d] = p[d];
+			if (p[d] > maxPos[d]) maxPos[d] = p[d];
+		}
+	}
+	int splitDim = 0;
+	for (int d = 1; d < dim; d++)
+		if (maxPos[d] - minPos[d] > maxPos[splitDim] - minPos[splitDim])
+			splitDim = d;
+	
+//	split at the median
+	const size_t m = (b + e) / 2;
+	std::nth_element (m_vInd.begin () + b, m_vInd.begin () + m, m_vInd.begin () + e,
+		IDWSearchTreeCoordLess<dim> (m_vPos, splitDim));
+	m_vSplitDim[m] = splitDim;
+	
+	build_recursive (b, m);
+	build_recursive (m + 1, e);
+}
+
+/**
+ * Finds all the points in a closed ball.
+ */
+template <int WDim>
+void IDWSearchTree<WDim>::points_in_ball
+(
+	result_type & res, ///< the found points
+	const MathVector<dim> & x, ///< center of the ball
+	number R ///< radius of the ball
+) const
+{
+	ball_recursive (res, x, R * R, 0, m_vInd.size ());
+}
+
+template <int WDim>
+void IDWSearchTree<WDim>::ball_recursive
+(
+	result_type & res,
+	const MathVector<dim> & x,
+	number R2,
+	size_t b,
+	size_t e
+) const
+{
+	if (b >= e)
+		return;
+	
+	const size_t m = (b + e) / 2;
+	const number dist2 = VecDistanceSq (x, m_vPos[m]);
+	if (dist2 <= R2)
+		res.push_back (std::make_pair (dist2, m_vInd[m]));
+	
+	if (e == b + 1)
+		return;
+	
+//	the left subtree contains the points with smaller coordinates, the right one with larger
+	const number diff = x[m_vSplitDim[m]] - m_vPos[m][m_vSplitDim[m]];
+	if (diff <= 0 || diff * diff <= R2)
+		ball_recursive (res, x, R2, b, m);
+	if (diff >= 0 || diff * diff <= R2)
+		ball_recursive (res, x, R2, m + 1, e);
+}
+
+/**
+ * Finds the k nearest points, optionally restricted to a ball.
+ */
+template <int WDim>
+void IDWSearchTree<WDim>::nearest_points
+(
+	result_type & res, ///< the found points
+	const MathVector<dim> & x, ///< the point whose neighbours are searched
+	size_t k, ///< number of the neighbours
+	number R ///< radius of the ball (if 0 then the whole space)
+) const
+{
+	res.clear ();
+	if (k == 0)
+		return;
+	nearest_recursive (res, x, k, (R > 0)? R * R : std::numeric_limits<number>::max (),
+		0, m_vInd.size ());
+}
+
+template <int WDim>
+void IDWSearchTree<WDim>::nearest_recursive
+(
+	result_type & res, ///< max-heap of the found points (w.r.t. the distance)
+	const MathVector<dim> & x,
+	size_t k,
+	number R2,
+	size_t b,
+	size_t e
+) const
+{
+	if (b >= e)
+		return;
+	
+	const size_t m = (b + e) / 2;
+	const number dist2 = VecDistanceSq (x, m_vPos[m]);
+	if (dist2 <= R2)
+	{
+		if (res.size () < k)
+		{
+			res.push_back (std::make_pair (dist2, m_vInd[m]));
+			std::push_heap (res.begin (), res.end ());
+		}
+		else if (dist2 < res.front().first)
+		{
+			std::pop_heap (res.begin (), res.end ());
+			res.back () = std::make_pair (dist2, m_vInd[m]);
+			std::push_heap (res.begin (), res.end ());
+		}
+	}
+	
+	if (e == b + 1)
+		return;
+	
+//	search the side containing x first
+	const number diff = x[m_vSplitDim[m]] - m_vPos[m][m_vSplitDim[m]];
+	size_t nearB = b, nearE = m, farB = m + 1, farE = e;
+	if (diff > 0)
+	{
+		nearB = m + 1; nearE = e; farB = b; farE = m;
+	}
+	nearest_recursive (res, x, k, R2, nearB, nearE);
+	
+	const number diff2 = diff * diff;
+	if (diff2 <= R2 && (res.size () < k || diff2 < res.front().first))
+		nearest_recursive (res, x, k, R2, farB, farE);
+}
+
+/**
+ * Rebuilds the search tree if the interpolation points have changed.
+ * Without an atomic flag (i.e. without UG_CXX11), the flag is only
+ * checked inside the critical section.
+ */
+template <int WDim, typename TData>
+void IDWUserData<WDim, TData>::update_tree () const
+{
+#	ifdef UG_CXX11
+	if (m_tree_valid.load (std::memory_order_acquire))
+		return;
+#	endif
+	
+#	ifdef UG_OPENMP
+#	pragma omp critical (IDWUserData_update_tree)
+#	endif
+	{
+#		ifdef UG_CXX11
+		if (! m_tree_valid.load (std::memory_order_relaxed))
+		{
+			m_tree.build (m_data.begin (), m_data.end ());
+			m_tree_valid.store (true, std::memory_order_release);
+		}
+#		else
+		if (! m_tree_valid)
+		{
+			m_tree.build (m_data.begin (), m_data.end ());
+			m_tree_valid = true;
+		}
+#		endif
+	}
+}
+
+/**
+ * Computes the interpolation basing on the found neighbours.
+ */
+template <int WDim, typename TData>
+void IDWUserData<WDim, TData>::interpolate
+(
+	data_type & res, ///< interpolated value
+	const MathVector<dim> & pos, ///< geometric position where to interpolate
+	const typename IDWSearchTree<dim>::result_type & nb ///< the neighbours (squared distance, index)
+) const
+{
+	const number small_dist = 1e-7;
+	
+	if (nb.empty ())
+		UG_THROW ("IDWInterpolation: No interpolation points in the ball with R = " << m_R
+					<< " and center at" << pos << ".");
+	
+	data_type sum = 0;
+	number factor = 0;
+	const number half_order = m_order / 2;
+	for (size_t i = 0; i < nb.size (); i++)
+	{
+		const data_item & pnt = m_data[nb[i].second];
+		const number dist2 = nb[i].first;
+		if (dist2 < small_dist * small_dist)
+		{ /* We are at a data point: */
+			res = pnt.value;
+			return;
+		}
+	//	the squared distance is used to avoid sqrt (and pow for the order 2)
+		const number w = (half_order == 1)? dist2 : pow (dist2, half_order);
+		data_type value = pnt.value;
+		value /= w;
+		sum += value;
+		factor += 1 / w;
+	}
+	sum /= factor;
+	res = sum;
+}
+
+/**
+ * Evaluates the data at a given point using a given buffer for the search.
+ */
+template <int WDim, typename TData>
+void IDWUserData<WDim, TData>::evaluate_at
+(
+	data_type & value, ///< the computed value
+	const MathVector<dim> & x, ///< the point
+	typename IDWSearchTree<dim>::result_type & nb ///< buffer for the search
+) const
+{
+	if (m_R == 0.0 && m_num_nb == 0)
+	{ /* the unconstrained version: all the points are used */
+		typedef typename std::vector<data_item>::const_iterator pnt_iter_type;
+		IDWInterpolation<dim, pnt_iter_type, data_type>::compute (value, x,
+										m_data.begin (), m_data.end (), m_order);
+	}
+	else
+	{
+		if (m_data.empty ())
+			UG_THROW ("IDWInterpolation: Cannot interpolate using 0 data points!");
+		update_tree ();
+		if (m_num_nb > 0)
+			m_tree.nearest_points (nb, x, m_num_nb, m_R);
+		else
+		{
+			nb.clear ();
+			m_tree.points_in_ball (nb, x, m_R);
+		}
+		interpolate (value, x, nb);
+	}
+}
+
+/**
+ * Evaluates the data at an array of points. For large arrays, the evaluation
+ * is performed in parallel (if OpenMP is available).
+ */
+template <int WDim, typename TData>
+void IDWUserData<WDim, TData>::operator()
+(
+	data_type vValue [],
+	const MathVector<dim> vGlobIP [],
+	number time,
+	int si,
+	const size_t nip
+) const
+{
+	if (m_R != 0.0 || m_num_nb != 0)
+		update_tree ();
+	
+#	ifdef UG_OPENMP
+	const int n = (int) nip;
+	bool failed = false;
+	std::string errMsg;
+#	pragma omp parallel if (n >= 256)
+	{
+		typename IDWSearchTree<dim>::result_type nb;
+#		pragma omp for
+		for (int ip = 0; ip < n; ip++)
+		{
+			try
+			{
+				evaluate_at (vValue[ip], vGlobIP[ip], nb);
+			}
+			catch (UGError & err)
+			{
+#				pragma omp critical (IDWUserData_error)
+				{
+					failed = true;
+					errMsg = err.get_msg ();
+				}
+			}
+		}
+	}
+	if (failed)
+		UG_THROW (errMsg);
+#	else
+	typename IDWSearchTree<dim>::result_type nb;
+	for (size_t ip = 0; ip < nip; ip++)
+		evaluate_at (vValue[ip], vGlobIP[ip], nb);
+#	endif
+}
+
 /**
  * Loads interpolation points from a given stream.
  */
@@ -41,26 +41,48 @@
 
 // extern headers
 #include <vector>
+#ifdef UG_CXX11
+	#include <atomic>
+#endif
 #include "lib_disc/spatial_disc/user_data/std_glob_pos_data.h"
+#include "common/util/raster.h"
 
 namespace ug{
 
+/**
+ * The modes are stored as a structure of arrays, so that the sum over the
+ * modes can be vectorized by the compiler. Arrays of points (as in the
+ * assembling) are evaluated in blocks.
+ *
+ * Optionally, the field can be sampled on a raster (set_raster_sampling)
+ * and then interpolated linearly (in the log-space). The raster is computed
+ * on demand and recomputed whenever a new realization of the field is
+ * generated (set_config), cf. revision().
+ */
 template <typename TData, int dim, typename TRet = void>
 class LognormalRandomField
 		: public StdGlobPosData<LognormalRandomField<TData, dim, TRet>, TData, dim, TRet>
 {
+	typedef StdGlobPosData<LognormalRandomField<TData, dim, TRet>, TData, dim, TRet> base_type;
+	typedef Raster<number, dim> raster_type;
 
 public:
 
 	LognormalRandomField()
 	{
 		m_bNoExp=false;
+		m_revision=0;
+		m_bUseRaster=false;
+		m_rasterRevision=0;
 		set_config(100, 0, 1, 0.1);
 	};
 
 	LognormalRandomField(size_t N, double mean_f, double sigma_f, double sigma)
 	{
 		m_bNoExp=false;
+		m_revision=0;
+		m_bUseRaster=false;
+		m_rasterRevision=0;
 		set_config(N, mean_f, sigma_f, sigma);
 	};
 
@@ -70,15 +92,47 @@ public:
 	}
 	inline TRet evaluate(TData& D, const MathVector<dim>& x, number time, int si) const;
 
+	using base_type::operator();
+
+///	evaluates the field at an array of points
+	virtual void operator()(TData vValue[],
+							const MathVector<dim> vGlobIP[],
+							number time, int si, const size_t nip) const;
+
+///	evaluates the field at all the integration points
+	virtual void compute(LocalVector* u, GridObject* elem,
+						 const MathVector<dim> vCornerCoords[], bool bDeriv = false);
+
+///	evaluates the field at all the integration points
+	virtual void compute(LocalVectorTimeSeries* u, GridObject* elem,
+						 const MathVector<dim> vCornerCoords[], bool bDeriv = false);
+
 	void set_no_exp() { m_bNoExp = true; }
 	void set_config(size_t N, double mean_f, double sigma_f, double sigma);
 
+///	samples the field on a raster with the given number of nodes per dimension
+	void set_raster_sampling(const std::vector<number>& minCorner,
+							 const std::vector<number>& extension, size_t numNodes);
+
+///	evaluates the modes directly at every point (default)
+	void disable_raster_sampling() { m_bUseRaster = false; m_raster = raster_type(); }
+
+///	revision of the realization, increased by every call to set_config
+	size_t revision() const { return m_revision; }
+
 	std::string config_string() const;
 
 private:
 	double gasdev();
     double undev();
     double eval_K(const MathVector<dim> &x)  const;
+    void eval_f(double vf[], const MathVector<dim> vx[], size_t n) const;
+    double K_from_f(double f) const;
+    void eval_K(double vK[], const MathVector<dim> vx[], size_t n) const;
+    void update_raster() const;
+    void sample_raster() const;
+    void assign(TData& D, double k) const;
+    void compute_all_series();
 
     MathVector<dim> m_sigma;
 
@@ -88,9 +142,21 @@ private:
     bool m_bNoExp;
     double m_dSigma;
 
-	std::vector<MathVector<dim> > m_vRandomQvec;
+	std::vector<double> m_vRandomQ[dim]; ///< the wave vectors of the modes (one array per coordinate)
 	std::vector<double> m_vRandomAlpha;
 
+	size_t m_revision;
+
+	bool m_bUseRaster;
+	MathVector<dim> m_rasterMin;
+	MathVector<dim> m_rasterExt;
+	size_t m_rasterNodes;
+	mutable raster_type m_raster;
+#	ifdef UG_CXX11
+	mutable std::atomic<size_t> m_rasterRevision; ///< revision the raster was sampled for (0 == none)
+#	else
+	mutable size_t m_rasterRevision; ///< revision the raster was sampled for (0 == none)
+#	endif
 };
 
 } // end ug
@@ -53,9 +53,8 @@
 namespace ug{
 
 template <typename TData, int dim, typename TRet>
-TRet LognormalRandomField<TData,dim,TRet>::evaluate(TData& D, const MathVector<dim>& x, number time, int si) const
+void LognormalRandomField<TData,dim,TRet>::assign(TData& D, double k) const
 {
-	double k = eval_K(x);
 	for(size_t i = 0; i < dim; ++i)
 	{
 		for(size_t j = 0; j < dim; ++j)
@@ -65,9 +64,58 @@ TRet LognormalRandomField<TData,dim,TRet>::evaluate(TData& D, const MathVector<d
 				D[i][j] = k;
 		}
 	}
+}
+
+template <typename TData, int dim, typename TRet>
+TRet LognormalRandomField<TData,dim,TRet>::evaluate(TData& D, const MathVector<dim>& x, number time, int si) const
+{
+	double k;
+	eval_K(&k, &x, 1);
+	assign(D, k);
 	return;
 }
 
+template <typename TData, int dim, typename TRet>
+void LognormalRandomField<TData,dim,TRet>::operator()(TData vValue[],
+		const MathVector<dim> vGlobIP[], number time, int si, const size_t nip) const
+{
+	if(nip == 0) return;
+	std::vector<double> vK(nip);
+	eval_K(&vK[0], vGlobIP, nip);
+	for(size_t ip = 0; ip < nip; ++ip)
+		assign(vValue[ip], vK[ip]);
+}
+
+template <typename TData, int dim, typename TRet>
+void LognormalRandomField<TData,dim,TRet>::compute(LocalVector* u, GridObject* elem,
+		const MathVector<dim> vCornerCoords[], bool bDeriv)
+{
+	compute_all_series();
+}
+
+template <typename TData, int dim, typename TRet>
+void LognormalRandomField<TData,dim,TRet>::compute(LocalVectorTimeSeries* u, GridObject* elem,
+		const MathVector<dim> vCornerCoords[], bool bDeriv)
+{
+//	the field does not depend on time
+	compute_all_series();
+}
+
+template <typename TData, int dim, typename TRet>
+void LognormalRandomField<TData,dim,TRet>::compute_all_series()
+{
+	std::vector<double> vK;
+	for(size_t s = 0; s < this->num_series(); ++s)
+	{
+		const size_t nip = this->num_ip(s);
+		if(nip == 0) continue;
+		vK.resize(nip);
+		eval_K(&vK[0], this->ips(s), nip);
+		for(size_t ip = 0; ip < nip; ++ip)
+			assign(this->value(s,ip), vK[ip]);
+	}
+}
+
 template <typename TData, int dim, typename TRet>
 double LognormalRandomField<TData,dim,TRet>::gasdev()
 {
@@ -106,21 +154,215 @@ double LognormalRandomField<TData, dim, TRet>::undev()
 	return urand(0.0, 1.0);
 }
 
+template <typename TData, int dim, typename TRet>
+double LognormalRandomField<TData,dim,TRet>::K_from_f(double f) const
+{
+	if(m_bNoExp)
+		return f;
+	else
+		return exp(f);
+}
+
+template <typename TData, int dim, typename TRet>
+void LognormalRandomField<TData,dim,TRet>::eval_f(double vf[], const MathVector<dim> vx[], size_t n) const
+{
+	const size_t N = m_vRandomAlpha.size();
+	if(N == 0)
+	{
+		for(size_t p = 0; p < n; ++p)
+			vf[p] = m_dMean_f;
+		return;
+	}
+	const double scale = sqrt(2*m_dSigma_f*m_dSigma_f/m_N);
+	const double* alpha = &m_vRandomAlpha[0];
+
+//	the phases are computed first, so that the loop over the cosines runs
+//	over a contiguous array and can be vectorized
+	std::vector<double> vPhase(N);
+	double* phase = &vPhase[0];
+
+	for(size_t p = 0; p < n; ++p)
+	{
+		const MathVector<dim>& x = vx[p];
+
+		for(size_t i = 0; i < N; ++i)
+			phase[i] = alpha[i];
+		for(int d = 0; d < dim; ++d)
+		{
+			const double* q = &m_vRandomQ[d][0];
+			const double xd = x[d];
+			for(size_t i = 0; i < N; ++i)
+				phase[i] += q[i] * xd;
+		}
+
+		double result = 0.0;
+		for(size_t i = 0; i < N; ++i)
+			result += cos(phase[i]);
+
+		vf[p] = m_dMean_f + scale*result;
+	}
+}
+
 template <typename TData, int dim, typename TRet>
 double LognormalRandomField<TData,dim,TRet>::eval_K(const MathVector<dim> &x) const
 {
+	double k;
+	eval_K(&k, &x, 1);
+	return k;
+}
 
-	double result = 0.0;
-	for(int i = 0; i < m_N; i++)
-		result += cos(VecDot(m_vRandomQvec[i], x) + m_vRandomAlpha[i]);
+template <typename TData, int dim, typename TRet>
+void LognormalRandomField<TData,dim,TRet>::eval_K(double vK[], const MathVector<dim> vx[], size_t n) const
+{
+	if(m_bUseRaster)
+	{
+		update_raster();
+		typename raster_type::Coordinate c;
+		for(size_t p = 0; p < n; ++p)
+		{
+			for(int d = 0; d < dim; ++d)
+				c[d] = vx[p][d];
+			vK[p] = K_from_f(m_raster.interpolate(c, 1));
+		}
+		return;
+	}
 
+	eval_f(vK, vx, n);
+	for(size_t p = 0; p < n; ++p)
+		vK[p] = K_from_f(vK[p]);
+}
 
-	double f = m_dMean_f + sqrt(2*m_dSigma_f*m_dSigma_f/m_N)*result;
+template <typename TData, int dim, typename TRet>
+void LognormalRandomField<TData,dim,TRet>::set_raster_sampling(const std::vector<number>& minCorner,
+		const std::vector<number>& extension, size_t numNodes)
+{
+	UG_COND_THROW(minCorner.size() < (size_t) dim || extension.size() < (size_t) dim,
+				  "LognormalRandomField: The raster corner and extension must have "
+				  << dim << " components.");
+	UG_COND_THROW(numNodes < 2, "LognormalRandomField: At least 2 raster nodes per dimension required.");
 
-	if(m_bNoExp)
-		return f;
-	else
-		return exp(f);
+	for(int d = 0; d < dim; ++d)
+	{
+		UG_COND_THROW(extension[d] <= 0, "LognormalRandomField: Non-positive raster extension.");
+		m_rasterMin[d] = minCorner[d];
+		m_rasterExt[d] = extension[d];
+	}
+	m_rasterNodes = numNodes;
+	m_bUseRaster = true;
+	m_rasterRevision = 0;
+}
+
+/**
+ * Resamples the raster if the realization has changed. Without an atomic
+ * revision (i.e. without UG_CXX11), the revision is only checked inside the
+ * critical section.
+ */
+template <typename TData, int dim, typename TRet>
+void LognormalRandomField<TData,dim,TRet>::update_raster() const
+{
+#	ifdef UG_CXX11
+	if(m_rasterRevision.load(std::memory_order_acquire) == m_revision)
+		return;
+#	endif
+
+#	ifdef UG_OPENMP
+#	pragma omp critical (LognormalRandomField_update_raster)
+#	endif
+	{
+#		ifdef UG_CXX11
+		if(m_rasterRevision.load(std::memory_order_relaxed) != m_revision)
+		{
+			sample_raster();
+			m_rasterRevision.store(m_revision, std::memory_order_release);
+		}
+#		else
+		if(m_rasterRevision != m_revision)
+		{
+			sample_raster();
+			m_rasterRevision = m_revision;
+		}
+#		endif
+	}
+}
+
+/**
+ * Samples the Gaussian field f (i.e. before the exponentiation) at the raster
+ * nodes. Along the lines in the first coordinate direction, the modes
+ * exp(i (q x + alpha)) are advanced by the complex factors exp(i q_0 h_0),
+ * so that only one cosine and sine per mode and line are evaluated.
+ */
+template <typename TData, int dim, typename TRet>
+void LognormalRandomField<TData,dim,TRet>::sample_raster() const
+{
+	typedef typename raster_type::MultiIndex MultiIndex;
+	typedef typename raster_type::Coordinate Coordinate;
+
+	MultiIndex numNodes;
+	Coordinate ext, minCorner;
+	for(int d = 0; d < dim; ++d)
+	{
+		numNodes[d] = m_rasterNodes;
+		ext[d] = m_rasterExt[d];
+		minCorner[d] = m_rasterMin[d];
+	}
+	m_raster = raster_type(numNodes, ext, minCorner);
+
+	const size_t N = m_vRandomAlpha.size();
+	const double scale = sqrt(2*m_dSigma_f*m_dSigma_f/m_N);
+	MathVector<dim> h;
+	for(int d = 0; d < dim; ++d)
+		h[d] = m_rasterExt[d] / (m_rasterNodes - 1);
+
+//	rotation of the modes by one step in the first coordinate direction
+	std::vector<double> vStepRe(N), vStepIm(N), vRe(N), vIm(N);
+	for(size_t i = 0; i < N; ++i)
+	{
+		vStepRe[i] = cos(m_vRandomQ[0][i] * h[0]);
+		vStepIm[i] = sin(m_vRandomQ[0][i] * h[0]);
+	}
+
+	size_t numLines = 1;
+	for(int d = 1; d < dim; ++d)
+		numLines *= m_rasterNodes;
+
+	MultiIndex mi;
+	MathVector<dim> x;
+	for(size_t line = 0; line < numLines; ++line)
+	{
+	//	the first node of the line
+		size_t rest = line;
+		mi[0] = 0;
+		x[0] = m_rasterMin[0];
+		for(int d = 1; d < dim; ++d)
+		{
+			mi[d] = rest % m_rasterNodes;
+			rest /= m_rasterNodes;
+			x[d] = m_rasterMin[d] + mi[d] * h[d];
+		}
+
+		for(size_t i = 0; i < N; ++i)
+		{
+			double phase = m_vRandomAlpha[i];
+			for(int d = 0; d < dim; ++d)
+				phase += m_vRandomQ[d][i] * x[d];
+			vRe[i] = cos(phase);
+			vIm[i] = sin(phase);
+		}
+
+		for(size_t k = 0; k < m_rasterNodes; ++k)
+		{
+			double result = 0.0;
+			for(size_t i = 0; i < N; ++i)
+			{
+				result += vRe[i];
+				const double re = vRe[i] * vStepRe[i] - vIm[i] * vStepIm[i];
+				vIm[i] = vRe[i] * vStepIm[i] + vIm[i] * vStepRe[i];
+				vRe[i] = re;
+			}
+			mi[0] = k;
+			m_raster.node_value(mi) = m_dMean_f + scale*result;
+		}
+	}
 }
 
 template <typename TData, int dim, typename TRet>
@@ -133,22 +375,22 @@ void LognormalRandomField<TData,dim,TRet>::set_config(size_t N, double mean_f, d
 	m_dSigma_f = sigma_f;
 	m_dSigma = sigma;
 
-	m_vRandomQvec.clear();
 	m_vRandomAlpha.clear();
 
-	MathVector<dim> q;
-
-	m_vRandomQvec.resize(N);
+	for(int j=0; j<dim; j++)
+		m_vRandomQ[j].resize(N);
 	for(int j=0; j<dim; j++)
 		for(int i = 0; i < m_N; i++)
-			m_vRandomQvec[i][j] = m_sigma[j]*gasdev();
+			m_vRandomQ[j][i] = m_sigma[j]*gasdev();
 
 
 	for(int i = 0; i < m_N; i++)
 		m_vRandomAlpha.push_back(undev()*2*M_PI);
 
+//	a new realization: the sampled raster is outdated
+	++m_revision;
+
 //	UG_LOG("corrx = " << m_sigma[0] << " corry = " << m_sigma[1] << "\n");
-//	PRINT_VECTOR(m_vRandomQvec, "m_vRandomQvec");
 //	PRINT_VECTOR(m_vRandomAlpha, "m_vRandomAlpha");
 
 }
@@ -168,6 +168,9 @@ class StdDataLinker
 	///	requests series id's from input data
 		virtual void local_ip_series_added(const size_t seriesID);
 
+	///	requests the local ips of a series from all inputs
+		void register_input_series(const size_t seriesID);
+
 	///	forwards the local positions to the data inputs
 		virtual void local_ips_changed(const size_t seriesID, const size_t newNumIP);
 
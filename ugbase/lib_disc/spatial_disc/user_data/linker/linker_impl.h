@@ -240,6 +240,17 @@ set_function_pattern(ConstSmartPtr<FunctionPattern> fctPatt)
 template <typename TImpl, typename TData, int dim>
 void StdDataLinker<TImpl,TData,dim>::
 local_ip_series_added(const size_t seriesID)
+{
+//	request the series from the inputs
+	register_input_series(seriesID);
+
+//	resize data fields
+	DependentUserData<TData, dim>::local_ip_series_added(seriesID);
+}
+
+template <typename TImpl, typename TData, int dim>
+void StdDataLinker<TImpl,TData,dim>::
+register_input_series(const size_t seriesID)
 {
 	const size_t s = seriesID;
 
@@ -279,9 +290,6 @@ local_ip_series_added(const size_t seriesID)
 			default: UG_THROW("Dimension not supported."); break;
 		}
 	}
-
-//	resize data fields
-	DependentUserData<TData, dim>::local_ip_series_added(seriesID);
 }
 
 
@@ -87,7 +87,7 @@ struct linker_traits< MathVector<dim>,  MathVector<dim>, number >
 	                     const MathVector<dim>& in1,
 						 const MathVector<dim>& s)
 	{
-		out = VecDot(s, in1);
+		out += VecDot(s, in1);
 	}
 };
 
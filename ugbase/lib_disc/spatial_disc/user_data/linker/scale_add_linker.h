@@ -42,6 +42,20 @@ namespace ug{
 // Scaled adding of Data
 ////////////////////////////////////////////////////////////////////////////////
 
+/// a summand of a flattened ScaleAddLinker
+/**
+ * The term represents factor * f_1 * ... * f_n * scale * data, where the
+ * f_i are scalar user data.
+ */
+template <typename TData, typename TDataScale, int dim>
+struct ScaleAddTerm
+{
+	number factor;
+	std::vector<SmartPtr<CplUserData<number, dim> > > vFactor;
+	SmartPtr<CplUserData<TDataScale, dim> > scale;
+	SmartPtr<CplUserData<TData, dim> > data;
+};
+
 /**
  * This linker recombines the data like
  *
@@ -51,6 +65,16 @@ namespace ug{
  * scaling factor of a (possibly) different type, that is applicable to the
  * data type
  *
+ * Expressions in the scripts (like 'a*b + 2*c') create trees of such linkers.
+ * Unless disabled by set_fusion(false), the linker flattens these trees: Inputs
+ * (or scalings) that are ScaleAddLinkers with scalar scalings themselves are
+ * expanded into their summands, the scalings of the nested linkers becoming
+ * scalar factors of the summands. The linker then depends directly on the leaves of the tree and computes values
+ * and derivatives of the whole expression in one pass, without the
+ * intermediate linkers being evaluated by the DataEvaluator. The flattened
+ * form is updated when the evaluation is prepared, if any linker of the tree
+ * has been changed in the meantime.
+ *
  * \tparam		TData		exported and combined Data type
  * \tparam		dim			world dimension
  * \tparam		TDataScale 	type of scaling data
@@ -63,9 +87,12 @@ class ScaleAddLinker
 	//	type of base class
 		typedef StdDataLinker<ScaleAddLinker<TData, dim, TDataScale, TRet>, TRet, dim> base_type;
 
+	///	type of a summand of the flattened expression
+		typedef ScaleAddTerm<TData, TDataScale, dim> term_type;
+
 	public:
 	///	constructor
-		ScaleAddLinker() {}
+		ScaleAddLinker() : m_bFusion(true), m_revision(0), m_fusedRevision(0) {}
 
 	///	constructor
 		ScaleAddLinker(const ScaleAddLinker& linker);
@@ -82,6 +109,18 @@ class ScaleAddLinker
 		         number data);
 	/// \}
 
+	///	enables/disables the flattening of nested linkers (default: enabled)
+		void set_fusion(bool bFusion);
+
+	///	appends the summands of the flattened expression
+		void collect_terms(std::vector<term_type>& vTerm) const;
+
+	///	revision of the expression (increased by every change of this linker or its nested linkers)
+		size_t revision() const;
+
+	///	number of other Data this data depends on (updates the flattened form)
+		virtual size_t num_needed_data() const;
+
 		inline void evaluate (TRet& value,
 		                      const MathVector<dim>& globIP,
 		                      number time, int si) const;
@@ -112,62 +151,103 @@ class ScaleAddLinker
 		                    const MathMatrix<refDim, dim>* vJT = NULL) const;
 
 	protected:
-	///	data at ip of input
-		const TData& input_value(size_t i, size_t s, size_t ip) const
+	///	a summand of the flattened expression, referring to the inputs of the base class
+		struct FusedTerm
 		{
-			UG_ASSERT(i < m_vpUserData.size(), "Input not needed");
-			UG_ASSERT(m_vpUserData[i].valid(), "Input invalid");
-			return m_vpUserData[i]->value(this->series_id(2*i,s), ip);
+			number factor;
+			std::vector<size_t> vFactor;
+			size_t scale;
+			size_t data;
+		};
+
+	///	rebuilds the flattened expression and the inputs of the base class
+		void update_fusion();
+
+	///	returns the index of a leaf in a list, appends it if not yet contained
+		template <typename TUserData>
+		static size_t leaf_index(std::vector<SmartPtr<TUserData> >& vLeaf,
+		                         SmartPtr<TUserData> leaf);
+
+	///	data at ip of a data leaf
+		const TData& data_value(size_t i, size_t s, size_t ip) const
+		{
+			UG_ASSERT(i < m_vFusedData.size(), "Input not needed");
+			return m_vFusedData[i]->value(this->series_id(i,s), ip);
 		}
 
-	///	derivative of data at input at ip
-		const TData& input_deriv(size_t i, size_t s, size_t ip, size_t fct, size_t dof) const
+	///	derivative of a data leaf at ip
+		const TData& data_deriv(size_t i, size_t s, size_t ip, size_t fct, size_t dof) const
 		{
-			UG_ASSERT(i < m_vpDependData.size(), "Input not needed");
-			UG_ASSERT(m_vpDependData[i].valid(), "Input invalid");
-			return m_vpDependData[i]->deriv(this->series_id(2*i,s), ip, fct, dof);
+			UG_ASSERT(m_vFusedDependData[i].valid(), "Input invalid");
+			return m_vFusedDependData[i]->deriv(this->series_id(i,s), ip, fct, dof);
 		}
 
-	///	scale at ip of input
+	///	scale at ip of a scaling leaf
 		const TDataScale& scale_value(size_t i, size_t s, size_t ip) const
 		{
-			UG_ASSERT(i < m_vpScaleData.size(), "Input not needed");
-			UG_ASSERT(m_vpScaleData[i].valid(), "Input invalid");
-			return m_vpScaleData[i]->value(this->series_id(2*i+1,s), ip);
+			UG_ASSERT(i < m_vFusedScale.size(), "Input not needed");
+			return m_vFusedScale[i]->value(this->series_id(scale_input(i),s), ip);
 		}
 
-	///	derivative of data at input at ip
+	///	derivative of a scaling leaf at ip
 		const TDataScale& scale_deriv(size_t i, size_t s, size_t ip, size_t fct, size_t dof) const
 		{
-			UG_ASSERT(i < m_vpScaleDependData.size(), "Input not needed");
-			UG_ASSERT(m_vpScaleDependData[i].valid(), "Input invalid");
-			return m_vpScaleDependData[i]->deriv(this->series_id(2*i+1,s), ip, fct, dof);
+			UG_ASSERT(m_vFusedScaleDependData[i].valid(), "Input invalid");
+			return m_vFusedScaleDependData[i]->deriv(this->series_id(scale_input(i),s), ip, fct, dof);
 		}
 
-	///	returns number of functions the input depends on
-		size_t input_num_fct(size_t i) const {return base_type::input_num_fct(2*i);}
+	///	value at ip of a scalar factor leaf
+		number factor_value(size_t i, size_t s, size_t ip) const
+		{
+			UG_ASSERT(i < m_vFusedFactor.size(), "Input not needed");
+			return m_vFusedFactor[i]->value(this->series_id(factor_input(i),s), ip);
+		}
 
-	///	returns the number in the common FctGrp for a fct of an input
-		size_t input_common_fct(size_t i, size_t fct) const	{return base_type::input_common_fct(2*i, fct);}
+	///	derivative of a scalar factor leaf at ip
+		number factor_deriv(size_t i, size_t s, size_t ip, size_t fct, size_t dof) const
+		{
+			UG_ASSERT(m_vFusedFactorDependData[i].valid(), "Input invalid");
+			return m_vFusedFactorDependData[i]->deriv(this->series_id(factor_input(i),s), ip, fct, dof);
+		}
 
-	///	returns number of functions the scaling depends on
-		size_t scale_num_fct(size_t i) const {return base_type::input_num_fct(2*i+1);}
+	///	index of a scaling leaf among the inputs of the base class
+		size_t scale_input(size_t i) const {return m_vFusedData.size() + i;}
 
-	///	returns the number in the common FctGrp for a fct of a scaling
-		size_t scale_common_fct(size_t i, size_t fct) const	{return base_type::input_common_fct(2*i+1, fct);}
+	///	index of a scalar factor leaf among the inputs of the base class
+		size_t factor_input(size_t i) const {return m_vFusedData.size() + m_vFusedScale.size() + i;}
 
 	protected:
 	///	data input
 		std::vector<SmartPtr<CplUserData<TDataScale, dim> > > m_vpScaleData;
 
-	///	data input casted to dependend data
-		std::vector<SmartPtr<DependentUserData<TDataScale, dim> > > m_vpScaleDependData;
-
 	///	data input
 		std::vector<SmartPtr<CplUserData<TData, dim> > > m_vpUserData;
 
-	///	data input casted to dependend data
-		std::vector<SmartPtr<DependentUserData<TData, dim> > > m_vpDependData;
+	///	flag indicating if nested linkers are flattened
+		bool m_bFusion;
+
+	///	number of changes of this linker
+		size_t m_revision;
+
+	///	revision of the expression the flattened form has been built for
+		size_t m_fusedRevision;
+
+	///	summands of the flattened expression
+		std::vector<FusedTerm> m_vFusedTerm;
+
+	///	leaves of the flattened expression (in this order inputs of the base class)
+	///	\{
+		std::vector<SmartPtr<CplUserData<TData, dim> > > m_vFusedData;
+		std::vector<SmartPtr<CplUserData<TDataScale, dim> > > m_vFusedScale;
+		std::vector<SmartPtr<CplUserData<number, dim> > > m_vFusedFactor;
+	///	\}
+
+	///	leaves casted to dependent data
+	///	\{
+		std::vector<SmartPtr<DependentUserData<TData, dim> > > m_vFusedDependData;
+		std::vector<SmartPtr<DependentUserData<TDataScale, dim> > > m_vFusedScaleDependData;
+		std::vector<SmartPtr<DependentUserData<number, dim> > > m_vFusedFactorDependData;
+	///	\}
 };
 
 } // end namespace ug
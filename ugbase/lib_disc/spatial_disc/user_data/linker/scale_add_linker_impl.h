@@ -46,6 +46,7 @@ namespace ug{
 template <typename TData, int dim, typename TDataScale, typename TRet>
 ScaleAddLinker<TData,dim,TDataScale,TRet>::
 ScaleAddLinker(const ScaleAddLinker& linker)
+	: m_bFusion(linker.m_bFusion), m_revision(0), m_fusedRevision(0)
 {
 	if(linker.m_vpUserData.size() != linker.m_vpScaleData.size())
 		UG_THROW("ScaleAddLinker: number of scaling factors and data mismatch.");
@@ -61,29 +62,17 @@ template <typename TData, int dim, typename TDataScale, typename TRet>
 void ScaleAddLinker<TData,dim,TDataScale,TRet>::
 add(SmartPtr<CplUserData<TDataScale, dim> > scale, SmartPtr<CplUserData<TData, dim> > data)
 {
-//	current number of inputs
-	const size_t numInput = base_type::num_input() / 2;
-
-//	resize scaling
-	m_vpUserData.resize(numInput+1);
-	m_vpDependData.resize(numInput+1);
-	m_vpScaleData.resize(numInput+1);
-	m_vpScaleDependData.resize(numInput+1);
-
 //	remember userdata
 	UG_ASSERT(data.valid(), "Null Pointer as Input set.");
-	m_vpUserData[numInput] = data;
-	m_vpDependData[numInput] = data.template cast_dynamic<DependentUserData<TData, dim> >();
+	m_vpUserData.push_back(data);
 
 //	remember userdata
 	UG_ASSERT(scale.valid(), "Null Pointer as Scale set.");
-	m_vpScaleData[numInput] = scale;
-	m_vpScaleDependData[numInput] = scale.template cast_dynamic<DependentUserData<TDataScale, dim> >();
+	m_vpScaleData.push_back(scale);
 
-//	increase number of inputs by one and set inputs at base class
-	base_type::set_num_input(2*numInput+2);
-	base_type::set_input(2*numInput, data, data);
-	base_type::set_input(2*numInput+1, scale, scale);
+//	rebuild the inputs of the base class
+	++m_revision;
+	update_fusion();
 }
 
 template <typename TData, int dim, typename TDataScale, typename TRet>
@@ -109,6 +98,178 @@ add(number scale, number data)
 }
 
 
+template <typename TData, int dim, typename TDataScale, typename TRet>
+void ScaleAddLinker<TData,dim,TDataScale,TRet>::
+set_fusion(bool bFusion)
+{
+	m_bFusion = bFusion;
+	++m_revision;
+	update_fusion();
+}
+
+template <typename TData, int dim, typename TDataScale, typename TRet>
+size_t ScaleAddLinker<TData,dim,TDataScale,TRet>::
+revision() const
+{
+	typedef ScaleAddLinker<TData, dim, number> TDataLinker;
+	typedef ScaleAddLinker<TDataScale, dim, number> TScaleLinker;
+
+	size_t rev = m_revision;
+	if(!m_bFusion) return rev;
+
+//	changes of nested linkers change the flattened expression as well
+	for(size_t c = 0; c < m_vpUserData.size(); ++c)
+	{
+		const TDataLinker* pData = dynamic_cast<const TDataLinker*>(m_vpUserData[c].get());
+		if(pData != NULL) rev += pData->revision();
+
+		const TScaleLinker* pScale = dynamic_cast<const TScaleLinker*>(m_vpScaleData[c].get());
+		if(pScale != NULL) rev += pScale->revision();
+	}
+	return rev;
+}
+
+template <typename TData, int dim, typename TDataScale, typename TRet>
+void ScaleAddLinker<TData,dim,TDataScale,TRet>::
+collect_terms(std::vector<term_type>& vTerm) const
+{
+	typedef ScaleAddLinker<TData, dim, number> TDataLinker;
+	typedef ScaleAddLinker<TDataScale, dim, number> TScaleLinker;
+
+	std::vector<typename TDataLinker::term_type> vDataTerm;
+	std::vector<typename TScaleLinker::term_type> vScaleTerm;
+
+	for(size_t c = 0; c < m_vpUserData.size(); ++c)
+	{
+	//	summands of the input: either the input itself or the summands of a nested linker
+		vDataTerm.clear();
+		const TDataLinker* pData = m_bFusion ?
+				dynamic_cast<const TDataLinker*>(m_vpUserData[c].get()) : NULL;
+		if(pData != NULL)
+			pData->collect_terms(vDataTerm);
+		else
+		{
+			typename TDataLinker::term_type t;
+			t.factor = 1.0;
+			t.data = m_vpUserData[c];
+			vDataTerm.push_back(t);
+		}
+
+	//	summands of the scaling
+		vScaleTerm.clear();
+		const TScaleLinker* pScale = m_bFusion ?
+				dynamic_cast<const TScaleLinker*>(m_vpScaleData[c].get()) : NULL;
+		if(pScale != NULL)
+			pScale->collect_terms(vScaleTerm);
+		else
+		{
+			typename TScaleLinker::term_type t;
+			t.factor = 1.0;
+			t.data = m_vpScaleData[c];
+			vScaleTerm.push_back(t);
+		}
+
+	//	multiply out: the scalar scalings of the nested linkers become factors
+		for(size_t i = 0; i < vDataTerm.size(); ++i)
+			for(size_t j = 0; j < vScaleTerm.size(); ++j)
+			{
+				const typename TDataLinker::term_type& d = vDataTerm[i];
+				const typename TScaleLinker::term_type& sc = vScaleTerm[j];
+
+				term_type t;
+				t.factor = d.factor * sc.factor;
+				t.data = d.data;
+				t.scale = sc.data;
+				t.vFactor = d.vFactor;
+				t.vFactor.insert(t.vFactor.end(), sc.vFactor.begin(), sc.vFactor.end());
+				if(d.scale.valid()) t.vFactor.push_back(d.scale);
+				if(sc.scale.valid()) t.vFactor.push_back(sc.scale);
+
+				vTerm.push_back(t);
+			}
+	}
+}
+
+template <typename TData, int dim, typename TDataScale, typename TRet>
+template <typename TUserData>
+size_t ScaleAddLinker<TData,dim,TDataScale,TRet>::
+leaf_index(std::vector<SmartPtr<TUserData> >& vLeaf, SmartPtr<TUserData> leaf)
+{
+	for(size_t i = 0; i < vLeaf.size(); ++i)
+		if(vLeaf[i] == leaf) return i;
+	vLeaf.push_back(leaf);
+	return vLeaf.size() - 1;
+}
+
+template <typename TData, int dim, typename TDataScale, typename TRet>
+void ScaleAddLinker<TData,dim,TDataScale,TRet>::
+update_fusion()
+{
+	std::vector<term_type> vTerm;
+	collect_terms(vTerm);
+
+//	collect the leaves and remember the summands by indices
+	m_vFusedData.clear();
+	m_vFusedScale.clear();
+	m_vFusedFactor.clear();
+	m_vFusedTerm.resize(vTerm.size());
+	for(size_t t = 0; t < vTerm.size(); ++t)
+	{
+		FusedTerm& ft = m_vFusedTerm[t];
+		ft.factor = vTerm[t].factor;
+		ft.data = leaf_index(m_vFusedData, vTerm[t].data);
+		ft.scale = leaf_index(m_vFusedScale, vTerm[t].scale);
+		ft.vFactor.resize(vTerm[t].vFactor.size());
+		for(size_t k = 0; k < vTerm[t].vFactor.size(); ++k)
+			ft.vFactor[k] = leaf_index(m_vFusedFactor, vTerm[t].vFactor[k]);
+	}
+
+//	set the leaves as inputs at the base class
+	base_type::set_num_input(m_vFusedData.size() + m_vFusedScale.size() + m_vFusedFactor.size());
+
+	m_vFusedDependData.resize(m_vFusedData.size());
+	for(size_t i = 0; i < m_vFusedData.size(); ++i)
+	{
+		m_vFusedDependData[i] = m_vFusedData[i].template cast_dynamic<DependentUserData<TData, dim> >();
+		base_type::set_input(i, m_vFusedData[i], m_vFusedData[i]);
+	}
+
+	m_vFusedScaleDependData.resize(m_vFusedScale.size());
+	for(size_t i = 0; i < m_vFusedScale.size(); ++i)
+	{
+		m_vFusedScaleDependData[i] = m_vFusedScale[i].template cast_dynamic<DependentUserData<TDataScale, dim> >();
+		base_type::set_input(scale_input(i), m_vFusedScale[i], m_vFusedScale[i]);
+	}
+
+	m_vFusedFactorDependData.resize(m_vFusedFactor.size());
+	for(size_t i = 0; i < m_vFusedFactor.size(); ++i)
+	{
+		m_vFusedFactorDependData[i] = m_vFusedFactor[i].template cast_dynamic<DependentUserData<number, dim> >();
+		base_type::set_input(factor_input(i), m_vFusedFactor[i], m_vFusedFactor[i]);
+	}
+
+	m_fusedRevision = revision();
+
+//	request the already registered ip series from the new inputs
+	for(size_t s = 0; s < this->num_series(); ++s)
+	{
+		this->register_input_series(s);
+		if(this->num_ip(s) > 0 && this->ips(s) != NULL)
+			this->global_ips_changed(s, this->ips(s), this->num_ip(s));
+	}
+}
+
+template <typename TData, int dim, typename TDataScale, typename TRet>
+size_t ScaleAddLinker<TData,dim,TDataScale,TRet>::
+num_needed_data() const
+{
+//	a nested linker may have been changed since the expression has been flattened
+	if(revision() != m_fusedRevision)
+		const_cast<ScaleAddLinker*>(this)->update_fusion();
+
+	return base_type::num_needed_data();
+}
+
 template <typename TData, int dim, typename TDataScale, typename TRet>
 void ScaleAddLinker<TData,dim,TDataScale,TRet>::
 evaluate (TRet& value,
@@ -182,8 +343,7 @@ eval_and_deriv(TRet vValue[],
                     std::vector<std::vector<TRet> > vvvDeriv[],
                     const MathMatrix<refDim, dim>* vJT) const
 {
-//	check that size of Scalings and inputs is equal
-	UG_ASSERT(m_vpUserData.size() == m_vpScaleData.size(), "Wrong num Scales.");
+	TRet prod;
 
 //	compute value
 	for(size_t ip = 0; ip < nip; ++ip)
@@ -192,72 +352,115 @@ eval_and_deriv(TRet vValue[],
 		vValue[ip] = 0.0;
 
 	//	add contribution of each summand
-		for(size_t c = 0; c < m_vpUserData.size(); ++c)
+		for(size_t t = 0; t < m_vFusedTerm.size(); ++t)
 		{
+			const FusedTerm& ft = m_vFusedTerm[t];
+
+			number factor = ft.factor;
+			for(size_t k = 0; k < ft.vFactor.size(); ++k)
+				factor *= factor_value(ft.vFactor[k], s, ip);
+
+			prod = 0.0;
 			linker_traits<TData, TDataScale,TRet>::
-			mult_add(vValue[ip],
-					 input_value(c, s, ip),
-					 scale_value(c, s, ip));
+			mult_add(prod, data_value(ft.data, s, ip), scale_value(ft.scale, s, ip));
+			linker_traits<TRet, number>::mult_add(vValue[ip], prod, factor);
 		}
 	}
 
 //	check if derivative is required
 	if(!bDeriv || this->zero_derivative()) return;
 
-//	check sizes
-	UG_ASSERT(m_vpDependData.size() == m_vpScaleDependData.size(),
-	          	  	  	  	  	  	  	  	  	  "Wrong num Scales.");
-
 //	clear all derivative values
 	this->set_zero(vvvDeriv, nip);
 
-//	loop all inputs
-	for(size_t c = 0; c < m_vpUserData.size(); ++c)
+//	loop all summands
+	for(size_t t = 0; t < m_vFusedTerm.size(); ++t)
 	{
-	//	check if input has derivative
-		if(!m_vpUserData[c]->zero_derivative())
+		const FusedTerm& ft = m_vFusedTerm[t];
+		const size_t dataInput = ft.data;
+		const size_t scaleInput = scale_input(ft.scale);
+
+		for(size_t ip = 0; ip < nip; ++ip)
 		{
-			for(size_t ip = 0; ip < nip; ++ip)
+			number factor = ft.factor;
+			for(size_t k = 0; k < ft.vFactor.size(); ++k)
+				factor *= factor_value(ft.vFactor[k], s, ip);
+
+		//	derivative of the data
+			if(!m_vFusedData[ft.data]->zero_derivative())
 			{
-			//	loop functions
-				for(size_t fct = 0; fct < input_num_fct(c); ++fct)
+				for(size_t fct = 0; fct < base_type::input_num_fct(dataInput); ++fct)
 				{
 				//	get common fct id for this function
-					const size_t commonFct = input_common_fct(c, fct);
+					const size_t commonFct = base_type::input_common_fct(dataInput, fct);
 
 				//	loop dofs
-					for(size_t sh = 0; sh < this->num_sh(fct); ++sh)
+					for(size_t sh = 0; sh < this->num_sh(commonFct); ++sh)
 					{
+						prod = 0.0;
 						linker_traits<TData, TDataScale,TRet>::
-						mult_add(vvvDeriv[ip][commonFct][sh],
-								 input_deriv(c, s, ip, fct, sh),
-								 scale_value(c, s, ip));
+						mult_add(prod, data_deriv(ft.data, s, ip, fct, sh),
+						         scale_value(ft.scale, s, ip));
+						linker_traits<TRet, number>::
+						mult_add(vvvDeriv[ip][commonFct][sh], prod, factor);
 					}
 				}
 			}
-		}
 
-	//	check if scaling has derivative
-		if(!m_vpScaleData[c]->zero_derivative())
-		{
-			for(size_t ip = 0; ip < nip; ++ip)
+		//	derivative of the scaling
+			if(!m_vFusedScale[ft.scale]->zero_derivative())
 			{
-			//	loop functions
-				for(size_t fct = 0; fct < scale_num_fct(c); ++fct)
+				for(size_t fct = 0; fct < base_type::input_num_fct(scaleInput); ++fct)
 				{
 				//	get common fct id for this function
-					const size_t commonFct = scale_common_fct(c, fct);
+					const size_t commonFct = base_type::input_common_fct(scaleInput, fct);
 
 				//	loop dofs
-					for(size_t sh = 0; sh < this->num_sh(fct); ++sh)
+					for(size_t sh = 0; sh < this->num_sh(commonFct); ++sh)
 					{
+						prod = 0.0;
 						linker_traits<TData, TDataScale,TRet>::
-						mult_add(vvvDeriv[ip][commonFct][sh],
-								 input_value(c, s, ip),
-								 scale_deriv(c, s, ip, fct, sh));
+						mult_add(prod, data_value(ft.data, s, ip),
+						         scale_deriv(ft.scale, s, ip, fct, sh));
+						linker_traits<TRet, number>::
+						mult_add(vvvDeriv[ip][commonFct][sh], prod, factor);
 					}
 				}
 			}
+
+		//	derivatives of the scalar factors (product rule)
+			bool bFactorDeriv = false;
+			for(size_t k = 0; k < ft.vFactor.size(); ++k)
+				bFactorDeriv |= !m_vFusedFactor[ft.vFactor[k]]->zero_derivative();
+			if(!bFactorDeriv) continue;
+
+			TRet value; value = 0.0;
+			linker_traits<TData, TDataScale,TRet>::
+			mult_add(value, data_value(ft.data, s, ip), scale_value(ft.scale, s, ip));
+
+			for(size_t k = 0; k < ft.vFactor.size(); ++k)
+			{
+				const size_t leaf = ft.vFactor[k];
+				if(m_vFusedFactor[leaf]->zero_derivative()) continue;
+
+			//	product of all the other factors
+				number otherFactor = ft.factor;
+				for(size_t j = 0; j < ft.vFactor.size(); ++j)
+					if(j != k) otherFactor *= factor_value(ft.vFactor[j], s, ip);
+
+				const size_t factorInput = factor_input(leaf);
+				for(size_t fct = 0; fct < base_type::input_num_fct(factorInput); ++fct)
+				{
+				//	get common fct id for this function
+					const size_t commonFct = base_type::input_common_fct(factorInput, fct);
+
+				//	loop dofs
+					for(size_t sh = 0; sh < this->num_sh(commonFct); ++sh)
+						linker_traits<TRet, number>::
+						mult_add(vvvDeriv[ip][commonFct][sh], value,
+						         otherFactor * factor_deriv(leaf, s, ip, fct, sh));
+				}
+			}
 		}
 	}
 }
@@ -34,6 +34,7 @@
 #include "edge_util.h"
 #include "../trees/kd_tree_static.h"
 #include "misc_util.h"
+#include "lib_grid/tools/scoped_marker.h"
 
 using namespace std;
 
@@ -229,7 +230,7 @@ bool CollectSurfaceNeighborsSorted(std::vector<Vertex*>& vNeighborsOut,
 	if(grid.associated_faces_begin(v) == grid.associated_faces_end(v))
 		return false;
 	
-	grid.begin_marking();
+	ScopedMarker marker(grid);
 	
 	if(grid.option_is_enabled(FACEOPT_AUTOGENERATE_EDGES)
 	   && grid.option_is_enabled(EDGEOPT_STORE_ASSOCIATED_FACES)){
@@ -240,7 +241,7 @@ bool CollectSurfaceNeighborsSorted(std::vector<Vertex*>& vNeighborsOut,
 		
 		while(curEdge){
 			vNeighborsOut.push_back(GetConnectedVertex(curEdge, v));
-			grid.mark(curEdge);
+			marker.mark(curEdge);
 			
 		//	get associated faces
 			Face* f[2];
@@ -249,10 +250,10 @@ bool CollectSurfaceNeighborsSorted(std::vector<Vertex*>& vNeighborsOut,
 			
 			curEdge = NULL;
 			for(int i = 0; i < 2; ++i){
-				if(!grid.is_marked(f[i])){
+				if(!marker.is_marked(f[i])){
 					CollectEdges(edges, grid, f[i]);
 					for(size_t j = 0; j < edges.size(); ++j){
-						if(!grid.is_marked(edges[j])){
+						if(!marker.is_marked(edges[j])){
 							if(EdgeContains(edges[j], v)){
 								curEdge = edges[j];
 								break;
@@ -268,23 +269,23 @@ bool CollectSurfaceNeighborsSorted(std::vector<Vertex*>& vNeighborsOut,
 	//	EDGEOPT_STORE_ASSOCIATED_FACES is not enabled.
 	//	Start with an arbitrary face
 		Face* f = *grid.associated_faces_begin(v);
-		grid.mark(v);
+		marker.mark(v);
 
 		while(f){
-			grid.mark(f);
+			marker.mark(f);
 			
 		//	mark one of the edges that is connected to v by marking
 		//	the edges endpoints. Make sure that it was not already marked.
 			size_t numVrts = f->num_vertices();
 			int vind = GetVertexIndex(f, v);
 			Vertex* tvrt = f->vertex((vind + 1)%numVrts);
-			if(grid.is_marked(tvrt))
+			if(marker.is_marked(tvrt))
 				tvrt = f->vertex((vind + numVrts - 1)%numVrts);
-			if(grid.is_marked(tvrt))
+			if(marker.is_marked(tvrt))
 				throw(UGError("CollectSurfaceNeighborsSorted: unexpected exit."));
 				
 			vNeighborsOut.push_back(tvrt);
-			grid.mark(tvrt);
+			marker.mark(tvrt);
 
 		//	iterate through the faces associated with v and find an unmarked one that
 		//	contains two marked vertices
@@ -293,11 +294,11 @@ bool CollectSurfaceNeighborsSorted(std::vector<Vertex*>& vNeighborsOut,
 			for(Grid::AssociatedFaceIterator iter = grid.associated_faces_begin(v);
 				iter != iterEnd; ++iter)
 			{
-				if(!grid.is_marked(*iter)){
+				if(!marker.is_marked(*iter)){
 					f = *iter;
 					size_t numMarked = 0;
 					for(size_t i = 0; i < f->num_vertices(); ++i){
-						if(grid.is_marked(f->vertex(i)))
+						if(marker.is_marked(f->vertex(i)))
 							++numMarked;
 					}
 					if(numMarked == 2)
@@ -309,7 +310,6 @@ bool CollectSurfaceNeighborsSorted(std::vector<Vertex*>& vNeighborsOut,
 		}
 	}
 
-	grid.end_marking();
 	return true;
 }
 
@@ -622,7 +622,7 @@ void MarkFixedCreaseVertices(Grid& grid, SubsetHandler& sh,
 		return;
 
 //	begin marking
-	grid.begin_marking();
+	ScopedMarker marker(grid);
 //	iterate over all crease-edges
 	for(EdgeIterator iter = sh.begin<Edge>(creaseSI);
 		iter != sh.end<Edge>(creaseSI); ++iter)
@@ -632,10 +632,10 @@ void MarkFixedCreaseVertices(Grid& grid, SubsetHandler& sh,
 		{
 			Vertex* v = (*iter)->vertex(i);
 		//	if the vertex is not marked (has not been checked yet)
-			if(!grid.is_marked(v))
+			if(!marker.is_marked(v))
 			{
 			//	mark it
-				grid.mark(v);
+				marker.mark(v);
 			//	count associated crease edges
 				int counter = 0;
 				Grid::AssociatedEdgeIterator aeIterEnd = grid.associated_edges_end(v);
@@ -657,9 +657,6 @@ void MarkFixedCreaseVertices(Grid& grid, SubsetHandler& sh,
 			}
 		}
 	}
-
-//	end marking
-	grid.end_marking();
 }
 
 }//	end of namespace
@@ -0,0 +1,688 @@
+/*
+ * Copyright (c) 2017:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+
+#include <algorithm>
+#include <deque>
+#include <queue>
+#include <utility>
+#include "multilevel_partitioning.h"
+#include "common/error.h"
+
+using namespace std;
+
+namespace ug{
+
+///	one level of the multilevel hierarchy
+struct MLGraph{
+	vector<int>		xadj;
+	vector<int>		adj;
+	vector<number>	ewgt;
+	vector<number>	vwgt;
+///	initial part of each vertex or -1
+	vector<int>		home;
+///	index of the coarse vertex into which a vertex was merged
+	vector<int>		cmap;
+
+	int num_vertices() const	{return (int)vwgt.size();}
+};
+
+typedef pair<int, number>	PartConn;
+
+
+///	sorts vertex indices by their degree
+struct CompareDegree{
+	CompareDegree(const vector<int>& xadj) : m_xadj(xadj)	{}
+	bool operator()(int a, int b) const
+	{
+		return m_xadj[a+1] - m_xadj[a] < m_xadj[b+1] - m_xadj[b];
+	}
+	const vector<int>& m_xadj;
+};
+
+
+///	merges pairs of vertices connected by heavy edges.
+/**	returns false if the graph could not be reduced substantially. In this case
+ * coarse is not filled.*/
+static bool CoarsenGraph(MLGraph& coarse, MLGraph& fine, number maxVrtWeight)
+{
+	const int n = fine.num_vertices();
+
+//	vertices with few neighbors are visited first, since they are least
+//	likely to find a partner later on
+	vector<int> order(n);
+	for(int i = 0; i < n; ++i)
+		order[i] = i;
+	stable_sort(order.begin(), order.end(), CompareDegree(fine.xadj));
+
+	vector<int> match(n, -1);
+	for(int k = 0; k < n; ++k){
+		const int u = order[k];
+		if(match[u] != -1)
+			continue;
+
+		int best = u;
+		number bestWeight = -1;
+		for(int j = fine.xadj[u]; j < fine.xadj[u+1]; ++j){
+			const int v = fine.adj[j];
+			if(v == u || match[v] != -1
+			   || fine.home[u] != fine.home[v]
+			   || fine.vwgt[u] + fine.vwgt[v] > maxVrtWeight)
+			{
+				continue;
+			}
+
+			if(fine.ewgt[j] > bestWeight){
+				bestWeight = fine.ewgt[j];
+				best = v;
+			}
+		}
+		match[u] = best;
+		match[best] = u;
+	}
+
+	fine.cmap.assign(n, -1);
+	vector<int> rep;
+	rep.reserve(n);
+	for(int u = 0; u < n; ++u){
+		if(fine.cmap[u] != -1)
+			continue;
+		fine.cmap[u] = fine.cmap[match[u]] = (int)rep.size();
+		rep.push_back(u);
+	}
+
+	const int nc = (int)rep.size();
+	if(nc > 0.95 * n)
+		return false;
+
+	coarse.xadj.resize(nc + 1);
+	coarse.adj.clear();
+	coarse.ewgt.clear();
+	coarse.vwgt.resize(nc);
+	coarse.home.resize(nc);
+
+//	pos[c] holds the position of the connection to coarse vertex c in the
+//	adjacency list of the coarse vertex which is currently built
+	vector<int> pos(nc, -1);
+	for(int c = 0; c < nc; ++c){
+		coarse.xadj[c] = (int)coarse.adj.size();
+		const int u = rep[c];
+		const int v = match[u];
+		coarse.home[c] = fine.home[u];
+		coarse.vwgt[c] = fine.vwgt[u];
+		if(v != u)
+			coarse.vwgt[c] += fine.vwgt[v];
+
+		for(int k = 0; k < 2; ++k){
+			const int w = (k == 0) ? u : v;
+			if(k == 1 && v == u)
+				break;
+
+			for(int j = fine.xadj[w]; j < fine.xadj[w+1]; ++j){
+				const int cn = fine.cmap[fine.adj[j]];
+				if(cn == c)
+					continue;
+				if(pos[cn] == -1){
+					pos[cn] = (int)coarse.adj.size();
+					coarse.adj.push_back(cn);
+					coarse.ewgt.push_back(fine.ewgt[j]);
+				}
+				else
+					coarse.ewgt[pos[cn]] += fine.ewgt[j];
+			}
+		}
+
+		for(size_t j = coarse.xadj[c]; j < coarse.adj.size(); ++j)
+			pos[coarse.adj[j]] = -1;
+	}
+	coarse.xadj[nc] = (int)coarse.adj.size();
+	return true;
+}
+
+
+///	collects the summed weights of the edges from u to each adjacent part
+static void CollectConnectivity(vector<PartConn>& connOut, const MLGraph& g,
+								const vector<int>& part, int u)
+{
+	connOut.clear();
+	for(int j = g.xadj[u]; j < g.xadj[u+1]; ++j){
+		const int p = part[g.adj[j]];
+		size_t k = 0;
+		for(; k < connOut.size(); ++k){
+			if(connOut[k].first == p)
+				break;
+		}
+		if(k == connOut.size())
+			connOut.push_back(PartConn(p, g.ewgt[j]));
+		else
+			connOut[k].second += g.ewgt[j];
+	}
+}
+
+
+///	change of the migration penalty if u is moved from part 'from' to part 'to'
+static inline number MigrationGain(const MLGraph& g, int u, int from, int to,
+								   number migrationCost)
+{
+	const int h = g.home[u];
+	if(h < 0 || migrationCost == 0)
+		return 0;
+	return migrationCost * g.vwgt[u] * (number)((to == h) - (from == h));
+}
+
+
+///	finds the move of u into an adjacent part which reduces the cut most.
+/**	Only parts which can take u without exceeding maxPartWeight are considered.
+ * returns false if no such part exists.*/
+static bool FindBestMove(int& toOut, number& gainOut, vector<PartConn>& conn,
+						 const MLGraph& g, const vector<int>& part,
+						 const vector<number>& partWeights, number maxPartWeight,
+						 number migrationCost, int u)
+{
+	const int from = part[u];
+	const number w = g.vwgt[u];
+	CollectConnectivity(conn, g, part, u);
+
+	number internal = 0;
+	for(size_t k = 0; k < conn.size(); ++k){
+		if(conn[k].first == from)
+			internal = conn[k].second;
+	}
+
+	bool found = false;
+	for(size_t k = 0; k < conn.size(); ++k){
+		const int q = conn[k].first;
+		if(q == from || partWeights[q] + w > maxPartWeight)
+			continue;
+
+		const number gain = conn[k].second - internal
+							+ MigrationGain(g, u, from, q, migrationCost);
+		if(!found || gain > gainOut
+		   || (gain == gainOut && partWeights[q] < partWeights[toOut]))
+		{
+			toOut = q;
+			gainOut = gain;
+			found = true;
+		}
+	}
+	return found;
+}
+
+
+static inline void MoveVertex(vector<int>& part, vector<number>& partWeights,
+							  const MLGraph& g, int u, int to)
+{
+	partWeights[part[u]] -= g.vwgt[u];
+	partWeights[to] += g.vwgt[u];
+	part[u] = to;
+}
+
+
+///	moves vertices out of parts which are heavier than maxPartWeight
+/**	Vertices are preferably moved to adjacent parts, choosing those moves
+ * which increase the cut least. If this is not sufficient, vertices are moved
+ * to the lightest part.*/
+static void BalancePartition(vector<int>& part, vector<number>& partWeights,
+							 const MLGraph& g, int numParts,
+							 number maxPartWeight, number migrationCost)
+{
+	const int n = g.num_vertices();
+	vector<PartConn> conn;
+	vector<pair<number, int> > cands;
+
+	for(int p = 0; p < numParts; ++p){
+		if(partWeights[p] <= maxPartWeight)
+			continue;
+
+		cands.clear();
+		for(int u = 0; u < n; ++u){
+			if(part[u] != p)
+				continue;
+			int to;
+			number gain;
+			if(FindBestMove(to, gain, conn, g, part, partWeights, maxPartWeight,
+							migrationCost, u))
+			{
+				cands.push_back(make_pair(gain, u));
+			}
+		}
+		sort(cands.rbegin(), cands.rend());
+
+		for(size_t i = 0; i < cands.size() && partWeights[p] > maxPartWeight; ++i){
+			const int u = cands[i].second;
+			int to;
+			number gain;
+		//	part weights have changed since the candidates were collected
+			if(FindBestMove(to, gain, conn, g, part, partWeights, maxPartWeight,
+							migrationCost, u))
+			{
+				MoveVertex(part, partWeights, g, u, to);
+			}
+		}
+
+		for(int u = 0; u < n && partWeights[p] > maxPartWeight; ++u){
+			if(part[u] != p)
+				continue;
+			const int to = (int)(min_element(partWeights.begin(), partWeights.end())
+								 - partWeights.begin());
+			if(partWeights[to] + g.vwgt[u] >= partWeights[p])
+				break;
+			MoveVertex(part, partWeights, g, u, to);
+		}
+	}
+}
+
+
+///	performs one k-way Fiduccia-Mattheyses pass.
+/**	Vertices are moved in the order of decreasing gain, each vertex at most
+ * once, also if the gain is negative. The pass stops if the cut did not
+ * improve during a number of moves. Moves after the best intermediate
+ * state are then undone.
+ * returns true if the partition was improved.*/
+static bool RefinementPass(vector<int>& part, vector<number>& partWeights,
+						   const MLGraph& g, number maxPartWeight,
+						   number migrationCost)
+{
+	typedef pair<number, int>	entry_t;
+
+	const int n = g.num_vertices();
+	const size_t maxNumBadMoves = max<size_t>(25, n / 100);
+
+	priority_queue<entry_t> heap;
+	vector<char> locked(n, 0);
+	vector<pair<int, int> > moves;
+	vector<PartConn> conn;
+
+	for(int u = 0; u < n; ++u){
+		int to;
+		number gain;
+		if(FindBestMove(to, gain, conn, g, part, partWeights, maxPartWeight,
+						migrationCost, u))
+		{
+			heap.push(entry_t(gain, u));
+		}
+	}
+
+	number curGain = 0, bestGain = 0;
+	size_t bestNumMoves = 0;
+
+	while(!heap.empty()){
+		const entry_t e = heap.top();
+		heap.pop();
+		const int u = e.second;
+		if(locked[u])
+			continue;
+
+		int to;
+		number gain;
+		if(!FindBestMove(to, gain, conn, g, part, partWeights, maxPartWeight,
+						 migrationCost, u))
+		{
+			continue;
+		}
+
+	//	outdated entry. Requeue with the current gain.
+		if(gain != e.first){
+			heap.push(entry_t(gain, u));
+			continue;
+		}
+
+		moves.push_back(make_pair(u, part[u]));
+		MoveVertex(part, partWeights, g, u, to);
+		locked[u] = 1;
+
+		curGain += gain;
+		if(curGain > bestGain){
+			bestGain = curGain;
+			bestNumMoves = moves.size();
+		}
+		else if(moves.size() - bestNumMoves > maxNumBadMoves)
+			break;
+
+		for(int j = g.xadj[u]; j < g.xadj[u+1]; ++j){
+			const int v = g.adj[j];
+			if(locked[v])
+				continue;
+			if(FindBestMove(to, gain, conn, g, part, partWeights, maxPartWeight,
+							migrationCost, v))
+			{
+				heap.push(entry_t(gain, v));
+			}
+		}
+	}
+
+//	undo all moves after the best state
+	for(size_t i = moves.size(); i > bestNumMoves; --i)
+		MoveVertex(part, partWeights, g, moves[i-1].first, moves[i-1].second);
+
+	return bestNumMoves > 0;
+}
+
+
+///	appends the vertices of the component of start in breadth-first order
+static int BreadthFirstSearch(vector<int>& orderOut, vector<char>& visited,
+							  const MLGraph& g, int start)
+{
+	size_t i = orderOut.size();
+	orderOut.push_back(start);
+	visited[start] = 1;
+	for(; i < orderOut.size(); ++i){
+		const int u = orderOut[i];
+		for(int j = g.xadj[u]; j < g.xadj[u+1]; ++j){
+			const int v = g.adj[j];
+			if(!visited[v]){
+				visited[v] = 1;
+				orderOut.push_back(v);
+			}
+		}
+	}
+	return orderOut.back();
+}
+
+
+///	creates a partition of the (coarsest) graph by greedy graph growing
+/**	Parts are grown one after the other from a seed, always adding the free
+ * vertex with the strongest connection to the part, until the part has
+ * reached its share of the remaining weight. Seeds are taken in the order
+ * of a breadth-first search started at a pseudo-peripheral vertex, so that
+ * consecutive parts are neighbors.*/
+static void GrowPartition(vector<int>& part, const MLGraph& g, int numParts)
+{
+	typedef pair<number, int>	entry_t;
+
+	const int n = g.num_vertices();
+
+	vector<int> seedOrder;
+	seedOrder.reserve(n);
+	{
+		vector<char> visited(n, 0), tmpVisited(n, 0);
+		vector<int> tmp;
+		for(int u = 0; u < n; ++u){
+			if(visited[u])
+				continue;
+		//	restart the search from the last vertex found in this component
+			tmp.clear();
+			const int far = BreadthFirstSearch(tmp, tmpVisited, g, u);
+			BreadthFirstSearch(seedOrder, visited, g, far);
+		}
+	}
+
+	number remainingWeight = 0;
+	for(int u = 0; u < n; ++u)
+		remainingWeight += g.vwgt[u];
+
+	part.assign(n, -1);
+	vector<number> conn(n, 0);
+	vector<int> touched;
+	size_t seedPos = 0;
+
+	for(int p = 0; p < numParts - 1; ++p){
+		const number target = remainingWeight / (number)(numParts - p);
+		number w = 0;
+		priority_queue<entry_t> heap;
+		touched.clear();
+
+		while(w < target){
+			int u = -1;
+			while(!heap.empty()){
+				const entry_t e = heap.top();
+				heap.pop();
+				if(part[e.second] == -1 && conn[e.second] == e.first){
+					u = e.second;
+					break;
+				}
+			}
+
+			if(u == -1){
+				while(seedPos < seedOrder.size() && part[seedOrder[seedPos]] != -1)
+					++seedPos;
+				if(seedPos == seedOrder.size())
+					break;
+				u = seedOrder[seedPos];
+			}
+
+		//	don't add u if the part would overshoot its target more than it falls short now
+			if(w > 0 && w + g.vwgt[u] - target > target - w)
+				break;
+
+			part[u] = p;
+			w += g.vwgt[u];
+
+			for(int j = g.xadj[u]; j < g.xadj[u+1]; ++j){
+				const int v = g.adj[j];
+				if(part[v] != -1)
+					continue;
+				if(conn[v] == 0)
+					touched.push_back(v);
+				conn[v] += g.ewgt[j];
+				heap.push(entry_t(conn[v], v));
+			}
+		}
+
+		remainingWeight -= w;
+		for(size_t i = 0; i < touched.size(); ++i)
+			conn[touched[i]] = 0;
+	}
+
+	for(int u = 0; u < n; ++u){
+		if(part[u] == -1)
+			part[u] = numParts - 1;
+	}
+}
+
+
+///	uses the initial parts and assigns vertices without initial part
+/**	Those vertices are given to the adjacent part with the strongest
+ * connection, isolated ones to the lightest part.*/
+static void PartitionFromHome(vector<int>& part, const MLGraph& g, int numParts)
+{
+	const int n = g.num_vertices();
+	part = g.home;
+
+	vector<number> partWeights(numParts, 0);
+	vector<int> queue;
+	for(int u = 0; u < n; ++u){
+		if(part[u] >= 0)
+			partWeights[part[u]] += g.vwgt[u];
+	}
+
+	for(int u = 0; u < n; ++u){
+		if(part[u] >= 0)
+			queue.push_back(u);
+	}
+
+	vector<PartConn> conn;
+	for(size_t i = 0; i < queue.size(); ++i){
+		const int u = queue[i];
+		for(int j = g.xadj[u]; j < g.xadj[u+1]; ++j){
+			const int v = g.adj[j];
+			if(part[v] >= 0)
+				continue;
+
+			CollectConnectivity(conn, g, part, v);
+			int best = -1;
+			number bestConn = 0;
+			for(size_t k = 0; k < conn.size(); ++k){
+				if(conn[k].first >= 0 && conn[k].second > bestConn){
+					best = conn[k].first;
+					bestConn = conn[k].second;
+				}
+			}
+			if(best == -1)
+				best = part[u];
+			part[v] = best;
+			partWeights[best] += g.vwgt[v];
+			queue.push_back(v);
+		}
+	}
+
+	for(int u = 0; u < n; ++u){
+		if(part[u] >= 0)
+			continue;
+		const int p = (int)(min_element(partWeights.begin(), partWeights.end())
+							- partWeights.begin());
+		part[u] = p;
+		partWeights[p] += g.vwgt[u];
+	}
+}
+
+
+static void RefinePartition(vector<int>& part, const MLGraph& g, int numParts,
+							number avgPartWeight, number imbalanceTol,
+							number migrationCost, bool isCoarseLevel)
+{
+	const int n = g.num_vertices();
+	const int maxNumPasses = 8;
+
+	vector<number> partWeights(numParts, 0);
+	number maxVrtWeight = 0;
+	for(int u = 0; u < n; ++u){
+		partWeights[part[u]] += g.vwgt[u];
+		maxVrtWeight = max(maxVrtWeight, g.vwgt[u]);
+	}
+
+//	on coarse levels the heavy vertices make it impossible to meet the
+//	tolerance exactly. It is met on the finest level.
+	number maxPartWeight = max(imbalanceTol * avgPartWeight, maxVrtWeight);
+	if(isCoarseLevel)
+		maxPartWeight = max(maxPartWeight, avgPartWeight + maxVrtWeight);
+
+	BalancePartition(part, partWeights, g, numParts, maxPartWeight, migrationCost);
+	for(int i = 0; i < maxNumPasses; ++i){
+		if(!RefinementPass(part, partWeights, g, maxPartWeight, migrationCost))
+			break;
+	}
+}
+
+
+void PartitionGraphMultilevel(std::vector<int>& partitionOut,
+                              const std::vector<int>& adjacencyMapStructure,
+                              const std::vector<int>& adjacencyMap,
+                              const std::vector<number>& vrtWeights,
+                              const std::vector<number>& edgeWeights,
+                              int numParts,
+                              number imbalanceTol,
+                              const std::vector<int>* pInitialPartition,
+                              number migrationCost)
+{
+	UG_COND_THROW(numParts < 1, "PartitionGraphMultilevel: numParts has to be positive.");
+
+	const int n = (int)adjacencyMapStructure.size() - 1;
+	if(n <= 0){
+		partitionOut.clear();
+		return;
+	}
+
+	if(numParts == 1){
+		partitionOut.assign(n, 0);
+		return;
+	}
+
+	UG_COND_THROW(!vrtWeights.empty() && (int)vrtWeights.size() != n,
+				  "PartitionGraphMultilevel: vrtWeights has to be empty or "
+				  "contain one entry for each vertex.");
+	UG_COND_THROW(!edgeWeights.empty() && edgeWeights.size() != adjacencyMap.size(),
+				  "PartitionGraphMultilevel: edgeWeights has to be empty or "
+				  "contain one entry for each entry in adjacencyMap.");
+	UG_COND_THROW(pInitialPartition && (int)pInitialPartition->size() != n,
+				  "PartitionGraphMultilevel: the initial partition has to "
+				  "contain one entry for each vertex.");
+
+//	levels are stored in a deque, since references to them have to stay
+//	valid while new levels are added.
+	deque<MLGraph> levels(1);
+	{
+		MLGraph& g = levels.front();
+		g.xadj = adjacencyMapStructure;
+		g.adj = adjacencyMap;
+		if(edgeWeights.empty())
+			g.ewgt.assign(adjacencyMap.size(), 1);
+		else
+			g.ewgt = edgeWeights;
+		if(vrtWeights.empty())
+			g.vwgt.assign(n, 1);
+		else
+			g.vwgt = vrtWeights;
+
+		g.home.assign(n, -1);
+		if(pInitialPartition){
+			for(int u = 0; u < n; ++u){
+				const int h = (*pInitialPartition)[u];
+				if(h >= 0 && h < numParts)
+					g.home[u] = h;
+			}
+		}
+	}
+
+	number totalWeight = 0;
+	for(int u = 0; u < n; ++u)
+		totalWeight += levels.front().vwgt[u];
+	const number avgPartWeight = totalWeight / (number)numParts;
+
+//	coarsen
+	const int coarsenTo = max(20 * numParts, 100);
+	const number maxCoarseVrtWeight = 1.5 * totalWeight / (number)coarsenTo;
+	while(levels.back().num_vertices() > coarsenTo){
+		levels.push_back(MLGraph());
+		if(!CoarsenGraph(levels.back(), levels[levels.size() - 2], maxCoarseVrtWeight)){
+			levels.pop_back();
+			break;
+		}
+	}
+
+//	initial partition on the coarsest level
+	vector<int> part;
+	if(pInitialPartition)
+		PartitionFromHome(part, levels.back(), numParts);
+	else
+		GrowPartition(part, levels.back(), numParts);
+
+	RefinePartition(part, levels.back(), numParts, avgPartWeight, imbalanceTol,
+					migrationCost, levels.size() > 1);
+
+//	project back and refine on each level
+	vector<int> finePart;
+	for(int lvl = (int)levels.size() - 2; lvl >= 0; --lvl){
+		const MLGraph& g = levels[lvl];
+		finePart.resize(g.num_vertices());
+		for(int u = 0; u < g.num_vertices(); ++u)
+			finePart[u] = part[g.cmap[u]];
+		part.swap(finePart);
+		levels.pop_back();
+
+		RefinePartition(part, g, numParts, avgPartWeight, imbalanceTol,
+						migrationCost, lvl > 0);
+	}
+
+	partitionOut.swap(part);
+}
+
+}//	end of namespace
@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2017:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+
+#ifndef __H__UG_multilevel_partitioning
+#define __H__UG_multilevel_partitioning
+
+#include <vector>
+#include "common/types.h"
+
+namespace ug{
+
+///	Partitions a weighted graph into numParts parts with a multilevel k-way scheme
+/**	The graph is given in the CSR format used by ConstructDualGraph and
+ * ParallelDualGraph: the neighbors of vertex i are found in
+ * adjacencyMap[adjacencyMapStructure[i]] to (but not including)
+ * adjacencyMap[adjacencyMapStructure[i+1]]. The graph has to be symmetric.
+ *
+ * The graph is coarsened by heavy-edge matching until it is small compared to
+ * numParts. The coarsest graph is partitioned by greedy graph growing, the
+ * partition is then projected back level by level and improved on each
+ * level by a k-way Fiduccia-Mattheyses refinement, which minimizes the
+ * weight of cut edges while the weight of each part stays below
+ * imbalanceTol times the average part weight.
+ *
+ * If pInitialPartition is specified, it is used as starting point instead
+ * of the greedy partition (adaptive repartitioning). Vertices are then only
+ * matched with vertices of the same initial part and moving a vertex away
+ * from its initial part is penalized by migrationCost times its weight, so
+ * that only few vertices change their part if the initial partition is
+ * nearly balanced. Entries of pInitialPartition which are negative or not
+ * smaller than numParts denote vertices without an initial part.
+ *
+ * \param[out]	partitionOut			part index in [0, numParts) for each vertex
+ * \param[in]	adjacencyMapStructure	numVertices+1 offsets into adjacencyMap
+ * \param[in]	adjacencyMap			neighbors of all vertices
+ * \param[in]	vrtWeights				weight of each vertex. May be empty (all 1).
+ * \param[in]	edgeWeights				weight of each entry in adjacencyMap. May be empty (all 1).
+ * \param[in]	numParts				number of parts
+ * \param[in]	imbalanceTol			maximal ratio of part weight and average part weight
+ * \param[in]	pInitialPartition		optional starting partition
+ * \param[in]	migrationCost			penalty for moving weight away from its initial part
+ */
+void PartitionGraphMultilevel(std::vector<int>& partitionOut,
+                              const std::vector<int>& adjacencyMapStructure,
+                              const std::vector<int>& adjacencyMap,
+                              const std::vector<number>& vrtWeights,
+                              const std::vector<number>& edgeWeights,
+                              int numParts,
+                              number imbalanceTol = 1.05,
+                              const std::vector<int>* pInitialPartition = NULL,
+                              number migrationCost = 0);
+
+}//	end of namespace
+
+#endif	//__H__UG_multilevel_partitioning
@@ -35,6 +35,7 @@
 
 #include "lib_grid/grid/grid.h"
 #include "lib_grid/grid/grid_util.h"
+#include "lib_grid/tools/scoped_marker.h"
 
 namespace ug{
 
@@ -46,7 +47,7 @@ void RemoveDuplicates(Grid& grid, TElemIter elemsBegin, TElemIter elemsEnd)
 	typedef typename TElemIter::value_type					TElemPtr;
 	typedef typename PtrToValueType<TElemPtr>::base_type	TElem;
 
-	grid.begin_marking();
+	ScopedMarker marker(grid);
 
 //	the first is the double, the second the original
 	std::vector<std::pair<TElem*, TElem*> > doubles;
@@ -54,13 +55,13 @@ void RemoveDuplicates(Grid& grid, TElemIter elemsBegin, TElemIter elemsEnd)
 
 	for(TElemIter iter = elemsBegin; iter != elemsEnd; ++iter){
 		TElem* e = *iter;
-		if(!grid.is_marked(e)){
+		if(!marker.is_marked(e)){
 			typename TElem::ConstVertexArray vrts = e->vertices();
 			const size_t numVrts = e->num_vertices();
 
 			bool allMarked = true;
 			for(size_t i = 0; i < numVrts; ++i){
-				if(!grid.is_marked(vrts[i])){
+				if(!marker.is_marked(vrts[i])){
 					allMarked = false;
 					break;
 				}
@@ -74,7 +75,7 @@ void RemoveDuplicates(Grid& grid, TElemIter elemsBegin, TElemIter elemsEnd)
 				grid.associated_elements(elems, vrts[0]);
 				for(size_t i = 0; i < elems.size(); ++i){
 					TElem* te = elems[i];
-					if(grid.is_marked(te) && CompareVertices(e, te)){
+					if(marker.is_marked(te) && CompareVertices(e, te)){
 					//	e is a double
 						isDouble = true;
 						doubles.push_back(std::make_pair(e, te));
@@ -85,15 +86,13 @@ void RemoveDuplicates(Grid& grid, TElemIter elemsBegin, TElemIter elemsEnd)
 
 		//	finally mark e and its vertices (every processed non-double element is marked).
 			if(!isDouble){
-				grid.mark(e);
+				marker.mark(e);
 				for(size_t i = 0; i < numVrts; ++i)
-					grid.mark(vrts[i]);
+					marker.mark(vrts[i]);
 			}
 		}
 	}
 
-	grid.end_marking();
-
 //	now erase all doubles
 	for(size_t i = 0; i < doubles.size(); ++i){
 	//	this allows listeners to take actions
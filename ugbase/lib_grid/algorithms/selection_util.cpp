@@ -37,6 +37,7 @@
 #include "selection_util.h"
 #include "geom_obj_util/geom_obj_util.h"
 #include "lib_grid/grid/grid_util.h"
+#include "lib_grid/tools/scoped_marker.h"
 
 using namespace std;
 
@@ -84,7 +85,7 @@ size_t CollectVerticesTouchingSelection(std::vector<Vertex*>& vrtsOut,
 
 	Grid& grid = *pGrid;
 
-	grid.begin_marking();
+	ScopedMarker marker(grid);
 
 //	get the goc and iterate over all elements
 	GridObjectCollection goc = sel.get_grid_objects();
@@ -92,8 +93,8 @@ size_t CollectVerticesTouchingSelection(std::vector<Vertex*>& vrtsOut,
 		for(VertexIterator iter = goc.begin<Vertex>(lvl);
 			iter != goc.end<Vertex>(lvl); ++iter)
 		{
-			if(!grid.is_marked(*iter)){
-				grid.mark(*iter);
+			if(!marker.is_marked(*iter)){
+				marker.mark(*iter);
 				vrtsOut.push_back(*iter);
 			}
 		}
@@ -103,8 +104,8 @@ size_t CollectVerticesTouchingSelection(std::vector<Vertex*>& vrtsOut,
 		{
 			for(size_t i = 0; i < (*iter)->num_vertices(); ++i){
 				Vertex* vrt = (*iter)->vertex(i);
-				if(!grid.is_marked(vrt)){
-					grid.mark(vrt);
+				if(!marker.is_marked(vrt)){
+					marker.mark(vrt);
 					vrtsOut.push_back(vrt);
 				}
 			}
@@ -115,8 +116,8 @@ size_t CollectVerticesTouchingSelection(std::vector<Vertex*>& vrtsOut,
 		{
 			for(size_t i = 0; i < (*iter)->num_vertices(); ++i){
 				Vertex* vrt = (*iter)->vertex(i);
-				if(!grid.is_marked(vrt)){
-					grid.mark(vrt);
+				if(!marker.is_marked(vrt)){
+					marker.mark(vrt);
 					vrtsOut.push_back(vrt);
 				}
 			}
@@ -127,15 +128,14 @@ size_t CollectVerticesTouchingSelection(std::vector<Vertex*>& vrtsOut,
 		{
 			for(size_t i = 0; i < (*iter)->num_vertices(); ++i){
 				Vertex* vrt = (*iter)->vertex(i);
-				if(!grid.is_marked(vrt)){
-					grid.mark(vrt);
+				if(!marker.is_marked(vrt)){
+					marker.mark(vrt);
 					vrtsOut.push_back(vrt);
 				}
 			}
 		}
 	}
 
-	grid.end_marking();
 
 	return vrtsOut.size();
 }
@@ -305,7 +305,7 @@ void ExtendSelection(TSelector& sel, size_t extSize, ISelector::status_t status)
 //	do this extSize times.
 //	elements that have already been processed are marked.
 	
-	grid.begin_marking();
+	ScopedMarker marker(grid);
 	
 //	perform iteration
 	for(size_t extIters = 0; extIters < extSize; ++extIters)
@@ -323,8 +323,8 @@ void ExtendSelection(TSelector& sel, size_t extSize, ISelector::status_t status)
 			{
 				Vertex* vrt = *iter;
 			//	all marked vertices have already been processed.
-				if(!grid.is_marked(vrt)){
-					grid.mark(vrt);
+				if(!marker.is_marked(vrt)){
+					marker.mark(vrt);
 
 				//	select associated volumes, faces and edges.
 					for(Grid::AssociatedEdgeIterator asIter = grid.associated_edges_begin(vrt);
@@ -348,8 +348,6 @@ void ExtendSelection(TSelector& sel, size_t extSize, ISelector::status_t status)
 			}
 		}
 	}
-	
-	grid.end_marking();
 }
 
 template void ExtendSelection<Selector>(Selector& sel, size_t extSize,
@@ -645,7 +643,7 @@ void SelectInnerSelectionVertices(TSelector& sel)
 	
 	Grid& grid = *sel.grid();
 	
-	grid.begin_marking();
+	ScopedMarker marker(grid);
 	
 //	we'll first collect all vertices that we want to check
 	vector<Vertex*> vrts;
@@ -659,8 +657,8 @@ void SelectInnerSelectionVertices(TSelector& sel)
 			Volume* vol = *iter;
 			for(size_t i = 0; i < vol->num_vertices(); ++i){
 				Vertex* v = vol->vertex(i);
-				if(!grid.is_marked(v)){
-					grid.mark(v);
+				if(!marker.is_marked(v)){
+					marker.mark(v);
 					vrts.push_back(v);
 				}
 			}
@@ -672,8 +670,8 @@ void SelectInnerSelectionVertices(TSelector& sel)
 			Face* f = *iter;
 			for(size_t i = 0; i < f->num_vertices(); ++i){
 				Vertex* v = f->vertex(i);
-				if(!grid.is_marked(v)){
-					grid.mark(v);
+				if(!marker.is_marked(v)){
+					marker.mark(v);
 					vrts.push_back(v);
 				}
 			}
@@ -685,14 +683,13 @@ void SelectInnerSelectionVertices(TSelector& sel)
 			Edge* e = *iter;
 			for(size_t i = 0; i < 2; ++i){
 				Vertex* v = e->vertex(i);
-				if(!grid.is_marked(v)){
-					grid.mark(v);
+				if(!marker.is_marked(v)){
+					marker.mark(v);
 					vrts.push_back(v);
 				}
 			}
 		}
 	}
-	grid.end_marking();
 
 
 //	now check for each vertex if an unselected element is associated
@@ -752,7 +749,7 @@ void SelectInnerSelectionEdges(TSelector& sel)
 	
 	Grid& grid = *sel.grid();
 	
-	grid.begin_marking();
+	ScopedMarker marker(grid);
 	
 //	we'll first collect all edges that we want to check
 	vector<Edge*> edges;
@@ -767,8 +764,8 @@ void SelectInnerSelectionEdges(TSelector& sel)
 			CollectEdges(vAssEdges, grid, *iter);
 			for(size_t i = 0; i < vAssEdges.size(); ++i){
 				Edge* e = vAssEdges[i];
-				if(!grid.is_marked(e)){
-					grid.mark(e);
+				if(!marker.is_marked(e)){
+					marker.mark(e);
 					edges.push_back(e);
 				}
 			}
@@ -780,14 +777,13 @@ void SelectInnerSelectionEdges(TSelector& sel)
 			CollectEdges(vAssEdges, grid, *iter);
 			for(size_t i = 0; i < vAssEdges.size(); ++i){
 				Edge* e = vAssEdges[i];
-				if(!grid.is_marked(e)){
-					grid.mark(e);
+				if(!marker.is_marked(e)){
+					marker.mark(e);
 					edges.push_back(e);
 				}
 			}
 		}
 	}
-	grid.end_marking();
 
 
 //	now check for each edge if an unselected element is associated
@@ -839,7 +835,7 @@ void SelectInnerSelectionFaces(TSelector& sel)
 	
 	Grid& grid = *sel.grid();
 	
-	grid.begin_marking();
+	ScopedMarker marker(grid);
 	
 //	iterate through selected volumes and check for each side
 //	whether it is connected to any unselected volumes.
@@ -855,8 +851,8 @@ void SelectInnerSelectionFaces(TSelector& sel)
 			CollectFaces(vAssFaces, grid, *iter);
 			for(size_t i = 0; i < vAssFaces.size(); ++i){
 				Face* f = vAssFaces[i];
-				if(!grid.is_marked(f)){
-					grid.mark(f);
+				if(!marker.is_marked(f)){
+					marker.mark(f);
 					CollectVolumes(vAssVols, grid, f);
 					bool foundUnselected = false;
 					for(size_t j = 0; j < vAssVols.size(); ++j){
@@ -872,8 +868,6 @@ void SelectInnerSelectionFaces(TSelector& sel)
 			}
 		}
 	}
-	
-	grid.end_marking();
 }
 
 
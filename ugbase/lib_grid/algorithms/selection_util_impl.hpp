@@ -37,6 +37,7 @@
 #include <queue>
 #include "lib_grid/algorithms/geom_obj_util/geom_obj_util.h"
 #include "common/util/metaprogramming_util.h"
+#include "lib_grid/tools/scoped_marker.h"
 
 namespace ug
 {
@@ -59,12 +60,12 @@ bool CalculateCenter(typename TAAPosVRT::ValueType& centerOut,
 	
 //	collect all vertices that are adjacent to selected elements
 //	we have to make sure that each vertex is only counted once.
-//	we do this by using grid::mark.
-	grid.begin_marking();
+//	we do this by using a ScopedMarker.
+	ScopedMarker marker(grid);
 
 //	std::vector<Vertex*> vrts;
 //	vrts.assign(sel.vertices_begin(), sel.vertices_end());
-//	grid.mark(sel.vertices_begin(), sel.vertices_end());
+//	marker.mark(sel.vertices_begin(), sel.vertices_end());
 
 	VecSet(centerOut, 0);
 	size_t n = 0;
@@ -72,7 +73,7 @@ bool CalculateCenter(typename TAAPosVRT::ValueType& centerOut,
 		iter != sel.vertices_end(); ++iter)
 	{
 		VecAdd(centerOut, centerOut, aaPos[*iter]);
-		grid.mark(*iter);
+		marker.mark(*iter);
 		++n;
 	}
 
@@ -81,8 +82,8 @@ bool CalculateCenter(typename TAAPosVRT::ValueType& centerOut,
 	{
 		Edge::ConstVertexArray vrts = (*iter)->vertices();
 		for(size_t i = 0; i < (*iter)->num_vertices(); ++i){
-			if(!grid.is_marked(vrts[i])){
-				grid.mark(vrts[i]);
+			if(!marker.is_marked(vrts[i])){
+				marker.mark(vrts[i]);
 				VecAdd(centerOut, centerOut, aaPos[vrts[i]]);
 				++n;
 			}
@@ -94,8 +95,8 @@ bool CalculateCenter(typename TAAPosVRT::ValueType& centerOut,
 	{
 		Face::ConstVertexArray vrts = (*iter)->vertices();
 		for(size_t i = 0; i < (*iter)->num_vertices(); ++i){
-			if(!grid.is_marked(vrts[i])){
-				grid.mark(vrts[i]);
+			if(!marker.is_marked(vrts[i])){
+				marker.mark(vrts[i]);
 				VecAdd(centerOut, centerOut, aaPos[vrts[i]]);
 				++n;
 			}
@@ -107,15 +108,14 @@ bool CalculateCenter(typename TAAPosVRT::ValueType& centerOut,
 	{
 		Volume::ConstVertexArray vrts = (*iter)->vertices();
 		for(size_t i = 0; i < (*iter)->num_vertices(); ++i){
-			if(!grid.is_marked(vrts[i])){
-				grid.mark(vrts[i]);
+			if(!marker.is_marked(vrts[i])){
+				marker.mark(vrts[i]);
 				VecAdd(centerOut, centerOut, aaPos[vrts[i]]);
 				++n;
 			}
 		}
 	}
 
-	grid.end_marking();
 
 	if(n > 0){
 		VecScale(centerOut, centerOut, 1. / (number)n);
@@ -136,14 +136,14 @@ void TranslateSelection(Selector& sel, const typename TAAPosVRT::ValueType& offs
 
 //	collect all vertices that are adjacent to selected elements
 //	we have to make sure that each vertex is only counted once.
-//	we do this by using grid::mark.
-	grid.begin_marking();
+//	we do this by using a ScopedMarker.
+	ScopedMarker marker(grid);
 
 	for(VertexIterator iter = sel.vertices_begin();
 		iter != sel.vertices_end(); ++iter)
 	{
 		VecAdd(aaPos[*iter], aaPos[*iter], offset);
-		grid.mark(*iter);
+		marker.mark(*iter);
 	}
 
 	for(EdgeIterator iter = sel.edges_begin();
@@ -151,8 +151,8 @@ void TranslateSelection(Selector& sel, const typename TAAPosVRT::ValueType& offs
 	{
 		Edge::ConstVertexArray vrts = (*iter)->vertices();
 		for(size_t i = 0; i < (*iter)->num_vertices(); ++i){
-			if(!grid.is_marked(vrts[i])){
-				grid.mark(vrts[i]);
+			if(!marker.is_marked(vrts[i])){
+				marker.mark(vrts[i]);
 				VecAdd(aaPos[vrts[i]], aaPos[vrts[i]], offset);
 			}
 		}
@@ -163,8 +163,8 @@ void TranslateSelection(Selector& sel, const typename TAAPosVRT::ValueType& offs
 	{
 		Face::ConstVertexArray vrts = (*iter)->vertices();
 		for(size_t i = 0; i < (*iter)->num_vertices(); ++i){
-			if(!grid.is_marked(vrts[i])){
-				grid.mark(vrts[i]);
+			if(!marker.is_marked(vrts[i])){
+				marker.mark(vrts[i]);
 				VecAdd(aaPos[vrts[i]], aaPos[vrts[i]], offset);
 			}
 		}
@@ -175,14 +175,12 @@ void TranslateSelection(Selector& sel, const typename TAAPosVRT::ValueType& offs
 	{
 		Volume::ConstVertexArray vrts = (*iter)->vertices();
 		for(size_t i = 0; i < (*iter)->num_vertices(); ++i){
-			if(!grid.is_marked(vrts[i])){
-				grid.mark(vrts[i]);
+			if(!marker.is_marked(vrts[i])){
+				marker.mark(vrts[i]);
 				VecAdd(aaPos[vrts[i]], aaPos[vrts[i]], offset);
 			}
 		}
 	}
-
-	grid.end_marking();
 }
 
 ////////////////////////////////////////////////////////////////////////
@@ -376,7 +374,7 @@ void ExtendSelectionInDirection(
 //	do this extSize times.
 //	elements that have already been processed are marked.
 	
-	grid.begin_marking();
+	ScopedMarker marker(grid);
 	
 //	perform iteration
 	for(size_t extIters = 0; extIters < extSize; ++extIters)
@@ -394,8 +392,8 @@ void ExtendSelectionInDirection(
 			{
 				Vertex* vrt = *iter;
 			//	all marked vertices have already been processed.
-				if(!grid.is_marked(vrt)){
-					grid.mark(vrt);
+				if(!marker.is_marked(vrt)){
+					marker.mark(vrt);
 
 				//	select associated volumes, faces and edges.
 					for(Grid::AssociatedEdgeIterator asIter = grid.associated_edges_begin(vrt);
@@ -422,8 +420,6 @@ void ExtendSelectionInDirection(
 			}
 		}
 	}
-	
-	grid.end_marking();
 }
 
 ////////////////////////////////////////////////////////////////////////
@@ -556,7 +552,7 @@ void SelectAreaBoundary(ISelector& sel, const TIter begin, const TIter end)
 
 	Grid& grid = *sel.grid();
 
-	grid.begin_marking();
+	ScopedMarker marker(grid);
 
 	std::vector<TSide*> sides;
 	TIter iter = begin;
@@ -566,10 +562,10 @@ void SelectAreaBoundary(ISelector& sel, const TIter begin, const TIter end)
 		CollectAssociated(sides, grid, elem);
 		for(size_t i = 0; i < sides.size(); ++i){
 			TSide* side = sides[i];
-			if(!grid.is_marked(side)){
+			if(!marker.is_marked(side)){
 			//	if the side was initially selected, it should stay that way
 				if(!sel.is_selected(side)){
-					grid.mark(side);
+					marker.mark(side);
 					sel.select(side);
 				}
 			}
@@ -579,8 +575,6 @@ void SelectAreaBoundary(ISelector& sel, const TIter begin, const TIter end)
 			}
 		}
 	}
-
-	grid.end_marking();
 }
 
 ////////////////////////////////////////////////////////////////////////
@@ -686,10 +680,10 @@ void SelectShortPolychains(ISelector& sel, number maxLength, bool closedChainsOn
 
 	std::vector<Vertex*> junctionPoints;
 
-	grid.begin_marking();
+	ScopedMarker marker(grid);
 
 	for(EdgeIterator eiter = grid.begin<Edge>(); eiter != grid.end<Edge>(); ++eiter){
-		if(grid.is_marked(*eiter))
+		if(marker.is_marked(*eiter))
 			continue;
 
 		bool curChainIsClosed = true;
@@ -699,7 +693,7 @@ void SelectShortPolychains(ISelector& sel, number maxLength, bool closedChainsOn
 		junctionPoints.clear();
 		
 		nextEdges.push(*eiter);
-		grid.mark(*eiter);
+		marker.mark(*eiter);
 
 		while(!nextEdges.empty()){
 			Edge* e = nextEdges.front();
@@ -717,8 +711,8 @@ void SelectShortPolychains(ISelector& sel, number maxLength, bool closedChainsOn
 				else if(edges.size() == 2){
 					for(size_t iedge = 0; iedge < 2; ++iedge){
 						Edge* nextEdge = edges[iedge];
-						if(!grid.is_marked(nextEdge)){
-							grid.mark(nextEdge);
+						if(!marker.is_marked(nextEdge)){
+							marker.mark(nextEdge);
 							nextEdges.push(nextEdge);
 						}
 					}
@@ -754,8 +748,6 @@ void SelectShortPolychains(ISelector& sel, number maxLength, bool closedChainsOn
 				sel.select(curChain.begin(), curChain.end());
 		}
 	}
-
-	grid.end_marking();
 }
 
 template <class TElem>
@@ -0,0 +1,151 @@
+/*
+ * Copyright (c) 2017:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+
+#ifndef __H__UG_space_filling_curve_util
+#define __H__UG_space_filling_curve_util
+
+#include <algorithm>
+#include "common/types.h"
+#include "common/math/ugmath_types.h"
+
+namespace ug{
+
+///	the space filling curves which can be used to compute keys
+enum SpaceFillingCurveType{
+	SFC_MORTON,
+	SFC_HILBERT
+};
+
+///	number of bits per coordinate direction used in keys of dimension dim
+/**	The key of a point is an uint64, i.e. 32 bits per direction are used in
+ * 1d and 2d and 21 bits per direction in 3d.*/
+template <int dim>
+inline int SFCBitsPerDim()	{return std::min<int>(32, 64 / dim);}
+
+///	quantizes the coordinates of p relative to the box [boxMin, boxMax]
+/**	Each coordinate is mapped to an integer in [0, 2^SFCBitsPerDim<dim>() - 1].
+ * Coordinates outside the box are clamped.*/
+template <int dim>
+inline void SFCQuantize(uint32* coordsOut, const MathVector<dim>& p,
+						const MathVector<dim>& boxMin, const MathVector<dim>& boxMax)
+{
+	const int bits = SFCBitsPerDim<dim>();
+	const number maxCoord = (number)((((uint64)1) << bits) - 1);
+	for(int i = 0; i < dim; ++i){
+		const number ext = boxMax[i] - boxMin[i];
+		number c = 0;
+		if(ext > 0)
+			c = (p[i] - boxMin[i]) / ext * maxCoord;
+		c = std::max<number>(0, std::min<number>(c, maxCoord));
+		coordsOut[i] = (uint32)c;
+	}
+}
+
+///	interleaves the bits of the given coordinates (most significant bits first)
+template <int dim>
+inline uint64 SFCInterleave(const uint32* coords)
+{
+	const int bits = SFCBitsPerDim<dim>();
+	uint64 key = 0;
+	for(int b = bits - 1; b >= 0; --b){
+		for(int i = 0; i < dim; ++i)
+			key = (key << 1) | ((coords[i] >> b) & 1);
+	}
+	return key;
+}
+
+///	returns the position of p on the Morton (Z-order) curve through the given box
+template <int dim>
+inline uint64 MortonKey(const MathVector<dim>& p, const MathVector<dim>& boxMin,
+						const MathVector<dim>& boxMax)
+{
+	uint32 x[dim];
+	SFCQuantize<dim>(x, p, boxMin, boxMax);
+	return SFCInterleave<dim>(x);
+}
+
+///	returns the position of p on the Hilbert curve through the given box
+/**	The coordinates are transformed into the 'transposed' Hilbert index
+ * following J. Skilling, "Programming the Hilbert curve", AIP Conf. Proc. 707
+ * (2004), whose bits are then interleaved.*/
+template <int dim>
+inline uint64 HilbertKey(const MathVector<dim>& p, const MathVector<dim>& boxMin,
+						 const MathVector<dim>& boxMax)
+{
+	uint32 x[dim];
+	SFCQuantize<dim>(x, p, boxMin, boxMax);
+
+	const uint32 m = ((uint32)1) << (SFCBitsPerDim<dim>() - 1);
+
+//	inverse undo
+	for(uint32 q = m; q > 1; q >>= 1){
+		const uint32 pMask = q - 1;
+		for(int i = 0; i < dim; ++i){
+			if(x[i] & q)
+				x[0] ^= pMask;
+			else{
+				const uint32 t = (x[0] ^ x[i]) & pMask;
+				x[0] ^= t;
+				x[i] ^= t;
+			}
+		}
+	}
+
+//	gray encode
+	for(int i = 1; i < dim; ++i)
+		x[i] ^= x[i-1];
+	uint32 t = 0;
+	for(uint32 q = m; q > 1; q >>= 1){
+		if(x[dim-1] & q)
+			t ^= q - 1;
+	}
+	for(int i = 0; i < dim; ++i)
+		x[i] ^= t;
+
+	return SFCInterleave<dim>(x);
+}
+
+///	returns the key of p on the specified space filling curve
+template <int dim>
+inline uint64 SpaceFillingCurveKey(SpaceFillingCurveType curve,
+								   const MathVector<dim>& p,
+								   const MathVector<dim>& boxMin,
+								   const MathVector<dim>& boxMax)
+{
+	if(curve == SFC_HILBERT)
+		return HilbertKey<dim>(p, boxMin, boxMax);
+	return MortonKey<dim>(p, boxMin, boxMax);
+}
+
+}//	end of namespace
+
+#endif	//__H__UG_space_filling_curve_util
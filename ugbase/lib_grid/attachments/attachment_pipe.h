@@ -41,6 +41,7 @@
 #include "common/types.h"
 #include "common/util/uid.h"
 #include "common/util/hash.h"
+#include "common/util/mem_accounting.h"
 #include "common/ug_config.h"
 #include "page_container.h"
 
@@ -143,7 +144,8 @@ template <class T> class UG_API AttachmentDataContainer : public IAttachmentData
 	public:
 		typedef T	ValueType;
 
-		AttachmentDataContainer(const T& defaultValue = T())	: m_defaultValue(defaultValue)	{}
+		AttachmentDataContainer(const T& defaultValue = T())	:
+			m_defaultValue(defaultValue), m_memAccount(MEM_ATTACHMENT)	{}
 
 		virtual ~AttachmentDataContainer()			{m_vData.clear();}
 
@@ -153,6 +155,7 @@ template <class T> class UG_API AttachmentDataContainer : public IAttachmentData
 					m_vData.resize(iSize, m_defaultValue);
 				else
 					m_vData.clear();
+				update_mem_account();
 			}
 
 		virtual size_t size()	{return m_vData.size();}
@@ -175,6 +178,7 @@ template <class T> class UG_API AttachmentDataContainer : public IAttachmentData
 					if(nInd != INVALID_ATTACHMENT_INDEX)
 						m_vData[nInd] = vDataOld[i];
 				}
+				update_mem_account();
 			}
 	
 	/**	copies entries from the this-container to the container
@@ -214,16 +218,28 @@ template <class T> class UG_API AttachmentDataContainer : public IAttachmentData
 		inline TRef operator[] (size_t index)				{return m_vData[index];}
 
 	///	swaps the buffer content of associated data
-		void swap(AttachmentDataContainer<T>& container)	{m_vData.swap(container.m_vData);}
+		void swap(AttachmentDataContainer<T>& container)
+			{
+				m_vData.swap(container.m_vData);
+				update_mem_account();
+				container.update_mem_account();
+			}
+
+	///	sets the category in which the memory of this container is accounted
+	/**	Defaults to MEM_ATTACHMENT.*/
+		void set_mem_category(MemCategory cat)		{m_memAccount.set_category(cat);}
 
 	protected:
 		DataContainer& get_data_container()			{return m_vData;}
 		//inline const T* get_ptr() const			{return &m_vData.front();}
 		//inline T* get_ptr()						{return &m_vData.front();}
+
+		void update_mem_account()	{m_memAccount.update(m_vData.capacity() * sizeof(T));}
 		
 	protected:
 		DataContainer	m_vData;
 		T				m_defaultValue;
+		MemAccount		m_memAccount;
 };
 
 ////////////////////////////////////////////////////////////////////////////////////////////////
@@ -30,158 +30,806 @@
  * GNU Lesser General Public License for more details.
  */
 
-#include <fstream>
 #include <vector>
+#include <map>
 #include <string>
 #include <cctype>
 #include <algorithm>
 #include "file_io_msh.h"
+#include "file_io_tokenizer.h"
 #include "../lg_base.h"
 
 using namespace std;
 
 namespace ug
 {
+
+////////////////////////////////////////////////////////////////////////
+//	helper types
+///	properties of the gmsh element types which can be imported
+/**	For higher order elements only the corner nodes are used.*/
+struct MSHElemType
+{
+	int numNodes;
+	int numCorners;
+	int roid;
+};
+
+static const MSHElemType* GetMSHElemType(int type)
+{
+	static const int numTypes = 20;
+	static const MSHElemType types[numTypes] = {
+		{0, 0, ROID_UNKNOWN},
+		{2, 2, ROID_EDGE},				//	1:	2-node line
+		{3, 3, ROID_TRIANGLE},			//	2:	3-node triangle
+		{4, 4, ROID_QUADRILATERAL},		//	3:	4-node quadrangle
+		{4, 4, ROID_TETRAHEDRON},		//	4:	4-node tetrahedron
+		{8, 8, ROID_HEXAHEDRON},		//	5:	8-node hexahedron
+		{6, 6, ROID_PRISM},				//	6:	6-node prism
+		{5, 5, ROID_PYRAMID},			//	7:	5-node pyramid
+		{3, 2, ROID_EDGE},				//	8:	3-node line
+		{6, 3, ROID_TRIANGLE},			//	9:	6-node triangle
+		{9, 4, ROID_QUADRILATERAL},		//	10:	9-node quadrangle
+		{10, 4, ROID_TETRAHEDRON},		//	11:	10-node tetrahedron
+		{27, 8, ROID_HEXAHEDRON},		//	12:	27-node hexahedron
+		{18, 6, ROID_PRISM},			//	13:	18-node prism
+		{14, 5, ROID_PYRAMID},			//	14:	14-node pyramid
+		{1, 1, ROID_VERTEX},			//	15:	1-node point
+		{8, 4, ROID_QUADRILATERAL},		//	16:	8-node quadrangle
+		{20, 8, ROID_HEXAHEDRON},		//	17:	20-node hexahedron
+		{15, 6, ROID_PRISM},			//	18:	15-node prism
+		{13, 5, ROID_PYRAMID}			//	19:	13-node pyramid
+	};
+
+	if(type <= 0 || type >= numTypes)
+		return NULL;
+	return &types[type];
+}
+
+static int MSHElemDim(int roid)
+{
+	switch(roid){
+		case ROID_VERTEX:			return 0;
+		case ROID_EDGE:				return 1;
+		case ROID_TRIANGLE:
+		case ROID_QUADRILATERAL:	return 2;
+		default:					return 3;
+	}
+}
+
+///	an element as it was read from the file
+struct MSHElement
+{
+	int		type;
+	int		physTag;	///< physical group of the element (0 if none)
+	size_t	nodes[8];	///< node tags of the corners
+};
+
+///	an entry of the $PhysicalNames section
+struct MSHPhysicalName
+{
+	int		dim;
+	int		tag;
+	string	name;
+};
+
+///	everything that is read from a msh file before the grid is created
+struct MSHData
+{
+	MSHData() : version(2.2), binary(false)	{}
+
+	double					version;
+	bool					binary;
+	vector<size_t>			nodeTags;
+	vector<vector3>			nodePos;
+	vector<MSHElement>		elems;
+	vector<MSHPhysicalName>	physicalNames;
+///	maps entity tags to their first physical tag (one map per dimension, v4 only)
+	map<int, int>			entityPhysTags[4];
+};
+
+///	maps node tags to the created vertices
+/**	Node tags are usually dense, so that a plain vector can be used.
+ * For sparse tags a sorted array is searched instead.*/
+class MSHNodeMap
+{
+	public:
+		MSHNodeMap(const vector<size_t>& tags, const vector<Vertex*>& vrts)
+		{
+			size_t maxTag = 0;
+			for(size_t i = 0; i < tags.size(); ++i)
+				maxTag = max(maxTag, tags[i]);
+
+			m_bDense = (maxTag <= 2 * tags.size() + 1024);
+			if(m_bDense){
+				m_denseVrts.resize(maxTag + 1, NULL);
+				for(size_t i = 0; i < tags.size(); ++i)
+					m_denseVrts[tags[i]] = vrts[i];
+			}
+			else{
+				m_sparseVrts.resize(tags.size());
+				for(size_t i = 0; i < tags.size(); ++i)
+					m_sparseVrts[i] = make_pair(tags[i], vrts[i]);
+				sort(m_sparseVrts.begin(), m_sparseVrts.end());
+			}
+		}
+
+		Vertex* get(size_t tag) const
+		{
+			if(m_bDense)
+				return tag < m_denseVrts.size() ? m_denseVrts[tag] : NULL;
+
+			vector<pair<size_t, Vertex*> >::const_iterator iter =
+				lower_bound(m_sparseVrts.begin(), m_sparseVrts.end(),
+							make_pair(tag, (Vertex*)NULL));
+			if(iter != m_sparseVrts.end() && iter->first == tag)
+				return iter->second;
+			return NULL;
+		}
+
+	private:
+		bool							m_bDense;
+		vector<Vertex*>					m_denseVrts;
+		vector<pair<size_t, Vertex*> >	m_sparseVrts;
+};
+
+template <class T>
+static inline bool ReadBinary(AsciiTokenizer& tok, T& valOut)
+{
+	return tok.read_raw(&valOut, sizeof(T));
+}
+
+
+////////////////////////////////////////////////////////////////////////
+//	line parsers
+///	parses a node line 'tag x y z [params]'
+struct MSHNodeLineParser
+{
+	MSHNodeLineParser(MSHData& d, size_t offset, bool withTag) :
+		data(d), first(offset), bWithTag(withTag)	{}
+
+	bool operator()(size_t i, AsciiTokenizer& tok)
+	{
+		if(bWithTag && !tok.read(data.nodeTags[first + i]))
+			return false;
+		double x, y, z;
+		if(!(tok.read(x) && tok.read(y) && tok.read(z)))
+			return false;
+		data.nodePos[first + i] = vector3(x, y, z);
+		return true;
+	}
+
+	MSHData&	data;
+	size_t		first;
+	bool		bWithTag;
+};
+
+///	parses a single node tag per line (v4)
+struct MSHNodeTagLineParser
+{
+	MSHNodeTagLineParser(MSHData& d, size_t offset) : data(d), first(offset)	{}
+
+	bool operator()(size_t i, AsciiTokenizer& tok)
+	{
+		return tok.read(data.nodeTags[first + i]);
+	}
+
+	MSHData&	data;
+	size_t		first;
+};
+
+///	parses an element line of the v2 format 'tag type numTags tags... nodes...'
+/**	The first tag holds the physical group of the element.*/
+struct MSHElementLineParserV2
+{
+	MSHElementLineParserV2(MSHData& d) : data(d)	{}
+
+	bool operator()(size_t i, AsciiTokenizer& tok)
+	{
+		MSHElement& elem = data.elems[i];
+		long tag;
+		int numTags;
+		if(!(tok.read(tag) && tok.read(elem.type) && tok.read(numTags)))
+			return false;
+
+		elem.physTag = 0;
+		for(int j = 0; j < numTags; ++j){
+			int t;
+			if(!tok.read(t))
+				return false;
+			if(j == 0)
+				elem.physTag = t;
+		}
+
+		const MSHElemType* et = GetMSHElemType(elem.type);
+		if(!et)
+			return false;
+
+		for(int j = 0; j < et->numCorners; ++j){
+			if(!tok.read(elem.nodes[j]))
+				return false;
+		}
+		return true;
+	}
+
+	MSHData&	data;
+};
+
+///	parses an element line of the v4 format 'tag nodes...'
+struct MSHElementLineParserV4
+{
+	MSHElementLineParserV4(MSHData& d, size_t offset, int t, int phys) :
+		data(d), first(offset), type(t), physTag(phys),
+		numCorners(GetMSHElemType(t)->numCorners)	{}
+
+	bool operator()(size_t i, AsciiTokenizer& tok)
+	{
+		MSHElement& elem = data.elems[first + i];
+		elem.type = type;
+		elem.physTag = physTag;
+		long tag;
+		if(!tok.read(tag))
+			return false;
+		for(int j = 0; j < numCorners; ++j){
+			if(!tok.read(elem.nodes[j]))
+				return false;
+		}
+		return true;
+	}
+
+	MSHData&	data;
+	size_t		first;
+	int			type;
+	int			physTag;
+	int			numCorners;
+};
+
+
+////////////////////////////////////////////////////////////////////////
+//	section readers
+static bool ReadMSHNodesV2(AsciiTokenizer& tok, MSHData& data)
+{
+	size_t numNodes;
+	if(!tok.read(numNodes)){
+		UG_LOG("LoadGridFromMSH: bad format in $NODES - numNodes\n");
+		return false;
+	}
+
+	data.nodeTags.resize(numNodes);
+	data.nodePos.resize(numNodes);
+	MSHNodeLineParser parser(data, 0, true);
+	if(ParseLines(tok, numNodes, parser) != numNodes){
+		UG_LOG("LoadGridFromMSH: bad format in $NODES\n");
+		return false;
+	}
+	return true;
+}
+
+static bool ReadMSHElementsV2(AsciiTokenizer& tok, MSHData& data)
+{
+	size_t numElems;
+	if(!tok.read(numElems)){
+		UG_LOG("LoadGridFromMSH: bad format in $ELEMENTS - numElems\n");
+		return false;
+	}
+
+	data.elems.resize(numElems);
+	MSHElementLineParserV2 parser(data);
+	size_t numParsed = ParseLines(tok, numElems, parser);
+	if(numParsed != numElems){
+		if(numParsed < numElems && data.elems[numParsed].type != 0
+		   && !GetMSHElemType(data.elems[numParsed].type))
+		{
+			UG_LOG("ERROR in LoadGridFromMSH: element type "
+					<< data.elems[numParsed].type << " not supported. aborting...\n");
+		}
+		else{
+			UG_LOG("LoadGridFromMSH: bad format in $ELEMENTS\n");
+		}
+		return false;
+	}
+	return true;
+}
+
+static bool ReadMSHPhysicalNames(AsciiTokenizer& tok, MSHData& data)
+{
+	size_t numNames;
+	if(!tok.read(numNames))
+		return false;
+
+	for(size_t i = 0; i < numNames; ++i){
+		MSHPhysicalName pn;
+		if(!(tok.read(pn.dim) && tok.read(pn.tag) && tok.read_string(pn.name)))
+			return false;
+		data.physicalNames.push_back(pn);
+	}
+	return true;
+}
+
+static bool ReadMSHEntitiesV4(AsciiTokenizer& tok, MSHData& data)
+{
+	uint64 numEntities[4];
+	for(int i = 0; i < 4; ++i){
+		if(data.binary){
+			if(!ReadBinary(tok, numEntities[i]))
+				return false;
+		}
+		else{
+			size_t num;
+			if(!tok.read(num))
+				return false;
+			numEntities[i] = num;
+		}
+	}
+
+	for(int dim = 0; dim < 4; ++dim){
+	//	points store a position, all other entities a bounding box
+		const int numCoords = (dim == 0) ? 3 : 6;
+		for(uint64 i = 0; i < numEntities[dim]; ++i){
+			int tag;
+			double coord;
+			uint64 numPhys;
+			bool ok;
+			if(data.binary){
+				ok = ReadBinary(tok, tag);
+				for(int j = 0; j < numCoords; ++j)
+					ok = ok && ReadBinary(tok, coord);
+				ok = ok && ReadBinary(tok, numPhys);
+			}
+			else{
+				size_t num = 0;
+				ok = tok.read(tag);
+				for(int j = 0; j < numCoords; ++j)
+					ok = ok && tok.read(coord);
+				ok = ok && tok.read(num);
+				numPhys = num;
+			}
+			if(!ok)
+				return false;
+
+			for(uint64 j = 0; j < numPhys; ++j){
+				int physTag;
+				if(data.binary)	ok = ReadBinary(tok, physTag);
+				else			ok = tok.read(physTag);
+				if(!ok)
+					return false;
+				if(j == 0)
+					data.entityPhysTags[dim][tag] = physTag;
+			}
+
+		//	tags of bounding entities
+			if(dim > 0){
+				uint64 numBnd;
+				if(data.binary){
+					if(!ReadBinary(tok, numBnd))
+						return false;
+					if(tok.remaining() < numBnd * sizeof(int))
+						return false;
+					tok.set_position(tok.position() + numBnd * sizeof(int));
+				}
+				else{
+					size_t num;
+					if(!tok.read(num))
+						return false;
+					for(size_t j = 0; j < num; ++j){
+						int bndTag;
+						if(!tok.read(bndTag))
+							return false;
+					}
+				}
+			}
+		}
+	}
+	return true;
+}
+
+static bool ReadMSHNodesV4(AsciiTokenizer& tok, MSHData& data)
+{
+	uint64 header[4];	// numEntityBlocks, numNodes, minNodeTag, maxNodeTag
+	for(int i = 0; i < 4; ++i){
+		if(data.binary){
+			if(!ReadBinary(tok, header[i]))
+				return false;
+		}
+		else{
+			size_t val;
+			if(!tok.read(val))
+				return false;
+			header[i] = val;
+		}
+	}
+
+	const size_t offset = data.nodeTags.size();
+	data.nodeTags.resize(offset + header[1]);
+	data.nodePos.resize(offset + header[1]);
+
+	size_t first = offset;
+	for(uint64 iblock = 0; iblock < header[0]; ++iblock){
+		int entityDim, entityTag, parametric;
+		uint64 numNodes;
+		if(data.binary){
+			if(!(ReadBinary(tok, entityDim) && ReadBinary(tok, entityTag)
+				 && ReadBinary(tok, parametric) && ReadBinary(tok, numNodes)))
+				return false;
+		}
+		else{
+			size_t num;
+			if(!(tok.read(entityDim) && tok.read(entityTag)
+				 && tok.read(parametric) && tok.read(num)))
+				return false;
+			numNodes = num;
+		}
+
+		if(first + numNodes > data.nodeTags.size())
+			return false;
+
+		if(data.binary){
+			const size_t numParams = parametric ? entityDim : 0;
+			const size_t numCoords = 3 + numParams;
+			if(tok.remaining() < numNodes * (sizeof(uint64) + numCoords * sizeof(double)))
+				return false;
+
+			for(uint64 i = 0; i < numNodes; ++i){
+				uint64 tag;
+				ReadBinary(tok, tag);
+				data.nodeTags[first + i] = (size_t)tag;
+			}
+
+			for(uint64 i = 0; i < numNodes; ++i){
+				double x[3];
+				tok.read_raw(x, 3 * sizeof(double));
+				data.nodePos[first + i] = vector3(x[0], x[1], x[2]);
+				tok.set_position(tok.position() + numParams * sizeof(double));
+			}
+		}
+		else{
+			MSHNodeTagLineParser tagParser(data, first);
+			if(ParseLines(tok, numNodes, tagParser) != numNodes)
+				return false;
+
+		//	parametric coordinates at the end of a line are ignored
+			MSHNodeLineParser posParser(data, first, false);
+			if(ParseLines(tok, numNodes, posParser) != numNodes)
+				return false;
+		}
+		first += numNodes;
+	}
+
+	return first == data.nodeTags.size();
+}
+
+static bool ReadMSHElementsV4(AsciiTokenizer& tok, MSHData& data)
+{
+	uint64 header[4];	// numEntityBlocks, numElements, minElementTag, maxElementTag
+	for(int i = 0; i < 4; ++i){
+		if(data.binary){
+			if(!ReadBinary(tok, header[i]))
+				return false;
+		}
+		else{
+			size_t val;
+			if(!tok.read(val))
+				return false;
+			header[i] = val;
+		}
+	}
+
+	const size_t offset = data.elems.size();
+	data.elems.resize(offset + header[1]);
+
+	size_t first = offset;
+	vector<uint64> buf;
+	for(uint64 iblock = 0; iblock < header[0]; ++iblock){
+		int entityDim, entityTag, type;
+		uint64 numElems;
+		if(data.binary){
+			if(!(ReadBinary(tok, entityDim) && ReadBinary(tok, entityTag)
+				 && ReadBinary(tok, type) && ReadBinary(tok, numElems)))
+				return false;
+		}
+		else{
+			size_t num;
+			if(!(tok.read(entityDim) && tok.read(entityTag)
+				 && tok.read(type) && tok.read(num)))
+				return false;
+			numElems = num;
+		}
+
+		const MSHElemType* et = GetMSHElemType(type);
+		if(!et){
+			UG_LOG("ERROR in LoadGridFromMSH: element type " << type
+					<< " not supported. aborting...\n");
+			return false;
+		}
+
+		if(entityDim < 0 || entityDim > 3 || first + numElems > data.elems.size())
+			return false;
+
+		int physTag = 0;
+		map<int, int>::const_iterator iter = data.entityPhysTags[entityDim].find(entityTag);
+		if(iter != data.entityPhysTags[entityDim].end())
+			physTag = iter->second;
+
+		if(data.binary){
+			const size_t stride = 1 + et->numNodes;
+			if(tok.remaining() < numElems * stride * sizeof(uint64))
+				return false;
+			buf.resize(stride);
+			for(uint64 i = 0; i < numElems; ++i){
+				tok.read_raw(&buf.front(), stride * sizeof(uint64));
+				MSHElement& elem = data.elems[first + i];
+				elem.type = type;
+				elem.physTag = physTag;
+				for(int j = 0; j < et->numCorners; ++j)
+					elem.nodes[j] = (size_t)buf[1 + j];
+			}
+		}
+		else{
+			MSHElementLineParserV4 parser(data, first, type, physTag);
+			if(ParseLines(tok, numElems, parser) != numElems)
+				return false;
+		}
+		first += numElems;
+	}
+
+	return first == data.elems.size();
+}
+
+
+////////////////////////////////////////////////////////////////////////
+///	maps the physical groups of the elements to dense subset indices
+/**	Physical groups are identified by their dimension and tag. Groups listed
+ * in $PhysicalNames are assigned to the first subsets in the order of that
+ * section, all other groups (including elements without a group) follow in
+ * the order of their first appearance. If a file does not define physical
+ * groups, all elements are thus assigned to subset 0.*/
+static void MSHSubsetIndices(vector<int>& vSIOut, vector<string>& vNamesOut,
+							 const MSHData& data)
+{
+	typedef map<pair<int, int>, int> IndexMap;
+	IndexMap indices;
+	vNamesOut.clear();
+	for(size_t i = 0; i < data.physicalNames.size(); ++i){
+		const MSHPhysicalName& pn = data.physicalNames[i];
+		if(indices.insert(make_pair(make_pair(pn.dim, pn.tag), (int)indices.size())).second)
+			vNamesOut.push_back(pn.name);
+	}
+
+	vSIOut.resize(data.elems.size());
+	for(size_t i = 0; i < data.elems.size(); ++i){
+		const MSHElement& elem = data.elems[i];
+	//	elements without a physical group share one subset, regardless of their dimension
+		const int dim = (elem.physTag == 0) ? -1
+						: MSHElemDim(GetMSHElemType(elem.type)->roid);
+		pair<IndexMap::iterator, bool> res =
+			indices.insert(make_pair(make_pair(dim, elem.physTag), (int)indices.size()));
+		vSIOut[i] = res.first->second;
+	}
+}
+
+////////////////////////////////////////////////////////////////////////
+///	creates vertices and elements from the data read from a msh file
+static bool CreateGridFromMSHData(Grid& grid, ISubsetHandler* psh,
+								  AVector3& aPos, const MSHData& data)
+{
+	PROFILE_FUNC_GROUP("grid");
+	Grid::VertexAttachmentAccessor<APosition> aaPos(grid, aPos);
+
+//	create the vertices in one go
+	const size_t numNodes = data.nodeTags.size();
+	grid.reserve<Vertex>(grid.num<Vertex>() + numNodes);
+	vector<Vertex*> vrts(numNodes);
+	for(size_t i = 0; i < numNodes; ++i){
+		RegularVertex* vrt = *grid.create<RegularVertex>();
+		aaPos[vrt] = data.nodePos[i];
+		vrts[i] = vrt;
+	}
+
+	MSHNodeMap nodeMap(data.nodeTags, vrts);
+
+//	reserve memory for the elements
+	size_t numElemsOfDim[4] = {0, 0, 0, 0};
+	for(size_t i = 0; i < data.elems.size(); ++i)
+		++numElemsOfDim[MSHElemDim(GetMSHElemType(data.elems[i].type)->roid)];
+
+	grid.reserve<Edge>(grid.num<Edge>() + numElemsOfDim[1]);
+	grid.reserve<Face>(grid.num<Face>() + numElemsOfDim[2]);
+	grid.reserve<Volume>(grid.num<Volume>() + numElemsOfDim[3]);
+
+	vector<int> vSI;
+	vector<string> vSubsetNames;
+	MSHSubsetIndices(vSI, vSubsetNames, data);
+
+//	elements are created in the order of their dimension. This way elements
+//	which are auto-generated as sides of higher dimensional elements are
+//	found in the grid and not created twice.
+	size_t numIgnored = 0;
+	for(int dim = 0; dim < 4; ++dim){
+		if(numElemsOfDim[dim] == 0)
+			continue;
+
+		for(size_t i = 0; i < data.elems.size(); ++i){
+			const MSHElement& elem = data.elems[i];
+			const MSHElemType* et = GetMSHElemType(elem.type);
+			if(MSHElemDim(et->roid) != dim)
+				continue;
+
+			Vertex* v[8];
+			bool bValid = true;
+			for(int j = 0; j < et->numCorners; ++j){
+				v[j] = nodeMap.get(elem.nodes[j]);
+				if(!v[j])
+					bValid = false;
+			}
+
+			if(!bValid){
+				++numIgnored;
+				continue;
+			}
+
+			const int si = vSI[i];
+			switch(et->roid){
+				case ROID_VERTEX:
+					if(psh)
+						psh->assign_subset(v[0], si);
+					break;
+				case ROID_EDGE:{
+					Edge* e = *grid.create<RegularEdge>(EdgeDescriptor(v[0], v[1]));
+					if(psh)
+						psh->assign_subset(e, si);
+				}break;
+				case ROID_TRIANGLE:{
+					Face* f = *grid.create<Triangle>(TriangleDescriptor(v[0], v[1], v[2]));
+					if(psh)
+						psh->assign_subset(f, si);
+				}break;
+				case ROID_QUADRILATERAL:{
+					Face* f = *grid.create<Quadrilateral>(
+								QuadrilateralDescriptor(v[0], v[1], v[2], v[3]));
+					if(psh)
+						psh->assign_subset(f, si);
+				}break;
+				case ROID_TETRAHEDRON:{
+					Volume* vol = *grid.create<Tetrahedron>(
+								TetrahedronDescriptor(v[0], v[1], v[2], v[3]));
+					if(psh)
+						psh->assign_subset(vol, si);
+				}break;
+				case ROID_PYRAMID:{
+					Volume* vol = *grid.create<Pyramid>(
+								PyramidDescriptor(v[0], v[1], v[2], v[3], v[4]));
+					if(psh)
+						psh->assign_subset(vol, si);
+				}break;
+				case ROID_PRISM:{
+					Volume* vol = *grid.create<Prism>(
+								PrismDescriptor(v[0], v[1], v[2], v[3], v[4], v[5]));
+					if(psh)
+						psh->assign_subset(vol, si);
+				}break;
+				case ROID_HEXAHEDRON:{
+					Volume* vol = *grid.create<Hexahedron>(
+								HexahedronDescriptor(v[0], v[1], v[2], v[3],
+													 v[4], v[5], v[6], v[7]));
+					if(psh)
+						psh->assign_subset(vol, si);
+				}break;
+				default:
+					break;
+			}
+		}
+	}
+
+	if(numIgnored > 0){
+		UG_LOG("LoadGridFromMSH: bad vertex indices. " << numIgnored
+				<< " elements were ignored.\n");
+	}
+
+//	named physical groups occupy the first subsets (see MSHSubsetIndices)
+	if(psh){
+		for(size_t i = 0; i < vSubsetNames.size(); ++i)
+			psh->set_subset_name(vSubsetNames[i].c_str(), (int)i);
+	}
+
+	return true;
+}
+
+
+////////////////////////////////////////////////////////////////////////
 bool LoadGridFromMSH(Grid& grid, const char* filename,
 					 ISubsetHandler* psh, AVector3& aPos)
 {
-//	the position attachment	
+	PROFILE_FUNC_GROUP("grid");
+//	the position attachment
 	if(!grid.has_vertex_attachment(aPos))
 		grid.attach_to_vertices(aPos);
-	Grid::VertexAttachmentAccessor<APosition> aaPos(grid, aPos);
 
 //	open the file
-	ifstream in(filename);
-	if(!in){
+	MappedFile file;
+	if(!file.open(filename)){
 		UG_LOG("File not found: " << filename << "\n");
 		return false;
 	}
-//	this buffer is used to find the commands
-	string buffer;	
-	
-//	here we'll store all nodes, so that we can access them by index
-	vector<Vertex*> vrts;
-	
-//	iterate through the lines
-	while(!in.eof())
-	{
-	//	check whether any commands can be found
-		in >> buffer;
-	//	make all entries upper case
-		transform(buffer.begin(), buffer.end(), buffer.begin(), (int(*)(int)) toupper);
-		//UG_LOG(buffer);
-		
-	//	compare with known commands
-		if(buffer.find("$NODES") != string::npos){
-		//	read the nodes array
-			int numNodes;
-			in >> numNodes;
-			if(in.fail()){
-				UG_LOG("LoadGridFromMSH: bad format in $NODES - numNodes\n");
-				return false;
-			}
-			
-		//	iterate through the nodes. Create a new vertex for each
-		//	and assign the position
-			int ind;
-			vector3 p;
-			for(int i = 0; i < numNodes; ++i){
-				in >> ind >> p.x() >> p.y() >> p.z();
-				
-				if(in.fail()){
-					UG_LOG("LoadGridFromMSH: bad format in $NODES\n");
-					return false;
-				}
-				
-				RegularVertex* vrt = *grid.create<RegularVertex>();
-				aaPos[vrt] = p;
-				vrts.push_back(vrt);
+
+	AsciiTokenizer tok(file.begin(), file.end());
+	MSHData data;
+	string section;
+
+//	iterate through the sections
+	while(tok.skip_to_line_starting_with("$")){
+		tok.read_token(section);
+		transform(section.begin(), section.end(), section.begin(), (int(*)(int)) toupper);
+
+		if(section.compare(0, 4, "$END") == 0)
+			continue;
+
+		bool bSuccess = true;
+		if(section == "$MESHFORMAT"){
+			int fileType, dataSize;
+			if(!(tok.read(data.version) && tok.read(fileType) && tok.read(dataSize))){
+				UG_LOG("LoadGridFromMSH: bad format in $MESHFORMAT\n");
+				return false;
 			}
-		}
-		else if(buffer.find("$ELEMENTS") != string::npos)
-		{
-			int numVrts = (int)vrts.size();
-		//	read the number of elements
-			int numElems;
-			in >> numElems;
-			if(in.fail()){
-				UG_LOG("LoadGridFromMSH: bad format in $ELEMENTS - numElems\n");
-				return false;
-			}
-			
-		//	iterate through the entries and create the elements
-			int ind, type, numTags;
-			vector<int> tags;
-			
-			for(int i = 0; i < numElems; ++i){
-				in >> ind >> type >> numTags;
-				if(in.fail()){
-					UG_LOG("LoadGridFromMSH: bad format in $ELEMENTS\n");
+
+			data.binary = (fileType == 1);
+			if(data.version >= 4 && data.version < 4.1){
+				UG_LOG("ERROR in LoadGridFromMSH: msh format " << data.version
+						<< " is not supported. Please use version 4.1 or 2.2.\n");
+				return false;
+			}
+			if(data.binary){
+				if(data.version < 4 || dataSize != (int)sizeof(uint64)){
+					UG_LOG("ERROR in LoadGridFromMSH: binary msh files are only "
+							"supported for format 4.1 with 8 byte data-size.\n");
 					return false;
 				}
-				
-			//	read the tags (tags are ignored in the moment)
-				tags.clear();
-				for(int j = 0; j < numTags; ++j){
-					int tag;
-					in >> tag;
-					tags.push_back(tag);
-				}
-				
-				if(in.fail()){
-					UG_LOG("LoadGridFromMSH: bad tags in $ELEMENTS\n");
+			//	the binary int '1' is used to detect the endianness
+				int one = 0;
+				tok.skip_line();
+				if(!ReadBinary(tok, one) || one != 1){
+					UG_LOG("ERROR in LoadGridFromMSH: binary msh files with "
+							"foreign endianness are not supported.\n");
 					return false;
 				}
-				
-				Face* f = NULL;
-				switch(type){
-					case 2://triangles
-					{
-						int i1, i2, i3;
-						in >> i1 >> i2 >> i3;
-						if(in.fail()){
-							UG_LOG("LoadGridFromMSH: bad format in triangle\n");
-							return false;
-						}
-						
-					//	make sure that indices are fine
-						if((i1 < 0 || i1 >= numVrts) ||
-						   (i2 < 0 || i2 >= numVrts) ||
-						   (i3 < 0 || i3 >= numVrts))
-						{
-							UG_LOG("LoadGridFromMSH: bad vertex indices in triangle. ignoring triangle "
-									<< grid.num<Triangle>() << ".\n");
-							continue;
-						}
-						else{
-							f = *grid.create<Triangle>(TriangleDescriptor(vrts[i1], vrts[i2], vrts[i3]));
-						}
-						
-					}break;
-					
-					default:
-					{
-						UG_LOG("ERROR in LoadGridFromMSH: element type " << type << " not supported. aborting...\n");
-						return false;
-					}
-				}//	end of switch
-			//	assign subset index from tag
-				if(psh){
-					if(numTags < 3){
-					// since there are no tags, we'll assign all elements to subset 0
-						psh->assign_subset(f, 0);
-					}
-					else{
-					//	tag 3 holds the mesh-partition. assign the index
-						psh->assign_subset(f, tags[2]);
-					}
-				}
 			}
 		}
+		else if(section == "$PHYSICALNAMES")
+			bSuccess = ReadMSHPhysicalNames(tok, data);
+		else if(section == "$ENTITIES" && data.version >= 4){
+			if(data.binary) tok.skip_line();
+			bSuccess = ReadMSHEntitiesV4(tok, data);
+		}
+		else if(section == "$NODES"){
+			if(data.version >= 4){
+				if(data.binary) tok.skip_line();
+				bSuccess = ReadMSHNodesV4(tok, data);
+			}
+			else
+				bSuccess = ReadMSHNodesV2(tok, data);
+		}
+		else if(section == "$ELEMENTS"){
+			if(data.version >= 4){
+				if(data.binary) tok.skip_line();
+				bSuccess = ReadMSHElementsV4(tok, data);
+			}
+			else
+				bSuccess = ReadMSHElementsV2(tok, data);
+		}
+		else{
+		//	unknown or unused section. Move on to its end.
+			tok.skip_line();
+			string endTag = string("$END") + section.substr(1);
+			tok.skip_to_line_starting_with(endTag.c_str(), true);
+			continue;
+		}
+
+		if(!bSuccess){
+			UG_LOG("LoadGridFromMSH: bad format in " << section << "\n");
+			return false;
+		}
 	}
 
-//	done.
-	return true;
+	return CreateGridFromMSHData(grid, psh, aPos, data);
 }
 /*
 bool LoadGridFromTXT(Grid& grid, const char* filename, AVector3& aPos)
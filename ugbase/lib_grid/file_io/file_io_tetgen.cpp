@@ -32,6 +32,7 @@
 
 #include <fstream>
 #include "file_io_tetgen.h"
+#include "file_io_tokenizer.h"
 #include "common/util/string_util.h"
 #include "../lg_base.h"
 
@@ -281,6 +282,81 @@ bool ImportGridFromTETGEN(Grid& grid,
 	return true;
 }
 
+////////////////////////////////////////////////////////////////////////
+//	line parsers for the tetgen files
+///	parses a line of a .node file 'index x y z [attributes] [boundary marker]'
+struct TetgenNodeLineParser
+{
+	TetgenNodeLineParser(size_t numNodes, size_t numAttributes,
+						 bool readAttributes, bool hasMarker) :
+		numAttribs(numAttributes),
+		bReadAttribs(readAttributes),
+		bHasMarker(hasMarker),
+		indices(numNodes),
+		positions(numNodes),
+		attribs(readAttributes ? numNodes * numAttributes : 0),
+		markers(hasMarker ? numNodes : 0)
+	{}
+
+	bool operator()(size_t i, AsciiTokenizer& tok)
+	{
+		double x, y, z;
+		if(!(tok.read(indices[i]) && tok.read(x) && tok.read(y) && tok.read(z)))
+			return false;
+		positions[i] = vector3(x, y, z);
+
+		for(size_t j = 0; j < numAttribs; ++j){
+			float tmp;
+			if(!tok.read(tmp))
+				return false;
+			if(bReadAttribs)
+				attribs[i * numAttribs + j] = tmp;
+		}
+
+		if(bHasMarker && !tok.read(markers[i]))
+			return false;
+		return true;
+	}
+
+	size_t			numAttribs;
+	bool			bReadAttribs;
+	bool			bHasMarker;
+	vector<int>		indices;
+	vector<vector3>	positions;
+	vector<float>	attribs;
+	vector<int>		markers;
+};
+
+///	parses a line of a .face or .ele file 'index n_1 ... n_k [marker]'
+struct TetgenElemLineParser
+{
+	TetgenElemLineParser(size_t numElems, size_t nodesPerElem, bool hasMarker) :
+		numNodes(nodesPerElem),
+		bHasMarker(hasMarker),
+		nodes(numElems * nodesPerElem),
+		markers(numElems, 0)
+	{}
+
+	bool operator()(size_t i, AsciiTokenizer& tok)
+	{
+		int index;
+		if(!tok.read(index))
+			return false;
+		for(size_t j = 0; j < numNodes; ++j){
+			if(!tok.read(nodes[i * numNodes + j]))
+				return false;
+		}
+		if(bHasMarker && !tok.read(markers[i]))
+			return false;
+		return true;
+	}
+
+	size_t		numNodes;
+	bool		bHasMarker;
+	vector<int>	nodes;
+	vector<int>	markers;
+};
+
 ////////////////////////////////////////////////////////////////////////
 //	ImportGridFromTETGEN
 bool ImportGridFromTETGEN(Grid& grid,
@@ -295,21 +371,35 @@ bool ImportGridFromTETGEN(Grid& grid,
 
 	{
 		PROFILE_BEGIN(read_vertices);
-		ifstream in(nodesFilename);
-		if(!in)
+		MappedFile file;
+		if(!file.open(nodesFilename))
 		{
 			LOG("WARNING in ImportGridFromTETGEN: nodes file not found: " << nodesFilename << endl);
 			return false;
 		}
 
-		uint numNodes, dim, numAttribs, numBoundaryMarkers;
-		in >> numNodes;
-		in >> dim;
-		in >> numAttribs;
-		in >> numBoundaryMarkers;
+		AsciiTokenizer tok(file.begin(), file.end(), '#');
+		size_t numNodes, dim, numAttribs, numBoundaryMarkers;
+		if(!(tok.read(numNodes) && tok.read(dim)
+			 && tok.read(numAttribs) && tok.read(numBoundaryMarkers)))
+		{
+			LOG("WARNING in ImportGridFromTETGEN: bad header in " << nodesFilename << endl);
+			return false;
+		}
+
+	//	parse all lines first. This can be done concurrently.
+		TetgenNodeLineParser parser(numNodes, numAttribs,
+									pvNodeAttributes != NULL,
+									numBoundaryMarkers > 0);
+		size_t numParsed = ParseLines(tok, numNodes, parser, '#');
+		if(numParsed != numNodes){
+			LOG("WARNING in ImportGridFromTETGEN: bad format in " << nodesFilename
+				<< ", node " << numParsed << endl);
+			return false;
+		}
 
 		vVertices.reserve(numNodes + 1);
-		grid.reserve<Vertex>(numNodes);
+		grid.reserve<Vertex>(grid.num<Vertex>() + numNodes);
 
 	//	set up attachment accessors
 		if(!grid.has_vertex_attachment(aPos))
@@ -324,125 +414,121 @@ bool ImportGridFromTETGEN(Grid& grid,
 				vaaAttributesVRT[i].access(grid, (*pvNodeAttributes)[i]);
 		}
 
-	//	read the vertices
-		int index;
-		for(uint i = 0; i < numNodes; ++i)
+	//	create the vertices
+		for(size_t i = 0; i < numNodes; ++i)
 		{
 			RegularVertex* v = *grid.create<RegularVertex>();
 
-		//	read index and coords
-			in >> index;
+			const int index = parser.indices[i];
 			if(index > (int) vVertices.size())
 				vVertices.resize(index, NULL);
 			vVertices.push_back(v);
-			in >> aaPosVRT[v].x();
-			in >> aaPosVRT[v].y();
-			in >> aaPosVRT[v].z();
+			aaPosVRT[v] = parser.positions[i];
 
-		//	read attributes
-			if(numAttribs > 0)
-			{
-				for(uint j = 0; j < numAttribs; ++j)
-				{
-					float tmp;
-					in >> tmp;
-					if(j < vaaAttributesVRT.size())
-						(vaaAttributesVRT[j])[v] = tmp;
-				}
-			}
+			for(size_t j = 0; j < vaaAttributesVRT.size() && j < numAttribs; ++j)
+				(vaaAttributesVRT[j])[v] = parser.attribs[i * numAttribs + j];
 
-		//	read boundary marker
-			if(numBoundaryMarkers > 0)
-			{
-				int bm;
-				in >> bm;
-				if(psh != NULL)
-					psh->assign_subset(v, abs(bm));
-			}
+			if(numBoundaryMarkers > 0 && psh != NULL)
+				psh->assign_subset(v, abs(parser.markers[i]));
 		}
-
-		in.close();
 	}
 
+	const int numVrts = (int)vVertices.size();
+
 //	read faces
 	if(facesFilename != NULL)
 	{
 		PROFILE_BEGIN(read_faces);
-		ifstream in(facesFilename);
-		if(in)
+		MappedFile file;
+		if(file.open(facesFilename))
 		{
-			int numFaces, numBoundaryMarkers;
-			in >> numFaces;
-			in >> numBoundaryMarkers;
-
-			grid.reserve<Face>(numFaces);
+			AsciiTokenizer tok(file.begin(), file.end(), '#');
+			size_t numFaces, numBoundaryMarkers;
+			if(!(tok.read(numFaces) && tok.read(numBoundaryMarkers))){
+				LOG("WARNING in ImportGridFromTETGEN: bad header in " << facesFilename << endl);
+				return false;
+			}
 
-			for(int i = 0; i < numFaces; ++i)
-			{
-				int index, i1, i2, i3;
-				in >> index;
-				in >> i1;
-				in >> i2;
-				in >> i3;
+			TetgenElemLineParser parser(numFaces, 3, numBoundaryMarkers > 0);
+			size_t numParsed = ParseLines(tok, numFaces, parser, '#');
+			if(numParsed != numFaces){
+				LOG("WARNING in ImportGridFromTETGEN: bad format in " << facesFilename
+					<< ", face " << numParsed << endl);
+				return false;
+			}
 
-				Triangle* t = *grid.create<Triangle>(TriangleDescriptor(vVertices[i1], vVertices[i2], vVertices[i3]));
+			grid.reserve<Face>(grid.num<Face>() + numFaces);
 
-				if(numBoundaryMarkers > 0){
-					int bm;
-					in >> bm;
-					if(psh != NULL){
-						psh->assign_subset(t, abs(bm));
+			for(size_t i = 0; i < numFaces; ++i)
+			{
+				const int* ind = &parser.nodes[3 * i];
+				for(int j = 0; j < 3; ++j){
+					if(ind[j] < 0 || ind[j] >= numVrts || !vVertices[ind[j]]){
+						LOG("WARNING in ImportGridFromTETGEN: bad vertex index in face "
+							<< i << endl);
+						return false;
 					}
 				}
-				else if(psh != NULL){
-					psh->assign_subset(t, 0);
-				}
+
+				Triangle* t = *grid.create<Triangle>(TriangleDescriptor(
+							vVertices[ind[0]], vVertices[ind[1]], vVertices[ind[2]]));
+
+				if(psh != NULL)
+					psh->assign_subset(t, abs(parser.markers[i]));
 			}
 		}
 		else
 			LOG("WARNING in ImportGridFromTETGEN: faces file not found: " << facesFilename << endl);
-
-		in.close();
 	}
 
 //	read volumes
 	if(elemsFilename != NULL)
 	{
 		PROFILE_BEGIN(read_volumes);
-		ifstream in(elemsFilename);
-		if(in)
+		MappedFile file;
+		if(file.open(elemsFilename))
 		{
-			int numTets, numNodesPerTet, numAttribs;
-			in >> numTets;
-			in >> numNodesPerTet;
-			in >> numAttribs;
+			AsciiTokenizer tok(file.begin(), file.end(), '#');
+			size_t numTets, numNodesPerTet, numAttribs;
+			if(!(tok.read(numTets) && tok.read(numNodesPerTet) && tok.read(numAttribs))
+			   || numNodesPerTet < 4)
+			{
+				LOG("WARNING in ImportGridFromTETGEN: bad header in " << elemsFilename << endl);
+				return false;
+			}
 
-			grid.reserve<Volume>(numTets);
+		//	only the first attribute is used as subset index
+			TetgenElemLineParser parser(numTets, numNodesPerTet, numAttribs > 0);
+			size_t numParsed = ParseLines(tok, numTets, parser, '#');
+			if(numParsed != numTets){
+				LOG("WARNING in ImportGridFromTETGEN: bad format in " << elemsFilename
+					<< ", element " << numParsed << endl);
+				return false;
+			}
 
-			vector<int> vTetNodes(numNodesPerTet);
-			for(int i = 0; i < numTets; ++i)
+			grid.reserve<Volume>(grid.num<Volume>() + numTets);
+
+			for(size_t i = 0; i < numTets; ++i)
 			{
-				int index;
-				in >> index;
-				// UG_LOG("  index = " << index << std::endl);
-				for(int j = 0; j < numNodesPerTet; ++j)
-					in >> vTetNodes[j];
+				const int* ind = &parser.nodes[numNodesPerTet * i];
+				for(int j = 0; j < 4; ++j){
+					if(ind[j] < 0 || ind[j] >= numVrts || !vVertices[ind[j]]){
+						LOG("WARNING in ImportGridFromTETGEN: bad vertex index in element "
+							<< i << endl);
+						return false;
+					}
+				}
 
 				Tetrahedron* t = *grid.create<Tetrahedron>(TetrahedronDescriptor(
-											vVertices[vTetNodes[0]], vVertices[vTetNodes[1]],
-											vVertices[vTetNodes[2]], vVertices[vTetNodes[3]]));
+											vVertices[ind[0]], vVertices[ind[1]],
+											vVertices[ind[2]], vVertices[ind[3]]));
 
-				int a = 0;
-				if(numAttribs > 0)
-					in >> a;
 				if(psh != NULL)
-					psh->assign_subset(t, a);
+					psh->assign_subset(t, parser.markers[i]);
 			}
 		}
 		else
 			LOG("WARNING in ImportGridFromTETGEN: elems file not found: " << elemsFilename << endl);
-
-		in.close();
 	}
 
 	return true;
@@ -0,0 +1,461 @@
+/*
+ * Copyright (c) 2017:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+
+#include <cstdio>
+#include <cstdlib>
+#include <cctype>
+#include "file_io_tokenizer.h"
+
+#ifdef UG_POSIX
+	#include <sys/types.h>
+	#include <sys/stat.h>
+	#include <sys/mman.h>
+	#include <fcntl.h>
+	#include <unistd.h>
+#endif
+
+using namespace std;
+
+namespace ug
+{
+
+////////////////////////////////////////////////////////////////////////
+//	MappedFile
+MappedFile::MappedFile() :
+	m_data(NULL),
+	m_size(0),
+	m_bOpen(false),
+	m_bMapped(false)
+{
+}
+
+MappedFile::~MappedFile()
+{
+	close();
+}
+
+bool MappedFile::open(const char* filename)
+{
+	close();
+
+#ifdef UG_POSIX
+	int fd = ::open(filename, O_RDONLY);
+	if(fd < 0)
+		return false;
+
+	struct stat st;
+	if(fstat(fd, &st) != 0){
+		::close(fd);
+		return false;
+	}
+
+	m_size = (size_t)st.st_size;
+	if(m_size > 0){
+		void* data = mmap(NULL, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+		if(data != MAP_FAILED){
+		//	the readers traverse the file front to back
+			madvise(data, m_size, MADV_SEQUENTIAL);
+			m_data = static_cast<const char*>(data);
+			m_bMapped = true;
+		}
+	}
+	::close(fd);
+
+	if(m_bMapped || m_size == 0){
+		m_bOpen = true;
+		return true;
+	}
+//	mapping failed (e.g. special files). Fall back to reading.
+	m_size = 0;
+#endif
+
+	FILE* file = fopen(filename, "rb");
+	if(!file)
+		return false;
+
+	fseek(file, 0, SEEK_END);
+	long fileSize = ftell(file);
+	fseek(file, 0, SEEK_SET);
+	if(fileSize < 0){
+		fclose(file);
+		return false;
+	}
+
+	m_buffer.resize((size_t)fileSize);
+	if(fileSize > 0
+		&& fread(&m_buffer.front(), 1, m_buffer.size(), file) != m_buffer.size())
+	{
+		fclose(file);
+		m_buffer.clear();
+		return false;
+	}
+	fclose(file);
+
+	m_size = m_buffer.size();
+	m_data = m_size > 0 ? &m_buffer.front() : NULL;
+	m_bOpen = true;
+	return true;
+}
+
+void MappedFile::close()
+{
+#ifdef UG_POSIX
+	if(m_bMapped)
+		munmap(const_cast<char*>(m_data), m_size);
+#endif
+	m_buffer.clear();
+	m_data = NULL;
+	m_size = 0;
+	m_bOpen = false;
+	m_bMapped = false;
+}
+
+
+////////////////////////////////////////////////////////////////////////
+//	number parsing
+static inline bool IsSpace(char c)
+{
+	return c == ' ' || c == '\n' || c == '\r' || c == '\t' || c == '\v' || c == '\f';
+}
+
+static inline bool IsDigit(char c)
+{
+	return c >= '0' && c <= '9';
+}
+
+bool ParseInteger(const char*& p, const char* end, long& valOut)
+{
+	const char* c = p;
+	while(c != end && IsSpace(*c))
+		++c;
+
+	bool negative = false;
+	if(c != end && (*c == '-' || *c == '+')){
+		negative = (*c == '-');
+		++c;
+	}
+
+	if(c == end || !IsDigit(*c))
+		return false;
+
+	unsigned long val = 0;
+	while(c != end && IsDigit(*c)){
+		val = val * 10 + (unsigned long)(*c - '0');
+		++c;
+	}
+
+	valOut = negative ? -(long)val : (long)val;
+	p = c;
+	return true;
+}
+
+///	converts the token starting at p with strtod.
+static bool ParseNumberFallback(const char*& p, const char* end, double& valOut)
+{
+	const int maxLen = 128;
+	char buf[maxLen];
+	int len = 0;
+	while(p + len != end && len < maxLen - 1 && !IsSpace(p[len])){
+		buf[len] = p[len];
+		++len;
+	}
+	buf[len] = 0;
+
+	char* numEnd = NULL;
+	valOut = strtod(buf, &numEnd);
+	if(numEnd == buf)
+		return false;
+	p += (numEnd - buf);
+	return true;
+}
+
+bool ParseNumber(const char*& p, const char* end, double& valOut)
+{
+//	powers of ten which are exactly representable as double
+	static const double s_pow10[] = {
+		1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+		1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+	while(p != end && IsSpace(*p))
+		++p;
+
+	const char* c = p;
+	bool negative = false;
+	if(c != end && (*c == '-' || *c == '+')){
+		negative = (*c == '-');
+		++c;
+	}
+
+//	mantissa. Leading zeros are not counted as significant digits.
+	unsigned long long mantissa = 0;
+	int numSigDigits = 0;
+	int exp10 = 0;
+	bool gotDigits = false;
+
+	while(c != end && IsDigit(*c)){
+		gotDigits = true;
+		if(numSigDigits < 19){
+			mantissa = mantissa * 10 + (unsigned long long)(*c - '0');
+			if(mantissa) ++numSigDigits;
+		}
+		else
+			++exp10;
+		++c;
+	}
+
+	if(c != end && *c == '.'){
+		++c;
+		while(c != end && IsDigit(*c)){
+			gotDigits = true;
+			if(numSigDigits < 19){
+				mantissa = mantissa * 10 + (unsigned long long)(*c - '0');
+				if(mantissa) ++numSigDigits;
+				--exp10;
+			}
+			++c;
+		}
+	}
+
+	if(!gotDigits)
+		return ParseNumberFallback(p, end, valOut);
+
+	if(c != end && (*c == 'e' || *c == 'E')){
+		const char* expStart = c;
+		++c;
+		bool negExp = false;
+		if(c != end && (*c == '-' || *c == '+')){
+			negExp = (*c == '-');
+			++c;
+		}
+		if(c == end || !IsDigit(*c)){
+		//	not an exponent. Leave the 'e' untouched.
+			c = expStart;
+		}
+		else{
+			int e = 0;
+			while(c != end && IsDigit(*c)){
+				if(e < 100000)
+					e = e * 10 + (*c - '0');
+				++c;
+			}
+			exp10 += negExp ? -e : e;
+		}
+	}
+
+	if(mantissa == 0){
+		valOut = negative ? -0.0 : 0.0;
+		p = c;
+		return true;
+	}
+
+//	fast path: mantissa and power of ten are exact, so that a single
+//	multiplication or division yields the correctly rounded result.
+	if(numSigDigits <= 15 && exp10 >= -22 && exp10 <= 22){
+		double val = (double)mantissa;
+		if(exp10 < 0)	val /= s_pow10[-exp10];
+		else			val *= s_pow10[exp10];
+		valOut = negative ? -val : val;
+		p = c;
+		return true;
+	}
+
+	return ParseNumberFallback(p, end, valOut);
+}
+
+
+////////////////////////////////////////////////////////////////////////
+//	FindLineStarts
+const char* FindLineStarts(std::vector<const char*>& lineStartsOut,
+						   const char* begin, const char* end,
+						   size_t numLines, char commentChar)
+{
+	const char* p = begin;
+	size_t numFound = 0;
+	while(numFound < numLines && p != end){
+	//	skip leading whitespace of the line
+		const char* lineStart = p;
+		while(p != end && (*p == ' ' || *p == '\t' || *p == '\r'))
+			++p;
+
+		const char* lineEnd = static_cast<const char*>(
+								memchr(p, '\n', (size_t)(end - p)));
+		if(!lineEnd)
+			lineEnd = end;
+
+		if(p != lineEnd && !(commentChar != 0 && *p == commentChar)){
+			lineStartsOut.push_back(lineStart);
+			++numFound;
+		}
+
+		p = (lineEnd == end) ? end : lineEnd + 1;
+	}
+
+	if(numFound < numLines)
+		return NULL;
+	return p;
+}
+
+
+////////////////////////////////////////////////////////////////////////
+//	AsciiTokenizer
+bool AsciiTokenizer::skip_whitespace()
+{
+	while(m_p != m_end){
+		if(IsSpace(*m_p))
+			++m_p;
+		else if(m_commentChar != 0 && *m_p == m_commentChar)
+			skip_line();
+		else
+			return true;
+	}
+	return false;
+}
+
+void AsciiTokenizer::skip_line()
+{
+	const char* lineEnd = static_cast<const char*>(
+							memchr(m_p, '\n', (size_t)(m_end - m_p)));
+	m_p = lineEnd ? lineEnd + 1 : m_end;
+}
+
+bool AsciiTokenizer::
+skip_to_line_starting_with(const char* str, bool bIgnoreCase)
+{
+	const size_t len = strlen(str);
+	while(m_p != m_end){
+		const char* p = m_p;
+		while(p != m_end && (*p == ' ' || *p == '\t'))
+			++p;
+
+		if((size_t)(m_end - p) >= len){
+			bool match;
+			if(bIgnoreCase){
+				match = true;
+				for(size_t i = 0; i < len; ++i){
+					if(toupper((unsigned char)p[i]) != toupper((unsigned char)str[i])){
+						match = false;
+						break;
+					}
+				}
+			}
+			else
+				match = (strncmp(p, str, len) == 0);
+
+			if(match){
+				m_p = p;
+				return true;
+			}
+		}
+		skip_line();
+	}
+	return false;
+}
+
+bool AsciiTokenizer::read(int& valOut)
+{
+	long val;
+	if(!read(val))
+		return false;
+	valOut = (int)val;
+	return true;
+}
+
+bool AsciiTokenizer::read(long& valOut)
+{
+	if(!skip_whitespace())
+		return false;
+	return ParseInteger(m_p, m_end, valOut);
+}
+
+bool AsciiTokenizer::read(size_t& valOut)
+{
+	long val;
+	if(!read(val) || val < 0)
+		return false;
+	valOut = (size_t)val;
+	return true;
+}
+
+bool AsciiTokenizer::read(double& valOut)
+{
+	if(!skip_whitespace())
+		return false;
+	return ParseNumber(m_p, m_end, valOut);
+}
+
+bool AsciiTokenizer::read(float& valOut)
+{
+	double val;
+	if(!read(val))
+		return false;
+	valOut = (float)val;
+	return true;
+}
+
+bool AsciiTokenizer::read_token(std::string& tokOut)
+{
+	if(!skip_whitespace())
+		return false;
+	const char* tokStart = m_p;
+	while(m_p != m_end && !IsSpace(*m_p))
+		++m_p;
+	tokOut.assign(tokStart, m_p);
+	return true;
+}
+
+bool AsciiTokenizer::read_string(std::string& strOut)
+{
+	if(!skip_whitespace())
+		return false;
+	if(*m_p != '"')
+		return read_token(strOut);
+
+	const char* strStart = ++m_p;
+	while(m_p != m_end && *m_p != '"' && *m_p != '\n')
+		++m_p;
+	strOut.assign(strStart, m_p);
+	if(m_p == m_end || *m_p != '"')
+		return false;
+	++m_p;
+	return true;
+}
+
+bool AsciiTokenizer::read_raw(void* dest, size_t numBytes)
+{
+	if(remaining() < numBytes)
+		return false;
+	memcpy(dest, m_p, numBytes);
+	m_p += numBytes;
+	return true;
+}
+
+}//	end of namespace
@@ -0,0 +1,209 @@
+/*
+ * Copyright (c) 2017:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+
+#ifndef __H__LIB_GRID__FILE_IO_TOKENIZER__
+#define __H__LIB_GRID__FILE_IO_TOKENIZER__
+
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace ug
+{
+
+////////////////////////////////////////////////////////////////////////
+///	Read-only view on the complete content of a file.
+/**	On POSIX systems the file is memory-mapped, so that even very large
+ * files are not copied into the heap. On other systems the file is read
+ * with one single call into an internal buffer.
+ * Note that the content is not null-terminated. Always use end() or size()
+ * to find the end of the data.*/
+class MappedFile
+{
+	public:
+		MappedFile();
+		~MappedFile();
+
+	///	maps the given file. Returns false if the file could not be opened.
+		bool open(const char* filename);
+
+	///	releases the mapping
+		void close();
+
+		bool is_open() const		{return m_bOpen;}
+		const char* begin() const	{return m_data;}
+		const char* end() const		{return m_data + m_size;}
+		size_t size() const			{return m_size;}
+
+	private:
+	//	copying is not allowed
+		MappedFile(const MappedFile&);
+		MappedFile& operator=(const MappedFile&);
+
+		const char*			m_data;
+		size_t				m_size;
+		bool				m_bOpen;
+		bool				m_bMapped;
+		std::vector<char>	m_buffer;
+};
+
+
+////////////////////////////////////////////////////////////////////////
+///	parses an integer from [p, end). Leading whitespace is skipped.
+/**	On success p points behind the parsed number and true is returned.*/
+bool ParseInteger(const char*& p, const char* end, long& valOut);
+
+///	parses a floating point number from [p, end). Leading whitespace is skipped.
+/**	Numbers with at most 15 significant digits and a small exponent are
+ * converted directly (the result is correctly rounded). All other numbers
+ * (and inf / nan) are handed to strtod.
+ * On success p points behind the parsed number and true is returned.*/
+bool ParseNumber(const char*& p, const char* end, double& valOut);
+
+///	collects the starts of the next numLines lines in [begin, end)
+/**	Empty lines and lines whose first non-whitespace character equals
+ * commentChar (if commentChar != 0) are skipped.
+ * The starts of the found lines are appended to lineStartsOut.
+ * Returns the position behind the last found line or NULL if less than
+ * numLines lines were found.
+ *
+ * The collected line starts can be used to parse the lines of large
+ * sections concurrently.*/
+const char* FindLineStarts(std::vector<const char*>& lineStartsOut,
+						   const char* begin, const char* end,
+						   size_t numLines, char commentChar = 0);
+
+
+////////////////////////////////////////////////////////////////////////
+///	A lightweight tokenizer on a character range
+/**	The tokenizer doesn't copy any data. It is meant to replace
+ * std::istream based parsing in file readers, where the overhead of
+ * the stream operators dominates the runtime for large files.
+ *
+ * All read methods skip leading whitespace (and comments, if a comment
+ * character was specified) and return false if no valid token could be
+ * read. A comment reaches from the comment character to the end of the line.*/
+class AsciiTokenizer
+{
+	public:
+		AsciiTokenizer(const char* begin, const char* end, char commentChar = 0) :
+			m_p(begin), m_end(end), m_commentChar(commentChar)	{}
+
+	///	skips whitespace and comments. Returns false if the end was reached.
+		bool skip_whitespace();
+
+	///	returns true if only whitespace and comments are left
+		bool eof()					{return !skip_whitespace();}
+
+	///	moves behind the next line break
+		void skip_line();
+
+	///	moves to the beginning of the next line that starts with the given string
+	/**	If no such line exists, the tokenizer is moved to the end and false
+	 * is returned. Leading whitespace of a line is ignored. If
+	 * bIgnoreCase is true, the comparison is performed case-insensitive.*/
+		bool skip_to_line_starting_with(const char* str, bool bIgnoreCase = false);
+
+		bool read(int& valOut);
+		bool read(long& valOut);
+		bool read(size_t& valOut);
+		bool read(double& valOut);
+		bool read(float& valOut);
+
+	///	reads a whitespace separated token
+		bool read_token(std::string& tokOut);
+
+	///	reads a string which may be enclosed in double quotes
+		bool read_string(std::string& strOut);
+
+	///	copies numBytes raw bytes starting at the current position
+	/**	No whitespace is skipped. Used for binary sections.*/
+		bool read_raw(void* dest, size_t numBytes);
+
+		const char* position() const	{return m_p;}
+		void set_position(const char* p)	{m_p = p;}
+		const char* end() const			{return m_end;}
+		size_t remaining() const		{return (size_t)(m_end - m_p);}
+
+	private:
+		const char*	m_p;
+		const char*	m_end;
+		char		m_commentChar;
+};
+
+
+////////////////////////////////////////////////////////////////////////
+///	calls lineParser(i, lineTok) for each of the next numLines lines of tok
+/**	The line starts are collected first (see FindLineStarts). The lines
+ * themselves are then parsed concurrently if UG_OPENMP is defined.
+ * lineParser thus has to be safe to be called concurrently for different
+ * lines and it must not throw. Each call receives a tokenizer which starts
+ * at the beginning of line i. lineParser should return false if the line
+ * could not be parsed.
+ *
+ * On success tok is moved behind the parsed lines and numLines is returned.
+ * Otherwise the index of the first line which couldn't be found or parsed
+ * is returned and tok is left untouched.*/
+template <class TLineParser>
+size_t ParseLines(AsciiTokenizer& tok, size_t numLines, TLineParser& lineParser,
+				  char commentChar = 0)
+{
+	std::vector<const char*> lineStarts;
+	lineStarts.reserve(numLines);
+	const char* sectionEnd = FindLineStarts(lineStarts, tok.position(), tok.end(),
+											numLines, commentChar);
+	if(!sectionEnd)
+		return lineStarts.size();
+
+	const long num = (long)numLines;
+	long firstBad = num;
+
+#ifdef UG_OPENMP
+	#pragma omp parallel for schedule(static) reduction(min:firstBad)
+#endif
+	for(long i = 0; i < num; ++i){
+		AsciiTokenizer lineTok(lineStarts[i], sectionEnd, commentChar);
+		if(!lineParser((size_t)i, lineTok) && i < firstBad)
+			firstBad = i;
+	}
+
+	if(firstBad < num)
+		return (size_t)firstBad;
+
+	tok.set_position(sectionEnd);
+	return numLines;
+}
+
+}//	end of namespace
+
+#endif
@@ -37,6 +37,7 @@
 #include "common/common.h"
 #include "lib_grid/attachments/attached_list.h"
 #include "lib_grid/tools/periodic_boundary_manager.h"
+#include "lib_grid/tools/scoped_marker.h"
 
 #ifdef UG_PARALLEL
 #include "lib_grid/parallelization/distributed_grid.h"
@@ -61,8 +62,10 @@ Grid::Grid() :
 	m_bMarking(false),
 	m_aMark("Grid_Mark", false),
 	m_distGridMgr(NULL),
-	m_periodicBndMgr(NULL)
+	m_periodicBndMgr(NULL),
+	m_markerPool(NULL)
 {
+	m_markerPool = new MarkerPool(*this);
 	m_hashCounter = 0;
 	m_currentMark = 0;
 	m_options = GRIDOPT_NONE;
@@ -79,8 +82,10 @@ Grid::Grid(uint options) :
 	m_bMarking(false),
 	m_aMark("Grid_Mark", false),
 	m_distGridMgr(NULL),
-	m_periodicBndMgr(NULL)
+	m_periodicBndMgr(NULL),
+	m_markerPool(NULL)
 {
+	m_markerPool = new MarkerPool(*this);
 	m_hashCounter = 0;
 	m_currentMark = 0;
 	m_options = GRIDOPT_NONE;
@@ -97,8 +102,10 @@ Grid::Grid(const Grid& grid) :
 	m_bMarking(false),
 	m_aMark("Grid_Mark", false),
 	m_distGridMgr(NULL),
-	m_periodicBndMgr(NULL)
+	m_periodicBndMgr(NULL),
+	m_markerPool(NULL)
 {
+	m_markerPool = new MarkerPool(*this);
 	m_hashCounter = 0;
 	m_currentMark = 0;
 	m_options = GRIDOPT_NONE;
@@ -123,6 +130,7 @@ Grid::~Grid()
 	#endif
 
 	if(m_periodicBndMgr)		delete m_periodicBndMgr;
+	if(m_markerPool)			delete m_markerPool;
 }
 
 void Grid::notify_and_clear_observers_on_grid_destruction(GridObserver* initiator)
@@ -1287,6 +1295,11 @@ void Grid::end_marking()
 	m_bMarking = false;
 }
 
+MarkerPool& Grid::marker_pool()
+{
+	return *m_markerPool;
+}
+
 void Grid::clear_marks()
 {
 	if(m_bMarking){
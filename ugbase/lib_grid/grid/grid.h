@@ -72,6 +72,10 @@ class DistributedGridManager;
 //	"lib_grid/tools/periodic_boundary_identifier.h"
 class PeriodicBoundaryManager;
 
+//	predeclaration of the pool of mark buffers used by ScopedMarker. If you want
+//	to use it, you have to include "lib_grid/tools/scoped_marker.h"
+class MarkerPool;
+
 /**
  * \brief Grid, MultiGrid and GridObjectCollection are contained in this group
  * \defgroup lib_grid_grid grid
@@ -940,6 +944,13 @@ class UG_API Grid
 
 	///	ends a marking sequence. Call this method when you're done with marking.
 		void end_marking();
+
+	///	returns the pool of mark buffers used by ScopedMarker.
+	/**	The pool is created together with the grid. In contrast to begin_marking
+	 * and end_marking, marking through ScopedMarker is reentrant and may be used
+	 * by several threads at once.
+	 * You have to include "lib_grid/tools/scoped_marker.h" to use it.*/
+		MarkerPool& marker_pool();
 		
 	///	gives access to the grid's message-hub
 		SPMessageHub message_hub()		{return m_messageHub;}
@@ -1198,6 +1209,7 @@ class UG_API Grid
 		SPMessageHub 							m_messageHub;
 		DistributedGridManager*		m_distGridMgr;
 		PeriodicBoundaryManager*	m_periodicBndMgr;
+		MarkerPool*					m_markerPool;
 };
 
 /** \} */
@@ -56,6 +56,7 @@
 #include "grid_util.h"
 #include "common/common.h"
 #include "common/profiler/profiler.h"
+#include "lib_grid/tools/scoped_marker.h"
 
 using namespace std;
 
@@ -100,6 +101,7 @@ void Grid::register_vertex(Vertex* v, GridObject* pParent)
 
 //	store the element and register it at the pipe.
 	m_vertexElementStorage.m_attachmentPipe.register_element(v);
+	m_markerPool->element_registered(VERTEX, v->grid_data_index());
 	m_vertexElementStorage.m_sectionContainer.insert(v, v->container_section());
 
 //	assign the hash-value
@@ -114,6 +116,7 @@ void Grid::register_vertex(Vertex* v, GridObject* pParent)
 void Grid::register_and_replace_element(Vertex* v, Vertex* pReplaceMe)
 {
 	m_vertexElementStorage.m_attachmentPipe.register_element(v);
+	m_markerPool->element_registered(VERTEX, v->grid_data_index());
 	m_vertexElementStorage.m_sectionContainer.insert(v, v->container_section());
 
 //	assign the hash-value
@@ -482,6 +485,7 @@ void Grid::register_edge(Edge* e, GridObject* pParent,
 
 //	store the element and register it at the pipe.
 	m_edgeElementStorage.m_attachmentPipe.register_element(e);
+	m_markerPool->element_registered(EDGE, e->grid_data_index());
 	m_edgeElementStorage.m_sectionContainer.insert(e, e->container_section());
 
 //	register edge at vertices, faces and volumes, if the according options are enabled.
@@ -609,6 +613,7 @@ void Grid::register_and_replace_element(Edge* e, Edge* pReplaceMe)
 {
 //	store the element and register it at the pipe.
 	m_edgeElementStorage.m_attachmentPipe.register_element(e);
+	m_markerPool->element_registered(EDGE, e->grid_data_index());
 	m_edgeElementStorage.m_sectionContainer.insert(e, e->container_section());
 
 	pass_on_values(pReplaceMe, e);
@@ -925,6 +930,7 @@ void Grid::register_face(Face* f, GridObject* pParent, Volume* createdByVol)
 
 //	store the element and register it at the pipe.
 	m_faceElementStorage.m_attachmentPipe.register_element(f);
+	m_markerPool->element_registered(FACE, f->grid_data_index());
 	m_faceElementStorage.m_sectionContainer.insert(f, f->container_section());
 
 //	register face at vertices
@@ -1054,6 +1060,7 @@ void Grid::register_and_replace_element(Face* f, Face* pReplaceMe)
 
 //	store the element and register it at the pipe.
 	m_faceElementStorage.m_attachmentPipe.register_element(f);
+	m_markerPool->element_registered(FACE, f->grid_data_index());
 	m_faceElementStorage.m_sectionContainer.insert(f, f->container_section());
 
 	pass_on_values(pReplaceMe, f);
@@ -1443,6 +1450,7 @@ void Grid::register_volume(Volume* v, GridObject* pParent)
 
 //	store the element and register it at the pipe.
 	m_volumeElementStorage.m_attachmentPipe.register_element(v);
+	m_markerPool->element_registered(VOLUME, v->grid_data_index());
 	m_volumeElementStorage.m_sectionContainer.insert(v, v->container_section());
 
 //	create edges and faces if the according options are enabled.
@@ -1586,6 +1594,7 @@ void Grid::register_and_replace_element(Volume* v, Volume* pReplaceMe)
 
 //	store the element and register it at the pipe.
 	m_volumeElementStorage.m_attachmentPipe.register_element(v);
+	m_markerPool->element_registered(VOLUME, v->grid_data_index());
 	m_volumeElementStorage.m_sectionContainer.insert(v, v->container_section());
 
 	pass_on_values(pReplaceMe, v);
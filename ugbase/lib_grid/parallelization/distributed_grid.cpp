@@ -139,6 +139,12 @@ void DistributedGridManager::free_grid_data()
 
 //	clear the layout-map
 	m_gridLayoutMap = GridLayoutMap();
+
+//	clear the status log
+	m_statusLogVrts.clear();
+	m_statusLogEdges.clear();
+	m_statusLogFaces.clear();
+	m_statusLogVols.clear();
 }
 
 void DistributedGridManager::
@@ -283,7 +289,10 @@ void DistributedGridManager::grid_layouts_changed(bool addedElemsOnly)
 //	I thus disabled it here.
 	//if(!addedElemsOnly)
 	{
-	//	first we have to reset all elem infos
+	//	first we have to reset all elem infos. Only logged elements hold infos,
+	//	so that this is cheap if only a small part of the grid is distributed.
+	//	Note that the infos are then rebuilt from the complete layout map below.
+	//	Changes are not patched incrementally.
 		reset_elem_infos<Vertex>();
 		reset_elem_infos<Edge>();
 		reset_elem_infos<Face>();
@@ -300,6 +309,12 @@ void DistributedGridManager::grid_layouts_changed(bool addedElemsOnly)
 
 //	update ghost states
 	//update_ghost_states();
+
+	#ifdef UG_DEBUG
+		UG_COND_THROW(!check_elem_infos(),
+					  "DistributedGridManager: Element infos are inconsistent "
+					  "with the grid layout map after grid_layouts_changed.");
+	#endif
 }
 
 ////////////////////////////////////////////////////////////////////////
@@ -323,12 +338,143 @@ void DistributedGridManager::update_all_elem_infos()
 template <class TGeomObj>
 void DistributedGridManager::reset_elem_infos()
 {
+	std::vector<TGeomObj*>& log = status_log((TGeomObj*)NULL);
+	for(size_t i = 0; i < log.size(); ++i)
+		elem_info(log[i]).reset();
+	log.clear();
+}
+
+////////////////////////////////////////////////////////////////////////
+template <class TElem>
+void DistributedGridManager::log_elem_info(TElem* elem)
+{
+	ElementInfo<TElem>& info = elem_info(elem);
+	if(info.has_data() && (info.log_index() == ElementInfo<TElem>::NO_LOG_ENTRY)){
+		std::vector<TElem*>& log = status_log(elem);
+		info.set_log_index(log.size());
+		log.push_back(elem);
+	}
+}
+
+template <class TElem>
+void DistributedGridManager::unlog_elem_info(TElem* elem)
+{
+	ElementInfo<TElem>& info = elem_info(elem);
+	const size_t ind = info.log_index();
+	if(ind == ElementInfo<TElem>::NO_LOG_ENTRY)
+		return;
+
+//	move the last entry to the free position
+	std::vector<TElem*>& log = status_log(elem);
+	UG_ASSERT(ind < log.size() && log[ind] == elem, "Corrupt status log.");
+	TElem* last = log.back();
+	log[ind] = last;
+	elem_info(last).set_log_index(ind);
+	log.pop_back();
+	info.set_log_index(ElementInfo<TElem>::NO_LOG_ENTRY);
+}
+
+////////////////////////////////////////////////////////////////////////
+bool DistributedGridManager::check_elem_infos(bool verbose)
+{
+	bool isValid = true;
+	isValid &= check_elem_infos<Vertex>(verbose);
+	isValid &= check_elem_infos<Edge>(verbose);
+	isValid &= check_elem_infos<Face>(verbose);
+	isValid &= check_elem_infos<Volume>(verbose);
+	return isValid;
+}
+
+template <class TGeomObj>
+bool DistributedGridManager::check_elem_infos(bool verbose)
+{
+	typedef ElementInfo<TGeomObj> ElemInfo;
+	typedef typename GridLayoutMap::Types<TGeomObj>::Layout Layout;
+
+	if(!m_pGrid)
+		return true;
+
+	bool isValid = true;
+	std::vector<TGeomObj*>& log = status_log((TGeomObj*)NULL);
+
+//	the log has to be consistent with the positions stored in the infos
+	for(size_t i = 0; i < log.size(); ++i){
+		if(elem_info(log[i]).log_index() != i){
+			if(verbose){UG_LOG("  Status log entry " << i << " does not match "
+								"the position stored in the element info.\n");}
+			isValid = false;
+		}
+	}
+
+//	each element which holds an info has to be logged
 	for(typename geometry_traits<TGeomObj>::iterator
-		iter = m_pGrid->begin<TGeomObj>();
-		iter != m_pGrid->end<TGeomObj>(); ++iter)
+		iter = m_pGrid->begin<TGeomObj>(); iter != m_pGrid->end<TGeomObj>(); ++iter)
 	{
-		elem_info(*iter).reset();
+		ElemInfo& info = elem_info(*iter);
+		if(info.has_data() && (info.log_index() >= log.size()
+							   || log[info.log_index()] != *iter))
+		{
+			if(verbose){UG_LOG("  Element with info is not logged. Status: "
+								<< (int)info.get_status() << "\n");}
+			isValid = false;
+		}
+	}
+
+//	each interface element has to reference the interface
+	const int intfcTypes[] = {INT_H_MASTER, INT_H_SLAVE, INT_V_MASTER, INT_V_SLAVE};
+	for(size_t i_type = 0; i_type < 4; ++i_type){
+		const int nodeType = intfcTypes[i_type];
+		if(!m_gridLayoutMap.has_layout<TGeomObj>(nodeType))
+			continue;
+
+		Layout& layout = m_gridLayoutMap.get_layout<TGeomObj>(nodeType);
+		for(size_t l = 0; l < layout.num_levels(); ++l){
+			for(typename Layout::iterator iiter = layout.begin(l);
+				iiter != layout.end(l); ++iiter)
+			{
+				typename Layout::Interface& interface = layout.interface(iiter);
+				for(typename Layout::Interface::iterator iter = interface.begin();
+					iter != interface.end(); ++iter)
+				{
+					TGeomObj* e = interface.get_element(iter);
+					ElemInfo& info = elem_info(e);
+					if(!(info.get_status() & nodeType)){
+						if(verbose){UG_LOG("  Status " << (int)info.get_status()
+							<< " of interface element does not contain interface type "
+							<< nodeType << " (target proc " << interface.get_target_proc()
+							<< ", level " << l << ").\n");}
+						isValid = false;
+					}
+					if(!info.is_interface_element()
+					   || info.find_entry(&interface) == info.entries_end())
+					{
+						if(verbose){UG_LOG("  Interface element does not reference its "
+							"interface (type " << nodeType << ", target proc "
+							<< interface.get_target_proc() << ", level " << l << ").\n");}
+						isValid = false;
+					}
+				}
+			}
+		}
+	}
+
+//	all entries of logged elements have to reference the element
+	for(size_t i = 0; i < log.size(); ++i){
+		ElemInfo& info = elem_info(log[i]);
+		if(!info.is_interface_element())
+			continue;
+		for(typename ElemInfo::EntryIterator iter = info.entries_begin();
+			iter != info.entries_end(); ++iter)
+		{
+			if(iter->m_interface->get_element(iter->m_interfaceElemIter) != log[i]){
+				if(verbose){UG_LOG("  Interface entry of element points to a "
+									"different element.\n");}
+				isValid = false;
+			}
+		}
 	}
+
+	return isValid;
 }
 
 ////////////////////////////////////////////////////////////////////////
@@ -365,6 +511,7 @@ update_elem_info(TLayoutMap& layoutMap, int nodeType, byte newStatus, bool addSt
 				//	add the iterator to the iterator list and set the proc-id
 					//if(newStatus & ES_IN_INTERFACE)
 					elem_info(interface.get_element(iter)).add_entry(&interface, iter, nodeType);
+					log_elem_info(interface.get_element(iter));
 				/*
 					elem_info(*iter).lstProcIterPairs.push_back(
 								typename ElementInfo<TGeomObj>(procID, iter));
@@ -467,6 +614,7 @@ add_element_to_interface(TElem* pElem, int procID)
 	
 //	add the interface-entry to the info
 	elem_info(pElem).add_entry(interface, iter, intfcType);
+	log_elem_info(pElem);
 }
 		
 template <class TScheduledElemMap>
@@ -561,6 +709,7 @@ schedule_element_for_insertion(TScheduledElemMap& elemMap,
 			UG_ASSERT(parentInfo.get_status() & (ES_H_SLAVE), "interface-elements have to be either master or slave!");
 			elem_info(elem).set_status(ES_H_SLAVE | ES_SCHEDULED_FOR_INTERFACE);
 		}
+		log_elem_info(elem);
 	}
 }
 
@@ -581,6 +730,10 @@ handle_created_element(TElem* pElem, GridObject* pParent,
 			ElementInfo<TElem>& elemInfo = elem_info(pElem);
 			elemInfo = elem_info(parent);
 
+		//	the new element takes the place of the parent in the status log
+			if(elemInfo.log_index() != ElementInfo<TElem>::NO_LOG_ENTRY)
+				status_log(pElem)[elemInfo.log_index()] = pElem;
+
 			if(elemInfo.is_interface_element()){
 			//	update all pointers
 				for(typename ElementInfo<TElem>::EntryIterator iter = elemInfo.entries_begin();
@@ -609,7 +762,9 @@ handle_created_element(TElem* pElem, GridObject* pParent,
 		}
 	}
 
-	elem_info(pElem).set_status(ES_NONE);
+//	the info of a new element is empty. Note that reset also releases data
+//	which may have been left in a reused attachment entry.
+	elem_info(pElem).reset();
 	
 	if(!m_interfaceManagementEnabled)
 		return;
@@ -1101,6 +1256,7 @@ create_missing_constrained_h_interfaces(vector<TElem*>& newConstrainedElems)
 					if(!hInterfaceExists){
 						scheduledElems.insert(make_pair(hmasterOrder, ScheduledElement(e, tp)));
 						elem_info(e).set_status(get_status(e) | ES_H_MASTER | ES_SCHEDULED_FOR_INTERFACE);
+						log_elem_info(e);
 					}
 				}
 			}
@@ -1123,6 +1279,7 @@ create_missing_constrained_h_interfaces(vector<TElem*>& newConstrainedElems)
 					if(!hInterfaceExists){
 						scheduledElems.insert(make_pair(hmasterOrder, ScheduledElement(e, om)));
 						elem_info(e).set_status(get_status(e) | ES_H_MASTER | ES_SCHEDULED_FOR_INTERFACE);
+						log_elem_info(e);
 					}
 				}
 
@@ -1141,6 +1298,7 @@ create_missing_constrained_h_interfaces(vector<TElem*>& newConstrainedElems)
 					if(!hInterfaceExists){
 						scheduledElems.insert(make_pair(hmasterOrder, ScheduledElement(e, tp)));
 						elem_info(e).set_status(get_status(e) | ES_H_MASTER | ES_SCHEDULED_FOR_INTERFACE);
+						log_elem_info(e);
 					}
 				}
 			}
@@ -1163,6 +1321,7 @@ create_missing_constrained_h_interfaces(vector<TElem*>& newConstrainedElems)
 			if(!hInterfaceExists){
 				scheduledElems.insert(make_pair(hmasterOrder, ScheduledElement(e, hmasterRank)));
 				elem_info(e).set_status(get_status(e) | ES_H_SLAVE | ES_SCHEDULED_FOR_INTERFACE);
+				log_elem_info(e);
 			}
 		}
 	}
@@ -1226,6 +1385,9 @@ template <class TElem>
 void DistributedGridManager::
 element_to_be_erased(TElem* elem)
 {
+//	the status log may not reference erased elements
+	unlog_elem_info(elem);
+
 	if(!m_interfaceManagementEnabled)
 		return;
 
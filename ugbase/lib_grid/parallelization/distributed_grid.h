@@ -110,10 +110,33 @@ class DistributedGridManager : public GridObserver
 	 *	in the layout.
 	 *	If you removed elements or if you are unsure what operations have been
 	 *	performed on the layout, you have to set addedElemsOnly to false
-	 *	(the default value). Complexity in this case is proportional to the
-	 *	number of elements in the underlying grid (or numer of elements in
-	 *	the layout - whichever is higher).*/
+	 *	(the default value).
+	 *
+	 *	\note	This is not an incremental update. All element infos are reset
+	 *			and rebuilt from all interface elements of the layout map.
+	 *			Only the reset uses a log of the elements which currently hold
+	 *			an info (see log_elem_info), so that the costs are proportional
+	 *			to the number of elements in the old and new layouts instead of
+	 *			the number of elements in the grid. Changes made through
+	 *			add_element_to_interface or by erasing elements are already
+	 *			reflected in the infos and do not require a call to this method.
+	 *			Algebra layouts which were derived from the grid layouts have to
+	 *			be rebuilt separately. In debug builds the result is validated
+	 *			by check_elem_infos.*/
 	 	void grid_layouts_changed(bool addedElemsOnly = false);
+
+	///	checks whether element infos, the status log and the layouts are consistent
+	/**	For each element of the grid it is checked that the element is logged
+	 * if it holds an info. For each element in an interface of the grid layout
+	 * map it is checked that the interface is referenced by the elements info and
+	 * that the status of the element contains the interface type. Finally all
+	 * interface entries of logged elements have to reference the element.
+	 *
+	 * The costs are proportional to the number of elements in the grid.
+	 * Used for debugging only.
+	 *
+	 * \returns true if everything is consistent.*/
+		bool check_elem_infos(bool verbose = true);
 		
 	///	returns the status of the given object.
 	/**	The status gives information about the type of interfaces in which a node
@@ -247,6 +270,9 @@ class DistributedGridManager : public GridObserver
 
 		template <class TGeomObj>
 		void reset_elem_infos();
+
+		template <class TGeomObj>
+		bool check_elem_infos(bool verbose);
 		
 	/*	Currently unused. See implementation for more details.
 		template <class TElem>
@@ -283,6 +309,16 @@ class DistributedGridManager : public GridObserver
 		template <class TElem>
 		void element_to_be_erased(TElem* elem);
 
+	///	adds the element to the status log, if its info holds data
+	/**	Has to be called whenever the info of an element may have been
+	 * created, i.e. after set_status or add_entry.*/
+		template <class TElem>
+		void log_elem_info(TElem* elem);
+
+	///	removes the element from the status log (O(1))
+		template <class TElem>
+		void unlog_elem_info(TElem* elem);
+
 	/**	Note that the content of the given vector may be extended during this method.*/
 		template <class TElem>
 		void create_missing_constrained_h_interfaces(std::vector<TElem*>& newConstrainedElems);
@@ -382,11 +418,24 @@ class DistributedGridManager : public GridObserver
 					return !m_data->m_entries.empty();
 				}
 
+				inline bool has_data() const	{return m_data.get() != NULL;}
+
+			///	index of the associated element in the status log (NO_LOG_ENTRY if not logged)
+				size_t log_index() const
+				{
+					if(!has_data()) return NO_LOG_ENTRY;
+					return m_data->m_logIndex;
+				}
+				void set_log_index(size_t i)	{data().m_logIndex = i;}
+
+				static const size_t NO_LOG_ENTRY = ~size_t(0);
+
 			protected:
 				struct Data{
-					Data() : m_status(ES_NONE) {}
+					Data() : m_status(ES_NONE), m_logIndex(NO_LOG_ENTRY) {}
 					EntryList	m_entries;
 					byte		m_status;
+					size_t		m_logIndex;
 				};
 
 			///	returns the data object. Creates it if necessary.
@@ -397,8 +446,6 @@ class DistributedGridManager : public GridObserver
 					return *m_data;
 				}
 
-				inline bool has_data() const	{return m_data.get() != NULL;}
-
 			///	OwnedPtr is required to transfer ownership of the data-ptr during copy-operations.
 			/**	Since ElementInfo objects are stored in attachments, they will be copied
 			 * from time to time. Ownership is thereby transfered to the new copy.
@@ -444,6 +491,14 @@ class DistributedGridManager : public GridObserver
 		inline const ElemInfoFace& elem_info(Face* ele) const		{return m_aaElemInfoFACE[ele];}
 		inline const ElemInfoVol& elem_info(Volume* ele) const		{return m_aaElemInfoVOL[ele];}
 
+	///	the status log, i.e. all elements whose infos hold data
+	/**	\{ */
+		inline std::vector<Vertex*>& status_log(Vertex*)	{return m_statusLogVrts;}
+		inline std::vector<Edge*>& status_log(Edge*)		{return m_statusLogEdges;}
+		inline std::vector<Face*>& status_log(Face*)		{return m_statusLogFaces;}
+		inline std::vector<Volume*>& status_log(Volume*)	{return m_statusLogVols;}
+	/**	\} */
+
 		inline void got_new_constrained_vertical(Vertex* v)	{m_newConstrainedVerticalVrts.push_back(v);}
 		inline void got_new_constrained_vertical(Edge* e)	{m_newConstrainedVerticalEdges.push_back(e);}
 		inline void got_new_constrained_vertical(Face* f)		{m_newConstrainedVerticalFaces.push_back(f);}
@@ -478,6 +533,14 @@ class DistributedGridManager : public GridObserver
 		std::vector<Edge*>		m_newConstrainedVerticalEdges;
 		std::vector<Face*>			m_newConstrainedVerticalFaces;
 
+	///	elements whose infos hold data (the position is stored in the info).
+	/**	Maintained by the grid callbacks and all methods which change infos,
+	 * so that grid_layouts_changed doesn't have to iterate over the whole grid.*/
+		std::vector<Vertex*>	m_statusLogVrts;
+		std::vector<Edge*>		m_statusLogEdges;
+		std::vector<Face*>		m_statusLogFaces;
+		std::vector<Volume*>	m_statusLogVols;
+
 		SmartPtr<DistroAdjuster> m_spDistroAdjuster;
 };
 
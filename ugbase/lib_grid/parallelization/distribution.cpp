@@ -510,6 +510,7 @@ static bool PerformValidityCheck(DistributedGridManager& dgm)
 	isValid &= PerformValidityCheck<Edge>(dgm);
 	isValid &= PerformValidityCheck<Face>(dgm);
 	isValid &= PerformValidityCheck<Volume>(dgm);
+	isValid &= dgm.check_elem_infos();
 	return isValid;
 }
 
@@ -0,0 +1,466 @@
+/*
+ * Copyright (c) 2017:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+
+
+#include <algorithm>
+#include "partitioner_multilevel.h"
+#include "distributed_grid.h"
+#include "common/util/vector_util.h"
+#include "lib_grid/algorithms/graph/multilevel_partitioning.h"
+#include "lib_grid/parallelization/util/compol_subset.h"
+#include "lib_grid/parallelization/util/parallel_dual_graph.h"
+#include "lib_grid/parallelization/parallelization_util.h"
+
+using namespace std;
+
+namespace ug{
+
+template <class TElem, int dim>
+Partitioner_Multilevel<TElem, dim>::
+Partitioner_Multilevel() :
+	m_mg(NULL),
+	m_imbalanceTol(1.05),
+	m_migrationCost(0.1),
+	m_repartitioning(true)
+{
+	m_processHierarchy = SPProcessHierarchy(new ProcessHierarchy);
+	m_processHierarchy->add_hierarchy_level(0, 1);
+
+	m_balanceWeights = make_sp(new IBalanceWeights());
+}
+
+template <class TElem, int dim>
+Partitioner_Multilevel<TElem, dim>::
+~Partitioner_Multilevel()
+{
+}
+
+////////////////////////////////
+//	SETTERS AND GETTERS
+////////////////////////////////
+template <class TElem, int dim>
+void Partitioner_Multilevel<TElem, dim>::
+set_grid(MultiGrid* mg, Attachment<MathVector<dim> >)
+{
+	m_mg = mg;
+	if(m_sh.valid())
+		m_sh->assign_grid(m_mg);
+}
+
+template <class TElem, int dim>
+void Partitioner_Multilevel<TElem, dim>::
+set_subset_handler(SmartPtr<SubsetHandler> sh)
+{
+	m_sh = sh;
+	if(m_mg)
+		m_sh->assign_grid(m_mg);
+}
+
+template <class TElem, int dim>
+void Partitioner_Multilevel<TElem, dim>::
+set_imbalance_tolerance(number tol)
+{
+	UG_COND_THROW(tol < 1, "Partitioner_Multilevel: The imbalance tolerance "
+				  "has to be at least 1, but " << tol << " was specified.");
+	m_imbalanceTol = tol;
+}
+
+template <class TElem, int dim>
+void Partitioner_Multilevel<TElem, dim>::
+set_migration_cost(number cost)
+{
+	UG_COND_THROW(cost < 0, "Partitioner_Multilevel: The migration cost "
+				  "must not be negative.");
+	m_migrationCost = cost;
+}
+
+template <class TElem, int dim>
+void Partitioner_Multilevel<TElem, dim>::
+set_next_process_hierarchy(SPProcessHierarchy procHierarchy)
+{
+	m_nextProcessHierarchy = procHierarchy;
+}
+
+template <class TElem, int dim>
+void Partitioner_Multilevel<TElem, dim>::
+set_balance_weights(SPBalanceWeights balanceWeights)
+{
+	m_balanceWeights = balanceWeights;
+}
+
+template <class TElem, int dim>
+void Partitioner_Multilevel<TElem, dim>::
+set_communication_weights(SPCommunicationWeights commWeights)
+{
+	m_commWeights = commWeights;
+}
+
+template <class TElem, int dim>
+ConstSPProcessHierarchy Partitioner_Multilevel<TElem, dim>::
+current_process_hierarchy() const
+{
+	return m_processHierarchy;
+}
+
+template <class TElem, int dim>
+ConstSPProcessHierarchy Partitioner_Multilevel<TElem, dim>::
+next_process_hierarchy() const
+{
+	return m_nextProcessHierarchy;
+}
+
+template <class TElem, int dim>
+SubsetHandler& Partitioner_Multilevel<TElem, dim>::
+get_partitions()
+{
+	if(m_sh.invalid()){
+		if(m_mg)
+			m_sh = make_sp(new SubsetHandler(*m_mg));
+		else
+			m_sh = make_sp(new SubsetHandler());
+	}
+	return *m_sh;
+}
+
+template <class TElem, int dim>
+const std::vector<int>* Partitioner_Multilevel<TElem, dim>::
+get_process_map() const
+{
+	return NULL;
+}
+
+
+////////////////////////////////
+//	PARTITIONING
+////////////////////////////////
+template <class TElem, int dim>
+bool Partitioner_Multilevel<TElem, dim>::
+partition(size_t baseLvl, size_t elementThreshold)
+{
+	GDIST_PROFILE_FUNC();
+
+	UG_COND_THROW(m_mg == NULL,
+			"No grid was specified for Partitioner_Multilevel. "
+			"partitioning can't be executed without a specified grid.");
+
+	if(m_balanceWeights.invalid())
+		m_balanceWeights = make_sp(new IBalanceWeights());
+
+	MultiGrid& mg = *m_mg;
+	if(m_sh.invalid())
+		m_sh = make_sp(new SubsetHandler(mg));
+	SubsetHandler& sh = *m_sh;
+	sh.clear();
+
+//	assign all elements below baseLvl to the local process
+	for(int i = 0; i < (int)baseLvl; ++i)
+		sh.assign_subset(mg.begin<elem_t>(i), mg.end<elem_t>(i), 0);
+
+	const ProcessHierarchy* procH;
+	if(m_nextProcessHierarchy.valid())
+		procH = m_nextProcessHierarchy.get();
+	else
+		procH = m_processHierarchy.get();
+
+	m_problemsOccurred = false;
+
+	for(size_t hlevel = 0; hlevel < procH->num_hierarchy_levels(); ++ hlevel)
+	{
+		int numProcs = procH->num_global_procs_involved(hlevel);
+
+		int minLvl = procH->grid_base_level(hlevel);
+		int maxLvl = (int)mg.top_level();
+
+		if(hlevel + 1 < procH->num_hierarchy_levels()){
+			maxLvl = min<int>(maxLvl,
+						(int)procH->grid_base_level(hlevel + 1) - 1);
+		}
+
+		if(minLvl < (int)baseLvl)
+			minLvl = (int)baseLvl;
+
+		if(maxLvl < minLvl)
+			continue;
+
+		if(numProcs <= 1){
+			for(int i = minLvl; i <= maxLvl; ++i)
+				sh.assign_subset(mg.begin<elem_t>(i), mg.end<elem_t>(i), 0);
+			continue;
+		}
+
+	//	if clustered siblings are enabled, we'll perform partitioning on the level
+	//	below minLvl (if such a level exists). However, only the partition-map
+	//	of minLvl and levels above will be adjusted.
+		int partitionLvl = minLvl;
+		pcl::ProcessCommunicator com;
+
+		if((minLvl > 0) && base_class::clustered_siblings_enabled()){
+			partitionLvl = minLvl - 1;
+			size_t partitionHLvl = m_processHierarchy->hierarchy_level_from_grid_level(partitionLvl);
+			com = m_processHierarchy->global_proc_com(partitionHLvl);
+		}
+		else
+			com = procH->global_proc_com(hlevel);
+
+		partition_level(numProcs, minLvl, maxLvl, partitionLvl, com);
+
+		for(int i = minLvl; i < maxLvl; ++i){
+			copy_partitions_to_children(sh, i);
+		}
+	}
+
+	if(m_nextProcessHierarchy.valid()){
+		*m_processHierarchy = *m_nextProcessHierarchy;
+		m_nextProcessHierarchy = SPProcessHierarchy(NULL);
+	}
+
+	PCL_DEBUG_BARRIER_ALL();
+	return true;
+}
+
+
+template <class TElem, int dim>
+number Partitioner_Multilevel<TElem, dim>::
+accumulated_weight(elem_t* e, int minLvl, int maxLvl)
+{
+	IBalanceWeights& bw = *m_balanceWeights;
+	MultiGrid& mg = *m_mg;
+
+	const int lvl = mg.get_level(e);
+	number w = 0;
+	if(lvl >= minLvl){
+		if(bw.consider_in_level_above(e))
+			w = bw.get_refined_weight(e);
+		else
+			w = bw.get_weight(e);
+	}
+
+	if(lvl < maxLvl){
+		const size_t numChildren = mg.num_children<elem_t>(e);
+		for(size_t i = 0; i < numChildren; ++i)
+			w += accumulated_weight(mg.get_child<elem_t>(e, i), minLvl, maxLvl);
+	}
+	return w;
+}
+
+
+template <class TElem, int dim>
+void Partitioner_Multilevel<TElem, dim>::
+partition_level(int numTargetProcs, int minLvl, int maxLvl, int partitionLvl,
+				pcl::ProcessCommunicator com)
+{
+	GDIST_PROFILE_FUNC();
+
+	typedef typename MultiGrid::traits<elem_t>::iterator iter_t;
+
+	MultiGrid&		mg	= *m_mg;
+	SubsetHandler&	sh	= *m_sh;
+	DistributedGridManager* pdgm = mg.distributed_grid_manager();
+
+	vector<int> origSubsetIndices;
+	if(partitionLvl < minLvl){
+		origSubsetIndices.reserve(mg.num<elem_t>(partitionLvl));
+		for(iter_t eiter = mg.begin<elem_t>(partitionLvl);
+			eiter != mg.end<elem_t>(partitionLvl); ++eiter)
+		{
+			origSubsetIndices.push_back(sh.get_subset_index(*eiter));
+		}
+	}
+
+//	invalidate target partitions of all elements in partitionLvl
+	sh.assign_subset(mg.begin<elem_t>(partitionLvl),
+					 mg.end<elem_t>(partitionLvl), -1);
+
+	if(!com.empty()){
+		ParallelDualGraph<elem_t, int> pdg(&mg);
+		pdg.generate_graph(partitionLvl, com);
+
+	//	only processes which hold elements of partitionLvl are contained in graphCom
+		pcl::ProcessCommunicator graphCom = pdg.process_communicator();
+		if(!graphCom.empty()){
+			const int numLocalVrts = pdg.num_graph_vertices();
+			const int numLocalEdges = pdg.num_graph_edges();
+			const int* adjStructure = pdg.adjacency_map_structure();
+
+			vector<int> degrees(numLocalVrts);
+			vector<number> vrtWeights(numLocalVrts);
+			for(int i = 0; i < numLocalVrts; ++i){
+				degrees[i] = adjStructure[i + 1] - adjStructure[i];
+				vrtWeights[i] = accumulated_weight(pdg.get_element(i), minLvl, maxLvl);
+			}
+
+			vector<int> adjMap;
+			vector<number> edgeWeights(numLocalEdges, 1);
+			if(numLocalEdges > 0)
+				adjMap.assign(pdg.adjacency_map(), pdg.adjacency_map() + numLocalEdges);
+			if(m_commWeights.valid()){
+				for(int i = 0; i < numLocalEdges; ++i){
+					GridObject* conn = pdg.get_connection(i);
+					if(m_commWeights->reweigh(conn))
+						edgeWeights[i] = m_commWeights->get_weight(conn);
+				}
+			}
+
+		//	if the elements are already distributed over all target processes,
+		//	the current distribution is the starting point of the partitioning.
+			const bool useCurrentDistribution =
+					m_repartitioning && ((int)graphCom.size() == numTargetProcs);
+			vector<int> curProcs;
+			if(useCurrentDistribution)
+				curProcs.assign(numLocalVrts, pcl::ProcRank());
+
+		//	gather the graph on the first process of graphCom
+			vector<int> gDegrees, gAdjMap, gCurProcs, vrtCounts;
+			vector<number> gVrtWeights, gEdgeWeights;
+			graphCom.gatherv(gDegrees, degrees, 0, &vrtCounts);
+			graphCom.gatherv(gAdjMap, adjMap, 0);
+			graphCom.gatherv(gVrtWeights, vrtWeights, 0);
+			graphCom.gatherv(gEdgeWeights, edgeWeights, 0);
+			if(useCurrentDistribution)
+				graphCom.gatherv(gCurProcs, curProcs, 0);
+
+			const int tag = 4233;
+			vector<int> partition(numLocalVrts);
+			if(graphCom.get_local_proc_id() == 0){
+				vector<int> gAdjStructure(gDegrees.size() + 1, 0);
+				for(size_t i = 0; i < gDegrees.size(); ++i)
+					gAdjStructure[i + 1] = gAdjStructure[i] + gDegrees[i];
+
+				vector<int> gPartition;
+				PartitionGraphMultilevel(gPartition, gAdjStructure, gAdjMap,
+										 gVrtWeights, gEdgeWeights, numTargetProcs,
+										 m_imbalanceTol,
+										 useCurrentDistribution ? &gCurProcs : NULL,
+										 m_migrationCost);
+
+				copy(gPartition.begin(), gPartition.begin() + numLocalVrts,
+					 partition.begin());
+
+			//	send the partitions of their elements to the other processes
+				if(graphCom.size() > 1){
+					const int numRecProcs = (int)graphCom.size() - 1;
+					vector<int> segSizes(numRecProcs), recProcs(numRecProcs);
+					for(int i = 0; i < numRecProcs; ++i){
+						segSizes[i] = vrtCounts[i + 1] * sizeof(int);
+						recProcs[i] = i + 1;
+					}
+					graphCom.send_data(&gPartition[vrtCounts[0]], GetDataPtr(segSizes),
+									   GetDataPtr(recProcs), numRecProcs, tag);
+				}
+			}
+			else{
+				graphCom.receive_data(GetDataPtr(partition),
+									  numLocalVrts * sizeof(int), 0, tag);
+			}
+
+			for(int i = 0; i < numLocalVrts; ++i)
+				sh.assign_subset(pdg.get_element(i), partition[i]);
+		}
+	}
+
+	if(partitionLvl < minLvl){
+		UG_ASSERT(partitionLvl == minLvl - 1,
+				  "partitionLvl and minLvl should be neighbors");
+
+	//	copy subset indices from partition-level to minLvl
+		for(int i = partitionLvl; i < minLvl; ++i){
+			copy_partitions_to_children(sh, i);
+		}
+
+	//	reset partitions in the specified partition-level
+		size_t counter = 0;
+		for(iter_t eiter = mg.begin<elem_t>(partitionLvl);
+			eiter != mg.end<elem_t>(partitionLvl); ++eiter, ++counter)
+		{
+			sh.assign_subset(*eiter, origSubsetIndices[counter]);
+		}
+	}
+	else if(pdgm){
+	//	copy subset indices from vertical slaves to vertical masters,
+	//	since partitioning was only performed on vslaves
+		GridLayoutMap& glm = pdgm->grid_layout_map();
+		ComPol_Subset<layout_t>	compolSHCopy(sh, true);
+
+		if(glm.has_layout<elem_t>(INT_V_SLAVE))
+			m_intfcCom.send_data(glm.get_layout<elem_t>(INT_V_SLAVE).layout_on_level(partitionLvl),
+								 compolSHCopy);
+		if(glm.has_layout<elem_t>(INT_V_MASTER))
+			m_intfcCom.receive_data(glm.get_layout<elem_t>(INT_V_MASTER).layout_on_level(partitionLvl),
+									compolSHCopy);
+		m_intfcCom.communicate();
+	}
+}
+
+
+template <class TElem, int dim>
+void Partitioner_Multilevel<TElem, dim>::
+copy_partitions_to_children(ISubsetHandler& partitionSH, int lvl)
+{
+	GDIST_PROFILE_FUNC();
+	typedef typename Grid::traits<elem_t>::iterator ElemIter;
+	MultiGrid& mg = *m_mg;
+
+//	assign partitions to all children in this hierarchy level
+	for(ElemIter iter = mg.begin<elem_t>(lvl); iter != mg.end<elem_t>(lvl); ++iter)
+	{
+		size_t numChildren = mg.num_children<elem_t>(*iter);
+		int si = partitionSH.get_subset_index(*iter);
+		for(size_t i = 0; i < numChildren; ++i)
+			partitionSH.assign_subset(mg.get_child<elem_t>(*iter, i), si);
+	}
+
+	if(mg.is_parallel()){
+		GridLayoutMap& glm = mg.distributed_grid_manager()->grid_layout_map();
+	//	communicate partitions from v-masters to v-slaves, since v-slaves
+	//	havn't got no parents on their procs.
+		ComPol_Subset<layout_t>	compolSHCopy(partitionSH, true);
+		if(glm.has_layout<elem_t>(INT_V_MASTER)){
+			m_intfcCom.send_data(glm.get_layout<elem_t>(INT_V_MASTER).layout_on_level(lvl+1),
+								 compolSHCopy);
+		}
+		if(glm.has_layout<elem_t>(INT_V_SLAVE)){
+			m_intfcCom.receive_data(glm.get_layout<elem_t>(INT_V_SLAVE).layout_on_level(lvl+1),
+									compolSHCopy);
+		}
+		m_intfcCom.communicate();
+	}
+}
+
+
+template class Partitioner_Multilevel<Edge, 1>;
+template class Partitioner_Multilevel<Edge, 2>;
+template class Partitioner_Multilevel<Face, 2>;
+template class Partitioner_Multilevel<Edge, 3>;
+template class Partitioner_Multilevel<Face, 3>;
+template class Partitioner_Multilevel<Volume, 3>;
+
+}// end of namespace
@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) 2017:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+
+
+#ifndef __H__UG_partitioner_multilevel
+#define __H__UG_partitioner_multilevel
+
+#include <vector>
+#include "parallel_grid_layout.h"
+#include "partitioner.h"
+#include "pcl/pcl_interface_communicator.h"
+
+namespace ug{
+
+/// \addtogroup lib_grid_parallelization_distribution
+///	\{
+
+///	Multilevel k-way graph partitioner operating on the dual graph of the grid
+/**	The parallel dual graph of the partition level is gathered on one process
+ * and partitioned there by PartitionGraphMultilevel (heavy-edge matching,
+ * greedy graph growing and k-way Fiduccia-Mattheyses refinement). The
+ * weight of a graph vertex is the sum of the balance weights of the element
+ * and all its descendants in the levels which are distributed. The weight of
+ * a graph edge is given by the communication weights of the connecting side
+ * (1 by default). Children always inherit the partition of their parents.
+ *
+ * In contrast to geometric partitioners, the edge cut is minimized
+ * directly, which gives better partitions on anisotropic or layered grids.
+ *
+ * If the elements of the partition level are already distributed over as
+ * many processes as there are target processes, the current distribution is
+ * used as starting point and moving elements away from their process is
+ * penalized by the migration cost (see set_migration_cost). Rebalancing an
+ * adapted grid thus only moves few elements. Repartitioning can be disabled
+ * through enable_repartitioning(false).
+ *
+ * \note	Since the whole dual graph of the partition level is held on one
+ *			process, this partitioner is intended for the moderate sizes of the
+ *			partition levels of hierarchical distributions.
+ */
+template <class TElem, int dim>
+class Partitioner_Multilevel : public IPartitioner{
+	public:
+		typedef IPartitioner	 						base_class;
+		typedef TElem									elem_t;
+		typedef Attachment<MathVector<dim> >			apos_t;
+		typedef typename GridLayoutMap::Types<elem_t>::Layout::LevelLayout	layout_t;
+
+		Partitioner_Multilevel();
+		virtual ~Partitioner_Multilevel();
+
+		void set_grid(MultiGrid* mg, Attachment<MathVector<dim> > aPos);
+
+	///	allows to optionally specify a subset-handler on which the balancer shall operate
+		void set_subset_handler(SmartPtr<SubsetHandler> sh);
+
+	///	maximal ratio of the weight of a partition and the average weight (default 1.05)
+		void set_imbalance_tolerance(number tol);
+		number imbalance_tolerance() const						{return m_imbalanceTol;}
+
+	///	penalty for moving the weight of an element away from its current process (default 0.1)
+	/**	The penalty is compared with the communication weights of the cut sides.
+	 * Large values keep more elements on their current process, 0 only
+	 * minimizes the edge cut.*/
+		void set_migration_cost(number cost);
+		number migration_cost() const							{return m_migrationCost;}
+
+	///	enables the use of the current distribution as starting point (default true)
+		void enable_repartitioning(bool enable)					{m_repartitioning = enable;}
+		bool repartitioning_enabled() const						{return m_repartitioning;}
+
+		virtual void set_next_process_hierarchy(SPProcessHierarchy procHierarchy);
+		virtual void set_balance_weights(SPBalanceWeights balanceWeights);
+		virtual void set_communication_weights(SPCommunicationWeights commWeights);
+
+		virtual ConstSPProcessHierarchy current_process_hierarchy() const;
+		virtual ConstSPProcessHierarchy next_process_hierarchy() const;
+
+		virtual bool supports_balance_weights() const			{return true;}
+		virtual bool supports_communication_weights() const		{return true;}
+		virtual bool supports_repartitioning() const			{return true;}
+
+		virtual bool partition(size_t baseLvl, size_t elementThreshold);
+
+		virtual SubsetHandler& get_partitions();
+		virtual const std::vector<int>* get_process_map() const;
+
+	private:
+	///	partitions the elements of partitionLvl and copies partitions up to maxLvl
+		void partition_level(int numTargetProcs, int minLvl, int maxLvl,
+							 int partitionLvl, pcl::ProcessCommunicator com);
+
+	///	sums the balance weights of e and its descendants in [minLvl, maxLvl]
+		number accumulated_weight(elem_t* e, int minLvl, int maxLvl);
+
+		void copy_partitions_to_children(ISubsetHandler& partitionSH, int lvl);
+
+		MultiGrid*								m_mg;
+		SmartPtr<SubsetHandler>					m_sh;
+		SPProcessHierarchy						m_processHierarchy;
+		SPProcessHierarchy						m_nextProcessHierarchy;
+		pcl::InterfaceCommunicator<layout_t>	m_intfcCom;
+		SPBalanceWeights						m_balanceWeights;
+		SPCommunicationWeights					m_commWeights;
+		number									m_imbalanceTol;
+		number									m_migrationCost;
+		bool									m_repartitioning;
+};
+
+///	\}
+
+}//	end of namespace
+
+#endif	//__H__UG_partitioner_multilevel
@@ -0,0 +1,482 @@
+/*
+ * Copyright (c) 2017:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include "partitioner_sfc.h"
+#include "distributed_grid.h"
+#include "lib_grid/parallelization/util/compol_subset.h"
+#include "lib_grid/parallelization/parallelization_util.h"
+#include "lib_grid/algorithms/geom_obj_util/geom_obj_util.h"
+
+using namespace std;
+
+namespace ug{
+
+template <class TElem, int dim>
+Partitioner_SFC<TElem, dim>::
+Partitioner_SFC() :
+	m_mg(NULL),
+	m_curve(SFC_HILBERT)
+{
+	m_processHierarchy = SPProcessHierarchy(new ProcessHierarchy);
+	m_processHierarchy->add_hierarchy_level(0, 1);
+
+	m_balanceWeights = make_sp(new IBalanceWeights());
+}
+
+template <class TElem, int dim>
+Partitioner_SFC<TElem, dim>::
+~Partitioner_SFC()
+{
+}
+
+////////////////////////////////
+//	SETTERS AND GETTERS
+////////////////////////////////
+template <class TElem, int dim>
+void Partitioner_SFC<TElem, dim>::
+set_grid(MultiGrid* mg, Attachment<MathVector<dim> > aPos)
+{
+	m_mg = mg;
+	if(m_sh.valid())
+		m_sh->assign_grid(m_mg);
+	m_aPos = aPos;
+	m_aaPos.access(*m_mg, m_aPos);
+}
+
+template <class TElem, int dim>
+void Partitioner_SFC<TElem, dim>::
+set_subset_handler(SmartPtr<SubsetHandler> sh)
+{
+	m_sh = sh;
+	if(m_mg)
+		m_sh->assign_grid(m_mg);
+}
+
+template <class TElem, int dim>
+void Partitioner_SFC<TElem, dim>::
+set_curve(const char* curve)
+{
+	if(strcmp(curve, "hilbert") == 0)
+		m_curve = SFC_HILBERT;
+	else if(strcmp(curve, "morton") == 0)
+		m_curve = SFC_MORTON;
+	else{
+		UG_THROW("Partitioner_SFC: Unknown curve '" << curve << "'. "
+				 "Supported curves are 'hilbert' and 'morton'.");
+	}
+}
+
+template <class TElem, int dim>
+void Partitioner_SFC<TElem, dim>::
+set_next_process_hierarchy(SPProcessHierarchy procHierarchy)
+{
+	m_nextProcessHierarchy = procHierarchy;
+}
+
+template <class TElem, int dim>
+void Partitioner_SFC<TElem, dim>::
+set_balance_weights(SPBalanceWeights balanceWeights)
+{
+	m_balanceWeights = balanceWeights;
+}
+
+template <class TElem, int dim>
+ConstSPProcessHierarchy Partitioner_SFC<TElem, dim>::
+current_process_hierarchy() const
+{
+	return m_processHierarchy;
+}
+
+template <class TElem, int dim>
+ConstSPProcessHierarchy Partitioner_SFC<TElem, dim>::
+next_process_hierarchy() const
+{
+	return m_nextProcessHierarchy;
+}
+
+template <class TElem, int dim>
+SubsetHandler& Partitioner_SFC<TElem, dim>::
+get_partitions()
+{
+	if(m_sh.invalid()){
+		if(m_mg)
+			m_sh = make_sp(new SubsetHandler(*m_mg));
+		else
+			m_sh = make_sp(new SubsetHandler());
+	}
+	return *m_sh;
+}
+
+template <class TElem, int dim>
+const std::vector<int>* Partitioner_SFC<TElem, dim>::
+get_process_map() const
+{
+	return NULL;
+}
+
+
+////////////////////////////////
+//	PARTITIONING
+////////////////////////////////
+template <class TElem, int dim>
+bool Partitioner_SFC<TElem, dim>::
+partition(size_t baseLvl, size_t elementThreshold)
+{
+	GDIST_PROFILE_FUNC();
+
+	UG_COND_THROW(m_mg == NULL,
+			"No grid was specified for Partitioner_SFC. "
+			"partitioning can't be executed without a specified grid.");
+
+	if(m_balanceWeights.invalid())
+		m_balanceWeights = make_sp(new IBalanceWeights());
+
+	MultiGrid& mg = *m_mg;
+	if(m_sh.invalid())
+		m_sh = make_sp(new SubsetHandler(mg));
+	SubsetHandler& sh = *m_sh;
+	sh.clear();
+
+//	assign all elements below baseLvl to the local process
+	for(int i = 0; i < (int)baseLvl; ++i)
+		sh.assign_subset(mg.begin<elem_t>(i), mg.end<elem_t>(i), 0);
+
+	const ProcessHierarchy* procH;
+	if(m_nextProcessHierarchy.valid())
+		procH = m_nextProcessHierarchy.get();
+	else
+		procH = m_processHierarchy.get();
+
+	m_problemsOccurred = false;
+
+	for(size_t hlevel = 0; hlevel < procH->num_hierarchy_levels(); ++ hlevel)
+	{
+		int numProcs = procH->num_global_procs_involved(hlevel);
+
+		int minLvl = procH->grid_base_level(hlevel);
+		int maxLvl = (int)mg.top_level();
+
+		if(hlevel + 1 < procH->num_hierarchy_levels()){
+			maxLvl = min<int>(maxLvl,
+						(int)procH->grid_base_level(hlevel + 1) - 1);
+		}
+
+		if(minLvl < (int)baseLvl)
+			minLvl = (int)baseLvl;
+
+		if(maxLvl < minLvl)
+			continue;
+
+		if(numProcs <= 1){
+			for(int i = minLvl; i <= maxLvl; ++i)
+				sh.assign_subset(mg.begin<elem_t>(i), mg.end<elem_t>(i), 0);
+			continue;
+		}
+
+	//	if clustered siblings are enabled, we'll perform partitioning on the level
+	//	below minLvl (if such a level exists). However, only the partition-map
+	//	of minLvl and levels above will be adjusted.
+		int partitionLvl = minLvl;
+		pcl::ProcessCommunicator com;
+
+		if((minLvl > 0) && base_class::clustered_siblings_enabled()){
+			partitionLvl = minLvl - 1;
+			size_t partitionHLvl = m_processHierarchy->hierarchy_level_from_grid_level(partitionLvl);
+			com = m_processHierarchy->global_proc_com(partitionHLvl);
+		}
+		else
+			com = procH->global_proc_com(hlevel);
+
+		partition_level(numProcs, minLvl, maxLvl, partitionLvl, com);
+
+		for(int i = minLvl; i < maxLvl; ++i){
+			copy_partitions_to_children(sh, i);
+		}
+	}
+
+	if(m_nextProcessHierarchy.valid()){
+		*m_processHierarchy = *m_nextProcessHierarchy;
+		m_nextProcessHierarchy = SPProcessHierarchy(NULL);
+	}
+
+	PCL_DEBUG_BARRIER_ALL();
+	return true;
+}
+
+
+template <class TElem, int dim>
+number Partitioner_SFC<TElem, dim>::
+accumulated_weight(elem_t* e, int minLvl, int maxLvl)
+{
+	IBalanceWeights& bw = *m_balanceWeights;
+	MultiGrid& mg = *m_mg;
+
+	const int lvl = mg.get_level(e);
+	number w = 0;
+	if(lvl >= minLvl){
+		if(bw.consider_in_level_above(e))
+			w = bw.get_refined_weight(e);
+		else
+			w = bw.get_weight(e);
+	}
+
+	if(lvl < maxLvl){
+		const size_t numChildren = mg.num_children<elem_t>(e);
+		for(size_t i = 0; i < numChildren; ++i)
+			w += accumulated_weight(mg.get_child<elem_t>(e, i), minLvl, maxLvl);
+	}
+	return w;
+}
+
+
+template <class TElem, int dim>
+void Partitioner_SFC<TElem, dim>::
+partition_level(int numTargetProcs, int minLvl, int maxLvl, int partitionLvl,
+				pcl::ProcessCommunicator com)
+{
+	GDIST_PROFILE_FUNC();
+
+	typedef typename MultiGrid::traits<elem_t>::iterator iter_t;
+
+	MultiGrid&		mg	= *m_mg;
+	SubsetHandler&	sh	= *m_sh;
+	DistributedGridManager* pdgm = mg.distributed_grid_manager();
+
+	vector<int> origSubsetIndices;
+	if(partitionLvl < minLvl){
+		origSubsetIndices.reserve(mg.num<elem_t>(partitionLvl));
+		for(iter_t eiter = mg.begin<elem_t>(partitionLvl);
+			eiter != mg.end<elem_t>(partitionLvl); ++eiter)
+		{
+			origSubsetIndices.push_back(sh.get_subset_index(*eiter));
+		}
+	}
+
+//	invalidate target partitions of all elements in partitionLvl
+	sh.assign_subset(mg.begin<elem_t>(partitionLvl),
+					 mg.end<elem_t>(partitionLvl), -1);
+
+	if(!com.empty()){
+	//	collect centers and weights of all non-ghost elements in partitionLvl
+		vector<KeyEntry> entries;
+		vector<vector_t> centers;
+		entries.reserve(mg.num<elem_t>(partitionLvl));
+		centers.reserve(mg.num<elem_t>(partitionLvl));
+
+		vector_t boxMin, boxMax;
+		for(int i = 0; i < dim; ++i){
+			boxMin[i] = numeric_limits<number>::max();
+			boxMax[i] = -numeric_limits<number>::max();
+		}
+
+		for(iter_t eiter = mg.begin<elem_t>(partitionLvl);
+			eiter != mg.end<elem_t>(partitionLvl); ++eiter)
+		{
+			elem_t* elem = *eiter;
+			if(pdgm && pdgm->is_ghost(elem))
+				continue;
+
+			KeyEntry entry;
+			entry.elem = elem;
+			entry.weight = accumulated_weight(elem, minLvl, maxLvl);
+			entry.key = 0;
+			entries.push_back(entry);
+
+			vector_t c = CalculateCenter(elem, m_aaPos);
+			centers.push_back(c);
+			for(int i = 0; i < dim; ++i){
+				boxMin[i] = min(boxMin[i], c[i]);
+				boxMax[i] = max(boxMax[i], c[i]);
+			}
+		}
+
+	//	the curve runs through the global bounding box
+		vector_t gBoxMin, gBoxMax;
+		com.allreduce(&boxMin[0], &gBoxMin[0], dim, PCL_RO_MIN);
+		com.allreduce(&boxMax[0], &gBoxMax[0], dim, PCL_RO_MAX);
+
+		for(size_t i = 0; i < entries.size(); ++i)
+			entries[i].key = SpaceFillingCurveKey<dim>(m_curve, centers[i],
+													   gBoxMin, gBoxMax);
+		sort(entries.begin(), entries.end());
+
+		vector<uint64> splitters;
+		find_splitters(splitters, entries, numTargetProcs, com);
+
+		for(size_t i = 0; i < entries.size(); ++i){
+			const int p = (int)(lower_bound(splitters.begin(), splitters.end(),
+											entries[i].key) - splitters.begin());
+			sh.assign_subset(entries[i].elem, p);
+		}
+	}
+
+	if(partitionLvl < minLvl){
+		UG_ASSERT(partitionLvl == minLvl - 1,
+				  "partitionLvl and minLvl should be neighbors");
+
+	//	copy subset indices from partition-level to minLvl
+		for(int i = partitionLvl; i < minLvl; ++i){
+			copy_partitions_to_children(sh, i);
+		}
+
+	//	reset partitions in the specified partition-level
+		size_t counter = 0;
+		for(iter_t eiter = mg.begin<elem_t>(partitionLvl);
+			eiter != mg.end<elem_t>(partitionLvl); ++eiter, ++counter)
+		{
+			sh.assign_subset(*eiter, origSubsetIndices[counter]);
+		}
+	}
+	else if(pdgm){
+	//	copy subset indices from vertical slaves to vertical masters,
+	//	since partitioning was only performed on vslaves
+		GridLayoutMap& glm = pdgm->grid_layout_map();
+		ComPol_Subset<layout_t>	compolSHCopy(sh, true);
+
+		if(glm.has_layout<elem_t>(INT_V_SLAVE))
+			m_intfcCom.send_data(glm.get_layout<elem_t>(INT_V_SLAVE).layout_on_level(partitionLvl),
+								 compolSHCopy);
+		if(glm.has_layout<elem_t>(INT_V_MASTER))
+			m_intfcCom.receive_data(glm.get_layout<elem_t>(INT_V_MASTER).layout_on_level(partitionLvl),
+									compolSHCopy);
+		m_intfcCom.communicate();
+	}
+}
+
+
+template <class TElem, int dim>
+void Partitioner_SFC<TElem, dim>::
+find_splitters(std::vector<uint64>& splittersOut,
+			   const std::vector<KeyEntry>& entries,
+			   int numTargetProcs, pcl::ProcessCommunicator& com)
+{
+	GDIST_PROFILE_FUNC();
+
+	const size_t numSplitters = (size_t)numTargetProcs - 1;
+
+//	prefix sums of the weights of the (sorted) local entries
+	vector<uint64> keys(entries.size());
+	vector<number> prefixWeight(entries.size() + 1, 0);
+	for(size_t i = 0; i < entries.size(); ++i){
+		keys[i] = entries[i].key;
+		prefixWeight[i + 1] = prefixWeight[i] + entries[i].weight;
+	}
+
+	const number totalWeight = com.allreduce(prefixWeight.back(), PCL_RO_SUM);
+
+//	splitter k is the smallest key m such that the global weight of all
+//	elements with keys <= m reaches (k+1)/numTargetProcs of the total weight.
+//	All splitters are found simultaneously by bisection on the key space.
+	vector<uint64> lo(numSplitters, 0);
+	vector<uint64> hi(numSplitters, numeric_limits<uint64>::max());
+	vector<number> target(numSplitters);
+	for(size_t k = 0; k < numSplitters; ++k)
+		target[k] = totalWeight * (number)(k + 1) / (number)numTargetProcs;
+
+	vector<uint64> mid(numSplitters);
+	vector<number> localWeight(numSplitters), globalWeight(numSplitters);
+
+	for(int iteration = 0; iteration <= 64; ++iteration){
+		bool bActive = false;
+		for(size_t k = 0; k < numSplitters; ++k){
+			mid[k] = lo[k] + (hi[k] - lo[k]) / 2;
+			if(lo[k] < hi[k]) bActive = true;
+			const size_t numBelow = upper_bound(keys.begin(), keys.end(), mid[k])
+									- keys.begin();
+			localWeight[k] = prefixWeight[numBelow];
+		}
+
+	//	all processes take the same decision, since all use the same global weights
+		if(!bActive)
+			break;
+
+		com.allreduce(localWeight, globalWeight, PCL_RO_SUM);
+
+		for(size_t k = 0; k < numSplitters; ++k){
+			if(lo[k] >= hi[k]) continue;
+			if(globalWeight[k] >= target[k])
+				hi[k] = mid[k];
+			else
+				lo[k] = mid[k] + 1;
+		}
+	}
+
+	splittersOut = lo;
+}
+
+
+template <class TElem, int dim>
+void Partitioner_SFC<TElem, dim>::
+copy_partitions_to_children(ISubsetHandler& partitionSH, int lvl)
+{
+	GDIST_PROFILE_FUNC();
+	typedef typename Grid::traits<elem_t>::iterator ElemIter;
+	MultiGrid& mg = *m_mg;
+
+//	assign partitions to all children in this hierarchy level
+	for(ElemIter iter = mg.begin<elem_t>(lvl); iter != mg.end<elem_t>(lvl); ++iter)
+	{
+		size_t numChildren = mg.num_children<elem_t>(*iter);
+		int si = partitionSH.get_subset_index(*iter);
+		for(size_t i = 0; i < numChildren; ++i)
+			partitionSH.assign_subset(mg.get_child<elem_t>(*iter, i), si);
+	}
+
+	if(mg.is_parallel()){
+		GridLayoutMap& glm = mg.distributed_grid_manager()->grid_layout_map();
+	//	communicate partitions from v-masters to v-slaves, since v-slaves
+	//	havn't got no parents on their procs.
+		ComPol_Subset<layout_t>	compolSHCopy(partitionSH, true);
+		if(glm.has_layout<elem_t>(INT_V_MASTER)){
+			m_intfcCom.send_data(glm.get_layout<elem_t>(INT_V_MASTER).layout_on_level(lvl+1),
+								 compolSHCopy);
+		}
+		if(glm.has_layout<elem_t>(INT_V_SLAVE)){
+			m_intfcCom.receive_data(glm.get_layout<elem_t>(INT_V_SLAVE).layout_on_level(lvl+1),
+									compolSHCopy);
+		}
+		m_intfcCom.communicate();
+	}
+}
+
+
+template class Partitioner_SFC<Edge, 1>;
+template class Partitioner_SFC<Edge, 2>;
+template class Partitioner_SFC<Face, 2>;
+template class Partitioner_SFC<Edge, 3>;
+template class Partitioner_SFC<Face, 3>;
+template class Partitioner_SFC<Volume, 3>;
+
+}// end of namespace
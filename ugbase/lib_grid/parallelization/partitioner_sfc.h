@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2017:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+
+#ifndef __H__UG_partitioner_sfc
+#define __H__UG_partitioner_sfc
+
+#include <utility>
+#include <vector>
+#include "parallel_grid_layout.h"
+#include "partitioner.h"
+#include "pcl/pcl_interface_communicator.h"
+#include "lib_grid/algorithms/space_filling_curve_util.h"
+
+namespace ug{
+
+/// \addtogroup lib_grid_parallelization_distribution
+///	\{
+
+///	Parallel space filling curve partitioner
+/**	Elements of the partition level are sorted along a Hilbert (default) or
+ * Morton curve through the global bounding box of their centers. The curve is
+ * then cut into pieces of equal weight, where the weight of an element is the
+ * sum of the balance weights of all its descendants in the levels which are
+ * distributed. Children always inherit the partition of their parents, thus
+ * the multigrid hierarchy is respected.
+ *
+ * Since the keys of the elements do not change between successive calls,
+ * repartitioning of a slightly changed grid only moves the elements close to
+ * the cuts. The partitioner thus supports repartitioning, i.e. the LoadBalancer
+ * only redistributes if the estimated distribution quality drops below its
+ * balance threshold.
+ *
+ * The splitters are determined by a parallel bisection on the key space, which
+ * requires one allreduce per key bit and no global sorting of elements.
+ */
+template <class TElem, int dim>
+class Partitioner_SFC : public IPartitioner{
+	public:
+		typedef IPartitioner	 						base_class;
+		typedef TElem									elem_t;
+		typedef MathVector<dim>							vector_t;
+		typedef Attachment<vector_t>					apos_t;
+		typedef Grid::VertexAttachmentAccessor<apos_t>	aapos_t;
+		typedef typename GridLayoutMap::Types<elem_t>::Layout::LevelLayout	layout_t;
+
+		Partitioner_SFC();
+		virtual ~Partitioner_SFC();
+
+		void set_grid(MultiGrid* mg, Attachment<MathVector<dim> > aPos);
+
+	///	allows to optionally specify a subset-handler on which the balancer shall operate
+		void set_subset_handler(SmartPtr<SubsetHandler> sh);
+
+	///	sets the space filling curve. Supported are "hilbert" (default) and "morton".
+		void set_curve(const char* curve);
+
+		virtual void set_next_process_hierarchy(SPProcessHierarchy procHierarchy);
+		virtual void set_balance_weights(SPBalanceWeights balanceWeights);
+
+		virtual ConstSPProcessHierarchy current_process_hierarchy() const;
+		virtual ConstSPProcessHierarchy next_process_hierarchy() const;
+
+		virtual bool supports_balance_weights() const			{return true;}
+		virtual bool supports_repartitioning() const			{return true;}
+
+		virtual bool partition(size_t baseLvl, size_t elementThreshold);
+
+		virtual SubsetHandler& get_partitions();
+		virtual const std::vector<int>* get_process_map() const;
+
+	private:
+		struct KeyEntry{
+			uint64	key;
+			number	weight;
+			elem_t*	elem;
+			bool operator<(const KeyEntry& e) const	{return key < e.key;}
+		};
+
+	///	partitions the elements of partitionLvl and copies partitions up to maxLvl
+		void partition_level(int numTargetProcs, int minLvl, int maxLvl,
+							 int partitionLvl, pcl::ProcessCommunicator com);
+
+	///	sums the balance weights of e and its descendants in [minLvl, maxLvl]
+		number accumulated_weight(elem_t* e, int minLvl, int maxLvl);
+
+	///	computes splitter keys such that the curve is cut into numTargetProcs pieces of equal weight
+		void find_splitters(std::vector<uint64>& splittersOut,
+							const std::vector<KeyEntry>& entries,
+							int numTargetProcs, pcl::ProcessCommunicator& com);
+
+		void copy_partitions_to_children(ISubsetHandler& partitionSH, int lvl);
+
+		MultiGrid*								m_mg;
+		apos_t									m_aPos;
+		aapos_t									m_aaPos;
+		SmartPtr<SubsetHandler>					m_sh;
+		SPProcessHierarchy						m_processHierarchy;
+		SPProcessHierarchy						m_nextProcessHierarchy;
+		pcl::InterfaceCommunicator<layout_t>	m_intfcCom;
+		SPBalanceWeights						m_balanceWeights;
+		SpaceFillingCurveType					m_curve;
+};
+
+///	\}
+
+}//	end of namespace
+
+#endif	//__H__UG_partitioner_sfc
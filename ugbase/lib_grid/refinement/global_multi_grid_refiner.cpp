@@ -36,6 +36,10 @@
 #include "lib_grid/algorithms/algorithms.h"
 #include "lib_grid/file_io/file_io.h"
 
+#ifdef UG_OPENMP
+	#include <omp.h>
+#endif
+
 //define PROFILE_GLOBAL_MULTI_GRID_REFINER if you want to profile
 //the refinement code.
 #define PROFILE_GLOBAL_MULTI_GRID_REFINER
@@ -57,18 +61,70 @@ namespace ug
 GlobalMultiGridRefiner::
 GlobalMultiGridRefiner(SPRefinementProjector projector) :
 	IRefiner(projector),
-	m_pMG(NULL)
+	m_pMG(NULL),
+	m_bulkProjection(false)
 {
 }
 
 GlobalMultiGridRefiner::
 GlobalMultiGridRefiner(MultiGrid& mg, SPRefinementProjector projector) :
-	IRefiner(projector)
+	IRefiner(projector),
+	m_bulkProjection(false)
 {
 	m_pMG = NULL;
 	assign_grid(mg);
 }
 
+///	computes the positions of the given new vertices through the projector
+/**	The loop is threaded if the projector supports concurrent calls.*/
+template <class TParent>
+static void ProjectNewVertices(RefinementProjector& projector,
+							   const vector<pair<Vertex*, TParent*> >& newVrts)
+{
+	const int numVrts = (int)newVrts.size();
+	bool bSuccess = true;
+	string errMsg;
+
+#ifdef UG_OPENMP
+	#pragma omp parallel for schedule(static) if(projector.concurrent_new_vertex_supported())
+#endif
+	for(int i = 0; i < numVrts; ++i){
+		try{
+			projector.new_vertex(newVrts[i].first, newVrts[i].second);
+		}
+		catch(UGError& err){
+		//	exceptions must not leave the parallel region
+#ifdef UG_OPENMP
+			#pragma omp critical
+#endif
+			{
+				bSuccess = false;
+				errMsg = err.get_msg();
+			}
+		}
+		catch(std::exception& err){
+#ifdef UG_OPENMP
+			#pragma omp critical
+#endif
+			{
+				bSuccess = false;
+				errMsg = err.what();
+			}
+		}
+		catch(...){
+#ifdef UG_OPENMP
+			#pragma omp critical
+#endif
+			{
+				bSuccess = false;
+				errMsg = "unknown exception";
+			}
+		}
+	}
+
+	UG_COND_THROW(!bSuccess, "Projection of new vertices failed: " << errMsg);
+}
+
 GlobalMultiGridRefiner::~GlobalMultiGridRefiner()
 {
 	if(m_pMG)
@@ -244,6 +300,20 @@ void GlobalMultiGridRefiner::perform_refinement()
 	FaceDescriptor fd;
 	VolumeDescriptor vd;
 
+//	if bulk projection is enabled, new vertices are only collected here and
+//	projected after all new elements have been created
+	const bool bBulkProjection = m_bulkProjection && m_projector.valid();
+	vector<pair<Vertex*, Vertex*> >	vNewVrtsFromVrts;
+	vector<pair<Vertex*, Edge*> >	vNewVrtsFromEdges;
+	vector<pair<Vertex*, Face*> >	vNewVrtsFromFaces;
+	vector<pair<Vertex*, Volume*> >	vNewVrtsFromVols;
+	if(bBulkProjection){
+		vNewVrtsFromVrts.reserve(mg.num<Vertex>(oldTopLevel));
+		vNewVrtsFromEdges.reserve(mg.num<Edge>(oldTopLevel));
+		vNewVrtsFromFaces.reserve(mg.num<Quadrilateral>(oldTopLevel));
+		vNewVrtsFromVols.reserve(mg.num<Hexahedron>(oldTopLevel));
+	}
+
 	UG_DLOG(LIB_GRID, 1, "  creating new vertices\n");
 
 //	create new vertices from marked vertices
@@ -260,7 +330,9 @@ void GlobalMultiGridRefiner::perform_refinement()
 		Vertex* nVrt = *mg.create_by_cloning(v, v);
 
 	//	allow refCallback to calculate a new position
-		if(m_projector.valid())
+		if(bBulkProjection)
+			vNewVrtsFromVrts.push_back(pair<Vertex*, Vertex*>(nVrt, v));
+		else if(m_projector.valid())
 			m_projector->new_vertex(nVrt, v);
 		//GMGR_PROFILE_END();
 	}
@@ -309,7 +381,9 @@ void GlobalMultiGridRefiner::perform_refinement()
 		RegularVertex* nVrt = *mg.create<RegularVertex>(e);
 
 	//	allow refCallback to calculate a new position
-		if(m_projector.valid())
+		if(bBulkProjection)
+			vNewVrtsFromEdges.push_back(pair<Vertex*, Edge*>(nVrt, e));
+		else if(m_projector.valid())
 			m_projector->new_vertex(nVrt, e);
 		//GMGR_PROFILE_END();
 
@@ -356,7 +430,9 @@ void GlobalMultiGridRefiner::perform_refinement()
 				//GMGR_PROFILE(GMGR_Refine_CreatingVertices);
 				mg.register_element(newVrt, f);
 			//	allow refCallback to calculate a new position
-				if(m_projector.valid())
+				if(bBulkProjection)
+					vNewVrtsFromFaces.push_back(pair<Vertex*, Face*>(newVrt, f));
+				else if(m_projector.valid())
 					m_projector->new_vertex(newVrt, f);
 				//GMGR_PROFILE_END();
 			}
@@ -433,7 +509,9 @@ void GlobalMultiGridRefiner::perform_refinement()
 			if(newVrt){
 				mg.register_element(newVrt, v);
 			//	allow refCallback to calculate a new position
-				if(m_projector.valid())
+				if(bBulkProjection)
+					vNewVrtsFromVols.push_back(pair<Vertex*, Volume*>(newVrt, v));
+				else if(m_projector.valid())
 					m_projector->new_vertex(newVrt, v);
 			}
 
@@ -447,6 +525,16 @@ void GlobalMultiGridRefiner::perform_refinement()
 		//GMGR_PROFILE_END();
 	}
 
+	if(bBulkProjection){
+		UG_DLOG(LIB_GRID, 1, "  projecting new vertices\n");
+		GMGR_PROFILE(GMGR_BulkProjection);
+		ProjectNewVertices(*m_projector, vNewVrtsFromVrts);
+		ProjectNewVertices(*m_projector, vNewVrtsFromEdges);
+		ProjectNewVertices(*m_projector, vNewVrtsFromFaces);
+		ProjectNewVertices(*m_projector, vNewVrtsFromVols);
+		GMGR_PROFILE_END();
+	}
+
 //	done - clean up
 	if(!bHierarchicalInsertionWasEnabled)
 		mg.enable_hierarchical_insertion(false);
@@ -67,6 +67,15 @@ class GlobalMultiGridRefiner : public IRefiner, public GridObserver
 
 		virtual bool save_marks_to_file(const char* filename);
 
+	///	enables the bulk projection of new vertices
+	/**	If enabled, all new elements of a refinement step are created first and
+	 * the positions of the new vertices are computed afterwards in one pass.
+	 * If the projector supports concurrent calls to 'new_vertex' and UG was
+	 * built with OpenMP, this pass is threaded.
+	 * Disabled by default.*/
+		void enable_bulk_projection(bool enable)	{m_bulkProjection = enable;}
+		bool bulk_projection_enabled() const		{return m_bulkProjection;}
+
 	protected:
 	///	returns the number of (globally) marked edges on this level of the hierarchy
 		virtual void num_marked_edges_local(std::vector<int>& numMarkedEdgesOut);
@@ -107,6 +116,7 @@ class GlobalMultiGridRefiner : public IRefiner, public GridObserver
 		
 	protected:
 		MultiGrid*	m_pMG;
+		bool		m_bulkProjection;
 };
 
 /// @}
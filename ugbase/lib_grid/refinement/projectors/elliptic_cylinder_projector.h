@@ -93,6 +93,8 @@ class EllipticCylinderProjector
 
 		virtual ~EllipticCylinderProjector();
 
+		virtual bool concurrent_new_vertex_supported () const	{return true;}
+
 		void set_center(const vector3& center);
 		const vector3& center() const;
 
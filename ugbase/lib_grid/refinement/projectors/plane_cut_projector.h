@@ -66,6 +66,8 @@ public:
 
 	virtual ~PlaneCutProjector ()			{}
 
+	virtual bool concurrent_new_vertex_supported () const	{return true;}
+
 	void set_position (const vector3& position)		{m_p = position;}
 	const vector3& position () const				{return m_p;}
 
@@ -155,6 +155,25 @@ refinement_begins_requires_subgrid () const
 	return false;
 }
 
+bool ProjectionHandler::
+concurrent_new_vertex_supported () const
+{
+	if(m_defaultProjector.valid()
+		&& !m_defaultProjector->concurrent_new_vertex_supported())
+	{
+		return false;
+	}
+
+	for(size_t i = 0; i < m_projectors.size(); ++i){
+		if(m_projectors[i].valid()
+			&& !m_projectors[i]->concurrent_new_vertex_supported())
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
 void ProjectionHandler::
 refinement_begins (const ISubGrid* psg)
 {
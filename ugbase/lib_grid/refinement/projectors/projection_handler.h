@@ -146,6 +146,9 @@ public:
 
 	virtual void refinement_ends();
 
+///	returns true if all associated projectors support concurrent calls to 'new_vertex'
+	virtual bool concurrent_new_vertex_supported () const;
+
 ///	called when a new vertex was created from an old vertex.
 	virtual number new_vertex (Vertex* vrt, Vertex* parent);
 
@@ -33,6 +33,7 @@
 #ifndef __H__UG_refinement_projector
 #define __H__UG_refinement_projector
 
+#include <typeinfo>
 #include "common/boost_serialization.h"
 #include "common/error.h"
 #include "lib_grid/grid/geometry.h"
@@ -117,6 +118,21 @@ public:
 ///	called when refinement is done
 	virtual void refinement_ends()	{}
 
+///	returns 'true' if 'new_vertex' may be called concurrently for different vertices
+/**	Refiners may compute the positions of new vertices in a separate, threaded
+ * pass if this method returns true. This is the case if 'new_vertex' only reads
+ * the coordinates of the parent's corners and writes the coordinate of the
+ * given vertex.
+ *
+ * Concurrency is opt-in: only the plain linear projector returns true here.
+ * Derived classes whose 'new_vertex' methods are known to be thread safe
+ * have to overload this method and return 'true'.
+ */
+	virtual bool concurrent_new_vertex_supported () const
+	{
+		return typeid(*this) == typeid(RefinementProjector);
+	}
+
 ///	called when a new vertex was created from an old vertex.
 	virtual number new_vertex(Vertex* vrt, Vertex* parent)
 	{
@@ -108,6 +108,8 @@ public:
 
 	virtual ~SphereProjector ()					{}
 
+	virtual bool concurrent_new_vertex_supported () const	{return true;}
+
 	void set_center (const vector3& center)		{m_center = center;}
 	const vector3& center () const				{return m_center;}
 
@@ -52,6 +52,20 @@ public:
 	virtual bool match(Edge*, Edge*) = 0;
 	virtual bool match(Face*, Face*) = 0;
 	virtual bool match(Volume*, Volume*) {UG_THROW("not impled, because volume identification is not supported.")}
+
+	///	maps the center of an element onto the expected center of its partner
+	/**	Identifiers which provide such a mapping allow IdentifySubsets to find
+	 * partners through a spatial lookup instead of comparing all pairs of
+	 * elements. toleranceOut receives the maximal distance between the mapped
+	 * center and the center of a matching element. Candidates found this way
+	 * are still verified through match(). Coordinates of lower dimensional
+	 * domains are padded with zeros.
+	 * The default implementation returns false.*/
+	virtual bool map_center(vector3& partnerCenterOut, const vector3& center,
+							number& toleranceOut) const	{return false;}
+
+	///	returns true if match() may be called concurrently from several threads
+	virtual bool concurrent_match_supported() const	{return false;}
 };
 
 /// This class matches geometric elements which are parallel translated.
@@ -67,6 +81,10 @@ public:
 	virtual bool match(Edge* e1, Edge* e2) {return match_impl(e1, e2);}
 	virtual bool match(Face* f1, Face* f2) {return match_impl(f1, f2);}
 
+	virtual bool map_center(vector3& partnerCenterOut, const vector3& center,
+							number& toleranceOut) const;
+	virtual bool concurrent_match_supported() const	{return true;}
+
 	virtual ~ParallelShiftIdentifier() {}
 	typedef typename TPosAA::ValueType AttachmentType;
 	ParallelShiftIdentifier(TPosAA& aa) : m_aaPos(aa) {}
@@ -45,6 +45,9 @@
 #include <boost/mpl/at.hpp>
 
 #include <algorithm>
+#include <cmath>
+#include <utility>
+#include <vector>
 
 namespace ug {
 
@@ -74,6 +77,18 @@ bool ParallelShiftIdentifier<TAAPos>::match_impl(TElem* e1, TElem* e2) const {
 	return result;
 }
 
+template <class TAAPos>
+bool ParallelShiftIdentifier<TAAPos>::map_center(vector3& partnerCenterOut,
+		const vector3& center, number& toleranceOut) const
+{
+	vector3 shift;
+	VecCopy(shift, m_shift, 0);
+	VecSubtract(partnerCenterOut, center, shift);
+//	match_impl accepts squared distances below 10E-8
+	toleranceOut = std::sqrt(10E-8);
+	return true;
+}
+
 template <class TElem>
 void PeriodicBoundaryManager::identify(TElem* e1, TElem* e2,
 		IIdentifier& ident) {
@@ -576,6 +591,142 @@ void PeriodicBoundaryManager::check_elements_periodicity(
 	}
 }
 
+namespace detail{
+///	integer coordinates of a cell of the uniform grid used by IdentifyElements
+struct PeriodicCellKey
+{
+	long long c[3];
+
+	bool operator < (const PeriodicCellKey& k) const
+	{
+		if(c[0] != k.c[0]) return c[0] < k.c[0];
+		if(c[1] != k.c[1]) return c[1] < k.c[1];
+		return c[2] < k.c[2];
+	}
+};
+
+inline PeriodicCellKey PeriodicCellOfPoint(const vector3& p, number cellSize)
+{
+	PeriodicCellKey k;
+	for(int i = 0; i < 3; ++i)
+		k.c[i] = (long long)std::floor(p[i] / cellSize);
+	return k;
+}
+
+struct PeriodicCellEntryCmp
+{
+	bool operator () (const std::pair<PeriodicCellKey, size_t>& e1,
+					  const std::pair<PeriodicCellKey, size_t>& e2) const
+	{return e1.first < e2.first;}
+};
+}//	end of namespace detail
+
+///	identifies elements of goc1 on level lvl with matching elements of goc2
+/**	If the identifier provides a center mapping (see IIdentifier::map_center),
+ * the centers of all elements of goc2 are sorted into a uniform grid whose
+ * cells are twice as large as the matching tolerance. Partner candidates of
+ * an element of goc1 are then taken from the cells around its mapped center
+ * only and verified through IIdentifier::match, which leads to an
+ * O(n log(n)) identification. Candidate search is performed in parallel
+ * if UG_OPENMP is defined and the identifier supports concurrent matching.
+ * Otherwise all pairs of elements are compared.*/
+template <class TElem, class TAAPos>
+void IdentifyElements(PeriodicBoundaryManager& pbm, IIdentifier& ident,
+					  GridObjectCollection& goc1, GridObjectCollection& goc2,
+					  size_t lvl, TAAPos& aaPos)
+{
+	typedef std::pair<detail::PeriodicCellKey, size_t> CellEntry;
+
+	std::vector<TElem*> elems1(goc1.begin<TElem>(lvl), goc1.end<TElem>(lvl));
+	std::vector<TElem*> elems2(goc2.begin<TElem>(lvl), goc2.end<TElem>(lvl));
+	if(elems1.empty() || elems2.empty())
+		return;
+
+	vector3 tmp(0, 0, 0), tmpMapped;
+	number tol = 0;
+	if(!ident.map_center(tmpMapped, tmp, tol) || !(tol > 0)){
+		for(size_t i = 0; i < elems1.size(); ++i){
+			for(size_t j = 0; j < elems2.size(); ++j){
+				if(ident.match(elems1[i], elems2[j]))
+					pbm.identify(elems1[i], elems2[j], ident);
+			}
+		}
+		return;
+	}
+
+	const number cellSize = 2 * tol;
+	const int dim = TAAPos::ValueType::Size;
+#ifdef UG_OPENMP
+	const bool bThreaded = ident.concurrent_match_supported();
+#endif
+	const int num2 = (int)elems2.size();
+	const int num1 = (int)elems1.size();
+
+//	sort the elements of the second collection into cells
+	std::vector<CellEntry> cells(num2);
+	#ifdef UG_OPENMP
+	#pragma omp parallel for if(bThreaded)
+	#endif
+	for(int j = 0; j < num2; ++j){
+		vector3 c;
+		VecCopy(c, CalculateCenter(elems2[j], aaPos), 0);
+		cells[j] = CellEntry(detail::PeriodicCellOfPoint(c, cellSize), (size_t)j);
+	}
+	std::sort(cells.begin(), cells.end(), detail::PeriodicCellEntryCmp());
+
+//	find partners for each element of the first collection. Since
+//	PeriodicBoundaryManager::identify is not thread safe, the matching pairs
+//	are collected first and identified afterwards.
+	std::vector<std::pair<size_t, size_t> > matches;
+	#ifdef UG_OPENMP
+	#pragma omp parallel if(bThreaded)
+	#endif
+	{
+		std::vector<std::pair<size_t, size_t> > localMatches;
+
+		#ifdef UG_OPENMP
+		#pragma omp for nowait
+		#endif
+		for(int i = 0; i < num1; ++i){
+			vector3 c, mc;
+			number curTol;
+			VecCopy(c, CalculateCenter(elems1[i], aaPos), 0);
+			ident.map_center(mc, c, curTol);
+			const detail::PeriodicCellKey center = detail::PeriodicCellOfPoint(mc, cellSize);
+
+		//	check all cells adjacent to the cell containing the mapped center
+			detail::PeriodicCellKey k = center;
+			for(int d0 = -1; d0 <= 1; ++d0){
+			for(int d1 = (dim > 1 ? -1 : 0); d1 <= (dim > 1 ? 1 : 0); ++d1){
+			for(int d2 = (dim > 2 ? -1 : 0); d2 <= (dim > 2 ? 1 : 0); ++d2){
+				k.c[0] = center.c[0] + d0;
+				k.c[1] = center.c[1] + d1;
+				k.c[2] = center.c[2] + d2;
+				std::pair<typename std::vector<CellEntry>::iterator,
+						  typename std::vector<CellEntry>::iterator>
+					range = std::equal_range(cells.begin(), cells.end(),
+											 CellEntry(k, 0),
+											 detail::PeriodicCellEntryCmp());
+				for(; range.first != range.second; ++range.first){
+					const size_t j = range.first->second;
+					if(ident.match(elems1[i], elems2[j]))
+						localMatches.push_back(std::make_pair((size_t)i, j));
+				}
+			}}}
+		}
+
+		#ifdef UG_OPENMP
+		#pragma omp critical
+		#endif
+		matches.insert(matches.end(), localMatches.begin(), localMatches.end());
+	}
+
+//	identify in the order of the first collection, as a full comparison would do
+	std::sort(matches.begin(), matches.end());
+	for(size_t i = 0; i < matches.size(); ++i)
+		pbm.identify(elems1[matches[i].first], elems2[matches[i].second], ident);
+}
+
 template <class TDomain>
 void IdentifySubsets(TDomain& dom, const char* sName1, const char* sName2) {
 	// get subset handler from domain
@@ -671,7 +822,6 @@ void IdentifySubsets(TDomain& dom, int sInd1, int sInd2) {
 
 	// typedef typename mpl::at<m, TDomain>::type TElem;
 	typedef typename grid_dim_traits<TDomain::dim>::side_type	TElem;
-	typedef typename ElementStorage<TElem>::SectionContainer::iterator gocIter;
 
 	// calculate shift vector for top level
 	position_type c1 = CalculateCenter(goc1.begin<TElem>(0), goc1.end<TElem>(0),
@@ -686,15 +836,7 @@ void IdentifySubsets(TDomain& dom, int sInd1, int sInd2) {
 	for (size_t lvl = 0; lvl < goc1.num_levels(); lvl++) {
 		// identify corresponding elements for second subset. A element is considered
 		// to have symmetric element in second subset if there exists a shift vector between them.
-		// todo use kd-tree for fast lookup of shifted elements
-		for (gocIter iter1 = goc1.begin<TElem>(lvl);
-				iter1 != goc1.end<TElem>(lvl); ++iter1)
-			for (gocIter iter2 = goc2.begin<TElem>(lvl);
-					iter2 != goc2.end<TElem>(lvl); ++iter2) {
-				if(ident.match(*iter1, *iter2)) {
-					pbm.identify(*iter1, *iter2, ident);
-				}
-			}
+		IdentifyElements<TElem>(pbm, ident, goc1, goc2, lvl, aaPos);
 	}
 
 	// ensure periodic identification has been performed correctly
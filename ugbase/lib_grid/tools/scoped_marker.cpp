@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2017:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+
+#include <algorithm>
+#include "scoped_marker.h"
+
+namespace ug
+{
+
+#ifdef UG_CXX11
+	#define MARKER_POOL_LOCK	std::lock_guard<std::mutex> lock(m_mutex);
+#else
+	#define MARKER_POOL_LOCK
+#endif
+
+////////////////////////////////////////////////////////////////////////
+//	MarkerPool
+MarkerPool::MarkerPool(Grid& g) :
+	m_pGrid(&g)
+{
+}
+
+MarkerPool::~MarkerPool()
+{
+	for(size_t i = 0; i < m_vBuffers.size(); ++i)
+		delete m_vBuffers[i];
+}
+
+MarkerPool::Buffer* MarkerPool::acquire()
+{
+	MARKER_POOL_LOCK
+	Buffer* buf;
+	if(m_vFreeBuffers.empty()){
+		buf = new Buffer;
+		m_vBuffers.push_back(buf);
+	}
+	else{
+		buf = m_vFreeBuffers.back();
+		m_vFreeBuffers.pop_back();
+	}
+
+	if(++buf->stamp == 0){
+	//	the stamp wrapped around. Old stamps have to be erased.
+		for(int i = 0; i < NUM_GEOMETRIC_BASE_OBJECTS; ++i)
+			std::fill(buf->vMarks[i].begin(), buf->vMarks[i].end(), 0);
+		buf->stamp = 1;
+	}
+
+//	size buffers for all existing elements, so that marking does not
+//	reallocate (which would prevent concurrent marking)
+	buf->vMarks[VERTEX].resize(m_pGrid->attachment_container_size<Vertex>(), 0);
+	buf->vMarks[EDGE].resize(m_pGrid->attachment_container_size<Edge>(), 0);
+	buf->vMarks[FACE].resize(m_pGrid->attachment_container_size<Face>(), 0);
+	buf->vMarks[VOLUME].resize(m_pGrid->attachment_container_size<Volume>(), 0);
+	return buf;
+}
+
+void MarkerPool::release(Buffer* buf)
+{
+	MARKER_POOL_LOCK
+	m_vFreeBuffers.push_back(buf);
+}
+
+
+////////////////////////////////////////////////////////////////////////
+//	ScopedMarker
+ScopedMarker::ScopedMarker(Grid& g) :
+	m_pGrid(&g),
+	m_pPool(&g.marker_pool()),
+	m_pBuf(m_pPool->acquire())
+{
+}
+
+ScopedMarker::~ScopedMarker()
+{
+	m_pPool->release(m_pBuf);
+}
+
+void ScopedMarker::clear()
+{
+	if(++m_pBuf->stamp == 0){
+		for(int i = 0; i < NUM_GEOMETRIC_BASE_OBJECTS; ++i)
+			std::fill(m_pBuf->vMarks[i].begin(), m_pBuf->vMarks[i].end(), 0);
+		m_pBuf->stamp = 1;
+	}
+}
+
+}//	end of namespace
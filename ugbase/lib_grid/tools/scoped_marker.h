@@ -0,0 +1,212 @@
+/*
+ * Copyright (c) 2017:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+
+#ifndef __H__UG__scoped_marker__
+#define __H__UG__scoped_marker__
+
+#include <vector>
+#include "lib_grid/grid/grid.h"
+
+#ifdef UG_CXX11
+	#include <mutex>
+#endif
+
+namespace ug
+{
+
+/** \ingroup lib_grid_tools
+ *  \{ */
+
+///	Pool of mark buffers of a grid, used by ScopedMarker.
+/**	Each buffer holds one stamp per element (indexed by the grid data index
+ * of the element) for each base object type, together with the stamp of the
+ * marking sequence it is currently used for. Buffers are handed out to
+ * ScopedMarker instances and returned on their destruction, so that marks
+ * can be cleared in O(1) by increasing the stamp and memory is only
+ * allocated when more markers are alive at the same time than ever before.
+ *
+ * The grid calls element_registered for each new element. The entry of the
+ * element is then reset in all buffers, since the grid reuses the data
+ * indices of erased elements, and the buffers grow with the grid, so that
+ * marking never reallocates. As for attachments, this is a plain array
+ * access per buffer and is not synchronized: the grid must not be changed
+ * while markers are constructed in other threads.
+ *
+ * You normally don't use this class directly. Each grid creates its pool on
+ * construction, see Grid::marker_pool.
+ */
+class MarkerPool
+{
+	public:
+		struct Buffer{
+			Buffer() : stamp(0)	{}
+			std::vector<uint>	vMarks[NUM_GEOMETRIC_BASE_OBJECTS];
+			uint				stamp;
+		};
+
+		MarkerPool(Grid& g);
+		~MarkerPool();
+
+	///	returns a free buffer with a fresh stamp, sized for all elements of the grid
+		Buffer* acquire();
+	///	returns a buffer to the pool
+		void release(Buffer* buf);
+
+	///	number of buffers allocated so far (i.e. maximal number of simultaneous markers)
+		size_t num_buffers() const		{return m_vBuffers.size();}
+
+	///	resets the entry of a newly registered element in all buffers
+	/**	Called by the grid right after the element received its data index.*/
+		inline void element_registered(int baseObjId, uint ind)
+		{
+			for(size_t i = 0; i < m_vBuffers.size(); ++i){
+				std::vector<uint>& v = m_vBuffers[i]->vMarks[baseObjId];
+				if(ind < v.size())
+					v[ind] = 0;
+				else
+					v.resize(std::max<size_t>(ind + 1, 2 * v.size()), 0);
+			}
+		}
+
+	protected:
+		Grid*					m_pGrid;
+		std::vector<Buffer*>	m_vBuffers;
+		std::vector<Buffer*>	m_vFreeBuffers;
+#ifdef UG_CXX11
+		std::mutex				m_mutex;
+#endif
+};
+
+
+///	Marks elements of a grid for the lifetime of the marker.
+/**	This is a reentrant replacement for Grid::begin_marking, Grid::mark,
+ * Grid::is_marked and Grid::end_marking. Each ScopedMarker has its own mark
+ * storage (taken from the grid's MarkerPool), so that nested algorithms and
+ * algorithms running in different threads on the same grid can mark elements
+ * independently of each other and of the grid's own marks.
+ *
+ * Construction and clear() are O(1) (apart from the first time the pool has
+ * to allocate a buffer or the grid has grown), the marks are released on
+ * destruction.
+ *
+ * Threads may construct and use their own markers concurrently. A single
+ * marker may also be used by several threads at once, as long as different
+ * threads mark different elements. Marking never reallocates, since the mark
+ * storage always covers all elements of the grid.
+ *
+ * As for Grid::mark, the grid must not be defragmented while a marker is alive.
+ * Elements created while a marker is alive are unmarked, even if they reuse
+ * the data index of an erased element which was marked.
+ *
+ * \code
+ * ScopedMarker marker(grid);
+ * for(VertexIterator iter = grid.begin<Vertex>(); iter != grid.end<Vertex>(); ++iter)
+ * 	if(!marker.is_marked(*iter)) marker.mark(*iter);
+ * \endcode
+ */
+class ScopedMarker
+{
+	public:
+		explicit ScopedMarker(Grid& g);
+		~ScopedMarker();
+
+		Grid& grid()							{return *m_pGrid;}
+
+	///	unmarks all elements. O(1).
+		void clear();
+
+		inline void mark(Vertex* e)				{mark(VERTEX, e->grid_data_index());}
+		inline void mark(Edge* e)				{mark(EDGE, e->grid_data_index());}
+		inline void mark(Face* e)				{mark(FACE, e->grid_data_index());}
+		inline void mark(Volume* e)				{mark(VOLUME, e->grid_data_index());}
+		inline void mark(GridObject* e)			{mark(e->base_object_id(), e->grid_data_index());}
+
+		template <class TIter>
+		void mark(TIter begin, TIter end)
+		{
+			for(TIter iter = begin; iter != end; ++iter) mark(*iter);
+		}
+
+		inline void unmark(Vertex* e)			{unmark(VERTEX, e->grid_data_index());}
+		inline void unmark(Edge* e)				{unmark(EDGE, e->grid_data_index());}
+		inline void unmark(Face* e)				{unmark(FACE, e->grid_data_index());}
+		inline void unmark(Volume* e)			{unmark(VOLUME, e->grid_data_index());}
+		inline void unmark(GridObject* e)		{unmark(e->base_object_id(), e->grid_data_index());}
+
+		template <class TIter>
+		void unmark(TIter begin, TIter end)
+		{
+			for(TIter iter = begin; iter != end; ++iter) unmark(*iter);
+		}
+
+		inline bool is_marked(Vertex* e) const		{return is_marked(VERTEX, e->grid_data_index());}
+		inline bool is_marked(Edge* e) const		{return is_marked(EDGE, e->grid_data_index());}
+		inline bool is_marked(Face* e) const		{return is_marked(FACE, e->grid_data_index());}
+		inline bool is_marked(Volume* e) const		{return is_marked(VOLUME, e->grid_data_index());}
+		inline bool is_marked(GridObject* e) const	{return is_marked(e->base_object_id(), e->grid_data_index());}
+
+	private:
+		inline void mark(int baseObjId, uint ind)
+		{
+			std::vector<uint>& v = m_pBuf->vMarks[baseObjId];
+			UG_ASSERT(ind < v.size(), "ScopedMarker: mark storage does not cover "
+					  "the element. Was it created by a different grid?");
+			v[ind] = m_pBuf->stamp;
+		}
+
+		inline void unmark(int baseObjId, uint ind)
+		{
+			std::vector<uint>& v = m_pBuf->vMarks[baseObjId];
+			if(ind < v.size()) v[ind] = 0;
+		}
+
+		inline bool is_marked(int baseObjId, uint ind) const
+		{
+			const std::vector<uint>& v = m_pBuf->vMarks[baseObjId];
+			return ind < v.size() && v[ind] == m_pBuf->stamp;
+		}
+
+	//	copying is not allowed
+		ScopedMarker(const ScopedMarker&);
+		ScopedMarker& operator=(const ScopedMarker&);
+
+	private:
+		Grid*				m_pGrid;
+		MarkerPool*			m_pPool;
+		MarkerPool::Buffer*	m_pBuf;
+};
+
+/** \} */
+
+}//	end of namespace
+
+#endif
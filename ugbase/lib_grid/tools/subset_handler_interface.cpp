@@ -89,6 +89,7 @@ ISubsetHandler(uint supportedElements) :
 	m_defaultSubsetIndex = -1;
 	m_bSubsetInheritanceEnabled = true;
 	m_bStrictInheritanceEnabled = false;
+	m_assignmentRevision = 0;
 //	m_bSubsetAttachmentsEnabled = false;
 	m_defaultSubsetInfo.name = "defSub";
 	m_defaultSubsetInfo.materialIndex = 0;
@@ -106,6 +107,7 @@ ISubsetHandler(Grid& grid, uint supportedElements) :
 	m_defaultSubsetIndex = -1;
 	m_bSubsetInheritanceEnabled = true;
 	m_bStrictInheritanceEnabled = false;
+	m_assignmentRevision = 0;
 	//m_bSubsetAttachmentsEnabled = false;
 	m_defaultSubsetInfo.name = "defSub";
 	m_defaultSubsetInfo.materialIndex = 0;
@@ -545,6 +547,7 @@ reset_subset_indices(uint shElements)
 {
 	if(m_pGrid)
 	{
+		++m_assignmentRevision;
 		if((shElements & SHE_VERTEX) && elements_are_supported(SHE_VERTEX))
 			ResetSubsetIndices<Vertex>(m_pGrid, m_aaSubsetIndexVRT);
 		if((shElements & SHE_EDGE) && elements_are_supported(SHE_EDGE))
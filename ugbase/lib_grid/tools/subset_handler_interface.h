@@ -362,6 +362,11 @@ class UG_API ISubsetHandler : public GridObserver
 		inline int get_subset_index(Face* elem) const;
 		inline int get_subset_index(Volume* elem) const;
 
+	///	returns a counter which is increased whenever subset indices are written
+	/**	Classes which cache data depending on the subset assignment of existing
+	 *	elements may compare this value to detect that their data is outdated.*/
+		inline size_t assignment_revision() const	{return m_assignmentRevision;}
+
 	///	returns the index of the first subset with the given name.
 	/**	If no subset with the given name exists, -1 is returned.
 	 *
@@ -596,22 +601,22 @@ class UG_API ISubsetHandler : public GridObserver
 	 *	change_subset_indices or reset_subset_indices.
 	 *	WARNING: This method only alters the index but does not actually
 	 *	move the element to another subset. Use assign_subset instead for this task.*/
-		inline void alter_subset_index(Vertex* v, int subsetIndex)	{m_aaSubsetIndexVRT[v] = subsetIndex;}
+		inline void alter_subset_index(Vertex* v, int subsetIndex)	{m_aaSubsetIndexVRT[v] = subsetIndex; ++m_assignmentRevision;}
 	/**	alters the subset index only. Suited as a helper for methods like
 	 *	change_subset_indices or reset_subset_indices.
 	 *	WARNING: This method only alters the index but does not actually
 	 *	move the element to another subset. Use assign_subset instead for this task.*/
-		inline void alter_subset_index(Edge* e, int subsetIndex)	{m_aaSubsetIndexEDGE[e] = subsetIndex;}
+		inline void alter_subset_index(Edge* e, int subsetIndex)	{m_aaSubsetIndexEDGE[e] = subsetIndex; ++m_assignmentRevision;}
 	/**	alters the subset index only. Suited as a helper for methods like
 	 *	change_subset_indices or reset_subset_indices.
 	 *	WARNING: This method only alters the index but does not actually
 	 *	move the element to another subset. Use assign_subset instead for this task.*/
-		inline void alter_subset_index(Face* f, int subsetIndex)		{m_aaSubsetIndexFACE[f] = subsetIndex;}
+		inline void alter_subset_index(Face* f, int subsetIndex)		{m_aaSubsetIndexFACE[f] = subsetIndex; ++m_assignmentRevision;}
 	/**	alters the subset index only. Suited as a helper for methods like
 	 *	change_subset_indices or reset_subset_indices.
 	 *	WARNING: This method only alters the index but does not actually
 	 *	move the element to another subset. Use assign_subset instead for this task.*/
-		inline void alter_subset_index(Volume* v, int subsetIndex)		{m_aaSubsetIndexVOL[v] = subsetIndex;}
+		inline void alter_subset_index(Volume* v, int subsetIndex)		{m_aaSubsetIndexVOL[v] = subsetIndex; ++m_assignmentRevision;}
 
 		virtual void erase_subset_lists() = 0;
 
@@ -750,6 +755,7 @@ class UG_API ISubsetHandler : public GridObserver
 		bool			m_bSubsetInheritanceEnabled;
 		bool			m_bStrictInheritanceEnabled;
 		//bool			m_bSubsetAttachmentsEnabled;
+		size_t			m_assignmentRevision;
 
 		Grid::VertexAttachmentAccessor<ASubsetIndex>	m_aaSubsetIndexVRT;
 		Grid::EdgeAttachmentAccessor<ASubsetIndex>		m_aaSubsetIndexEDGE;
@@ -116,6 +116,7 @@ subset_assigned(Vertex* v, int subsetIndex)
 	}*/
 
 	m_aaSubsetIndexVRT[v] = subsetIndex;
+	++m_assignmentRevision;
 }
 
 inline void ISubsetHandler::
@@ -131,6 +132,7 @@ subset_assigned(Edge* e, int subsetIndex)
 	}*/
 
 	m_aaSubsetIndexEDGE[e] = subsetIndex;
+	++m_assignmentRevision;
 }
 
 inline void
@@ -147,6 +149,7 @@ subset_assigned(Face* f, int subsetIndex)
 	}*/
 
 	m_aaSubsetIndexFACE[f] = subsetIndex;
+	++m_assignmentRevision;
 }
 
 inline void
@@ -163,6 +166,7 @@ subset_assigned(Volume* v, int subsetIndex)
 	}*/
 
 	m_aaSubsetIndexVOL[v] = subsetIndex;
+	++m_assignmentRevision;
 }
 
 template <class TIterator>
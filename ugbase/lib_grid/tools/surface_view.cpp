@@ -122,6 +122,8 @@ is_local_surface_view_element(TElem* elem)
 void SurfaceView::
 refresh_surface_states()
 {
+	clear_element_lists();
+
 //todo	we need a global max-dim!!! (empty processes have to do the right thing, too)
 	int maxElem = -1;
 	if(m_pMG->num<Volume>() > 0) maxElem = VOLUME;
@@ -319,19 +321,65 @@ SurfaceView::SurfaceView(SmartPtr<MGSubsetHandler> spMGSH,
 	m_spMGSH(spMGSH),
 	m_adaptiveMG(adaptiveMG),
 	m_pMG(m_spMGSH->multi_grid()),
-	m_distGridMgr(m_spMGSH->multi_grid()->distributed_grid_manager())
+	m_distGridMgr(m_spMGSH->multi_grid()->distributed_grid_manager()),
+	m_elementListsSHRevision(0),
+	m_bUseElementLists(false)
 {
 	UG_ASSERT(m_pMG, "A MultiGrid has to be assigned to the given subset handler");
 
 	m_pMG->attach_to_all_dv(m_aSurfState, 0);
 	m_aaSurfState.access(*m_pMG, m_aSurfState);
 
+//	cached element lists have to be released on each change of the grid
+	m_pMG->register_observer(this, OT_GRID_OBSERVER | OT_VERTEX_OBSERVER
+									| OT_EDGE_OBSERVER | OT_FACE_OBSERVER
+									| OT_VOLUME_OBSERVER);
+
 	refresh_surface_states();
 }
 
 SurfaceView::~SurfaceView()
 {
+	m_pMG->unregister_observer(this);
 	m_pMG->detach_from_all(m_aSurfState);
 }
 
+void SurfaceView::
+enable_element_lists(bool enable)
+{
+	m_bUseElementLists = enable;
+	clear_element_lists();
+}
+
+void SurfaceView::grid_to_be_destroyed(Grid* grid)		{clear_element_lists();}
+void SurfaceView::elements_to_be_cleared(Grid* grid)	{clear_element_lists();}
+
+void SurfaceView::vertex_created(Grid* grid, Vertex* vrt,
+								 GridObject* pParent, bool replacesParent)
+{clear_element_lists();}
+
+void SurfaceView::edge_created(Grid* grid, Edge* e,
+							   GridObject* pParent, bool replacesParent)
+{clear_element_lists();}
+
+void SurfaceView::face_created(Grid* grid, Face* f,
+							   GridObject* pParent, bool replacesParent)
+{clear_element_lists();}
+
+void SurfaceView::volume_created(Grid* grid, Volume* vol,
+								 GridObject* pParent, bool replacesParent)
+{clear_element_lists();}
+
+void SurfaceView::vertex_to_be_erased(Grid* grid, Vertex* vrt, Vertex* replacedBy)
+{clear_element_lists();}
+
+void SurfaceView::edge_to_be_erased(Grid* grid, Edge* e, Edge* replacedBy)
+{clear_element_lists();}
+
+void SurfaceView::face_to_be_erased(Grid* grid, Face* f, Face* replacedBy)
+{clear_element_lists();}
+
+void SurfaceView::volume_to_be_erased(Grid* grid, Volume* vol, Volume* replacedBy)
+{clear_element_lists();}
+
 }// end of namespace
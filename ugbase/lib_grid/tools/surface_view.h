@@ -37,11 +37,15 @@
 	#include "lib_grid/parallelization/distributed_grid.h"
 #endif
 
+#include <map>
+#include <vector>
 #include "lib_grid/multi_grid.h"
+#include "lib_grid/grid/grid_observer.h"
 #include "lib_grid/tools/grid_level.h"
 #include "subset_handler_multi_grid.h"
 #include "lib_grid/algorithms/attachment_util.h"
 #include "common/util/flags.h"
+#include "common/util/smart_pointer.h"
 
 namespace ug{
 
@@ -56,8 +60,15 @@ namespace ug{
  * to ignore all levels above a specified level, resulting in a new surface-view
  * in which only surface elements up to the specified level and the elements in
  * the specified level are regarded as surface-view-elements.
+ *
+ * On adaptive multigrids, the surface elements of a grid level are spread
+ * over all levels of the hierarchy. If enabled (see enable_element_lists),
+ * iterators over such surface grid levels traverse contiguous element lists,
+ * which are created on first use and released whenever elements are created
+ * or erased in the underlying grid, subsets are reassigned and in
+ * refresh_surface_states.
  */
-class SurfaceView
+class SurfaceView : public GridObserver
 {
 	public:
 		/**
@@ -152,6 +163,35 @@ class SurfaceView
 	///	refresh_surface_states must be called after a grid change
 		void refresh_surface_states();
 
+	///	enables or disables cached element lists for surface iteration
+	/**	If enabled, iterators over surface grid levels of an adaptive multigrid
+	 * traverse cached element lists instead of visiting all elements of all
+	 * levels. Disabled by default.
+	 * The lists are released on element creation, element erasure and
+	 * refresh_surface_states and are rebuilt if the subset handler reports
+	 * a changed subset assignment (see ISubsetHandler::assignment_revision).*/
+		void enable_element_lists(bool enable);
+
+	///	returns true if cached element lists are used for surface iteration
+		bool element_lists_enabled() const		{return m_bUseElementLists;}
+
+	///	returns a contiguous list of the elements in the given subset of a grid level
+	/**	The list is created on first request and cached. It is valid until
+	 * elements are created or erased in the underlying grid, subsets are
+	 * reassigned or refresh_surface_states is called. Since the list is
+	 * contiguous, it may be split into ranges for threaded traversal.*/
+		template <class TElem>
+		const std::vector<TElem*>&
+		surface_elements(int si, const GridLevel& gl,
+						 SurfaceState validStates = ALL) const;
+
+	///	returns a contiguous list of the elements in all subsets of a grid level
+	/**	\sa surface_elements(int, const GridLevel&, SurfaceState)*/
+		template <class TElem>
+		const std::vector<TElem*>&
+		surface_elements(const GridLevel& gl,
+						 SurfaceState validStates = ALL) const;
+
 	///	returns an or combination of current surface states
 	/**	Please use the methods is_surface_element, is_shadowed and is_shadowing
 	 * instead of this method.
@@ -168,6 +208,34 @@ class SurfaceView
 								const GridLevel& gl,
 								bool clearContainer = true) const;
 
+	///	grid observer callbacks. They release cached element lists.
+	///	\{
+		virtual void grid_to_be_destroyed(Grid* grid);
+		virtual void elements_to_be_cleared(Grid* grid);
+
+		virtual void vertex_created(Grid* grid, Vertex* vrt,
+									GridObject* pParent = NULL,
+									bool replacesParent = false);
+		virtual void edge_created(Grid* grid, Edge* e,
+									GridObject* pParent = NULL,
+									bool replacesParent = false);
+		virtual void face_created(Grid* grid, Face* f,
+									GridObject* pParent = NULL,
+									bool replacesParent = false);
+		virtual void volume_created(Grid* grid, Volume* vol,
+									GridObject* pParent = NULL,
+									bool replacesParent = false);
+
+		virtual void vertex_to_be_erased(Grid* grid, Vertex* vrt,
+										 Vertex* replacedBy = NULL);
+		virtual void edge_to_be_erased(Grid* grid, Edge* e,
+										 Edge* replacedBy = NULL);
+		virtual void face_to_be_erased(Grid* grid, Face* f,
+										 Face* replacedBy = NULL);
+		virtual void volume_to_be_erased(Grid* grid, Volume* vol,
+										 Volume* replacedBy = NULL);
+	///	\}
+
 	public:
 		template <class TElem> class SurfaceViewElementIterator;
 		template <class TElem> class ConstSurfaceViewElementIterator;
@@ -192,6 +260,10 @@ class SurfaceView
 				                           SurfaceState validStates,
 				                           int si = -1);
 
+			///	creates an iterator traversing a cached element list
+				SurfaceViewElementIterator(bool start,
+				                           const std::vector<TElem*>* list);
+
 			public:
 				this_type operator ++()	{increment(); return *this;}
 				this_type operator ++(int unused)	{this_type i = *this; increment(); return i;}
@@ -229,6 +301,9 @@ class SurfaceView
 				int m_lvl;
 				typename geometry_traits<TElem>::iterator m_elemIter;
 				typename geometry_traits<TElem>::iterator m_iterEndSection;
+			//	only used if the iterator traverses a cached element list
+				const std::vector<TElem*>* m_pList;
+				size_t m_listPos;
 		};
 
 	///	Const iterator to traverse the surface of a multi-grid hierarchy
@@ -254,6 +329,10 @@ class SurfaceView
 						                        SurfaceState validStates,
 						                        int si = -1);
 
+			///	creates an iterator traversing a cached element list
+				ConstSurfaceViewElementIterator(bool start,
+				                                const std::vector<TElem*>* list);
+
 			public:
 				this_type operator ++()	{increment(); return *this;}
 				this_type operator ++(int unused)	{this_type i = *this; increment(); return i;}
@@ -291,6 +370,9 @@ class SurfaceView
 				int m_lvl;
 				typename geometry_traits<TElem>::const_iterator m_elemIter;
 				typename geometry_traits<TElem>::const_iterator m_iterEndSection;
+			//	only used if the iterator traverses a cached element list
+				const std::vector<TElem*>* m_pList;
+				size_t m_listPos;
 			};
 
 	public:
@@ -369,6 +451,49 @@ class SurfaceView
 		template <class TElem>
 		bool is_vmaster(TElem* elem) const;
 
+	///	returns true if iterators over the given grid level use cached element lists
+		bool use_element_lists(const GridLevel& gl) const
+		{return m_bUseElementLists && m_adaptiveMG && gl.is_surface();}
+
+	///	returns the cached element list for the given subset (all subsets if si < 0)
+		template <class TElem>
+		const std::vector<TElem*>&
+		element_list(int si, const GridLevel& gl, SurfaceState validStates) const;
+
+	///	releases all cached element lists
+		void clear_element_lists()
+		{if(!m_elementLists.empty()) m_elementLists.clear();}
+
+	///	identifies a cached element list
+		struct ElementListKey
+		{
+			int vals[7];
+			bool operator < (const ElementListKey& k) const
+			{
+				for(int i = 0; i < 7; ++i){
+					if(vals[i] != k.vals[i])
+						return vals[i] < k.vals[i];
+				}
+				return false;
+			}
+		};
+
+	///	type independent base of cached element lists
+		class IElementList
+		{
+			public:
+				virtual ~IElementList()	{}
+		};
+
+		template <class TElem>
+		class ElementList : public IElementList
+		{
+			public:
+				std::vector<TElem*>	elems;
+		};
+
+		typedef std::map<ElementListKey, SmartPtr<IElementList> >	ElementListMap;
+
 	private:
 		SmartPtr<MGSubsetHandler> 		m_spMGSH;
 		bool							m_adaptiveMG;
@@ -376,6 +501,11 @@ class SurfaceView
 		DistributedGridManager*			m_distGridMgr;
 		ASurfaceState									m_aSurfState;
 		MultiElementAttachmentAccessor<ASurfaceState>	m_aaSurfState;
+
+	///	cached element lists, created on demand by const methods
+		mutable ElementListMap							m_elementLists;
+		mutable size_t									m_elementListsSHRevision; ///< subset assignment revision of the cached lists
+		bool											m_bUseElementLists;
 };
 
 /** \} */
@@ -59,8 +59,9 @@ SurfaceViewElementIterator(bool start,
 
 	m_elemIter(start ? sv->subset_handler()->begin<TElem>(m_si, m_lvl)
 					 : sv->subset_handler()->end<TElem>(m_toSI, m_topLvl)),
-	m_iterEndSection(sv->subset_handler()->end<TElem>(m_si, m_lvl))
-
+	m_iterEndSection(sv->subset_handler()->end<TElem>(m_si, m_lvl)),
+	m_pList(NULL),
+	m_listPos(0)
 {
 	UG_ASSERT(m_topLvl >= 0 && m_topLvl < (int)sv->subset_handler()->num_levels(),
 	          "Invalid level: "<<m_topLvl<<" [min: 0, max: "<<sv->subset_handler()->num_levels()<<"]");
@@ -92,13 +93,34 @@ SurfaceViewElementIterator() :
 	m_topLvl(0),
 	m_lvl(0),
 	m_elemIter(),
-	m_iterEndSection()
+	m_iterEndSection(),
+	m_pList(NULL),
+	m_listPos(0)
+{}
+
+template <class TElem>
+SurfaceView::SurfaceViewElementIterator<TElem>::
+SurfaceViewElementIterator(bool start, const std::vector<TElem*>* list) :
+	m_pSurfView(NULL),
+	m_gl(),
+	m_validStates(0),
+	m_fromSI(0),
+	m_toSI(0),
+	m_si(0),
+	m_topLvl(0),
+	m_lvl(0),
+	m_elemIter(),
+	m_iterEndSection(),
+	m_pList(list),
+	m_listPos(start ? 0 : list->size())
 {}
 
 template <class TElem>
 bool SurfaceView::SurfaceViewElementIterator<TElem>::
 equal(SurfaceView::SurfaceViewElementIterator<TElem> const& other) const
 {
+	if(m_pList)
+		return (m_listPos == other.m_listPos);
 	return (m_elemIter == other.m_elemIter);
 }
 
@@ -139,6 +161,11 @@ template <class TElem>
 void SurfaceView::SurfaceViewElementIterator<TElem>::
 increment()
 {
+	if(m_pList){
+		++m_listPos;
+		return;
+	}
+
 //	we search the next non-shadowed element
 	do
 	{
@@ -159,6 +186,8 @@ typename SurfaceView::SurfaceViewElementIterator<TElem>::TValue
 SurfaceView::SurfaceViewElementIterator<TElem>::
 dereference() const
 {
+	if(m_pList)
+		return (*m_pList)[m_listPos];
 	return *m_elemIter;
 }
 
@@ -205,6 +234,8 @@ ConstSurfaceViewElementIterator(const SurfaceView::SurfaceViewElementIterator<TE
 	m_lvl = iter.m_lvl;
 	m_elemIter = iter.m_elemIter;
 	m_iterEndSection = iter.m_iterEndSection;
+	m_pList = iter.m_pList;
+	m_listPos = iter.m_listPos;
 }
 
 template <class TElem>
@@ -219,7 +250,9 @@ ConstSurfaceViewElementIterator() :
 	m_topLvl(0),
 	m_lvl(0),
 	m_elemIter(),
-	m_iterEndSection()
+	m_iterEndSection(),
+	m_pList(NULL),
+	m_listPos(0)
 {}
 
 template <class TElem>
@@ -242,8 +275,9 @@ ConstSurfaceViewElementIterator(bool start,
 
 	m_elemIter(start ? sv->subset_handler()->begin<TElem>(m_si, m_lvl)
 					 : sv->subset_handler()->end<TElem>(m_toSI, m_topLvl)),
-	m_iterEndSection(sv->subset_handler()->end<TElem>(m_si, m_lvl))
-
+	m_iterEndSection(sv->subset_handler()->end<TElem>(m_si, m_lvl)),
+	m_pList(NULL),
+	m_listPos(0)
 {
 	UG_ASSERT(m_topLvl >= 0 && m_topLvl < (int)sv->subset_handler()->num_levels(),
 			  "Invalid level: "<<m_topLvl<<" [min: 0, max: "<<sv->subset_handler()->num_levels()<<"]");
@@ -263,10 +297,29 @@ ConstSurfaceViewElementIterator(bool start,
 	if(!is_contained(*m_elemIter)){increment(); return;}
 }
 
+template <class TElem>
+SurfaceView::ConstSurfaceViewElementIterator<TElem>::
+ConstSurfaceViewElementIterator(bool start, const std::vector<TElem*>* list) :
+	m_pSurfView(NULL),
+	m_gl(),
+	m_validStates(0),
+	m_fromSI(0),
+	m_toSI(0),
+	m_si(0),
+	m_topLvl(0),
+	m_lvl(0),
+	m_elemIter(),
+	m_iterEndSection(),
+	m_pList(list),
+	m_listPos(start ? 0 : list->size())
+{}
+
 template <class TElem>
 bool SurfaceView::ConstSurfaceViewElementIterator<TElem>::
 equal(SurfaceView::ConstSurfaceViewElementIterator<TElem> const& other) const
 {
+	if(m_pList)
+		return (m_listPos == other.m_listPos);
 	return (m_elemIter == other.m_elemIter);
 }
 
@@ -307,6 +360,11 @@ template <class TElem>
 void SurfaceView::ConstSurfaceViewElementIterator<TElem>::
 increment()
 {
+	if(m_pList){
+		++m_listPos;
+		return;
+	}
+
 //	this iterator should only be enabled for optimization work
 	// PROFILE_FUNC_GROUP("SurfaceView::iterator")
 //	we search the next non-shadowed element
@@ -328,6 +386,8 @@ typename SurfaceView::ConstSurfaceViewElementIterator<TElem>::TValue
 SurfaceView::ConstSurfaceViewElementIterator<TElem>::
 dereference() const
 {
+	if(m_pList)
+		return (*m_pList)[m_listPos];
 	return *m_elemIter;
 }
 
@@ -364,6 +424,8 @@ typename SurfaceView::traits<TElem>::iterator SurfaceView::
 begin(int si, const GridLevel& gl, SurfaceState validStates)
 {
 	UG_ASSERT(si >= 0 && si < m_spMGSH->num_subsets(), "Invalid subset: "<<si);
+	if(use_element_lists(gl))
+		return typename traits<TElem>::iterator(true, &element_list<TElem>(si, gl, validStates));
 	return typename traits<TElem>::iterator(true, this, gl, validStates, si);
 }
 
@@ -372,6 +434,8 @@ typename SurfaceView::traits<TElem>::iterator SurfaceView::
 end(int si, const GridLevel& gl, SurfaceState validStates)
 {
 	UG_ASSERT(si >= 0 && si < m_spMGSH->num_subsets(), "Invalid subset: "<<si);
+	if(use_element_lists(gl))
+		return typename traits<TElem>::iterator(false, &element_list<TElem>(si, gl, validStates));
 	return typename traits<TElem>::iterator(false, this, gl, validStates, si);
 }
 
@@ -380,6 +444,8 @@ typename SurfaceView::traits<TElem>::const_iterator SurfaceView::
 begin(int si, const GridLevel& gl, SurfaceState validStates) const
 {
 	UG_ASSERT(si >= 0 && si < m_spMGSH->num_subsets(), "Invalid subset: "<<si);
+	if(use_element_lists(gl))
+		return typename traits<TElem>::const_iterator(true, &element_list<TElem>(si, gl, validStates));
 	return typename traits<TElem>::const_iterator(true, this, gl, validStates, si);
 }
 
@@ -388,6 +454,8 @@ typename SurfaceView::traits<TElem>::const_iterator SurfaceView::
 end(int si, const GridLevel& gl, SurfaceState validStates) const
 {
 	UG_ASSERT(si >= 0 && si < m_spMGSH->num_subsets(), "Invalid subset: "<<si);
+	if(use_element_lists(gl))
+		return typename traits<TElem>::const_iterator(false, &element_list<TElem>(si, gl, validStates));
 	return typename traits<TElem>::const_iterator(false, this, gl, validStates, si);
 }
 
@@ -395,6 +463,8 @@ template <class TElem>
 typename SurfaceView::traits<TElem>::iterator SurfaceView::
 begin(const GridLevel& gl, SurfaceState validStates)
 {
+	if(use_element_lists(gl))
+		return typename traits<TElem>::iterator(true, &element_list<TElem>(-1, gl, validStates));
 	return typename traits<TElem>::iterator(true, this, gl, validStates);
 }
 
@@ -402,6 +472,8 @@ template <class TElem>
 typename SurfaceView::traits<TElem>::iterator SurfaceView::
 end(const GridLevel& gl, SurfaceState validStates)
 {
+	if(use_element_lists(gl))
+		return typename traits<TElem>::iterator(false, &element_list<TElem>(-1, gl, validStates));
 	return typename traits<TElem>::iterator(false, this, gl, validStates);
 }
 
@@ -409,6 +481,8 @@ template <class TElem>
 typename SurfaceView::traits<TElem>::const_iterator SurfaceView::
 begin(const GridLevel& gl, SurfaceState validStates) const
 {
+	if(use_element_lists(gl))
+		return typename traits<TElem>::const_iterator(true, &element_list<TElem>(-1, gl, validStates));
 	return typename traits<TElem>::const_iterator(true, this, gl, validStates);
 }
 
@@ -416,9 +490,74 @@ template <class TElem>
 typename SurfaceView::traits<TElem>::const_iterator SurfaceView::
 end(const GridLevel& gl, SurfaceState validStates) const
 {
+	if(use_element_lists(gl))
+		return typename traits<TElem>::const_iterator(false, &element_list<TElem>(-1, gl, validStates));
 	return typename traits<TElem>::const_iterator(false, this, gl, validStates);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+//	cached element lists
+////////////////////////////////////////////////////////////////////////////////
+
+template <class TElem>
+const std::vector<TElem*>& SurfaceView::
+element_list(int si, const GridLevel& gl, SurfaceState validStates) const
+{
+	typedef typename traits<TElem>::const_iterator const_iterator;
+
+	ElementListKey key;
+	key.vals[0] = geometry_traits<TElem>::BASE_OBJECT_ID;
+	key.vals[1] = geometry_traits<TElem>::CONTAINER_SECTION;
+	key.vals[2] = si;
+	key.vals[3] = gl.type();
+	key.vals[4] = gl.top() ? ((int)m_spMGSH->num_levels() - 1) : gl.level();
+	key.vals[5] = gl.ghosts();
+	key.vals[6] = validStates.get();
+
+	ElementList<TElem>* list = NULL;
+
+//	lists may be requested concurrently by threaded consumers
+	#ifdef UG_OPENMP
+	#pragma omp critical(SurfaceView_element_list)
+	#endif
+	{
+	//	subset assignments of existing elements are not observed otherwise
+		if(m_elementListsSHRevision != m_spMGSH->assignment_revision()){
+			m_elementLists.clear();
+			m_elementListsSHRevision = m_spMGSH->assignment_revision();
+		}
+
+		SmartPtr<IElementList>& entry = m_elementLists[key];
+		if(entry.invalid()){
+		//	collect the elements by traversing the hierarchy once
+			SmartPtr<ElementList<TElem> > newList = make_sp(new ElementList<TElem>);
+			const_iterator iter(true, this, gl, validStates, si);
+			const_iterator iterEnd(false, this, gl, validStates, si);
+			for(; iter != iterEnd; ++iter)
+				newList->elems.push_back(*iter);
+			entry = newList;
+		}
+		list = static_cast<ElementList<TElem>*>(entry.get());
+	}
+
+	return list->elems;
+}
+
+template <class TElem>
+const std::vector<TElem*>& SurfaceView::
+surface_elements(int si, const GridLevel& gl, SurfaceState validStates) const
+{
+	UG_ASSERT(si >= 0 && si < m_spMGSH->num_subsets(), "Invalid subset: "<<si);
+	return element_list<TElem>(si, gl, validStates);
+}
+
+template <class TElem>
+const std::vector<TElem*>& SurfaceView::
+surface_elements(const GridLevel& gl, SurfaceState validStates) const
+{
+	return element_list<TElem>(-1, gl, validStates);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 //	implementation of SurfaceView
 ////////////////////////////////////////////////////////////////////////////////
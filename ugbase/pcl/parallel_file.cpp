@@ -35,6 +35,9 @@
 #include "common/log.h"
 #include <map>
 #include <string>
+#include <vector>
+#include <limits>
+#include <cstdio>
 #include <mpi.h>
 
 namespace pcl{
@@ -87,6 +90,76 @@ void WriteCombinedParallelFile(ug::BinaryBuffer &buffer, std::string strFilename
 	MPI_File_close(&fh);
 }
 
+void WriteConcatenatedParallelFile(const char* data, size_t size, std::string strFilename, pcl::ProcessCommunicator pc)
+{
+	if(pc.empty())
+		return;
+
+	MPI_Status status;
+	MPI_Comm mpiComm = pc.get_mpi_communicator();
+	MPI_File fh;
+
+	UG_COND_THROW(size > (size_t)std::numeric_limits<int>::max(),
+				  "WriteConcatenatedParallelFile: too much data on one core ("
+				  << size << " bytes) for " << strFilename);
+
+	std::vector<char> filename(strFilename.begin(), strFilename.end());
+	filename.push_back(0);
+	if(MPI_File_open(mpiComm, &filename.front(), MPI_MODE_CREATE | MPI_MODE_WRONLY, MPI_INFO_NULL, &fh))
+		UG_THROW("could not open "<<strFilename);
+
+//	remove old content
+	MPI_File_set_size(fh, 0);
+
+	long long mySize = size;
+	long long myOffset = 0;
+	MPI_Exscan(&mySize, &myOffset, 1, MPI_LONG_LONG, MPI_SUM, mpiComm);
+//	the result of MPI_Exscan is undefined on the first core
+	if(pc.get_proc_id(0) == pcl::ProcRank())
+		myOffset = 0;
+
+	MPI_File_write_at_all(fh, myOffset, const_cast<char*>(data), (int)size, MPI_BYTE, &status);
+	MPI_File_close(&fh);
+}
+
+long long CreateCombinedParallelFile(size_t size, std::string strFilename, pcl::ProcessCommunicator pc)
+{
+	MPI_Comm mpiComm = pc.get_mpi_communicator();
+	bool bFirst = pc.get_proc_id(0) == pcl::ProcRank();
+
+	long long mySize = size;
+	long long myNextOffset = 0;
+	MPI_Scan(&mySize, &myNextOffset, 1, MPI_LONG_LONG, MPI_SUM, mpiComm);
+
+	std::vector<long long> allNextOffsets;
+	allNextOffsets.resize(pc.size(), 0);
+
+	myNextOffset += (pc.size())*sizeof(long long) + sizeof(int);
+	MPI_Gather(&myNextOffset, 1, MPI_LONG_LONG, &allNextOffsets[0], 1, MPI_LONG_LONG, pc.get_proc_id(0), mpiComm);
+
+//	the first core creates the file and writes the header
+	int ok = 1;
+	if(bFirst)
+	{
+		FILE* file = fopen(strFilename.c_str(), "wb");
+		if(file){
+			int numProcs = pcl::NumProcs();
+			if(fwrite(&numProcs, sizeof(numProcs), 1, file) != 1
+				|| fwrite(&allNextOffsets[0], sizeof(long long), allNextOffsets.size(), file)
+					!= allNextOffsets.size())
+				ok = 0;
+			if(fclose(file) != 0) ok = 0;
+		}
+		else ok = 0;
+	}
+
+//	the file has to exist, before the other cores write to it
+	int allOk = pc.allreduce(ok, PCL_RO_MIN);
+	UG_COND_THROW(allOk == 0, "could not create "<<strFilename);
+
+	return myNextOffset - mySize;
+}
+
 void ReadCombinedParallelFile(ug::BinaryBuffer &buffer, std::string strFilename, pcl::ProcessCommunicator pc)
 {
 	MPI_Status status;
@@ -89,5 +89,33 @@ void WriteCombinedParallelFile(ug::BinaryBuffer &buffer, std::string strFilename
  */
 void ReadCombinedParallelFile(ug::BinaryBuffer &buffer, std::string strFilename, pcl::ProcessCommunicator pc = pcl::ProcessCommunicator(pcl::PCD_WORLD));
 
+
+/**
+ * This function writes the data of all participating cores into one file.
+ * The data blocks are concatenated in the order of the ranks in pc, no
+ * additional header is written. Cores may contribute empty blocks.
+ * The file is written collectively using MPI-IO, so that only one file has to
+ * be created, regardless of the number of cores.
+ *
+ * @param data			the data of this core
+ * @param size			number of bytes in data
+ * @param strFilename	the filename
+ * @param pc			a processes communicator (default pcl::World)
+ */
+void WriteConcatenatedParallelFile(const char* data, size_t size, std::string strFilename, pcl::ProcessCommunicator pc = pcl::ProcessCommunicator(pcl::PCD_WORLD));
+
+/**
+ * Creates a file in the format of WriteCombinedParallelFile, but only writes
+ * the header. The data of all cores can then be written at the returned
+ * offsets without further communication, e.g. asynchronously by
+ * ug::AsyncFileWriter.
+ *
+ * @param size			number of bytes this core will write
+ * @param strFilename	the filename
+ * @param pc			a processes communicator (default pcl::World)
+ * @return				the offset (in bytes) of the data of this core
+ */
+long long CreateCombinedParallelFile(size_t size, std::string strFilename, pcl::ProcessCommunicator pc = pcl::ProcessCommunicator(pcl::PCD_WORLD));
+
 }
 #endif /* PARALLEL_ARCHIVE_H_ */
@@ -37,6 +37,7 @@
 #include "pcl_methods.h"
 #include "pcl_communication_structs.h"
 #include "pcl_interface_communicator.h"
+#include "pcl_interface_comm_plan.h"
 #include "pcl_process_communicator.h"
 #include "pcl_util.h"
 #include "pcl_debug.h"
@@ -0,0 +1,197 @@
+/*
+ * Copyright (c) 2017:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+
+#ifndef __H__PCL__PCL_INTERFACE_COMM_PLAN__
+#define __H__PCL__PCL_INTERFACE_COMM_PLAN__
+
+#include <vector>
+#include "mpi.h"
+#include "pcl_communication_structs.h"
+#include "pcl_process_communicator.h"
+
+namespace pcl
+{
+
+/// \addtogroup pcl
+/// \{
+
+////////////////////////////////////////////////////////////////////////
+//	InterfaceCommPlan
+///	A precompiled exchange of fixed size values between the interfaces of two layouts.
+/**	While the InterfaceCommunicator collects arbitrary data through
+ * communication policies into growing binary buffers, negotiates buffer sizes
+ * if necessary and posts new requests on each call, an InterfaceCommPlan is
+ * bound once to a send- and a receive-layout and to a fixed value size.
+ * During init() the interface elements of both layouts are flattened into
+ * contiguous gather / scatter lists (ordered by process and, for each process,
+ * in the same order the InterfaceCommunicator would pack them), contiguous
+ * send and receive buffers are allocated and persistent MPI requests
+ * (MPI_Send_init / MPI_Recv_init) are created for each neighbor process.
+ *
+ * A communication step then consists of:
+ * - writing the values for send_element(i) to send_value(i),
+ * - start() and wait() (or simply communicate()),
+ * - reading the values for recv_element(i) from recv_value(i).
+ *
+ * No sizes are exchanged and no memory is allocated during a communication
+ * step. Values are stored as raw bytes, i.e. the exchanged value type has to
+ * be trivially copyable.
+ *
+ * \note	A plan has to be initialized and used collectively by all processes
+ *			which are connected through the given layouts. If the layouts
+ *			change, init() has to be called again.
+ * \note	Requests are posted on the MPI communicator of the ProcessCommunicator
+ *			passed to init(), which has to contain all processes that are
+ *			referenced by the layouts. Several plans may share a communicator
+ *			and a tag, as long as each plan is completed through wait() before
+ *			the next one is started.
+ */
+template <class TLayout>
+class InterfaceCommPlan
+{
+	public:
+		typedef TLayout 					Layout;
+		typedef typename Layout::Interface	Interface;
+		typedef typename Layout::Element	Element;
+
+	public:
+		InterfaceCommPlan();
+		~InterfaceCommPlan();
+
+	///	builds gather / scatter lists, buffers and persistent requests
+	/**	Values are sent through the interfaces of sendLayout and received
+	 * through the interfaces of recvLayout. valueSize is the size in bytes of
+	 * a single value that is associated with an interface element.
+	 * Process ids in the layouts are global ranks. They are translated to
+	 * ranks of procComm, on whose MPI communicator all requests are posted.*/
+		void init(const Layout& sendLayout, const Layout& recvLayout,
+				  size_t valueSize, const ProcessCommunicator& procComm,
+				  int tag = 749346);
+
+	///	returns true if the plan was built from layouts with the given content
+	/**	Flattens both layouts again and compares them with the stored
+	 * gather / scatter lists. This is expensive and meant for debug checks.*/
+		bool matches(const Layout& sendLayout, const Layout& recvLayout) const;
+
+	///	frees all requests and buffers
+		void clear();
+
+	///	returns true if init() has been called
+		bool initialized() const				{return m_bInitialized;}
+
+	///	size in bytes of a single value
+		size_t value_size() const				{return m_valueSize;}
+
+	///	number of values which are sent in each communication step
+		size_t num_send_values() const			{return m_vSendElems.size();}
+
+	///	interface element associated with the i-th send value
+		const Element& send_element(size_t i) const	{return m_vSendElems[i];}
+
+	///	memory of the i-th send value
+		void* send_value(size_t i)				{return &m_vSendBuf[i * m_valueSize];}
+
+	///	number of values which are received in each communication step
+		size_t num_recv_values() const			{return m_vRecvElems.size();}
+
+	///	interface element associated with the i-th received value
+		const Element& recv_element(size_t i) const	{return m_vRecvElems[i];}
+
+	///	memory of the i-th received value
+		const void* recv_value(size_t i) const	{return &m_vRecvBuf[i * m_valueSize];}
+
+	///	starts all receives and sends of the plan.
+	/**	Values in the send buffer have to be written before start is called.
+	 *	A call to start() has to be followed by a call to wait().*/
+		void start();
+
+	///	waits until all receives and sends of the plan are completed
+		void wait();
+
+	///	calls start() directly followed by wait()
+		void communicate()						{start(); wait();}
+
+	protected:
+	///	appends the interface elements of a layout to the given lists
+		static void flatten_layout(const Layout& layout,
+								   std::vector<int>& vProcsOut,
+								   std::vector<size_t>& vOffsetsOut,
+								   std::vector<Element>& vElemsOut,
+								   const layout_tags::single_level_layout_tag&);
+
+		static void flatten_layout(const Layout& layout,
+								   std::vector<int>& vProcsOut,
+								   std::vector<size_t>& vOffsetsOut,
+								   std::vector<Element>& vElemsOut,
+								   const layout_tags::multi_level_layout_tag&);
+
+	private:
+	//	plans own persistent requests and are thus not copyable
+		InterfaceCommPlan(const InterfaceCommPlan&);
+		InterfaceCommPlan& operator=(const InterfaceCommPlan&);
+
+	private:
+	///	communicator on which the requests are posted. Keeps the MPI communicator alive.
+		ProcessCommunicator		m_procComm;
+
+	///	neighbor processes (global ranks) and offsets into the element lists (size: numProcs + 1)
+		std::vector<int>		m_vSendProcs;
+		std::vector<size_t>		m_vSendOffsets;
+		std::vector<int>		m_vRecvProcs;
+		std::vector<size_t>		m_vRecvOffsets;
+
+	///	flattened gather / scatter lists
+		std::vector<Element>	m_vSendElems;
+		std::vector<Element>	m_vRecvElems;
+
+	///	contiguous communication buffers
+		std::vector<char>		m_vSendBuf;
+		std::vector<char>		m_vRecvBuf;
+
+	///	persistent requests. Receives first, then sends.
+		std::vector<MPI_Request>	m_vRequests;
+
+		size_t	m_valueSize;
+		bool	m_bInitialized;
+		bool	m_bActive;
+};
+
+// end group pcl
+/// \}
+
+}//	end of namespace pcl
+
+////////////////////////////////////////
+//	include implementation
+#include "pcl_interface_comm_plan_impl.hpp"
+
+#endif
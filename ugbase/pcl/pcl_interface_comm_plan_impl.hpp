@@ -0,0 +1,310 @@
+/*
+ * Copyright (c) 2017:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+
+#ifndef __H__PCL__PCL_INTERFACE_COMM_PLAN_IMPL__
+#define __H__PCL__PCL_INTERFACE_COMM_PLAN_IMPL__
+
+#include <map>
+#include "pcl_interface_comm_plan.h"
+#include "pcl_comm_world.h"
+#include "pcl_methods.h"
+#include "pcl_profiling.h"
+#include "common/error.h"
+
+namespace pcl
+{
+
+template <class TLayout>
+InterfaceCommPlan<TLayout>::
+InterfaceCommPlan() :
+	m_procComm(PCD_LOCAL),
+	m_valueSize(0),
+	m_bInitialized(false),
+	m_bActive(false)
+{
+}
+
+template <class TLayout>
+InterfaceCommPlan<TLayout>::
+~InterfaceCommPlan()
+{
+//	we may not throw in the destructor. Pending requests are completed first.
+	if(m_bActive){
+		Waitall(m_vRequests);
+		m_bActive = false;
+	}
+	clear();
+}
+
+////////////////////////////////////////////////////////////////////////
+template <class TLayout>
+void InterfaceCommPlan<TLayout>::
+flatten_layout(const Layout& layout,
+			   std::vector<int>& vProcsOut,
+			   std::vector<size_t>& vOffsetsOut,
+			   std::vector<Element>& vElemsOut,
+			   const layout_tags::single_level_layout_tag&)
+{
+	for(typename Layout::const_iterator li = layout.begin();
+		li != layout.end(); ++li)
+	{
+		const Interface& interface = layout.interface(li);
+		if(interface.empty())
+			continue;
+
+		vProcsOut.push_back(layout.proc_id(li));
+		for(typename Interface::const_iterator iter = interface.begin();
+			iter != interface.end(); ++iter)
+		{
+			vElemsOut.push_back(interface.get_element(iter));
+		}
+		vOffsetsOut.push_back(vElemsOut.size());
+	}
+}
+
+////////////////////////////////////////////////////////////////////////
+template <class TLayout>
+void InterfaceCommPlan<TLayout>::
+flatten_layout(const Layout& layout,
+			   std::vector<int>& vProcsOut,
+			   std::vector<size_t>& vOffsetsOut,
+			   std::vector<Element>& vElemsOut,
+			   const layout_tags::multi_level_layout_tag&)
+{
+//	the InterfaceCommunicator packs all interfaces to one process into one
+//	buffer, level by level. We mimic this order by collecting the elements
+//	for each process in a separate list first.
+	std::map<int, std::vector<Element> > procElems;
+	for(size_t lvl = 0; lvl < layout.num_levels(); ++lvl){
+		for(typename Layout::const_iterator li = layout.begin(lvl);
+			li != layout.end(lvl); ++li)
+		{
+			const Interface& interface = layout.interface(li);
+			if(interface.empty())
+				continue;
+
+			std::vector<Element>& elems = procElems[layout.proc_id(li)];
+			for(typename Interface::const_iterator iter = interface.begin();
+				iter != interface.end(); ++iter)
+			{
+				elems.push_back(interface.get_element(iter));
+			}
+		}
+	}
+
+	for(typename std::map<int, std::vector<Element> >::iterator iter = procElems.begin();
+		iter != procElems.end(); ++iter)
+	{
+		vProcsOut.push_back(iter->first);
+		vElemsOut.insert(vElemsOut.end(), iter->second.begin(), iter->second.end());
+		vOffsetsOut.push_back(vElemsOut.size());
+	}
+}
+
+////////////////////////////////////////////////////////////////////////
+template <class TLayout>
+void InterfaceCommPlan<TLayout>::
+init(const Layout& sendLayout, const Layout& recvLayout,
+	 size_t valueSize, const ProcessCommunicator& procComm, int tag)
+{
+	PCL_PROFILE(pcl_IntComPlan_init);
+
+	UG_COND_THROW(m_bActive, "InterfaceCommPlan::init: Can't reinitialize a "
+				  "plan while a communication is pending.");
+	UG_COND_THROW(valueSize == 0, "InterfaceCommPlan::init: Value size "
+				  "has to be positive.");
+
+	clear();
+	m_valueSize = valueSize;
+
+//	build gather / scatter lists
+	m_vSendOffsets.push_back(0);
+	flatten_layout(sendLayout, m_vSendProcs, m_vSendOffsets, m_vSendElems,
+				   typename TLayout::category_tag());
+
+	m_vRecvOffsets.push_back(0);
+	flatten_layout(recvLayout, m_vRecvProcs, m_vRecvOffsets, m_vRecvElems,
+				   typename TLayout::category_tag());
+
+//	allocate buffers. They may not be resized afterwards, since the
+//	persistent requests refer to their memory.
+	m_vSendBuf.resize(m_vSendElems.size() * m_valueSize);
+	m_vRecvBuf.resize(m_vRecvElems.size() * m_valueSize);
+
+//	create persistent requests
+	const size_t numRecvs = m_vRecvProcs.size();
+	const size_t numSends = m_vSendProcs.size();
+	if(numRecvs + numSends == 0){
+		m_bInitialized = true;
+		return;
+	}
+
+	UG_COND_THROW(procComm.is_local() || procComm.empty(),
+				  "InterfaceCommPlan::init: The given process communicator "
+				  "does not contain the processes referenced by the layouts.");
+	m_procComm = procComm;
+	MPI_Comm mpiComm = m_procComm.get_mpi_communicator();
+
+//	translate global ranks of the neighbors to ranks in mpiComm
+	std::vector<int> vGlobalRanks(m_vRecvProcs);
+	vGlobalRanks.insert(vGlobalRanks.end(), m_vSendProcs.begin(), m_vSendProcs.end());
+	std::vector<int> vRanks(vGlobalRanks);
+	if(!m_procComm.is_world()){
+		MPI_Group worldGroup, commGroup;
+		MPI_Comm_group(PCL_COMM_WORLD, &worldGroup);
+		MPI_Comm_group(mpiComm, &commGroup);
+		MPI_Group_translate_ranks(worldGroup, (int)vGlobalRanks.size(),
+								  &vGlobalRanks[0], commGroup, &vRanks[0]);
+		MPI_Group_free(&worldGroup);
+		MPI_Group_free(&commGroup);
+		for(size_t i = 0; i < vRanks.size(); ++i){
+			UG_COND_THROW(vRanks[i] == MPI_UNDEFINED,
+						  "InterfaceCommPlan::init: Process " << vGlobalRanks[i]
+						  << " is referenced by the layouts but is not contained"
+						  " in the given process communicator.");
+		}
+	}
+
+	m_vRequests.resize(numRecvs + numSends, MPI_REQUEST_NULL);
+
+	for(size_t i = 0; i < numRecvs; ++i){
+		const size_t offset = m_vRecvOffsets[i] * m_valueSize;
+		const size_t size = m_vRecvOffsets[i+1] * m_valueSize - offset;
+		MPI_Recv_init(&m_vRecvBuf[offset], (int)size, MPI_UNSIGNED_CHAR,
+					  vRanks[i], tag, mpiComm, &m_vRequests[i]);
+	}
+
+	for(size_t i = 0; i < numSends; ++i){
+		const size_t offset = m_vSendOffsets[i] * m_valueSize;
+		const size_t size = m_vSendOffsets[i+1] * m_valueSize - offset;
+		MPI_Send_init(&m_vSendBuf[offset], (int)size, MPI_UNSIGNED_CHAR,
+					  vRanks[numRecvs + i], tag, mpiComm,
+					  &m_vRequests[numRecvs + i]);
+	}
+
+	m_bInitialized = true;
+}
+
+////////////////////////////////////////////////////////////////////////
+template <class TLayout>
+bool InterfaceCommPlan<TLayout>::
+matches(const Layout& sendLayout, const Layout& recvLayout) const
+{
+	if(!m_bInitialized)
+		return false;
+
+	std::vector<int> vProcs;
+	std::vector<size_t> vOffsets(1, 0);
+	std::vector<Element> vElems;
+	flatten_layout(sendLayout, vProcs, vOffsets, vElems,
+				   typename TLayout::category_tag());
+	if(vProcs != m_vSendProcs || vOffsets != m_vSendOffsets
+	   || vElems != m_vSendElems)
+		return false;
+
+	vProcs.clear();
+	vOffsets.assign(1, 0);
+	vElems.clear();
+	flatten_layout(recvLayout, vProcs, vOffsets, vElems,
+				   typename TLayout::category_tag());
+	return vProcs == m_vRecvProcs && vOffsets == m_vRecvOffsets
+		   && vElems == m_vRecvElems;
+}
+
+////////////////////////////////////////////////////////////////////////
+template <class TLayout>
+void InterfaceCommPlan<TLayout>::
+clear()
+{
+	UG_COND_THROW(m_bActive, "InterfaceCommPlan::clear: Can't clear a "
+				  "plan while a communication is pending.");
+
+//	plans may be destroyed after MPI has been finalized (e.g. if they are
+//	held by objects which are released at program exit).
+	int finalized = 0;
+	MPI_Finalized(&finalized);
+	if(!finalized){
+		for(size_t i = 0; i < m_vRequests.size(); ++i){
+			if(m_vRequests[i] != MPI_REQUEST_NULL)
+				MPI_Request_free(&m_vRequests[i]);
+		}
+	}
+
+	m_vRequests.clear();
+	m_procComm = ProcessCommunicator(PCD_LOCAL);
+	m_vSendProcs.clear();
+	m_vSendOffsets.clear();
+	m_vRecvProcs.clear();
+	m_vRecvOffsets.clear();
+	m_vSendElems.clear();
+	m_vRecvElems.clear();
+	m_vSendBuf.clear();
+	m_vRecvBuf.clear();
+	m_valueSize = 0;
+	m_bInitialized = false;
+}
+
+////////////////////////////////////////////////////////////////////////
+template <class TLayout>
+void InterfaceCommPlan<TLayout>::
+start()
+{
+	PCL_PROFILE(pcl_IntComPlan_start);
+
+	UG_COND_THROW(!m_bInitialized, "InterfaceCommPlan::start: "
+				  "Plan has not been initialized.");
+	UG_COND_THROW(m_bActive, "InterfaceCommPlan::start: A previous communication "
+				  "is still pending. Make sure to call wait() after each start().");
+
+	if(!m_vRequests.empty())
+		MPI_Startall((int)m_vRequests.size(), &m_vRequests[0]);
+	m_bActive = true;
+}
+
+////////////////////////////////////////////////////////////////////////
+template <class TLayout>
+void InterfaceCommPlan<TLayout>::
+wait()
+{
+	PCL_PROFILE(pcl_IntComPlan_wait);
+
+	if(!m_bActive)
+		return;
+
+//	persistent requests stay allocated after completion
+	Waitall(m_vRequests);
+	m_bActive = false;
+}
+
+}//	end of namespace pcl
+
+#endif
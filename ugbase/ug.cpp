@@ -37,6 +37,7 @@
 #include "common/log.h"
 #include "common/util/path_provider.h"
 #include "common/util/os_info.h"
+#include "common/util/async_file_writer.h"
 #include "common/profiler/profiler.h"
 #include "common/profiler/profile_node.h"
 
@@ -199,6 +200,15 @@ int UGInit(int *argcp, char ***argvp, int parallelOutputProcRank)
 int UGFinalizeNoPCLFinalize()
 {
 	EnableMemTracker(false);
+
+//	make sure that all asynchronous output is on disk
+	try{
+		GetAsyncFileWriter().flush();
+	}
+	catch(UGError& err){
+		UG_ERR_LOG(err.get_msg() << "\n");
+	}
+
 	ug::GetLogAssistant().flush_error_log();
 	
 	if (outputProfileStats) {